@@ -96,6 +96,7 @@ px4_add_board(
 		tune_control
 		usb_connected
 		ver
+		work_queue
 
 	EXAMPLES
 		bottle_drop # OBC challenge
@@ -45,20 +45,25 @@ class ScheduledWorkItem : public WorkItem
 public:
 
 	ScheduledWorkItem(const wq_config_t &config) : WorkItem(config) {}
+	ScheduledWorkItem(const char *name, const wq_config_t &config) : WorkItem(name, config) {}
 	virtual ~ScheduledWorkItem() override;
 
 	/**
 	 * Schedule next run with a delay in microseconds.
+	 * On an I2C or SPI bus queue the run might be delayed further by up to 1/8 of the delay, to keep it
+	 * from delaying the next run of another item on the same bus (@see WorkQueue::ScheduleDelay()).
 	 *
-	 * @param delay_us		The delay in microseconds.
+	 * @param delay_us		The minimum delay in microseconds.
 	 */
 	void ScheduleDelayed(uint32_t delay_us);
 
 	/**
 	 * Schedule repeating run with optional delay.
+	 * The first run is delayed further to a phase that minimizes the overlap with the other
+	 * periodic items of the work queue (@see WorkQueue::SchedulePeriodic()).
 	 *
 	 * @param interval_us		The interval in microseconds.
-	 * @param delay_us			The delay (optional) in microseconds.
+	 * @param delay_us			The minimum delay (optional) in microseconds.
 	 */
 	void ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0);
 
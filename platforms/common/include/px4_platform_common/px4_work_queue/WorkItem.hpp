@@ -49,12 +49,21 @@ class WorkItem : public IntrusiveQueueNode<WorkItem *>
 public:
 
 	explicit WorkItem(const wq_config_t &config);
+
+	/**
+	 * @param name		Name shown in the work queue status (must stay valid, e.g. a string literal).
+	 * @param config	The WorkQueue configuration (see WorkQueueManager.hpp).
+	 */
+	WorkItem(const char *name, const wq_config_t &config);
+
 	WorkItem() = delete;
 
 	virtual ~WorkItem();
 
 	inline void ScheduleNow() { if (_wq != nullptr) _wq->Add(this); }
 
+	const char *ItemName() const { return _item_name; }
+
 	virtual void Run() = 0;
 
 	/**
@@ -79,10 +88,18 @@ protected:
 	bool Init(const wq_config_t &config);
 	void Deinit();
 
+	WorkQueue *work_queue() const { return _wq; }
+
 private:
 
+	friend class WorkQueue;
+
 	WorkQueue *_wq{nullptr};
 
+	const char *_item_name{nullptr};
+
+	int _schedule_slot{-1};	///< run time statistics slot in the WorkQueue, -1 if not scheduled from a timer, -2 if the table was full
+
 };
 
 } // namespace px4
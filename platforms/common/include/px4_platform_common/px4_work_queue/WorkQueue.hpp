@@ -37,6 +37,7 @@
 
 #include <containers/List.hpp>
 #include <containers/IntrusiveQueue.hpp>
+#include <drivers/drv_hrt.h>
 #include <px4_atomic.h>
 #include <px4_defines.h>
 #include <px4_sem.h>
@@ -62,14 +63,94 @@ public:
 
 	void Clear();
 
+	/**
+	 * Register a work item that is going to run periodically on this queue and get the delay of its
+	 * first run. The phase is chosen to minimize the overlap with the other periodic items of the queue,
+	 * e.g. the transfers of the other devices on the same bus, based on their measured run times.
+	 *
+	 * @param item		The work item.
+	 * @param interval_us	The interval it is going to be scheduled at.
+	 * @param delay_us	The minimum delay of the first run.
+	 * @return		The delay of the first run, at least delay_us.
+	 */
+	uint32_t SchedulePeriodic(WorkItem *item, uint32_t interval_us, uint32_t delay_us);
+
+	/**
+	 * Get the delay of the next run of a work item that re-arms itself (e.g. measure/collect cycles).
+	 * On a bus queue (I2C or SPI) the run is moved back by up to 1/8 of the delay where this keeps it from
+	 * delaying the next release of another item of the queue. On the other queues the delay is not changed.
+	 *
+	 * @param item		The work item.
+	 * @param delay_us	The minimum delay of the run.
+	 * @return		The delay of the run, at least delay_us.
+	 */
+	uint32_t ScheduleDelay(WorkItem *item, uint32_t delay_us);
+
+	/**
+	 * Mark a work item as no longer scheduled. Its run time statistics are kept.
+	 */
+	void ScheduleCancel(WorkItem *item);
+
+	/**
+	 * Stop tracking a work item, e.g. before it is deleted.
+	 */
+	void ScheduleRemove(WorkItem *item);
+
 	void Run();
 
 	void request_stop() { _should_exit.store(true); }
 
+	/**
+	 * Print the items scheduled from a timer with their rate, run time and utilization of the queue (bus).
+	 */
 	void print_status();
 
 private:
 
+	/**
+	 * Work item scheduled from a timer, with run time statistics. The slot of an item does not change while it
+	 * is tracked, so the queue thread and the scheduling threads access their own entries without locking;
+	 * only allocating and freeing slots takes _schedule_lock.
+	 */
+	struct ScheduleEntry {
+		px4::atomic<const WorkItem *> item{nullptr};	///< nullptr if the slot is free
+		px4::atomic<bool> periodic{false};
+		px4::atomic<uint32_t> interval_us{0};		///< interval of a periodic item
+		px4::atomic<uint32_t> phase_us{0};		///< first run time of a periodic item modulo the interval
+		px4::atomic<uint32_t> next_release{0};		///< lower 32 bits of the next release time of a re-arming item, 0 if none
+
+		// published by the queue thread once per statistics window
+		px4::atomic<uint32_t> run_time_avg_us{0};
+		px4::atomic<uint32_t> run_time_max_us{0};
+		px4::atomic<uint32_t> rate_centihz{0};
+		px4::atomic<uint32_t> load_ppm{0};		///< fraction of the time spent running the item, in parts per million
+
+		// accessed by the queue thread only
+		hrt_abstime window_start{0};
+		uint32_t window_runs{0};
+		uint32_t window_run_time_us{0};
+	};
+
+	static constexpr int SCHEDULE_ENTRIES_MAX = 12;
+	static constexpr int SCHEDULE_SLOT_UNTRACKED = -2;	///< slot of an item that did not get one because the table was full
+	static constexpr hrt_abstime SCHEDULE_WINDOW_US = 1000000;
+
+	/// get the slot of an item, allocating one if needed, negative if the table is full
+	int schedule_slot(WorkItem *item);
+
+	/// average run time of an entry, estimated if it did not run yet
+	uint32_t schedule_duration_estimate(int index, uint32_t fallback_us) const;
+
+	/// first release of an entry at or after time t, false if it has no known release
+	bool schedule_next_release(int index, hrt_abstime t, hrt_abstime now, hrt_abstime &release) const;
+
+	/// total overlap (us) of the given runs with the runs of the other periodic entries
+	uint64_t schedule_overlap(hrt_abstime start, uint32_t interval_us, uint32_t duration_us, int releases,
+				  int skip_index, uint32_t fallback_us) const;
+
+	/// queue thread only, lock-free
+	void schedule_record_run(int index, const WorkItem *item, hrt_abstime start, hrt_abstime end);
+
 	bool should_exit() const { return _should_exit.load(); }
 
 #ifdef __PX4_NUTTX
@@ -88,6 +169,12 @@ private:
 
 	px4::atomic_bool	_should_exit{false};
 	const wq_config_t	&_config;
+	const bool		_bus_queue;	///< I2C or SPI bus queue, only these move the runs of re-arming items
+
+	ScheduleEntry		*_schedule{nullptr};	///< allocated on first use, the WorkQueue lives on its thread stack
+	px4::atomic_int		_schedule_count{0};	///< number of slots in use or used before
+	px4::atomic_int		_schedule_untracked{0};	///< number of items scheduled from a timer without a slot
+	px4_sem_t		_schedule_lock;
 
 };
 
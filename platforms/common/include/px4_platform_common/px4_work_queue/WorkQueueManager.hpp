@@ -44,6 +44,7 @@ struct wq_config_t {
 	const char *name;
 	uint16_t stacksize;
 	int8_t relative_priority; // relative to max
+	bool relative_to_default{false}; // relative_priority is relative to SCHED_PRIORITY_DEFAULT instead of max
 };
 
 namespace wq_configurations
@@ -65,6 +66,16 @@ static constexpr wq_config_t I2C4{"wq:I2C4", 1250, -10};
 static constexpr wq_config_t att_pos_ctrl{"wq:att_pos_ctrl", 2000, -11}; // PX4 att/pos controllers, highest priority after sensors
 
 static constexpr wq_config_t hp_default{"wq:hp_default", 1500, -12};
+
+static constexpr wq_config_t INS0{"wq:INS0", 6600, -16}; // ekf2 main filter, triggered by sensor_combined
+static constexpr wq_config_t INS1{"wq:INS1", 6000, -17}; // secondary ekf2 instances, one thread each, below the main ekf2 filter
+static constexpr wq_config_t INS2{"wq:INS2", 6000, -18};
+static constexpr wq_config_t INS3{"wq:INS3", 6000, -19};
+
+// navigator and other low rate vehicle logic, may block on dataman. Same priority as the former navigator task
+// (SCHED_PRIORITY_NAVIGATION), just above the default priority tasks (commander, mavlink, logger).
+static constexpr wq_config_t nav_and_controllers{"wq:nav_and_controllers", 1800, 5, true};
+
 static constexpr wq_config_t lp_default{"wq:lp_default", 1700, -50};
 
 static constexpr wq_config_t test1{"wq:test1", 800, 0};
@@ -82,6 +93,11 @@ int WorkQueueManagerStart();
  */
 int WorkQueueManagerStop();
 
+/**
+ * Print the status of all work queues, including the load of their periodic items.
+ */
+int WorkQueueManagerStatus();
+
 /**
  * Create (or find) a work queue with a particular configuration.
  *
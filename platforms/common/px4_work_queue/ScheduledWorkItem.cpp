@@ -32,6 +32,7 @@
  ****************************************************************************/
 
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <px4_platform_common/px4_work_queue/WorkQueue.hpp>
 
 namespace px4
 {
@@ -49,17 +50,35 @@ void ScheduledWorkItem::schedule_trampoline(void *arg)
 
 void ScheduledWorkItem::ScheduleDelayed(uint32_t delay_us)
 {
+	WorkQueue *wq = work_queue();
+
+	if (wq != nullptr) {
+		delay_us = wq->ScheduleDelay(this, delay_us);
+	}
+
 	hrt_call_after(&_call, delay_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
 void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us)
 {
+	WorkQueue *wq = work_queue();
+
+	if (wq != nullptr) {
+		delay_us = wq->SchedulePeriodic(this, interval_us, delay_us);
+	}
+
 	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
 void ScheduledWorkItem::ScheduleClear()
 {
 	hrt_cancel(&_call);
+
+	WorkQueue *wq = work_queue();
+
+	if (wq != nullptr) {
+		wq->ScheduleCancel(this);
+	}
 }
 
 } // namespace px4
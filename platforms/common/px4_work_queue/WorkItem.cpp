@@ -49,6 +49,14 @@ WorkItem::WorkItem(const wq_config_t &config)
 	}
 }
 
+WorkItem::WorkItem(const char *name, const wq_config_t &config) :
+	_item_name(name)
+{
+	if (!Init(config)) {
+		PX4_ERR("%s init failed", name);
+	}
+}
+
 WorkItem::~WorkItem()
 {
 	Deinit();
@@ -81,6 +89,7 @@ void WorkItem::Deinit()
 		_wq = nullptr;
 
 		wq_temp->Remove(this);
+		wq_temp->ScheduleRemove(this);
 	}
 }
 
@@ -34,8 +34,11 @@
 #include <px4_platform_common/px4_work_queue/WorkQueue.hpp>
 #include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 
+#include <stdio.h>
 #include <string.h>
 
+#include <lib/mathlib/mathlib.h>
+#include <px4_log.h>
 #include <px4_tasks.h>
 #include <px4_time.h>
 #include <drivers/drv_hrt.h>
@@ -44,7 +47,8 @@ namespace px4
 {
 
 WorkQueue::WorkQueue(const wq_config_t &config) :
-	_config(config)
+	_config(config),
+	_bus_queue((strncmp(config.name, "wq:I2C", 6) == 0) || (strncmp(config.name, "wq:SPI", 6) == 0))
 {
 	// set the threads name
 #ifdef __PX4_DARWIN
@@ -59,6 +63,8 @@ WorkQueue::WorkQueue(const wq_config_t &config) :
 
 	px4_sem_init(&_process_lock, 0, 0);
 	px4_sem_setprotocol(&_process_lock, SEM_PRIO_NONE);
+
+	px4_sem_init(&_schedule_lock, 0, 1);
 }
 
 WorkQueue::~WorkQueue()
@@ -67,6 +73,9 @@ WorkQueue::~WorkQueue()
 	px4_sem_destroy(&_process_lock);
 	work_unlock();
 
+	px4_sem_destroy(&_schedule_lock);
+	delete[] _schedule;
+
 #ifndef __PX4_NUTTX
 	px4_sem_destroy(&_qlock);
 #endif /* __PX4_NUTTX */
@@ -114,7 +123,18 @@ void WorkQueue::Run()
 			WorkItem *work = _q.pop();
 
 			work_unlock(); // unlock work queue to run (item may requeue itself)
+
+			// run time statistics of the items scheduled from a timer
+			const int slot = work->_schedule_slot;
+			const hrt_abstime start = (slot >= 0) ? hrt_absolute_time() : 0;
+
 			work->Run();
+
+			if (slot >= 0) {
+				// the item might have deleted itself, the pointer is only compared
+				schedule_record_run(slot, work, start, hrt_absolute_time());
+			}
+
 			work_lock(); // re-lock
 		}
 
@@ -122,9 +142,422 @@ void WorkQueue::Run()
 	}
 }
 
+int WorkQueue::schedule_slot(WorkItem *item)
+{
+	// an item that did not get a slot is not retried, it is counted as untracked until it is removed
+	if (item->_schedule_slot >= 0 || item->_schedule_slot == SCHEDULE_SLOT_UNTRACKED) {
+		return item->_schedule_slot;
+	}
+
+	px4_sem_wait(&_schedule_lock);
+
+	if (_schedule == nullptr) {
+		_schedule = new ScheduleEntry[SCHEDULE_ENTRIES_MAX] {};
+	}
+
+	int index = -1;
+
+	if (_schedule != nullptr) {
+		const int count = _schedule_count.load();
+
+		for (int i = 0; i < count && index < 0; i++) {
+			if (_schedule[i].item.load() == nullptr) {
+				index = i;
+			}
+		}
+
+		if (index < 0 && count < SCHEDULE_ENTRIES_MAX) {
+			index = count;
+		}
+	}
+
+	if (index >= 0) {
+		ScheduleEntry &entry = _schedule[index];
+		entry.periodic.store(false);
+		entry.interval_us.store(0);
+		entry.phase_us.store(0);
+		entry.next_release.store(0);
+		entry.run_time_avg_us.store(0);
+		entry.run_time_max_us.store(0);
+		entry.rate_centihz.store(0);
+		entry.load_ppm.store(0);
+		entry.window_start = 0;
+		entry.window_runs = 0;
+		entry.window_run_time_us = 0;
+
+		// publish the entry last, the queue thread only updates entries of the items it runs
+		entry.item.store(item);
+		item->_schedule_slot = index;
+
+		if (index == _schedule_count.load()) {
+			_schedule_count.store(index + 1);
+		}
+
+	} else {
+		PX4_WARN("%s: schedule table full, %s not tracked", get_name(),
+			 (item->ItemName() != nullptr) ? item->ItemName() : "item");
+		item->_schedule_slot = SCHEDULE_SLOT_UNTRACKED;
+		_schedule_untracked.fetch_add(1);
+	}
+
+	px4_sem_post(&_schedule_lock);
+
+	return index;
+}
+
+uint32_t WorkQueue::schedule_duration_estimate(int index, uint32_t fallback_us) const
+{
+	const ScheduleEntry &entry = _schedule[index];
+
+	// the average is published after the first statistics window, use the maximum until then
+	uint32_t duration = entry.run_time_avg_us.load();
+
+	if (duration == 0) {
+		duration = entry.run_time_max_us.load();
+	}
+
+	if (duration > 0) {
+		return duration;
+	}
+
+	// not run yet, assume it takes as long as the others on the queue
+	uint64_t total = 0;
+	uint32_t count = 0;
+
+	for (int i = 0; i < _schedule_count.load(); i++) {
+		const uint32_t other = _schedule[i].run_time_avg_us.load();
+
+		if (_schedule[i].item.load() != nullptr && other > 0) {
+			total += other;
+			count++;
+		}
+	}
+
+	return (count > 0) ? total / count : fallback_us;
+}
+
+bool WorkQueue::schedule_next_release(int index, hrt_abstime t, hrt_abstime now, hrt_abstime &release) const
+{
+	const ScheduleEntry &entry = _schedule[index];
+
+	if (entry.item.load() == nullptr) {
+		return false;
+	}
+
+	if (entry.periodic.load()) {
+		const uint32_t interval = entry.interval_us.load();
+
+		if (interval == 0) {
+			return false;
+		}
+
+		// next point of the phase grid
+		const uint32_t phase = entry.phase_us.load();
+		release = t + (interval - (t + interval - phase) % interval) % interval;
+		return true;
+	}
+
+	const uint32_t next_release = entry.next_release.load();
+
+	if (next_release == 0) {
+		return false;
+	}
+
+	// extend the lower 32 bits to the release time closest to now
+	release = now + (int32_t)(next_release - (uint32_t)now);
+
+	return release >= t;
+}
+
+uint64_t WorkQueue::schedule_overlap(hrt_abstime start, uint32_t interval_us, uint32_t duration_us, int releases,
+				     int skip_index, uint32_t fallback_us) const
+{
+	uint64_t overlap = 0;
+
+	for (int k = 0; k < releases; k++) {
+		const hrt_abstime begin = start + (hrt_abstime)k * interval_us;
+		const hrt_abstime end = begin + duration_us;
+
+		for (int i = 0; i < _schedule_count.load(); i++) {
+			const ScheduleEntry &other = _schedule[i];
+
+			if (i == skip_index || !other.periodic.load()) {
+				continue;
+			}
+
+			const uint32_t other_duration = schedule_duration_estimate(i, fallback_us);
+			const uint32_t other_interval = other.interval_us.load();
+
+			// first run of the other item that can still overlap
+			hrt_abstime other_begin;
+
+			if (!schedule_next_release(i, (begin > other_duration) ? begin - other_duration : 0, start, other_begin)) {
+				continue;
+			}
+
+			for (; other_begin < end; other_begin += other_interval) {
+				const hrt_abstime other_end = other_begin + other_duration;
+
+				if (other_end > begin) {
+					overlap += math::min(end, other_end) - math::max(begin, other_begin);
+				}
+			}
+		}
+	}
+
+	return overlap;
+}
+
+uint32_t WorkQueue::SchedulePeriodic(WorkItem *item, uint32_t interval_us, uint32_t delay_us)
+{
+	const int index = schedule_slot(item);
+
+	if (index < 0) {
+		return delay_us;
+	}
+
+	ScheduleEntry &entry = _schedule[index];
+
+	if (interval_us == 0) {
+		entry.periodic.store(false);
+		return delay_us;
+	}
+
+	// one phase assignment at a time
+	px4_sem_wait(&_schedule_lock);
+
+	entry.periodic.store(false);
+	entry.interval_us.store(interval_us);
+
+	// without any measured run time spread the items evenly over the shortest interval
+	uint32_t interval_min = interval_us;
+	uint32_t interval_max = interval_us;
+	uint32_t periodic_count = 1;
+
+	for (int i = 0; i < _schedule_count.load(); i++) {
+		if (_schedule[i].periodic.load()) {
+			interval_min = math::min(interval_min, _schedule[i].interval_us.load());
+			interval_max = math::max(interval_max, _schedule[i].interval_us.load());
+			periodic_count++;
+		}
+	}
+
+	const uint32_t fallback_us = interval_min / (2 * periodic_count);
+	const uint32_t duration_us = schedule_duration_estimate(index, fallback_us);
+
+	// try 32 phases, evaluated over the longest interval of the queue
+	const int releases = math::constrain((int)(interval_max / interval_us) + 1, 1, 32);
+	const uint32_t step = math::max(interval_us / 32, (uint32_t)1);
+	const hrt_abstime earliest = hrt_absolute_time() + delay_us;
+
+	uint32_t best_offset = 0;
+	uint64_t best_overlap = UINT64_MAX;
+
+	for (uint32_t offset = 0; offset < interval_us; offset += step) {
+		const uint64_t overlap = schedule_overlap(earliest + offset, interval_us, duration_us, releases, index, fallback_us);
+
+		if (overlap < best_overlap) {
+			best_overlap = overlap;
+			best_offset = offset;
+
+			if (overlap == 0) {
+				break;
+			}
+		}
+	}
+
+	entry.phase_us.store((earliest + best_offset) % interval_us);
+	entry.periodic.store(true);
+
+	px4_sem_post(&_schedule_lock);
+
+	return delay_us + best_offset;
+}
+
+uint32_t WorkQueue::ScheduleDelay(WorkItem *item, uint32_t delay_us)
+{
+	const int index = schedule_slot(item);
+
+	if (index < 0) {
+		return delay_us;
+	}
+
+	ScheduleEntry &entry = _schedule[index];
+
+	// a single run replaces a periodic schedule
+	entry.periodic.store(false);
+
+	const hrt_abstime now = hrt_absolute_time();
+	hrt_abstime release = now + delay_us;
+	const uint32_t duration = schedule_duration_estimate(index, 0);
+
+	if (_bus_queue && duration > 0 && delay_us >= 8) {
+		// move the run behind the bus transfers it would delay, as long as the delay grows by less than 1/8
+		const hrt_abstime latest = release + delay_us / 8;
+		hrt_abstime candidate = release;
+
+		for (int pass = 0; pass < SCHEDULE_ENTRIES_MAX && candidate <= latest; pass++) {
+			bool moved = false;
+
+			for (int i = 0; i < _schedule_count.load(); i++) {
+				hrt_abstime other_release;
+
+				if (i != index && schedule_next_release(i, candidate, now, other_release)
+				    && other_release < candidate + duration) {
+
+					candidate = other_release + schedule_duration_estimate(i, duration);
+					moved = true;
+				}
+			}
+
+			if (!moved) {
+				release = candidate;
+				break;
+			}
+		}
+	}
+
+	// 0 means no pending release
+	const uint32_t next_release = (uint32_t)release;
+	entry.next_release.store((next_release != 0) ? next_release : 1);
+
+	return release - now;
+}
+
+void WorkQueue::ScheduleCancel(WorkItem *item)
+{
+	const int index = item->_schedule_slot;
+
+	if (_schedule != nullptr && index >= 0) {
+		_schedule[index].periodic.store(false);
+		_schedule[index].next_release.store(0);
+	}
+}
+
+void WorkQueue::ScheduleRemove(WorkItem *item)
+{
+	px4_sem_wait(&_schedule_lock);
+
+	const int index = item->_schedule_slot;
+
+	if (_schedule != nullptr && index >= 0 && _schedule[index].item.load() == item) {
+		_schedule[index].item.store(nullptr);
+
+	} else if (index == SCHEDULE_SLOT_UNTRACKED) {
+		_schedule_untracked.fetch_sub(1);
+	}
+
+	item->_schedule_slot = -1;
+
+	px4_sem_post(&_schedule_lock);
+}
+
+void WorkQueue::schedule_record_run(int index, const WorkItem *item, hrt_abstime start, hrt_abstime end)
+{
+	ScheduleEntry &entry = _schedule[index];
+
+	if (entry.item.load() != item) {
+		return;
+	}
+
+	const uint32_t elapsed = end - start;
+
+	if (elapsed > entry.run_time_max_us.load()) {
+		entry.run_time_max_us.store(elapsed);
+	}
+
+	if (entry.window_runs == 0) {
+		entry.window_start = start;
+	}
+
+	entry.window_runs++;
+	entry.window_run_time_us += elapsed;
+
+	const hrt_abstime window = end - entry.window_start;
+
+	if (window >= SCHEDULE_WINDOW_US) {
+		entry.run_time_avg_us.store(entry.window_run_time_us / entry.window_runs);
+		entry.rate_centihz.store((uint32_t)((uint64_t)entry.window_runs * 100 * 1000000 / window));
+		entry.load_ppm.store((uint32_t)((uint64_t)entry.window_run_time_us * 1000000 / window));
+
+		entry.window_runs = 0;
+		entry.window_run_time_us = 0;
+	}
+}
+
 void WorkQueue::print_status()
 {
 	PX4_INFO("WorkQueue: %s running", get_name());
+
+	struct ItemStatus {
+		const char *name;
+		uint32_t interval_us;
+		uint32_t phase_us;
+		uint32_t run_time_avg_us;
+		uint32_t run_time_max_us;
+		uint32_t rate_centihz;
+		uint32_t load_ppm;
+		bool periodic;
+	};
+
+	ItemStatus status[SCHEDULE_ENTRIES_MAX];
+	int count = 0;
+
+	// copy the entries and print them without holding the lock
+	px4_sem_wait(&_schedule_lock);
+
+	for (int i = 0; i < _schedule_count.load(); i++) {
+		const ScheduleEntry &entry = _schedule[i];
+		const WorkItem *item = entry.item.load();
+
+		if (item != nullptr) {
+			ItemStatus &s = status[count++];
+			s.name = item->ItemName();
+			s.interval_us = entry.interval_us.load();
+			s.phase_us = entry.phase_us.load();
+			s.run_time_avg_us = entry.run_time_avg_us.load();
+			s.run_time_max_us = entry.run_time_max_us.load();
+			s.rate_centihz = entry.rate_centihz.load();
+			s.load_ppm = entry.load_ppm.load();
+			s.periodic = entry.periodic.load();
+		}
+	}
+
+	const int untracked = _schedule_untracked.load();
+
+	px4_sem_post(&_schedule_lock);
+
+	if (untracked > 0) {
+		PX4_INFO_RAW("  %d scheduled items not tracked, the table holds %d\n", untracked, SCHEDULE_ENTRIES_MAX);
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	PX4_INFO_RAW("  %-24s %11s %9s %8s %8s %8s %9s\n", "scheduled item", "rate", "interval", "phase", "avg", "max", "load");
+
+	uint32_t load_total = 0;
+
+	for (int i = 0; i < count; i++) {
+		const ItemStatus &s = status[i];
+		load_total += s.load_ppm;
+
+		char interval[12] = "-";
+		char phase[12] = "-";
+
+		if (s.periodic) {
+			snprintf(interval, sizeof(interval), "%u us", (unsigned)s.interval_us);
+			snprintf(phase, sizeof(phase), "%u us", (unsigned)s.phase_us);
+		}
+
+		PX4_INFO_RAW("  %-24s %6u.%u Hz %9s %8s %5u us %5u us %5u.%u %%\n", (s.name != nullptr) ? s.name : "(unnamed)",
+			     (unsigned)(s.rate_centihz / 100), (unsigned)(s.rate_centihz / 10 % 10), interval, phase,
+			     (unsigned)s.run_time_avg_us, (unsigned)s.run_time_max_us,
+			     (unsigned)(s.load_ppm / 10000), (unsigned)(s.load_ppm / 1000 % 10));
+	}
+
+	PX4_INFO_RAW("  total load: %u.%u %%\n", (unsigned)(load_total / 10000), (unsigned)(load_total / 1000 % 10));
 }
 
 } // namespace px4
@@ -220,7 +220,8 @@ static int WorkQueueManagerRun(int, char **)
 #endif // ! QuRT
 
 			// priority
-			param.sched_priority = sched_get_priority_max(SCHED_FIFO) + wq->relative_priority;
+			param.sched_priority = (wq->relative_to_default ? SCHED_PRIORITY_DEFAULT : sched_get_priority_max(SCHED_FIFO))
+					       + wq->relative_priority;
 			int ret_setschedparam = pthread_attr_setschedparam(&attr, &param);
 
 			if (ret_setschedparam != 0) {
@@ -295,4 +296,20 @@ int WorkQueueManagerStop()
 	return PX4_OK;
 }
 
+int WorkQueueManagerStatus()
+{
+	if (_wq_manager_wqs_list == nullptr) {
+		PX4_INFO("not running");
+		return PX4_ERROR;
+	}
+
+	auto lg = _wq_manager_wqs_list->getLockGuard();
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		wq->print_status();
+	}
+
+	return PX4_OK;
+}
+
 } // namespace px4
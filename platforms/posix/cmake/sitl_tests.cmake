@@ -14,10 +14,12 @@ set(tests
 	dataman
 	file2
 	float
+	geofence
 	hrt
 	int
 	IntrusiveQueue
 	List
+	lpe
 	mathlib
 	matrix
 	microbench_hrt
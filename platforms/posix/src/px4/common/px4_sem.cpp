@@ -139,6 +139,11 @@ int px4_sem_timedwait(px4_sem_t *s, const struct timespec *abstime)
 		ret = 0;
 	}
 
+	if (ret != 0) {
+		// the wait did not take a count, give back the one reserved above
+		s->value++;
+	}
+
 	errno = ret;
 
 	if (ret != 0 && ret != ETIMEDOUT) {
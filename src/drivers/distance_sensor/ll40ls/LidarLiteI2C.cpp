@@ -48,7 +48,7 @@
 LidarLiteI2C::LidarLiteI2C(int bus, uint8_t rotation, int address) :
 	LidarLite(rotation),
 	I2C("LL40LS", nullptr, bus, address, 100000),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id()))
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id()))
 {
 	// up the retries since the device misses the first measure attempts
 	_retries = 3;
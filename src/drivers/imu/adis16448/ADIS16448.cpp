@@ -39,7 +39,7 @@
 
 ADIS16448::ADIS16448(int bus, uint32_t device, enum Rotation rotation) :
 	SPI("ADIS16448", nullptr, bus, device, SPIDEV_MODE3, 1000000),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id())),
 	_px4_accel(get_device_id(), ORB_PRIO_MAX, rotation),
 	_px4_baro(get_device_id(), ORB_PRIO_MAX),
 	_px4_gyro(get_device_id(), ORB_PRIO_MAX, rotation),
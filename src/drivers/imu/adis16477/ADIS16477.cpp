@@ -55,7 +55,7 @@ using namespace time_literals;
 
 ADIS16477::ADIS16477(int bus, uint32_t device, enum Rotation rotation) :
 	SPI("ADIS16477", nullptr, bus, device, SPIDEV_MODE3, 1000000),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id())),
 	_px4_accel(get_device_id(), ORB_PRIO_MAX, rotation),
 	_px4_gyro(get_device_id(), ORB_PRIO_MAX, rotation),
 	_sample_interval_perf(perf_alloc(PC_INTERVAL, "adis16477: read interval")),
@@ -188,7 +188,7 @@ using namespace time_literals;
 
 FXAS21002C::FXAS21002C(int bus, uint32_t device, enum Rotation rotation) :
 	SPI("FXAS21002C", nullptr, bus, device, SPIDEV_MODE0, 2 * 1000 * 1000),
-	ScheduledWorkItem(px4::device_bus_to_wq(this->get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(this->get_device_id())),
 	_px4_gyro(get_device_id(), (external() ? ORB_PRIO_VERY_HIGH : ORB_PRIO_DEFAULT), rotation),
 	_sample_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": read")),
 	_sample_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": read interval")),
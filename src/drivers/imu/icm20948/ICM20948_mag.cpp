@@ -90,24 +90,18 @@ bool ICM20948_mag::check_duplicate(uint8_t *mag_data)
 void
 ICM20948_mag::measure()
 {
-	union raw_data_t {
-		struct ak8963_regs ak8963_data;
-		struct ak09916_regs ak09916_data;
-	} raw_data;
-
+	struct ak09916_regs raw_data;
 
 	const hrt_abstime timestamp_sample = hrt_absolute_time();
 	int ret = _interface->read(AK09916REG_ST1, &raw_data, sizeof(struct ak09916_regs));
 
 	if (ret == OK) {
-		raw_data.ak8963_data.st2 = raw_data.ak09916_data.st2;
-
-		_measure(timestamp_sample, raw_data.ak8963_data);
+		_measure(timestamp_sample, raw_data);
 	}
 }
 
 void
-ICM20948_mag::_measure(hrt_abstime timestamp_sample, ak8963_regs data)
+ICM20948_mag::_measure(hrt_abstime timestamp_sample, const ak09916_regs &data)
 {
 	if (check_duplicate((uint8_t *)&data.x) && !(data.st1 & 0x02)) {
 		perf_count(_mag_duplicates);
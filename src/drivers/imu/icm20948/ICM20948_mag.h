@@ -156,7 +156,7 @@ protected:
 	void measure();
 
 	/* Update the state with prefetched data (internally called by the regular measure() )*/
-	void _measure(hrt_abstime timestamp, struct ak8963_regs data);
+	void _measure(hrt_abstime timestamp, const struct ak09916_regs &data);
 
 	uint8_t read_reg(unsigned reg);
 	void write_reg(unsigned reg, uint8_t value);
@@ -86,7 +86,7 @@ const uint16_t ICM20948::_icm20948_checked_registers[ICM20948_NUM_CHECKED_REGIST
 
 ICM20948::ICM20948(device::Device *interface, device::Device *mag_interface, const char *path, enum Rotation rotation,
 		   bool magnetometer_only) :
-	ScheduledWorkItem(px4::device_bus_to_wq(interface->get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(interface->get_device_id())),
 	_interface(interface),
 	_px4_accel(_interface->get_device_id(), (_interface->external() ? ORB_PRIO_DEFAULT : ORB_PRIO_HIGH), rotation),
 	_px4_gyro(_interface->get_device_id(), (_interface->external() ? ORB_PRIO_DEFAULT : ORB_PRIO_HIGH), rotation),
@@ -784,7 +784,8 @@ ICM20948::measure()
 	}
 
 	/*
-	 * In case of a mag passthrough read, hand the magnetometer data over to _mag. Else,
+	 * In case of a mag passthrough read, the magnetometer data was read by the I2C master into the
+	 * external sensor registers and is part of the same burst, hand it over to _mag. Else,
 	 * try to read a magnetometer report.
 	 */
 
@@ -793,7 +794,9 @@ ICM20948::measure()
 	if (_mag.is_passthrough()) {
 #   endif
 
-		_mag._measure(timestamp_sample, mpu_report.mag);
+		if (_register_wait == 0) {
+			_mag._measure(timestamp_sample, icm_report.mag);
+		}
 
 #   ifdef USE_I2C
 
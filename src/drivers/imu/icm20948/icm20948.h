@@ -303,6 +303,7 @@
  * interrupt status.
  */
 struct ICMReport {
+	uint8_t		cmd;
 	uint8_t		accel_x[2];
 	uint8_t		accel_y[2];
 	uint8_t		accel_z[2];
@@ -310,7 +311,7 @@ struct ICMReport {
 	uint8_t		gyro_y[2];
 	uint8_t		gyro_z[2];
 	uint8_t		temp[2];
-	struct ak8963_regs mag;
+	struct ak09916_regs mag;	///< EXT_SLV_SENS_DATA, filled by the I2C master (@see ICM20948_mag::ak8963_setup)
 };
 #pragma pack(pop)
 
@@ -336,6 +337,9 @@ struct MPUReport {
 };
 #pragma pack(pop)
 
+/* the SPI and I2C interfaces tell a burst read from a register read by its size */
+static_assert(sizeof(ICMReport) == sizeof(MPUReport), "ICMReport must be read like an MPUReport");
+
 #define MPU_MAX_WRITE_BUFFER_SIZE (2)
 
 
@@ -100,7 +100,7 @@ ICM20948_I2C::read(unsigned reg_speed, void *data, unsigned count)
 	 */
 	uint32_t offset = count < sizeof(MPUReport) ? 0 : offsetof(MPUReport, status);
 	uint8_t cmd = MPU9250_REG(reg_speed);
-	return transfer(&cmd, 1, &((uint8_t *)data)[offset], count);
+	return transfer(&cmd, 1, &((uint8_t *)data)[offset], count - offset);
 }
 
 int
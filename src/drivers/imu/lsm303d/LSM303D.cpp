@@ -55,7 +55,7 @@ static constexpr uint8_t _checked_registers[] = {
 
 LSM303D::LSM303D(int bus, uint32_t device, enum Rotation rotation) :
 	SPI("LSM303D", nullptr, bus, device, SPIDEV_MODE3, 11 * 1000 * 1000),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id())),
 	_px4_accel(get_device_id(), ORB_PRIO_DEFAULT, rotation),
 	_px4_mag(get_device_id(), ORB_PRIO_LOW, rotation),
 	_accel_sample_perf(perf_alloc(PC_ELAPSED, "lsm303d: acc_read")),
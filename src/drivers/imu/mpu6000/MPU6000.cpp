@@ -39,19 +39,23 @@
  */
 constexpr uint8_t MPU6000::_checked_registers[MPU6000_NUM_CHECKED_REGISTERS];
 
-MPU6000::MPU6000(device::Device *interface, const char *path, enum Rotation rotation, int device_type) :
+MPU6000::MPU6000(device::Device *interface, const char *path, enum Rotation rotation, int device_type, bool fifo) :
 	CDev(path),
-	ScheduledWorkItem(px4::device_bus_to_wq(interface->get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(interface->get_device_id())),
 	_interface(interface),
 	_device_type(device_type),
 	_px4_accel(_interface->get_device_id(), (_interface->external() ? ORB_PRIO_MAX : ORB_PRIO_HIGH), rotation),
 	_px4_gyro(_interface->get_device_id(), (_interface->external() ? ORB_PRIO_MAX : ORB_PRIO_HIGH), rotation),
+	_fifo_enabled(fifo && (device_type == MPU_DEVICE_TYPE_MPU6000)
+		      && (interface->get_device_bus_type() == device::Device::DeviceBusType_SPI)),
 	_sample_perf(perf_alloc(PC_ELAPSED, "mpu6k_read")),
 	_measure_interval(perf_alloc(PC_INTERVAL, "mpu6k_measure_interval")),
 	_bad_transfers(perf_alloc(PC_COUNT, "mpu6k_bad_trans")),
 	_bad_registers(perf_alloc(PC_COUNT, "mpu6k_bad_reg")),
 	_reset_retries(perf_alloc(PC_COUNT, "mpu6k_reset")),
-	_duplicates(perf_alloc(PC_COUNT, "mpu6k_duplicates"))
+	_duplicates(perf_alloc(PC_COUNT, "mpu6k_duplicates")),
+	_fifo_empty(perf_alloc(PC_COUNT, "mpu6k_fifo_empty")),
+	_fifo_overflow(perf_alloc(PC_COUNT, "mpu6k_fifo_overflow"))
 {
 	switch (_device_type) {
 	default:
@@ -75,6 +79,10 @@ MPU6000::MPU6000(device::Device *interface, const char *path, enum Rotation rota
 		_px4_gyro.set_device_type(DRV_GYR_DEVTYPE_ICM20689);
 		break;
 	}
+
+	if (fifo && !_fifo_enabled) {
+		PX4_WARN("FIFO mode is only supported by the MPU6000 on SPI");
+	}
 }
 
 MPU6000::~MPU6000()
@@ -89,6 +97,8 @@ MPU6000::~MPU6000()
 	perf_free(_bad_registers);
 	perf_free(_reset_retries);
 	perf_free(_duplicates);
+	perf_free(_fifo_empty);
+	perf_free(_fifo_overflow);
 }
 
 int
@@ -169,11 +179,25 @@ int MPU6000::reset()
 
 	px4_usleep(1000);
 
-	// SAMPLE RATE
-	_set_sample_rate(1000);
-	px4_usleep(1000);
+	if (_fifo_enabled) {
+		// FIFO mode: bypass the DLPF so the gyro is sampled at 8 kHz and
+		// queue every sample, the software filters run at the full rate
+		write_checked_reg(MPUREG_SMPLRT_DIV, 0);
+		_sample_rate = MPU6000_FIFO_RATE;
+		px4_usleep(1000);
+
+		_set_dlpf_filter(256);
+
+	} else {
+		// SAMPLE RATE
+		_set_sample_rate(1000);
+		px4_usleep(1000);
+
+		_set_dlpf_filter(MPU6000_DEFAULT_ONCHIP_FILTER_FREQ);
+	}
 
-	_set_dlpf_filter(MPU6000_DEFAULT_ONCHIP_FILTER_FREQ);
+	_px4_accel.set_sample_rate(_sample_rate);
+	_px4_gyro.set_sample_rate(_sample_rate);
 
 	if (is_icm_device()) {
 		_set_icm_acc_dlpf_filter(MPU6000_DEFAULT_ONCHIP_FILTER_FREQ);
@@ -205,6 +229,15 @@ int MPU6000::reset()
 		write_checked_reg(MPUREG_ICM_UNDOC1, MPUREG_ICM_UNDOC1_VALUE);
 	}
 
+	if (_fifo_enabled) {
+		// accel, temperature and gyro, same layout as the data registers
+		write_checked_reg(MPUREG_FIFO_EN, BIT_TEMP_FIFO_EN | BIT_XG_FIFO_EN | BIT_YG_FIFO_EN | BIT_ZG_FIFO_EN | BIT_ACCEL_FIFO_EN);
+		write_checked_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_USER_CTRL_FIFO_EN);
+
+	} else {
+		write_checked_reg(MPUREG_FIFO_EN, 0);
+	}
+
 	// Oscillator set
 	// write_reg(MPUREG_PWR_MGMT_1,MPU_CLK_SEL_PLLGYROZ);
 	px4_usleep(1000);
@@ -646,6 +679,10 @@ MPU6000::start()
 	stop();
 	_call_interval = last_call_interval;
 
+	if (_fifo_enabled) {
+		fifo_reset();
+	}
+
 	ScheduleOnInterval(_call_interval - MPU6000_TIMER_REDUCTION, 1000);
 }
 
@@ -662,7 +699,12 @@ void
 MPU6000::Run()
 {
 	/* make another measurement */
-	measure();
+	if (_fifo_enabled) {
+		measure_fifo();
+
+	} else {
+		measure();
+	}
 }
 
 void
@@ -893,6 +935,147 @@ MPU6000::measure()
 	return OK;
 }
 
+void
+MPU6000::fifo_reset()
+{
+	// FIFO_RST is self clearing, keep the checked USER_CTRL value otherwise
+	write_reg(MPUREG_USER_CTRL, BIT_I2C_IF_DIS | BIT_USER_CTRL_FIFO_EN | BIT_USER_CTRL_FIFO_RST);
+}
+
+int
+MPU6000::measure_fifo()
+{
+	perf_count(_measure_interval);
+
+	if (_in_factory_test) {
+		// don't publish any data while in factory test mode
+		return OK;
+	}
+
+	if (hrt_absolute_time() < _reset_wait) {
+		// we're waiting for a reset to complete
+		return OK;
+	}
+
+	/* start measuring */
+	perf_begin(_sample_perf);
+
+	// sensor transfer at high clock speed
+	uint8_t fifo_count_buf[2] {};
+	const hrt_abstime timestamp_sample = hrt_absolute_time();
+
+	if (_interface->read(MPU6000_HIGH_SPEED_OP(MPUREG_FIFO_COUNTH), fifo_count_buf, sizeof(fifo_count_buf)) !=
+	    sizeof(fifo_count_buf)) {
+
+		perf_count(_bad_transfers);
+		perf_end(_sample_perf);
+		return -EIO;
+	}
+
+	const unsigned fifo_count = (fifo_count_buf[0] << 8) | fifo_count_buf[1];
+	const unsigned available = fifo_count / sizeof(MPUFIFOSample);
+
+	if (available == 0) {
+		perf_count(_fifo_empty);
+		perf_end(_sample_perf);
+		return OK;
+	}
+
+	if ((fifo_count >= MPU6000_FIFO_SIZE - sizeof(MPUFIFOSample)) || (fifo_count % sizeof(MPUFIFOSample) != 0)) {
+		// the FIFO wrapped (or lost alignment), the sample boundaries are no longer known
+		perf_count(_fifo_overflow);
+		fifo_reset();
+		perf_end(_sample_perf);
+		return OK;
+	}
+
+	const uint64_t error_count = perf_event_count(_bad_transfers) + perf_event_count(_bad_registers);
+	_px4_accel.set_error_count(error_count);
+	_px4_gyro.set_error_count(error_count);
+
+	// drain everything counted above, in transfers of up to MPU6000_FIFO_MAX_SAMPLES samples (oldest first),
+	// so the FIFO does not fill up with call intervals longer than one transfer
+	const float dt = 1e6f / MPU6000_FIFO_RATE;
+	unsigned remaining = available;
+
+	while (remaining > 0) {
+		const unsigned samples = math::min(remaining, (unsigned)MPU6000_FIFO_MAX_SAMPLES);
+		const unsigned transfer_size = sizeof(_fifo_transfer.cmd) + samples * sizeof(MPUFIFOSample);
+
+		if (_interface->read(MPU6000_HIGH_SPEED_OP(MPUREG_FIFO_R_W), (uint8_t *)&_fifo_transfer, transfer_size) !=
+		    (int)transfer_size) {
+
+			perf_count(_bad_transfers);
+			perf_end(_sample_perf);
+			return -EIO;
+		}
+
+		remaining -= samples;
+
+		PX4Accelerometer::FIFOSample accel[MPU6000_FIFO_MAX_SAMPLES];
+		PX4Gyroscope::FIFOSample gyro[MPU6000_FIFO_MAX_SAMPLES];
+		bool all_zero = true;
+
+		for (unsigned i = 0; i < samples; i++) {
+			MPUFIFOSample &s = _fifo_transfer.samples[i];
+
+			const int16_t accel_x = int16_t_from_bytes(s.accel_x);
+			const int16_t accel_y = int16_t_from_bytes(s.accel_y);
+			const int16_t accel_z = int16_t_from_bytes(s.accel_z);
+			const int16_t gyro_x = int16_t_from_bytes(s.gyro_x);
+			const int16_t gyro_y = int16_t_from_bytes(s.gyro_y);
+			const int16_t gyro_z = int16_t_from_bytes(s.gyro_z);
+
+			if (accel_x != 0 || accel_y != 0 || accel_z != 0 || gyro_x != 0 || gyro_y != 0 || gyro_z != 0) {
+				all_zero = false;
+			}
+
+			// Swap axes and negate y
+			accel[i].x = accel_y;
+			accel[i].y = ((accel_x == -32768) ? 32767 : -accel_x);
+			accel[i].z = accel_z;
+
+			gyro[i].x = gyro_y;
+			gyro[i].y = ((gyro_x == -32768) ? 32767 : -gyro_x);
+			gyro[i].z = gyro_z;
+		}
+
+		if (all_zero) {
+			// all zero data - probably a SPI bus error
+			perf_count(_bad_transfers);
+			perf_end(_sample_perf);
+			return -EIO;
+		}
+
+		if (_register_wait != 0) {
+			// we are waiting for some good transfers before using
+			// the sensor again, read the FIFO empty but don't return any data yet
+			continue;
+		}
+
+		// temperature of the newest sample is sufficient
+		const float temperature = int16_t_from_bytes(_fifo_transfer.samples[samples - 1].temp) / 340.0f + 35.0f;
+		_px4_accel.set_temperature(temperature);
+		_px4_gyro.set_temperature(temperature);
+
+		// the newest sample of this transfer was taken (remaining) intervals before the FIFO count
+		const hrt_abstime timestamp_newest = timestamp_sample - (hrt_abstime)(remaining * dt);
+
+		_px4_accel.updateFIFO(timestamp_newest, accel, samples, dt);
+		_px4_gyro.updateFIFO(timestamp_newest, gyro, samples, dt);
+	}
+
+	check_registers();
+
+	if (_register_wait != 0) {
+		_register_wait--;
+	}
+
+	/* stop measuring */
+	perf_end(_sample_perf);
+	return OK;
+}
+
 void
 MPU6000::print_info()
 {
@@ -903,6 +1086,11 @@ MPU6000::print_info()
 	perf_print_counter(_reset_retries);
 	perf_print_counter(_duplicates);
 
+	if (_fifo_enabled) {
+		perf_print_counter(_fifo_empty);
+		perf_print_counter(_fifo_overflow);
+	}
+
 	_px4_accel.print_status();
 	_px4_gyro.print_status();
 }
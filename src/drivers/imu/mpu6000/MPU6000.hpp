@@ -181,6 +181,18 @@ enum MPU_DEVICE_TYPE {
 #define BIT_RAW_RDY_EN			0x01
 #define BIT_I2C_IF_DIS			0x10
 #define BIT_INT_STATUS_DATA		0x01
+#define BIT_INT_STATUS_FIFO_OFLOW	0x10
+
+// USER_CTRL FIFO bits
+#define BIT_USER_CTRL_FIFO_EN		0x40
+#define BIT_USER_CTRL_FIFO_RST		0x04
+
+// FIFO_EN bits
+#define BIT_TEMP_FIFO_EN		0x80
+#define BIT_XG_FIFO_EN			0x40
+#define BIT_YG_FIFO_EN			0x20
+#define BIT_ZG_FIFO_EN			0x10
+#define BIT_ACCEL_FIFO_EN		0x08
 
 #define MPU_WHOAMI_6000			0x68
 #define ICM_WHOAMI_20602		0x12
@@ -261,6 +273,34 @@ struct MPUReport {
 	uint8_t		gyro_y[2];
 	uint8_t		gyro_z[2];
 };
+
+/**
+ * One FIFO sample with accel, temperature and gyro enabled. The order
+ * follows the sensor data registers.
+ */
+struct MPUFIFOSample {
+	uint8_t		accel_x[2];
+	uint8_t		accel_y[2];
+	uint8_t		accel_z[2];
+	uint8_t		temp[2];
+	uint8_t		gyro_x[2];
+	uint8_t		gyro_y[2];
+	uint8_t		gyro_z[2];
+};
+#pragma pack(pop)
+
+#define MPU6000_FIFO_SIZE				1024	// bytes
+#define MPU6000_FIFO_RATE				8000	// Hz, gyro output rate with the DLPF bypassed
+#define MPU6000_FIFO_MAX_SAMPLES			16	// samples per FIFO transfer (2 ms at 8 kHz), longer intervals use several
+
+#pragma pack(push, 1)
+/**
+ * FIFO burst transfer, command byte followed by the samples.
+ */
+struct MPUFIFOTransfer {
+	uint8_t		cmd;
+	MPUFIFOSample	samples[MPU6000_FIFO_MAX_SAMPLES];
+};
 #pragma pack(pop)
 
 #define MPU_MAX_READ_BUFFER_SIZE (sizeof(MPUReport) + 1)
@@ -303,7 +343,7 @@ enum MPU6000_BUS {
 class MPU6000 : public cdev::CDev, public px4::ScheduledWorkItem
 {
 public:
-	MPU6000(device::Device *interface, const char *path, enum Rotation rotation, int device_type);
+	MPU6000(device::Device *interface, const char *path, enum Rotation rotation, int device_type, bool fifo = false);
 
 	virtual ~MPU6000();
 
@@ -357,12 +397,18 @@ private:
 
 	unsigned		_sample_rate{1000};
 
+	// FIFO burst mode: all samples accumulated since the last cycle are read in one transfer
+	const bool		_fifo_enabled;
+	MPUFIFOTransfer		_fifo_transfer{};
+
 	perf_counter_t		_sample_perf;
 	perf_counter_t		_measure_interval;
 	perf_counter_t		_bad_transfers;
 	perf_counter_t		_bad_registers;
 	perf_counter_t		_reset_retries;
 	perf_counter_t		_duplicates;
+	perf_counter_t		_fifo_empty;
+	perf_counter_t		_fifo_overflow;
 
 	uint8_t			_register_wait{0};
 	uint64_t		_reset_wait{0};
@@ -371,7 +417,7 @@ private:
 	// configuration registers to detect SPI bus errors and sensor
 	// reset
 	static constexpr int MPU6000_CHECKED_PRODUCT_ID_INDEX = 0;
-	static constexpr int MPU6000_NUM_CHECKED_REGISTERS = 10;
+	static constexpr int MPU6000_NUM_CHECKED_REGISTERS = 11;
 
 	static constexpr uint8_t _checked_registers[MPU6000_NUM_CHECKED_REGISTERS] {
 		MPUREG_PRODUCT_ID,
@@ -383,6 +429,7 @@ private:
 		MPUREG_ACCEL_CONFIG,
 		MPUREG_INT_ENABLE,
 		MPUREG_INT_PIN_CFG,
+		MPUREG_FIFO_EN,
 		MPUREG_ICM_UNDOC1
 	};
 
@@ -416,6 +463,16 @@ private:
 	 */
 	int			measure();
 
+	/**
+	 * Fetch all samples accumulated in the sensor FIFO and update the report buffers.
+	 */
+	int			measure_fifo();
+
+	/**
+	 * Discard the FIFO contents, used at start and after an overflow.
+	 */
+	void			fifo_reset();
+
 	/**
 	 * Read a register from the MPU6000
 	 *
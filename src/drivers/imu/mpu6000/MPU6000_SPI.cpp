@@ -219,16 +219,16 @@ MPU6000_SPI::write(unsigned reg_speed, void *data, unsigned count)
 int
 MPU6000_SPI::read(unsigned reg_speed, void *data, unsigned count)
 {
-	/* We want to avoid copying the data of MPUReport: So if the caller
-	 * supplies a buffer not MPUReport in size, it is assume to be a reg or reg 16 read
+	/* We want to avoid copying the data of MPUReport or a FIFO transfer: So if the caller
+	 * supplies a buffer that fits in cmd, it is assume to be a reg or reg 16 read
 	 * and we need to provied the buffer large enough for the callers data
-	 * and our command.
+	 * and our command. Larger buffers start with the command byte.
 	 */
 	uint8_t cmd[3] = {0, 0, 0};
 
-	uint8_t *pbuff  =  count < sizeof(MPUReport) ? cmd : (uint8_t *) data ;
+	uint8_t *pbuff  =  count < sizeof(cmd) ? cmd : (uint8_t *) data ;
 
-	if (count < sizeof(MPUReport))  {
+	if (count < sizeof(cmd))  {
 		/* add command */
 		count++;
 	}
@@ -96,8 +96,8 @@ struct mpu6000_bus_option {
 #define NUM_BUS_OPTIONS (sizeof(bus_options)/sizeof(bus_options[0]))
 
 
-void	start(enum MPU6000_BUS busid, enum Rotation rotation, int device_type);
-bool 	start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int device_type);
+void	start(enum MPU6000_BUS busid, enum Rotation rotation, int device_type, bool fifo);
+bool 	start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int device_type, bool fifo);
 void	stop(enum MPU6000_BUS busid);
 static struct mpu6000_bus_option &find_bus(enum MPU6000_BUS busid);
 void	reset(enum MPU6000_BUS busid);
@@ -126,7 +126,7 @@ struct mpu6000_bus_option &find_bus(enum MPU6000_BUS busid)
  * start driver for a specific bus option
  */
 bool
-start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int device_type)
+start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int device_type, bool fifo)
 {
 	if (bus.dev != nullptr) {
 		warnx("%s SPI not available", bus.external ? "External" : "Internal");
@@ -146,7 +146,7 @@ start_bus(struct mpu6000_bus_option &bus, enum Rotation rotation, int device_typ
 		return false;
 	}
 
-	bus.dev = new MPU6000(interface, bus.devpath, rotation, device_type);
+	bus.dev = new MPU6000(interface, bus.devpath, rotation, device_type, fifo);
 
 	if (bus.dev == nullptr) {
 		delete interface;
@@ -180,7 +180,7 @@ fail:
  * or failed to detect the sensor.
  */
 void
-start(enum MPU6000_BUS busid, enum Rotation rotation, int device_type)
+start(enum MPU6000_BUS busid, enum Rotation rotation, int device_type, bool fifo)
 {
 	bool started = false;
 
@@ -200,7 +200,7 @@ start(enum MPU6000_BUS busid, enum Rotation rotation, int device_type)
 			continue;
 		}
 
-		started |= start_bus(bus_options[i], rotation, device_type);
+		started |= start_bus(bus_options[i], rotation, device_type, fifo);
 	}
 
 	exit(started ? 0 : 1);
@@ -324,6 +324,7 @@ usage()
 	warnx("    -z internal2 SPI bus");
 	warnx("    -T 6000|20608|20602 (default 6000)");
 	warnx("    -R rotation");
+	warnx("    -f FIFO mode, 8 kHz sampling (MPU6000 on SPI only)");
 }
 
 } // namespace
@@ -341,8 +342,9 @@ mpu6000_main(int argc, char *argv[])
 	enum MPU6000_BUS busid = MPU6000_BUS_ALL;
 	int device_type = MPU_DEVICE_TYPE_MPU6000;
 	enum Rotation rotation = ROTATION_NONE;
+	bool fifo = false;
 
-	while ((ch = px4_getopt(argc, argv, "T:XISsZzR:a:", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "T:XISsZzR:a:f", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'X':
 			busid = MPU6000_BUS_I2C_EXTERNAL;
@@ -376,6 +378,10 @@ mpu6000_main(int argc, char *argv[])
 			rotation = (enum Rotation)atoi(myoptarg);
 			break;
 
+		case 'f':
+			fifo = true;
+			break;
+
 		default:
 			mpu6000::usage();
 			return 0;
@@ -393,7 +399,7 @@ mpu6000_main(int argc, char *argv[])
 	 * Start/load the driver.
 	 */
 	if (!strcmp(verb, "start")) {
-		mpu6000::start(busid, rotation, device_type);
+		mpu6000::start(busid, rotation, device_type, fifo);
 	}
 
 	if (!strcmp(verb, "stop")) {
@@ -35,7 +35,7 @@
 
 PAW3902::PAW3902(int bus, enum Rotation yaw_rotation) :
 	SPI("PAW3902", nullptr, bus, PAW3902_SPIDEV, SPIDEV_MODE0, PAW3902_SPI_BUS_SPEED),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id())),
+	ScheduledWorkItem(MODULE_NAME, px4::device_bus_to_wq(get_device_id())),
 	_sample_perf(perf_alloc(PC_ELAPSED, "paw3902: read")),
 	_interval_perf(perf_alloc(PC_INTERVAL, "paw3902: interval")),
 	_comms_errors(perf_alloc(PC_COUNT, "paw3902: com_err")),
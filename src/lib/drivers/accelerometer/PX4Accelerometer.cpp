@@ -100,7 +100,18 @@ void
 PX4Accelerometer::set_sample_rate(unsigned rate)
 {
 	_sample_rate = rate;
-	_filter.set_cutoff_frequency(_sample_rate, _filter.get_cutoff_freq());
+	configure_filter(_filter_cutoff);
+}
+
+void
+PX4Accelerometer::configure_filter(float cutoff_freq)
+{
+	_filter_cutoff = cutoff_freq;
+	_filter.clear();
+
+	if (!_filter.add_lowpass(_sample_rate, cutoff_freq)) {
+		PX4_ERR("invalid filter cutoff %.1f Hz at %d Hz", (double)cutoff_freq, _sample_rate);
+	}
 }
 
 void
@@ -118,7 +129,9 @@ PX4Accelerometer::update(hrt_abstime timestamp, float x, float y, float z)
 	const matrix::Vector3f val_calibrated{(((raw * report.scaling) - _calibration_offset).emult(_calibration_scale))};
 
 	// Filtered values
-	const matrix::Vector3f val_filtered{_filter.apply(val_calibrated)};
+	float val_filtered[1][3];
+	val_calibrated.copyTo(val_filtered[0]);
+	_filter.apply(val_filtered, 1);
 
 	// Integrated values
 	matrix::Vector3f integrated_value;
@@ -131,9 +144,9 @@ PX4Accelerometer::update(hrt_abstime timestamp, float x, float y, float z)
 		report.y_raw = y;
 		report.z_raw = z;
 
-		report.x = val_filtered(0);
-		report.y = val_filtered(1);
-		report.z = val_filtered(2);
+		report.x = val_filtered[0][0];
+		report.y = val_filtered[0][1];
+		report.z = val_filtered[0][2];
 
 		report.integral_dt = integral_dt;
 		report.x_integral = integrated_value(0);
@@ -145,12 +158,81 @@ PX4Accelerometer::update(hrt_abstime timestamp, float x, float y, float z)
 	}
 }
 
+void
+PX4Accelerometer::updateFIFO(hrt_abstime timestamp, const FIFOSample samples[], uint8_t count, float dt)
+{
+	sensor_accel_s &report = _sensor_accel_pub.get();
+
+	// Range scale and calibration combined once for the whole block
+	const matrix::Vector3f scale{_calibration_scale * report.scaling};
+	const matrix::Vector3f offset{_calibration_offset.emult(_calibration_scale)};
+
+	float val_calibrated[FILTER_BLOCK_SIZE][3];
+	float val_filtered[FILTER_BLOCK_SIZE][3];
+	uint8_t n = 0;
+
+	for (uint8_t first = 0; first < count; first += n) {
+		n = math::min((uint8_t)(count - first), FILTER_BLOCK_SIZE);
+
+		for (uint8_t i = 0; i < n; i++) {
+			float x = samples[first + i].x;
+			float y = samples[first + i].y;
+			float z = samples[first + i].z;
+
+			// Apply rotation (before scaling)
+			rotate_3f(_rotation, x, y, z);
+
+			val_calibrated[i][0] = x * scale(0) - offset(0);
+			val_calibrated[i][1] = y * scale(1) - offset(1);
+			val_calibrated[i][2] = z * scale(2) - offset(2);
+		}
+
+		// Filtered values, the whole block in one pass at the FIFO rate
+		memcpy(val_filtered, val_calibrated, n * sizeof(val_calibrated[0]));
+		_filter.apply(val_filtered, n);
+
+		// Integrated values
+		for (uint8_t i = 0; i < n; i++) {
+			const hrt_abstime timestamp_sample = timestamp - (hrt_abstime)((count - 1 - first - i) * dt);
+
+			matrix::Vector3f integrated_value;
+			uint32_t integral_dt = 0;
+
+			if (_integrator.put(timestamp_sample, matrix::Vector3f{val_calibrated[i]}, integrated_value, integral_dt)) {
+				report.timestamp = timestamp_sample;
+
+				// Raw values (ADC units 0 - 65535)
+				float x = samples[first + i].x;
+				float y = samples[first + i].y;
+				float z = samples[first + i].z;
+				rotate_3f(_rotation, x, y, z);
+
+				report.x_raw = x;
+				report.y_raw = y;
+				report.z_raw = z;
+
+				report.x = val_filtered[i][0];
+				report.y = val_filtered[i][1];
+				report.z = val_filtered[i][2];
+
+				report.integral_dt = integral_dt;
+				report.x_integral = integrated_value(0);
+				report.y_integral = integrated_value(1);
+				report.z_integral = integrated_value(2);
+
+				poll_notify(POLLIN);
+				_sensor_accel_pub.update();
+			}
+		}
+	}
+}
+
 void
 PX4Accelerometer::print_status()
 {
 	PX4_INFO(ACCEL_BASE_DEVICE_PATH " device instance: %d", _class_device_instance);
 	PX4_INFO("sample rate: %d Hz", _sample_rate);
-	PX4_INFO("filter cutoff: %.3f Hz", (double)_filter.get_cutoff_freq());
+	PX4_INFO("filter cutoff: %.3f Hz", (double)_filter_cutoff);
 
 	PX4_INFO("calibration scale: %.5f %.5f %.5f", (double)_calibration_scale(0), (double)_calibration_scale(1),
 		 (double)_calibration_scale(2));
@@ -38,7 +38,7 @@
 #include <drivers/drv_hrt.h>
 #include <lib/cdev/CDev.hpp>
 #include <lib/conversion/rotation.h>
-#include <mathlib/math/filter/LowPassFilter2pVector3f.hpp>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
 #include <px4_module_params.h>
 #include <uORB/uORB.h>
 #include <uORB/PublicationMulti.hpp>
@@ -62,15 +62,42 @@ public:
 
 	void update(hrt_abstime timestamp, float x, float y, float z);
 
+	/**
+	 * Raw sample as read from a sensor FIFO (before rotation and scaling).
+	 */
+	struct FIFOSample {
+		int16_t x;
+		int16_t y;
+		int16_t z;
+	};
+
+	/**
+	 * Process a block of samples read from a sensor FIFO in one call.
+	 *
+	 * The samples are calibrated, filtered and integrated individually, but the
+	 * calibration is only prepared once per block. Configure the filter for the
+	 * FIFO rate with set_sample_rate().
+	 *
+	 * @param timestamp	Timestamp of the newest (last) sample.
+	 * @param samples	Samples, oldest first.
+	 * @param count		Number of samples.
+	 * @param dt		Interval between samples in microseconds.
+	 */
+	void updateFIFO(hrt_abstime timestamp, const FIFOSample samples[], uint8_t count, float dt);
+
 	void print_status();
 
 private:
 
-	void configure_filter(float cutoff_freq) { _filter.set_cutoff_frequency(_sample_rate, cutoff_freq); }
+	void configure_filter(float cutoff_freq);
+
+	// FIFO samples are calibrated and filtered in blocks of this size
+	static constexpr uint8_t FILTER_BLOCK_SIZE{16};
 
 	uORB::PublicationMultiData<sensor_accel_s>	_sensor_accel_pub;
 
-	math::LowPassFilter2pVector3f _filter{1000, 100};
+	math::BiquadFilterBank<3, 1> _filter{};
+	float			_filter_cutoff{0.0f};
 	Integrator _integrator{4000, false};
 
 	const enum Rotation	_rotation;
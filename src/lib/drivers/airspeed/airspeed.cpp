@@ -58,7 +58,7 @@
 
 Airspeed::Airspeed(int bus, int address, unsigned conversion_interval, const char *path) :
 	I2C("Airspeed", path, bus, address, 100000),
-	ScheduledWorkItem(px4::device_bus_to_wq(get_device_id())),
+	ScheduledWorkItem("airspeed", px4::device_bus_to_wq(get_device_id())),
 	_sensor_ok(false),
 	_measure_interval(0),
 	_collect_phase(false),
@@ -0,0 +1,315 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceGeometry.cpp
+ */
+
+#include "GeofenceGeometry.hpp"
+
+GeofenceGeometry::~GeofenceGeometry()
+{
+	clear();
+}
+
+void GeofenceGeometry::clear()
+{
+	for (int i = 0; i < _num_areas; ++i) {
+		delete[] _areas[i].slab_offsets;
+		delete[] _areas[i].slab_edges;
+	}
+
+	delete[] _areas;
+	delete[] _edges;
+	_areas = nullptr;
+	_edges = nullptr;
+	_num_areas = _max_areas = 0;
+	_num_edges = _max_edges = 0;
+	_has_inclusion = false;
+}
+
+bool GeofenceGeometry::reset(int num_areas, int num_vertices)
+{
+	clear();
+
+	if (num_areas > 0) {
+		_areas = new Area[num_areas];
+	}
+
+	if (num_vertices > 0) {
+		_edges = new Edge[num_vertices];
+	}
+
+	if ((num_areas > 0 && _areas == nullptr) || (num_vertices > 0 && _edges == nullptr)) {
+		clear();
+		return false;
+	}
+
+	_max_areas = num_areas;
+	_max_edges = num_vertices;
+	return true;
+}
+
+bool GeofenceGeometry::addPolygon(const float *x, const float *y, int vertex_count, bool inclusion)
+{
+	if (_num_areas >= _max_areas || vertex_count < 0 || _num_edges + vertex_count > _max_edges
+	    || _num_edges + vertex_count > UINT16_MAX) {
+		return false;
+	}
+
+	Area &area = _areas[_num_areas];
+	area.inclusion = inclusion;
+	area.circle = false;
+	area.first_edge = _num_edges;
+	area.edge_count = (vertex_count >= 3) ? vertex_count : 0;
+	area.slab_offsets = nullptr;
+	area.slab_edges = nullptr;
+	area.slab_count = 0;
+	area.slab_scale = 0.f;
+	area.min_x = area.min_y = 1.f;
+	area.max_x = area.max_y = -1.f; // empty bounding box
+
+	if (area.edge_count > 0) {
+		area.min_x = area.max_x = x[0];
+		area.min_y = area.max_y = y[0];
+	}
+
+	for (int i = 0, j = area.edge_count - 1; i < area.edge_count; j = i++) {
+		Edge &edge = _edges[_num_edges + i];
+		edge.x0 = x[i];
+		edge.y0 = y[i];
+		edge.y1 = y[j];
+		edge.dxdy = (y[j] != y[i]) ? (x[j] - x[i]) / (y[j] - y[i]) : 0.f; // only used if y is between y0 and y1
+
+		area.min_x = (x[i] < area.min_x) ? x[i] : area.min_x;
+		area.max_x = (x[i] > area.max_x) ? x[i] : area.max_x;
+		area.min_y = (y[i] < area.min_y) ? y[i] : area.min_y;
+		area.max_y = (y[i] > area.max_y) ? y[i] : area.max_y;
+	}
+
+	_num_edges += area.edge_count;
+	++_num_areas;
+	_has_inclusion = _has_inclusion || inclusion;
+
+	if (area.edge_count > SLAB_INDEX_MIN_EDGES) {
+		// without index the polygon is still checked correctly, just slower
+		buildSlabIndex(area);
+	}
+
+	return true;
+}
+
+bool GeofenceGeometry::addCircle(float x, float y, float radius, bool inclusion)
+{
+	if (_num_areas >= _max_areas) {
+		return false;
+	}
+
+	Area &area = _areas[_num_areas];
+	area.inclusion = inclusion;
+	area.circle = true;
+	area.center_x = x;
+	area.center_y = y;
+	area.radius_sq = (radius > 0.f) ? radius * radius : 0.f;
+	area.first_edge = 0;
+	area.edge_count = 0;
+	area.slab_offsets = nullptr;
+	area.slab_edges = nullptr;
+	area.slab_count = 0;
+	area.slab_scale = 0.f;
+	area.min_x = x - radius;
+	area.max_x = x + radius;
+	area.min_y = y - radius;
+	area.max_y = y + radius;
+
+	++_num_areas;
+	_has_inclusion = _has_inclusion || inclusion;
+	return true;
+}
+
+bool GeofenceGeometry::buildSlabIndex(Area &area)
+{
+	const float height = area.max_y - area.min_y;
+
+	if (!(height > 0.f)) {
+		return false;
+	}
+
+	const int slab_count = area.edge_count / EDGES_PER_SLAB;
+	const float slab_scale = slab_count / height;
+
+	auto slab = [&](float y) {
+		const int s = (int)((y - area.min_y) * slab_scale);
+		return (s < 0) ? 0 : ((s >= slab_count) ? slab_count - 1 : s);
+	};
+
+	uint16_t *offsets = new uint16_t[slab_count + 1];
+
+	if (offsets == nullptr) {
+		return false;
+	}
+
+	// count the edges of each slab (an edge is listed in every slab its y range overlaps)
+	for (int s = 0; s <= slab_count; ++s) {
+		offsets[s] = 0;
+	}
+
+	int total = 0;
+
+	for (int e = 0; e < area.edge_count; ++e) {
+		const Edge &edge = _edges[area.first_edge + e];
+		const int first = slab((edge.y0 < edge.y1) ? edge.y0 : edge.y1);
+		const int last = slab((edge.y0 < edge.y1) ? edge.y1 : edge.y0);
+
+		for (int s = first; s <= last; ++s) {
+			++offsets[s + 1];
+		}
+
+		total += last - first + 1;
+	}
+
+	if (total > UINT16_MAX) {
+		delete[] offsets;
+		return false;
+	}
+
+	uint16_t *edges = new uint16_t[total];
+
+	if (edges == nullptr) {
+		delete[] offsets;
+		return false;
+	}
+
+	// offsets[s] is the first entry of slab s
+	for (int s = 0; s < slab_count; ++s) {
+		offsets[s + 1] += offsets[s];
+	}
+
+	for (int e = 0; e < area.edge_count; ++e) {
+		const Edge &edge = _edges[area.first_edge + e];
+		const int first = slab((edge.y0 < edge.y1) ? edge.y0 : edge.y1);
+		const int last = slab((edge.y0 < edge.y1) ? edge.y1 : edge.y0);
+
+		for (int s = first; s <= last; ++s) {
+			edges[offsets[s]++] = e;
+		}
+	}
+
+	// filling advanced each offset to the start of the next slab, shift them back
+	for (int s = slab_count; s > 0; --s) {
+		offsets[s] = offsets[s - 1];
+	}
+
+	offsets[0] = 0;
+
+	area.slab_offsets = offsets;
+	area.slab_edges = edges;
+	area.slab_count = slab_count;
+	area.slab_scale = slab_scale;
+	return true;
+}
+
+bool GeofenceGeometry::insidePolygon(const Area &area, float x, float y) const
+{
+	if (x < area.min_x || x > area.max_x || y < area.min_y || y > area.max_y) {
+		return false;
+	}
+
+	/* Adaptation of algorithm originally presented as
+	 * PNPOLY - Point Inclusion in Polygon Test
+	 * W. Randolph Franklin (WRF)
+	 * Only supports non-complex polygons (not self intersecting)
+	 */
+	bool c = false;
+	const Edge *edges = &_edges[area.first_edge];
+
+	if (area.slab_edges != nullptr) {
+		int s = (int)((y - area.min_y) * area.slab_scale);
+		s = (s >= area.slab_count) ? area.slab_count - 1 : s;
+
+		for (int k = area.slab_offsets[s]; k < area.slab_offsets[s + 1]; ++k) {
+			const Edge &edge = edges[area.slab_edges[k]];
+
+			if ((edge.y0 >= y) != (edge.y1 >= y) && x <= edge.dxdy * (y - edge.y0) + edge.x0) {
+				c = !c;
+			}
+		}
+
+	} else {
+		for (int e = 0; e < area.edge_count; ++e) {
+			const Edge &edge = edges[e];
+
+			if ((edge.y0 >= y) != (edge.y1 >= y) && x <= edge.dxdy * (y - edge.y0) + edge.x0) {
+				c = !c;
+			}
+		}
+	}
+
+	return c;
+}
+
+bool GeofenceGeometry::insideArea(int area, float x, float y) const
+{
+	if (area < 0 || area >= _num_areas) {
+		return false;
+	}
+
+	const Area &a = _areas[area];
+
+	if (a.circle) {
+		const float dx = x - a.center_x;
+		const float dy = y - a.center_y;
+		return dx * dx + dy * dy < a.radius_sq;
+	}
+
+	return insidePolygon(a, x, y);
+}
+
+bool GeofenceGeometry::inside(float x, float y) const
+{
+	bool inside_inclusion = false;
+
+	for (int i = 0; i < _num_areas; ++i) {
+		const bool inside_area = insideArea(i, x, y);
+
+		if (_areas[i].inclusion) {
+			inside_inclusion = inside_inclusion || inside_area;
+
+		} else if (inside_area) {
+			// inside an exclusion area
+			return false;
+		}
+	}
+
+	return !_has_inclusion || inside_inclusion;
+}
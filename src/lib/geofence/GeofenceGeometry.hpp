@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceGeometry.hpp
+ *
+ * Geofence areas (polygons and circles) in a local frame, prepared for fast point tests:
+ * each polygon edge is stored with its precomputed crossing coefficients, each area has a bounding box, and
+ * polygons with many vertices get an index of horizontal slabs, so that a test only looks at the edges which
+ * can be crossed at the position of the point.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class GeofenceGeometry
+{
+public:
+	GeofenceGeometry() = default;
+	GeofenceGeometry(const GeofenceGeometry &) = delete;
+	GeofenceGeometry &operator=(const GeofenceGeometry &) = delete;
+	~GeofenceGeometry();
+
+	/**
+	 * Remove all areas and allocate space for new ones.
+	 * @param num_areas number of polygons and circles which will be added
+	 * @param num_vertices total number of polygon vertices which will be added
+	 * @return false if the allocation failed (the geometry is empty then)
+	 */
+	bool reset(int num_areas, int num_vertices);
+
+	/**
+	 * Add a polygon. Only non-complex polygons (not self intersecting) are supported.
+	 * @param x, y vertex coordinates in the local frame [m]
+	 * @param vertex_count number of vertices, a polygon with less than 3 vertices contains no point
+	 * @param inclusion true for an inclusion area, false for an exclusion area
+	 * @return false if there is no space left
+	 */
+	bool addPolygon(const float *x, const float *y, int vertex_count, bool inclusion);
+
+	/**
+	 * Add a circle.
+	 * @param x, y center in the local frame [m]
+	 * @param radius radius [m], a radius <= 0 contains no point
+	 * @param inclusion true for an inclusion area, false for an exclusion area
+	 * @return false if there is no space left
+	 */
+	bool addCircle(float x, float y, float radius, bool inclusion);
+
+	/**
+	 * Check a point against all areas.
+	 * @return true if the point is inside at least one inclusion area (or there are none) and outside of all
+	 * exclusion areas
+	 */
+	bool inside(float x, float y) const;
+
+	/**
+	 * Check if a point is inside a single area
+	 * @param area index of the area, in the order they were added
+	 */
+	bool insideArea(int area, float x, float y) const;
+
+	int numAreas() const { return _num_areas; }
+
+private:
+	/** Polygon edge from (x0, y0) to (., y1), crossed by the horizontal line at y at x = x0 + dxdy * (y - y0) */
+	struct Edge {
+		float x0;
+		float y0;
+		float y1;
+		float dxdy;
+	};
+
+	struct Area {
+		float min_x;		///< bounding box
+		float max_x;
+		float min_y;
+		float max_y;
+		float center_x;		///< circle only
+		float center_y;
+		float radius_sq;
+		uint16_t first_edge;	///< polygon only
+		uint16_t edge_count;
+		uint16_t *slab_offsets{nullptr}; ///< slab index, first entry of each slab in slab_edges (slab_count + 1)
+		uint16_t *slab_edges{nullptr};	///< edge indexes (relative to first_edge) sorted by slab
+		uint16_t slab_count;
+		float slab_scale;	///< 1 / slab height
+		bool inclusion;
+		bool circle;
+	};
+
+	/** polygons with more edges than this get a slab index */
+	static constexpr int SLAB_INDEX_MIN_EDGES = 12;
+
+	/** average number of edges per slab */
+	static constexpr int EDGES_PER_SLAB = 2;
+
+	void clear();
+	bool buildSlabIndex(Area &area);
+	bool insidePolygon(const Area &area, float x, float y) const;
+
+	Area *_areas{nullptr};
+	int _num_areas{0};
+	int _max_areas{0};
+
+	Edge *_edges{nullptr};
+	int _num_edges{0};
+	int _max_edges{0};
+
+	bool _has_inclusion{false};
+};
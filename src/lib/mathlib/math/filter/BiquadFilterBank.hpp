@@ -0,0 +1,212 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/// @file	BiquadFilterBank.hpp
+/// @brief	Cascaded biquad sections (low pass and notch) applied to several channels at once
+
+#pragma once
+
+#include <px4_defines.h>
+
+#include <cmath>
+
+namespace math
+{
+
+/**
+ * Bank of cascaded second order sections sharing one set of coefficients.
+ *
+ * The filter state is kept in structure-of-arrays layout (one array per delay
+ * element, indexed by channel) and a block is passed as data[sample][channel].
+ * The recursion only runs along the samples, so the innermost loop runs over
+ * the channels with a compile time trip count and is left to the compiler to
+ * unroll and vectorize. Several sensors with the same sample rate and filter
+ * settings (e.g. all gyros of a multi-IMU board) can share one bank by using
+ * 3 channels per sensor.
+ *
+ * The sections use the same direct form II as LowPassFilter2p, so a bank with
+ * one low pass section produces the same output as LowPassFilter2pVector3f.
+ */
+template<int CHANNELS, int MAX_SECTIONS = 2>
+class BiquadFilterBank
+{
+public:
+	BiquadFilterBank() = default;
+
+	/**
+	 * Append a second order Butterworth low pass section.
+	 *
+	 * A cutoff <= 0 disables the section (pass through).
+	 *
+	 * @return false if the bank is full or the parameters are invalid
+	 */
+	bool add_lowpass(float sample_freq, float cutoff_freq)
+	{
+		if (cutoff_freq <= 0.0f) {
+			return true;
+		}
+
+		if ((_num_sections >= MAX_SECTIONS) || (sample_freq <= 0.0f) || (cutoff_freq >= sample_freq / 2.0f)) {
+			return false;
+		}
+
+		const float fr = sample_freq / cutoff_freq;
+		const float ohm = tanf(M_PI_F / fr);
+		const float c = 1.0f + 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm;
+
+		Section &s = _sections[_num_sections];
+		s.b0 = ohm * ohm / c;
+		s.b1 = 2.0f * s.b0;
+		s.b2 = s.b0;
+		s.a1 = 2.0f * (ohm * ohm - 1.0f) / c;
+		s.a2 = (1.0f - 2.0f * cosf(M_PI_F / 4.0f) * ohm + ohm * ohm) / c;
+
+		reset_section(_num_sections++);
+		return true;
+	}
+
+	/**
+	 * Append a notch section.
+	 *
+	 * @param notch_freq	center frequency [Hz]
+	 * @param bandwidth	-3 dB bandwidth [Hz]
+	 * @return false if the bank is full or the parameters are invalid
+	 */
+	bool add_notch(float sample_freq, float notch_freq, float bandwidth)
+	{
+		if ((_num_sections >= MAX_SECTIONS) || (sample_freq <= 0.0f) || (notch_freq <= 0.0f)
+		    || (notch_freq >= sample_freq / 2.0f) || (bandwidth <= 0.0f)) {
+			return false;
+		}
+
+		const float alpha = tanf(M_PI_F * bandwidth / sample_freq);
+		const float beta = -cosf(2.0f * M_PI_F * notch_freq / sample_freq);
+		const float a0_inv = 1.0f / (alpha + 1.0f);
+
+		Section &s = _sections[_num_sections];
+		s.b0 = a0_inv;
+		s.b1 = 2.0f * beta * a0_inv;
+		s.b2 = a0_inv;
+		s.a1 = s.b1;
+		s.a2 = (1.0f - alpha) * a0_inv;
+
+		reset_section(_num_sections++);
+		return true;
+	}
+
+	// Remove all sections (pass through)
+	void clear() { _num_sections = 0; }
+
+	int sections() const { return _num_sections; }
+
+	// Reset the filter state to zero
+	void reset()
+	{
+		for (int k = 0; k < _num_sections; k++) {
+			reset_section(k);
+		}
+	}
+
+	/**
+	 * Reset the filter state to the steady state for a constant input.
+	 *
+	 * @param value	one value per channel
+	 */
+	void reset(const float value[CHANNELS])
+	{
+		// all sections have unity DC gain, so every section sees the same input
+		for (int k = 0; k < _num_sections; k++) {
+			const Section &s = _sections[k];
+
+			for (int ch = 0; ch < CHANNELS; ch++) {
+				const float dval = value[ch] / (s.b0 + s.b1 + s.b2);
+				const float w = PX4_ISFINITE(dval) ? dval : value[ch];
+				_w1[k][ch] = w;
+				_w2[k][ch] = w;
+			}
+		}
+	}
+
+	/**
+	 * Filter a block in place.
+	 *
+	 * @param data		data[sample][channel], oldest sample first
+	 * @param samples	number of samples in the block
+	 */
+	void apply(float (*data)[CHANNELS], int samples)
+	{
+		for (int i = 0; i < samples; i++) {
+			float *x = data[i];
+
+			for (int k = 0; k < _num_sections; k++) {
+				const Section s = _sections[k];
+				float *w1 = _w1[k];
+				float *w2 = _w2[k];
+
+				for (int ch = 0; ch < CHANNELS; ch++) {
+					const float w0 = x[ch] - w1[ch] * s.a1 - w2[ch] * s.a2;
+					x[ch] = w0 * s.b0 + w1[ch] * s.b1 + w2[ch] * s.b2;
+					w2[ch] = w1[ch];
+					w1[ch] = w0;
+				}
+			}
+		}
+	}
+
+private:
+
+	struct Section {
+		float b0{1.0f};
+		float b1{0.0f};
+		float b2{0.0f};
+		float a1{0.0f};
+		float a2{0.0f};
+	};
+
+	void reset_section(int k)
+	{
+		for (int ch = 0; ch < CHANNELS; ch++) {
+			_w1[k][ch] = 0.0f;
+			_w2[k][ch] = 0.0f;
+		}
+	}
+
+	Section _sections[MAX_SECTIONS] {};
+
+	float _w1[MAX_SECTIONS][CHANNELS] {};	// delay element -1, per section and channel
+	float _w2[MAX_SECTIONS][CHANNELS] {};	// delay element -2, per section and channel
+
+	int _num_sections{0};
+};
+
+} // namespace math
@@ -397,6 +397,29 @@ __EXPORT int 		param_load_default(void);
  */
 __EXPORT uint32_t	param_hash_check(void);
 
+/**
+ * Get the current parameter change epoch.
+ *
+ * The epoch is incremented on every change of a parameter value, a parameter reset or when a
+ * parameter becomes used. It is only valid during the current boot.
+ *
+ * @return		The current epoch.
+ */
+__EXPORT uint32_t	param_get_epoch(void);
+
+/**
+ * Check whether a parameter changed since a given epoch.
+ *
+ * This does not take the parameter lock and is cheap enough to be called for every parameter
+ * of a module on each parameter update.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param epoch		An epoch previously returned by param_get_epoch().
+ * @return		true if the parameter changed after the epoch. Also returns true if this cannot
+ *			be determined, e.g. if the epoch is too old or unknown.
+ */
+__EXPORT bool		param_changed_since(param_t param, uint32_t epoch);
+
 /**
  * Print the status of the param system
  *
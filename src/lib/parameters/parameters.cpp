@@ -47,10 +47,12 @@
 
 #include <crc32.h>
 #include <float.h>
+#include <limits.h>
 #include <math.h>
 
 #include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
+#include <px4_atomic.h>
 #include <px4_config.h>
 #include <px4_defines.h>
 #include <px4_posix.h>
@@ -80,6 +82,32 @@ static const char *param_default_file = PX4_ROOTFSDIR"/eeprom/parameters";
 
 static char *param_user_file = nullptr;
 
+/**
+ * Parameter file journal. The default parameter file starts with a BSON document holding all
+ * modified parameters and can be followed by journal records: BSON documents appended by
+ * param_save_default() with only the values changed since the previous save. The first node of
+ * every document is PARAM_JOURNAL_KEY with the sequence number of the file, so that left-over
+ * data at the end of a file is never applied. The file is compacted (rewritten as a single
+ * document) after a parameter reset, if a record is damaged or once the journal grows larger
+ * than the full document.
+ * The file and the journal state are protected by param_sem_save, except param_journal_compact,
+ * which is set with the parameter values and therefore protected by the writer lock.
+ */
+#define PARAM_JOURNAL_KEY "_JOURNAL_SEQ"
+static constexpr off_t PARAM_JOURNAL_COMPACT_MARGIN = 1024;	///< journal size above the full document size that triggers compaction
+static int32_t param_journal_seq = -1;		///< sequence number of the default file, -1 if unknown
+static off_t param_journal_base_size = 0;	///< size of the full document at the start of the default file
+static off_t param_journal_file_size = 0;	///< expected size of the default file
+static bool param_journal_compact = true;	///< the next save needs to rewrite the whole file
+
+/** result of reading a parameter file, see param_import_internal() */
+struct param_journal_state {
+	int32_t seq{-1};		///< sequence number of the file, -1 if the file has no journal
+	off_t base_size{0};		///< size of the first document
+	off_t file_size{0};
+	bool damaged{false};		///< a journal record could not be read
+};
+
 #ifdef __PX4_QURT
 #define PARAM_OPEN	px4_open
 #define PARAM_CLOSE	px4_close
@@ -117,6 +145,27 @@ uint8_t  *param_changed_storage = nullptr;
 int size_param_changed_storage_bytes = 0;
 const int bits_per_allocation_unit  = (sizeof(*param_changed_storage) * 8);
 
+/**
+ * Parameter change tracking: the epoch is incremented on every change of a parameter value or of
+ * the set of used parameters. For each parameter the lower 16 bits of the epoch of its last change
+ * are stored, which allows to find all parameters changed since a given epoch.
+ * Both are written with the writer lock held, the generations always before the epoch: the atomic
+ * epoch update then publishes them to the lock-free readers in param_changed_since().
+ */
+static px4::atomic<uint32_t> param_epoch{0};
+static uint16_t *param_change_generation = nullptr;
+
+/** cached result of param_hash_check(), valid as long as the epoch did not change. Protected by the writer lock. */
+static uint32_t param_hash_cached = 0;
+static uint32_t param_hash_cached_epoch = 0;
+static bool param_hash_cached_valid = false;
+
+/**
+ * Position + 1 of the modified value of each parameter in param_values, 0 if the
+ * parameter is unchanged. Gives O(1) access to the modified value of a parameter.
+ */
+static uint16_t *param_value_index = nullptr;
+
 
 static unsigned
 get_param_info_count()
@@ -133,6 +182,17 @@ get_param_info_count()
 		if (param_changed_storage == nullptr) {
 			return 0;
 		}
+
+		param_value_index = (uint16_t *)calloc(param_info_count, sizeof(uint16_t));
+
+		if (param_value_index == nullptr) {
+			free(param_changed_storage);
+			param_changed_storage = nullptr;
+			return 0;
+		}
+
+		/* change tracking is optional: without it param_changed_since() always returns true */
+		param_change_generation = (uint16_t *)calloc(param_info_count, sizeof(uint16_t));
 	}
 
 	return param_info_count;
@@ -251,25 +311,20 @@ handle_in_range(param_t param)
 }
 
 /**
- * Compare two modifid parameter structures to determine ordering.
+ * Record a change of a parameter and advance the change epoch.
  *
- * This function is suitable for passing to qsort or bsearch.
+ * @param param			The parameter that changed.
  */
-static int
-param_compare_values(const void *a, const void *b)
+static void
+param_mark_changed(param_t param)
 {
-	struct param_wbuf_s *pa = (struct param_wbuf_s *)a;
-	struct param_wbuf_s *pb = (struct param_wbuf_s *)b;
-
-	if (pa->param < pb->param) {
-		return -1;
-	}
-
-	if (pa->param > pb->param) {
-		return 1;
+	/* update the generation before the epoch, so that a lock-free param_changed_since() never
+	 * sees the new epoch together with the old generation */
+	if (param_change_generation != nullptr) {
+		param_change_generation[param] = (uint16_t)(param_epoch.load() + 1);
 	}
 
-	return 0;
+	param_epoch.fetch_add(1);
 }
 
 /**
@@ -286,10 +341,8 @@ param_find_changed(param_t param)
 
 	param_assert_locked();
 
-	if (param_values != nullptr) {
-		param_wbuf_s key{};
-		key.param = param;
-		s = (param_wbuf_s *)utarray_find(param_values, &key, param_compare_values);
+	if (param_values != nullptr && handle_in_range(param) && param_value_index[param] > 0) {
+		s = (param_wbuf_s *)utarray_eltptr(param_values, param_value_index[param] - 1u);
 	}
 
 	return s;
@@ -302,6 +355,7 @@ _param_notify_changes()
 	parameter_update_s pup = {};
 	pup.timestamp = hrt_absolute_time();
 	pup.instance = param_instance++;
+	pup.epoch = param_epoch.load();
 
 	/*
 	 * If we don't have a handle to our topic, create one now; otherwise
@@ -712,11 +766,10 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 			params_changed = true;
 
-			/* add it to the array and sort */
+			/* append it to the array and index it */
 			utarray_push_back(param_values, &buf);
-			utarray_sort(param_values, param_compare_values);
+			param_value_index[param] = utarray_len(param_values);
 
-			/* find it after sorting */
 			s = param_find_changed(param);
 		}
 
@@ -758,6 +811,10 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			goto out;
 		}
 
+		if (params_changed) {
+			param_mark_changed(param);
+		}
+
 		s->unsaved = !mark_saved;
 		result = 0;
 
@@ -832,8 +889,13 @@ void param_set_used_internal(param_t param)
 	}
 
 	// FIXME: this needs locking too
-	param_changed_storage[param_index / bits_per_allocation_unit] |=
-		(1 << param_index % bits_per_allocation_unit);
+	if (!(param_changed_storage[param_index / bits_per_allocation_unit] & (1 << param_index % bits_per_allocation_unit))) {
+		param_changed_storage[param_index / bits_per_allocation_unit] |=
+			(1 << param_index % bits_per_allocation_unit);
+
+		// a newly used parameter changes the hash and needs to be sent to a GCS doing a delta sync
+		param_mark_changed(param);
+	}
 }
 
 int
@@ -851,8 +913,21 @@ param_reset(param_t param)
 
 		/* if we found one, erase it */
 		if (s != nullptr) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
+			/* fill the gap with the last element, so that no other index needs to be updated */
+			const unsigned pos = utarray_eltidx(param_values, s);
+			const unsigned last = utarray_len(param_values) - 1;
+
+			if (pos != last) {
+				*s = *(param_wbuf_s *)utarray_eltptr(param_values, last);
+				param_value_index[s->param] = pos + 1;
+			}
+
+			utarray_pop_back(param_values);
+			param_value_index[param] = 0;
+			param_mark_changed(param);
+
+			/* a reset cannot be expressed by a journal record */
+			param_journal_compact = true;
 		}
 
 		param_found = true;
@@ -879,6 +954,22 @@ param_reset_all_internal(bool auto_save)
 
 	/* mark as reset / deleted */
 	param_values = nullptr;
+	param_journal_compact = true;
+
+	if (param_value_index != nullptr) {
+		memset(param_value_index, 0, param_info_count * sizeof(uint16_t));
+	}
+
+	/* all parameters are considered changed, the generations are updated before the epoch */
+	if (param_change_generation != nullptr) {
+		const uint16_t generation = (uint16_t)(param_epoch.load() + 1);
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			param_change_generation[param] = generation;
+		}
+	}
+
+	param_epoch.fetch_add(1);
 
 	if (auto_save) {
 		param_autosave();
@@ -942,6 +1033,10 @@ param_set_default_file(const char *filename)
 		param_user_file = strdup(filename);
 	}
 
+	param_lock_writer();
+	param_journal_compact = true;
+	param_unlock_writer();
+
 #endif /* FLASH_BASED_PARAMS */
 
 	return 0;
@@ -953,32 +1048,104 @@ param_get_default_file()
 	return (param_user_file != nullptr) ? param_user_file : param_default_file;
 }
 
-int
-param_save_default()
+static int param_export_internal(int fd, bool only_unsaved, int32_t journal_seq);
+static int param_import_internal(int fd, bool mark_saved, param_journal_state *journal);
+
+/**
+ * Check for parameter values that are not saved yet. Needs the lock held.
+ */
+static bool
+param_any_unsaved()
 {
+	param_wbuf_s *s = nullptr;
+
+	if (param_values != nullptr) {
+		while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != nullptr) {
+			if (s->unsaved) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Append a journal record with the unsaved values to the default parameter file.
+ * Needs param_sem_save held, which protects the file and the journal state.
+ *
+ * @param unsaved	false if there are no unsaved values, then only the file is checked
+ * @return PX4_OK on success, PX4_ERROR if the file needs to be compacted instead
+ */
+static int
+param_journal_append(const char *filename, bool unsaved)
+{
+	int fd = PARAM_OPEN(filename, O_WRONLY);
+
+	if (fd < 0) {
+		return PX4_ERROR;
+	}
+
 	int res = PX4_ERROR;
+	const off_t file_size = lseek(fd, 0, SEEK_END);
 
-	const char *filename = param_get_default_file();
+	/* the file must be the one we wrote last, and the journal is bounded by the size of the full
+	 * document, which keeps the amortized cost of a save independent of the number of parameters */
+	if (file_size == param_journal_file_size &&
+	    file_size - param_journal_base_size < param_journal_base_size + PARAM_JOURNAL_COMPACT_MARGIN) {
 
-	if (!filename) {
-		param_lock_writer();
-		res = flash_param_save(false);
-		param_unlock_writer();
-		return res;
+		res = unsaved ? param_export_internal(fd, true, param_journal_seq) : PX4_OK;
+
+		if (res == PX4_OK) {
+			param_journal_file_size = lseek(fd, 0, SEEK_CUR);
+		}
 	}
 
-	/* write parameters to temp file */
-	int fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+	PARAM_CLOSE(fd);
+
+	return res;
+}
+
+/**
+ * Get the name of the file a compaction of the default parameter file is written to.
+ * param_load_default() falls back to it if the default file is missing.
+ */
+static int
+param_journal_temp_filename(const char *filename, char *buf, size_t len)
+{
+	const int n = snprintf(buf, len, "%s.tmp", filename);
+	return (n > 0 && (size_t)n < len) ? PX4_OK : PX4_ERROR;
+}
+
+/**
+ * Rewrite the default parameter file as a single document, which starts a new journal.
+ * The document is written to a temporary file which then replaces the default file, so that a
+ * power loss during the rewrite leaves either the old or the new file.
+ * Needs param_sem_save held.
+ */
+static int
+param_journal_rewrite(const char *filename)
+{
+	char temp_filename[PATH_MAX];
+
+	if (param_journal_temp_filename(filename, temp_filename, sizeof(temp_filename)) != PX4_OK) {
+		PX4_ERR("param file name too long: %s", filename);
+		return PX4_ERROR;
+	}
+
+	int res = PX4_ERROR;
+	int fd = PARAM_OPEN(temp_filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
 
 	if (fd < 0) {
-		PX4_ERR("failed to open param file: %s", filename);
+		PX4_ERR("failed to open param file: %s", temp_filename);
 		return PX4_ERROR;
 	}
 
+	const int32_t seq = (param_journal_seq + 1) & INT32_MAX;
 	int attempts = 5;
 
 	while (res != OK && attempts > 0) {
-		res = param_export(fd, false);
+		res = param_export_internal(fd, false, seq);
 		attempts--;
 
 		if (res != PX4_OK) {
@@ -987,11 +1154,77 @@ param_save_default()
 		}
 	}
 
+	const off_t file_size = lseek(fd, 0, SEEK_CUR);
+
+	// the new file needs to be on the media before it replaces the old one
+	if (res == OK && fsync(fd) != 0) {
+		res = PX4_ERROR;
+	}
+
+	PARAM_CLOSE(fd);
+
+	if (res == OK && rename(temp_filename, filename) != 0) {
+		// some file systems (e.g. FAT on NuttX) do not replace an existing file,
+		// until the rename is done param_load_default() reads the temporary file
+		if (unlink(filename) != 0 || rename(temp_filename, filename) != 0) {
+			res = PX4_ERROR;
+		}
+	}
+
 	if (res != OK) {
 		PX4_ERR("failed to write parameters to file: %s", filename);
+
+	} else {
+		param_journal_seq = seq;
+		param_journal_base_size = file_size;
+		param_journal_file_size = file_size;
 	}
 
-	PARAM_CLOSE(fd);
+	return res;
+}
+
+int
+param_save_default()
+{
+	int res = PX4_ERROR;
+
+	const char *filename = param_get_default_file();
+
+	// take the file lock for the whole save, so that concurrent saves cannot append at the same offset
+	do {} while (px4_sem_wait(&param_sem_save) != 0);
+
+	param_lock_writer();
+	const bool compact = param_journal_compact;
+	const bool unsaved = param_any_unsaved();
+	param_journal_compact = false;
+	param_unlock_writer();
+
+	if (!filename) {
+		/* flashfs holds a single copy of the parameters, so there is no journal on flash,
+		 * but a save without changes can be skipped */
+		if (!compact && !unsaved) {
+			res = PX4_OK;
+
+		} else {
+			param_lock_writer();
+			res = flash_param_save(false);
+			param_unlock_writer();
+		}
+
+	} else if (!compact && param_journal_append(filename, unsaved) == PX4_OK) {
+		res = PX4_OK;
+
+	} else {
+		res = param_journal_rewrite(filename);
+	}
+
+	if (res != PX4_OK) {
+		param_lock_writer();
+		param_journal_compact = true;
+		param_unlock_writer();
+	}
+
+	px4_sem_post(&param_sem_save);
 
 	return res;
 }
@@ -1009,11 +1242,32 @@ param_load_default()
 		return flash_param_load();
 	}
 
+	// the file is not modified by a save while it is read
+	do {} while (px4_sem_wait(&param_sem_save) != 0);
+
 	int fd_load = PARAM_OPEN(filename, O_RDONLY);
+	bool temp_file = false;
+
+	if (fd_load < 0 && errno == ENOENT) {
+		/* a compaction can be interrupted between removing the old file and renaming the new one */
+		char temp_filename[PATH_MAX];
+
+		if (param_journal_temp_filename(filename, temp_filename, sizeof(temp_filename)) == PX4_OK) {
+			fd_load = PARAM_OPEN(temp_filename, O_RDONLY);
+			temp_file = fd_load >= 0;
+		}
+
+		if (!temp_file) {
+			errno = ENOENT;
+		}
+	}
 
 	if (fd_load < 0) {
+		const int open_errno = errno;
+		px4_sem_post(&param_sem_save);
+
 		/* no parameter file is OK, otherwise this is an error */
-		if (errno != ENOENT) {
+		if (open_errno != ENOENT) {
 			PX4_ERR("open '%s' for reading failed", filename);
 			return -1;
 		}
@@ -1021,19 +1275,64 @@ param_load_default()
 		return 1;
 	}
 
-	int result = param_load(fd_load);
+	param_journal_state journal{};
+
+	param_reset_all_internal(false);
+	int result = param_import_internal(fd_load, true, &journal);
 	PARAM_CLOSE(fd_load);
 
+	if (result != 0 && temp_file) {
+		/* the first write of the file was interrupted, this is the same as no file */
+		param_reset_all_internal(false);
+		px4_sem_post(&param_sem_save);
+		return 1;
+	}
+
 	if (result != 0) {
+		px4_sem_post(&param_sem_save);
 		PX4_ERR("error reading parameters from '%s'", filename);
 		return -2;
 	}
 
+	if (temp_file) {
+		/* the next save writes the default file again */
+		journal.damaged = true;
+	}
+
+	/* continue the journal of the file, unless it has none or it is damaged */
+	param_journal_seq = journal.seq;
+	param_journal_base_size = journal.base_size;
+	param_journal_file_size = journal.file_size;
+
+	param_lock_writer();
+	param_journal_compact = journal.seq < 0 || journal.damaged;
+	param_unlock_writer();
+
+	px4_sem_post(&param_sem_save);
+
 	return res;
 }
 
 int
 param_export(int fd, bool only_unsaved)
+{
+	// take the file lock
+	do {} while (px4_sem_wait(&param_sem_save) != 0);
+
+	const int result = param_export_internal(fd, only_unsaved, -1);
+
+	px4_sem_post(&param_sem_save);
+
+	return result;
+}
+
+/**
+ * Export parameters to a file. Needs param_sem_save held.
+ *
+ * @param journal_seq	if not negative, the document starts with PARAM_JOURNAL_KEY set to this value
+ */
+static int
+param_export_internal(int fd, bool only_unsaved, int32_t journal_seq)
 {
 	int	result = -1;
 	perf_begin(param_export_perf);
@@ -1056,21 +1355,30 @@ param_export(int fd, bool only_unsaved)
 		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
 	}
 
-	// take the file lock
-	do {} while (px4_sem_wait(&param_sem_save) != 0);
-
 	param_lock_reader();
 
 	uint8_t bson_buffer[256];
 	bson_encoder_init_buf_file(&encoder, fd, &bson_buffer, sizeof(bson_buffer));
 
+	if (journal_seq >= 0 && bson_encoder_append_int(&encoder, PARAM_JOURNAL_KEY, journal_seq)) {
+		PX4_ERR("BSON append failed for '%s'", PARAM_JOURNAL_KEY);
+		goto out;
+	}
+
 	/* no modified parameters -> we are done */
 	if (param_values == nullptr) {
 		result = 0;
 		goto out;
 	}
 
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != nullptr) {
+	/* export in parameter order, independent of the order in which the values were changed */
+	for (param_t param = 0; handle_in_range(param); param++) {
+		s = param_find_changed(param);
+
+		if (s == nullptr) {
+			continue;
+		}
+
 		/*
 		 * If we are only saving values changed since last save, and this
 		 * one hasn't, then skip it
@@ -1145,8 +1453,6 @@ out:
 
 	param_unlock_reader();
 
-	px4_sem_post(&param_sem_save);
-
 	if (shutdown_lock_ret == 0) {
 		px4_shutdown_unlock();
 	}
@@ -1158,6 +1464,9 @@ out:
 
 struct param_import_state {
 	bool mark_saved;
+	bool journal_record;	///< decoding a journal record, which needs to start with the matching PARAM_JOURNAL_KEY
+	bool first_node;
+	int32_t journal_seq;	///< value of PARAM_JOURNAL_KEY, -1 if not found
 };
 
 static int
@@ -1179,6 +1488,24 @@ param_import_callback(bson_decoder_t decoder, void *priv, bson_node_t node)
 		return 0;
 	}
 
+	const bool first_node = state->first_node;
+	state->first_node = false;
+
+	if (strcmp(node->name, PARAM_JOURNAL_KEY) == 0 && node->type == BSON_INT32) {
+		if (state->journal_record) {
+			/* a record belonging to another version of the file */
+			return (first_node && node->i == state->journal_seq) ? 1 : -1;
+		}
+
+		state->journal_seq = node->i;
+		return 1;
+	}
+
+	if (state->journal_record && first_node) {
+		/* not a journal record, e.g. data left over at the end of the file */
+		return -1;
+	}
+
 	/*
 	 * Find the parameter this node represents.  If we don't know it,
 	 * ignore the node.
@@ -1288,10 +1615,10 @@ out:
 }
 
 static int
-param_import_internal(int fd, bool mark_saved)
+param_import_internal(int fd, bool mark_saved, param_journal_state *journal)
 {
 	bson_decoder_s decoder;
-	param_import_state state;
+	param_import_state state{};
 	int result = -1;
 
 	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
@@ -1300,13 +1627,58 @@ param_import_internal(int fd, bool mark_saved)
 	}
 
 	state.mark_saved = mark_saved;
+	state.first_node = true;
+	state.journal_seq = -1;
 
 	do {
 		result = bson_decoder_next(&decoder);
 
 	} while (result > 0);
 
-	return result;
+	if (result < 0 || state.journal_seq < 0) {
+		return result;
+	}
+
+	/* replay the journal records following the first document */
+	const off_t base_size = lseek(fd, 0, SEEK_CUR);
+	const off_t file_size = lseek(fd, 0, SEEK_END);
+	off_t pos = lseek(fd, base_size, SEEK_SET);
+	bool damaged = false;
+
+	while (pos >= 0 && pos < file_size) {
+		state.journal_record = true;
+		state.first_node = true;
+
+		if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
+			damaged = true;
+			break;
+		}
+
+		do {
+			result = bson_decoder_next(&decoder);
+
+		} while (result > 0);
+
+		if (result < 0) {
+			damaged = true;
+			break;
+		}
+
+		pos = lseek(fd, 0, SEEK_CUR);
+	}
+
+	if (damaged) {
+		PX4_WARN("parameter journal damaged, ignoring the last %d bytes", (int)(file_size - pos));
+	}
+
+	if (journal != nullptr) {
+		journal->seq = state.journal_seq;
+		journal->base_size = base_size;
+		journal->file_size = file_size;
+		journal->damaged = damaged;
+	}
+
+	return 0;
 }
 
 int
@@ -1316,7 +1688,7 @@ param_import(int fd)
 		return flash_param_import();
 	}
 
-	return param_import_internal(fd, false);
+	return param_import_internal(fd, false, nullptr);
 }
 
 int
@@ -1327,7 +1699,7 @@ param_load(int fd)
 	}
 
 	param_reset_all_internal(false);
-	return param_import_internal(fd, true);
+	return param_import_internal(fd, true, nullptr);
 }
 
 void
@@ -1354,7 +1726,15 @@ uint32_t param_hash_check()
 {
 	uint32_t param_hash = 0;
 
-	param_lock_reader();
+	/* the writer lock also protects the cached hash, which is updated here */
+	param_lock_writer();
+
+	/* nothing changed since the last call: the cached hash is still valid */
+	if (param_hash_cached_valid && param_hash_cached_epoch == param_epoch.load()) {
+		param_hash = param_hash_cached;
+		param_unlock_writer();
+		return param_hash;
+	}
 
 	/* compute the CRC32 over all string param names and 4 byte values */
 	for (param_t param = 0; handle_in_range(param); param++) {
@@ -1368,11 +1748,42 @@ uint32_t param_hash_check()
 		param_hash = crc32part((const uint8_t *)val, param_size(param), param_hash);
 	}
 
-	param_unlock_reader();
+	param_hash_cached = param_hash;
+	param_hash_cached_epoch = param_epoch.load();
+	param_hash_cached_valid = true;
+
+	param_unlock_writer();
 
 	return param_hash;
 }
 
+uint32_t param_get_epoch()
+{
+	return param_epoch.load();
+}
+
+bool param_changed_since(param_t param, uint32_t epoch)
+{
+	bool changed = true;
+
+	/* no locking: this is called for every parameter of a module on each parameter update.
+	 * The epoch is read once, and all generations up to it are visible once it is read (see
+	 * param_mark_changed()). A change racing with this call has a generation newer than the epoch,
+	 * which is not reported here but by the next check against an epoch taken before that change. */
+	const uint32_t current_epoch = param_epoch.load();
+	const uint32_t epoch_diff = current_epoch - epoch;
+
+	/* only the lower 16 bits of the epoch are stored per parameter: if the requested epoch is
+	 * too old (or from the future, e.g. from before a reboot) everything is considered changed */
+	if (handle_in_range(param) && param_change_generation != nullptr && epoch <= current_epoch
+	    && epoch_diff < UINT16_MAX) {
+		const uint16_t age = (uint16_t)((uint16_t)current_epoch - param_change_generation[param]);
+		changed = age < epoch_diff;
+	}
+
+	return changed;
+}
+
 void param_print_status()
 {
 	PX4_INFO("summary: %d/%d (used/total)", param_count_used(), param_count());
@@ -1391,6 +1802,15 @@ void param_print_status()
 			 utarray_len(param_values), param_values->n, param_values->n * sizeof(UT_icd));
 	}
 
+#ifndef FLASH_BASED_PARAMS
+
+	if (param_journal_seq >= 0) {
+		PX4_INFO("journal: %d bytes%s", (int)(param_journal_file_size - param_journal_base_size),
+			 param_journal_compact ? " (compaction pending)" : "");
+	}
+
+#endif /* FLASH_BASED_PARAMS */
+
 #ifndef PARAM_NO_AUTOSAVE
 	PX4_INFO("auto save: %s", autosave_disabled ? "off" : "on");
 
@@ -50,6 +50,7 @@
 #include <math.h>
 
 #include <drivers/drv_hrt.h>
+#include <px4_atomic.h>
 #include <px4_config.h>
 #include <px4_defines.h>
 #include <px4_posix.h>
@@ -119,6 +120,27 @@ uint8_t  *param_changed_storage = nullptr;
 int size_param_changed_storage_bytes = 0;
 const int bits_per_allocation_unit  = (sizeof(*param_changed_storage) * 8);
 
+/**
+ * Parameter change tracking: the epoch is incremented on every change of a parameter value or of
+ * the set of used parameters. For each parameter the lower 16 bits of the epoch of its last change
+ * are stored, which allows to find all parameters changed since a given epoch.
+ * Both are written with the writer lock held, the generations always before the epoch: the atomic
+ * epoch update then publishes them to the lock-free readers in param_changed_since().
+ */
+static px4::atomic<uint32_t> param_epoch{0};
+static uint16_t *param_change_generation = nullptr;
+
+/** cached result of param_hash_check(), valid as long as the epoch did not change. Protected by the writer lock. */
+static uint32_t param_hash_cached = 0;
+static uint32_t param_hash_cached_epoch = 0;
+static bool param_hash_cached_valid = false;
+
+/**
+ * Position + 1 of the modified value of each parameter in param_values, 0 if the
+ * parameter is unchanged. Gives O(1) access to the modified value of a parameter.
+ */
+static uint16_t *param_value_index = nullptr;
+
 //#define ENABLE_SHMEM_DEBUG
 static void init_params();
 
@@ -145,6 +167,17 @@ get_param_info_count()
 		if (param_changed_storage == nullptr) {
 			return 0;
 		}
+
+		param_value_index = (uint16_t *)calloc(param_info_count, sizeof(uint16_t));
+
+		if (param_value_index == nullptr) {
+			free(param_changed_storage);
+			param_changed_storage = nullptr;
+			return 0;
+		}
+
+		/* change tracking is optional: without it param_changed_since() always returns true */
+		param_change_generation = (uint16_t *)calloc(param_info_count, sizeof(uint16_t));
 	}
 
 	return param_info_count;
@@ -283,25 +316,20 @@ handle_in_range(param_t param)
 }
 
 /**
- * Compare two modifid parameter structures to determine ordering.
+ * Record a change of a parameter and advance the change epoch.
  *
- * This function is suitable for passing to qsort or bsearch.
+ * @param param			The parameter that changed.
  */
-static int
-param_compare_values(const void *a, const void *b)
+static void
+param_mark_changed(param_t param)
 {
-	struct param_wbuf_s *pa = (struct param_wbuf_s *)a;
-	struct param_wbuf_s *pb = (struct param_wbuf_s *)b;
-
-	if (pa->param < pb->param) {
-		return -1;
-	}
-
-	if (pa->param > pb->param) {
-		return 1;
+	/* update the generation before the epoch, so that a lock-free param_changed_since() never
+	 * sees the new epoch together with the old generation */
+	if (param_change_generation != nullptr) {
+		param_change_generation[param] = (uint16_t)(param_epoch.load() + 1);
 	}
 
-	return 0;
+	param_epoch.fetch_add(1);
 }
 
 /**
@@ -318,10 +346,8 @@ param_find_changed(param_t param)
 
 	param_assert_locked();
 
-	if (param_values != nullptr) {
-		param_wbuf_s key{};
-		key.param = param;
-		s = (param_wbuf_s *)utarray_find(param_values, &key, param_compare_values);
+	if (param_values != nullptr && handle_in_range(param) && param_value_index[param] > 0) {
+		s = (param_wbuf_s *)utarray_eltptr(param_values, param_value_index[param] - 1u);
 	}
 
 	return s;
@@ -334,6 +360,7 @@ _param_notify_changes()
 	parameter_update_s pup = {};
 	pup.timestamp = hrt_absolute_time();
 	pup.instance = param_instance++;
+	pup.epoch = param_epoch.load();
 
 	/*
 	 * If we don't have a handle to our topic, create one now; otherwise
@@ -771,11 +798,10 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 			params_changed = true;
 
-			/* add it to the array and sort */
+			/* append it to the array and index it */
 			utarray_push_back(param_values, &buf);
-			utarray_sort(param_values, param_compare_values);
+			param_value_index[param] = utarray_len(param_values);
 
-			/* find it after sorting */
 			s = param_find_changed(param);
 		}
 
@@ -817,6 +843,10 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			goto out;
 		}
 
+		if (params_changed) {
+			param_mark_changed(param);
+		}
+
 		s->unsaved = !mark_saved;
 		result = 0;
 
@@ -917,8 +947,13 @@ void param_set_used_internal(param_t param)
 	}
 
 	// FIXME: this needs locking too
-	param_changed_storage[param_index / bits_per_allocation_unit] |=
-		(1 << param_index % bits_per_allocation_unit);
+	if (!(param_changed_storage[param_index / bits_per_allocation_unit] & (1 << param_index % bits_per_allocation_unit))) {
+		param_changed_storage[param_index / bits_per_allocation_unit] |=
+			(1 << param_index % bits_per_allocation_unit);
+
+		// a newly used parameter changes the hash and needs to be sent to a GCS doing a delta sync
+		param_mark_changed(param);
+	}
 }
 
 int
@@ -936,8 +971,18 @@ param_reset(param_t param)
 
 		/* if we found one, erase it */
 		if (s != nullptr) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
+			/* fill the gap with the last element, so that no other index needs to be updated */
+			const unsigned pos = utarray_eltidx(param_values, s);
+			const unsigned last = utarray_len(param_values) - 1;
+
+			if (pos != last) {
+				*s = *(param_wbuf_s *)utarray_eltptr(param_values, last);
+				param_value_index[s->param] = pos + 1;
+			}
+
+			utarray_pop_back(param_values);
+			param_value_index[param] = 0;
+			param_mark_changed(param);
 		}
 
 		param_found = true;
@@ -965,6 +1010,21 @@ param_reset_all_internal(bool auto_save)
 	/* mark as reset / deleted */
 	param_values = nullptr;
 
+	if (param_value_index != nullptr) {
+		memset(param_value_index, 0, param_info_count * sizeof(uint16_t));
+	}
+
+	/* all parameters are considered changed, the generations are updated before the epoch */
+	if (param_change_generation != nullptr) {
+		const uint16_t generation = (uint16_t)(param_epoch.load() + 1);
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			param_change_generation[param] = generation;
+		}
+	}
+
+	param_epoch.fetch_add(1);
+
 	if (auto_save) {
 		param_autosave();
 	}
@@ -1175,7 +1235,14 @@ param_export(int fd, bool only_unsaved)
 	 * that have recently been changed. */
 	update_index_from_shmem();
 
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != nullptr) {
+	/* export in parameter order, independent of the order in which the values were changed */
+	for (param_t param = 0; handle_in_range(param); param++) {
+		s = param_find_changed(param);
+
+		if (s == nullptr) {
+			continue;
+		}
+
 		/*
 		 * If we are only saving values changed since last save, and this
 		 * one hasn't, then skip it
@@ -1460,7 +1527,15 @@ uint32_t param_hash_check()
 {
 	uint32_t param_hash = 0;
 
-	param_lock_reader();
+	/* the writer lock also protects the cached hash, which is updated here */
+	param_lock_writer();
+
+	/* nothing changed since the last call: the cached hash is still valid */
+	if (param_hash_cached_valid && param_hash_cached_epoch == param_epoch.load()) {
+		param_hash = param_hash_cached;
+		param_unlock_writer();
+		return param_hash;
+	}
 
 	/* compute the CRC32 over all string param names and 4 byte values */
 	for (param_t param = 0; handle_in_range(param); param++) {
@@ -1474,11 +1549,42 @@ uint32_t param_hash_check()
 		param_hash = crc32part((const uint8_t *)val, param_size(param), param_hash);
 	}
 
-	param_unlock_reader();
+	param_hash_cached = param_hash;
+	param_hash_cached_epoch = param_epoch.load();
+	param_hash_cached_valid = true;
+
+	param_unlock_writer();
 
 	return param_hash;
 }
 
+uint32_t param_get_epoch()
+{
+	return param_epoch.load();
+}
+
+bool param_changed_since(param_t param, uint32_t epoch)
+{
+	bool changed = true;
+
+	/* no locking: this is called for every parameter of a module on each parameter update.
+	 * The epoch is read once, and all generations up to it are visible once it is read (see
+	 * param_mark_changed()). A change racing with this call has a generation newer than the epoch,
+	 * which is not reported here but by the next check against an epoch taken before that change. */
+	const uint32_t current_epoch = param_epoch.load();
+	const uint32_t epoch_diff = current_epoch - epoch;
+
+	/* only the lower 16 bits of the epoch are stored per parameter: if the requested epoch is
+	 * too old (or from the future, e.g. from before a reboot) everything is considered changed */
+	if (handle_in_range(param) && param_change_generation != nullptr && epoch <= current_epoch
+	    && epoch_diff < UINT16_MAX) {
+		const uint16_t age = (uint16_t)((uint16_t)current_epoch - param_change_generation[param]);
+		changed = age < epoch_diff;
+	}
+
+	return changed;
+}
+
 void param_print_status()
 {
 	PX4_INFO("summary: %d/%d (used/total)", param_count_used(), param_count());
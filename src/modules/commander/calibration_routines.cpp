@@ -62,463 +62,244 @@
 #include "calibration_messages.h"
 #include "commander_helper.h"
 
-int sphere_fit_least_squares(const float x[], const float y[], const float z[],
-			     unsigned int size, unsigned int max_iterations, float delta, float *sphere_x, float *sphere_y, float *sphere_z,
-			     float *sphere_radius)
+void EllipsoidFitAccumulator::reset()
 {
+	memset(_DTD, 0, sizeof(_DTD));
+	memset(_DTd, 0, sizeof(_DTd));
+	_dTd = 0.0;
+	_count = 0;
+}
 
-	float x_sumplain = 0.0f;
-	float x_sumsq = 0.0f;
-	float x_sumcube = 0.0f;
-
-	float y_sumplain = 0.0f;
-	float y_sumsq = 0.0f;
-	float y_sumcube = 0.0f;
-
-	float z_sumplain = 0.0f;
-	float z_sumsq = 0.0f;
-	float z_sumcube = 0.0f;
-
-	float xy_sum = 0.0f;
-	float xz_sum = 0.0f;
-	float yz_sum = 0.0f;
-
-	float x2y_sum = 0.0f;
-	float x2z_sum = 0.0f;
-	float y2x_sum = 0.0f;
-	float y2z_sum = 0.0f;
-	float z2x_sum = 0.0f;
-	float z2y_sum = 0.0f;
-
-	for (unsigned int i = 0; i < size; i++) {
-
-		float x2 = x[i] * x[i];
-		float y2 = y[i] * y[i];
-		float z2 = z[i] * z[i];
-
-		x_sumplain += x[i];
-		x_sumsq += x2;
-		x_sumcube += x2 * x[i];
+void EllipsoidFitAccumulator::add_sample(float x, float y, float z)
+{
+	// Fit x^2 + y^2 + z^2 = D * u, with the x^2, y^2 and z^2 coefficients constrained to an ellipsoid
+	// and a free constant term, so that points close to the origin do not make the system singular
+	const double dx = static_cast<double>(x);
+	const double dy = static_cast<double>(y);
+	const double dz = static_cast<double>(z);
+	const double x2 = dx * dx;
+	const double y2 = dy * dy;
+	const double z2 = dz * dz;
+
+	const double D[N] = {
+		x2 + y2 - 2.0 * z2,
+		x2 + z2 - 2.0 * y2,
+		2.0 * dx * dy,
+		2.0 * dx * dz,
+		2.0 * dy * dz,
+		2.0 * dx,
+		2.0 * dy,
+		2.0 * dz,
+		1.0
+	};
 
-		y_sumplain += y[i];
-		y_sumsq += y2;
-		y_sumcube += y2 * y[i];
+	const double d = x2 + y2 + z2;
 
-		z_sumplain += z[i];
-		z_sumsq += z2;
-		z_sumcube += z2 * z[i];
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j <= i; j++) {
+			_DTD[tri(i, j)] += D[i] * D[j];
+		}
 
-		xy_sum += x[i] * y[i];
-		xz_sum += x[i] * z[i];
-		yz_sum += y[i] * z[i];
+		_DTd[i] += D[i] * d;
+	}
 
-		x2y_sum += x2 * y[i];
-		x2z_sum += x2 * z[i];
+	_dTd += d * d;
+	_count++;
+}
 
-		y2x_sum += y2 * x[i];
-		y2z_sum += y2 * z[i];
+static double det3x3(const double m[3][3])
+{
+	return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+	       - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+	       + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+}
 
-		z2x_sum += z2 * x[i];
-		z2y_sum += z2 * y[i];
-	}
+static bool inverse3x3(const double m[3][3], double inv[3][3])
+{
+	const double det = det3x3(m);
 
-	//
-	//Least Squares Fit a sphere A,B,C with radius squared Rsq to 3D data
-	//
-	//    P is a structure that has been computed with the data earlier.
-	//    P.npoints is the number of elements; the length of X,Y,Z are identical.
-	//    P's members are logically named.
-	//
-	//    X[n] is the x component of point n
-	//    Y[n] is the y component of point n
-	//    Z[n] is the z component of point n
-	//
-	//    A is the x coordiante of the sphere
-	//    B is the y coordiante of the sphere
-	//    C is the z coordiante of the sphere
-	//    Rsq is the radius squared of the sphere.
-	//
-	//This method should converge; maybe 5-100 iterations or more.
-	//
-	float x_sum = x_sumplain / size;        //sum( X[n] )
-	float x_sum2 = x_sumsq / size;    //sum( X[n]^2 )
-	float x_sum3 = x_sumcube / size;    //sum( X[n]^3 )
-	float y_sum = y_sumplain / size;        //sum( Y[n] )
-	float y_sum2 = y_sumsq / size;    //sum( Y[n]^2 )
-	float y_sum3 = y_sumcube / size;    //sum( Y[n]^3 )
-	float z_sum = z_sumplain / size;        //sum( Z[n] )
-	float z_sum2 = z_sumsq / size;    //sum( Z[n]^2 )
-	float z_sum3 = z_sumcube / size;    //sum( Z[n]^3 )
-
-	float XY = xy_sum / size;        //sum( X[n] * Y[n] )
-	float XZ = xz_sum / size;        //sum( X[n] * Z[n] )
-	float YZ = yz_sum / size;        //sum( Y[n] * Z[n] )
-	float X2Y = x2y_sum / size;    //sum( X[n]^2 * Y[n] )
-	float X2Z = x2z_sum / size;    //sum( X[n]^2 * Z[n] )
-	float Y2X = y2x_sum / size;    //sum( Y[n]^2 * X[n] )
-	float Y2Z = y2z_sum / size;    //sum( Y[n]^2 * Z[n] )
-	float Z2X = z2x_sum / size;    //sum( Z[n]^2 * X[n] )
-	float Z2Y = z2y_sum / size;    //sum( Z[n]^2 * Y[n] )
-
-	//Reduction of multiplications
-	float F0 = x_sum2 + y_sum2 + z_sum2;
-	float F1 =  0.5f * F0;
-	float F2 = -8.0f * (x_sum3 + Y2X + Z2X);
-	float F3 = -8.0f * (X2Y + y_sum3 + Z2Y);
-	float F4 = -8.0f * (X2Z + Y2Z + z_sum3);
-
-	//Set initial conditions:
-	float A = x_sum;
-	float B = y_sum;
-	float C = z_sum;
-
-	//First iteration computation:
-	float A2 = A * A;
-	float B2 = B * B;
-	float C2 = C * C;
-	float QS = A2 + B2 + C2;
-	float QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
-
-	//Set initial conditions:
-	float Rsq = F0 + QB + QS;
-
-	//First iteration computation:
-	float Q0 = 0.5f * (QS - Rsq);
-	float Q1 = F1 + Q0;
-	float Q2 = 8.0f * (QS - Rsq + QB + F0);
-	float aA, aB, aC, nA, nB, nC, dA, dB, dC;
-
-	//Iterate N times, ignore stop condition.
-	unsigned int n = 0;
-
-	while (n < max_iterations) {
-		n++;
-
-		//Compute denominator:
-		aA = Q2 + 16.0f * (A2 - 2.0f * A * x_sum + x_sum2);
-		aB = Q2 + 16.0f * (B2 - 2.0f * B * y_sum + y_sum2);
-		aC = Q2 + 16.0f * (C2 - 2.0f * C * z_sum + z_sum2);
-		aA = (fabsf(aA) < FLT_EPSILON) ? 1.0f : aA;
-		aB = (fabsf(aB) < FLT_EPSILON) ? 1.0f : aB;
-		aC = (fabsf(aC) < FLT_EPSILON) ? 1.0f : aC;
-
-		//Compute next iteration
-		nA = A - ((F2 + 16.0f * (B * XY + C * XZ + x_sum * (-A2 - Q0) + A * (x_sum2 + Q1 - C * z_sum - B * y_sum))) / aA);
-		nB = B - ((F3 + 16.0f * (A * XY + C * YZ + y_sum * (-B2 - Q0) + B * (y_sum2 + Q1 - A * x_sum - C * z_sum))) / aB);
-		nC = C - ((F4 + 16.0f * (A * XZ + B * YZ + z_sum * (-C2 - Q0) + C * (z_sum2 + Q1 - A * x_sum - B * y_sum))) / aC);
-
-		//Check for stop condition
-		dA = (nA - A);
-		dB = (nB - B);
-		dC = (nC - C);
-
-		if ((dA * dA + dB * dB + dC * dC) <= delta) { break; }
-
-		//Compute next iteration's values
-		A = nA;
-		B = nB;
-		C = nC;
-		A2 = A * A;
-		B2 = B * B;
-		C2 = C * C;
-		QS = A2 + B2 + C2;
-		QB = -2.0f * (A * x_sum + B * y_sum + C * z_sum);
-		Rsq = F0 + QB + QS;
-		Q0 = 0.5f * (QS - Rsq);
-		Q1 = F1 + Q0;
-		Q2 = 8.0f * (QS - Rsq + QB + F0);
+	if (!(fabs(det) > 1e-30)) {
+		return false;
 	}
 
-	*sphere_x = A;
-	*sphere_y = B;
-	*sphere_z = C;
-	*sphere_radius = sqrtf(Rsq);
+	inv[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / det;
+	inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det;
+	inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+	inv[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) / det;
+	inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+	inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det;
+	inv[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / det;
+	inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det;
+	inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
 
-	return 0;
+	return true;
 }
 
-int ellipsoid_fit_least_squares(const float x[], const float y[], const float z[],
-				unsigned int size, int max_iterations, float delta, float *offset_x, float *offset_y, float *offset_z,
-				float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z)
+bool EllipsoidFitAccumulator::solve(float *offset_x, float *offset_y, float *offset_z, float *sphere_radius,
+				    float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z,
+				    float *fitness) const
 {
-	float _fitness = 1.0e30f, _sphere_lambda = 1.0f, _ellipsoid_lambda = 1.0f;
+	if (_count < N) {
+		return false;
+	}
 
-	for (int i = 0; i < max_iterations; i++) {
-		run_lm_sphere_fit(x, y, z, _fitness, _sphere_lambda,
-				  size, offset_x, offset_y, offset_z,
-				  sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z);
+	// Cholesky decomposition of the (symmetric positive definite) normal matrix
+	double L[N * (N + 1) / 2];
 
-	}
+	for (int i = 0; i < N; i++) {
+		for (int j = 0; j <= i; j++) {
+			double sum = _DTD[tri(i, j)];
 
-	_fitness = 1.0e30f;
+			for (int k = 0; k < j; k++) {
+				sum -= L[tri(i, k)] * L[tri(j, k)];
+			}
 
-	for (int i = 0; i < max_iterations; i++) {
-		run_lm_ellipsoid_fit(x, y, z, _fitness, _ellipsoid_lambda,
-				     size, offset_x, offset_y, offset_z,
-				     sphere_radius, diag_x, diag_y, diag_z, offdiag_x, offdiag_y, offdiag_z);
-	}
+			if (i == j) {
+				// relative threshold, the samples do not span all directions yet
+				if (!(sum > _DTD[tri(i, i)] * 1e-12)) {
+					return false;
+				}
 
-	return 0;
-}
+				L[tri(i, i)] = sqrt(sum);
 
-int run_lm_sphere_fit(const float x[], const float y[], const float z[], float &_fitness, float &_sphere_lambda,
-		      unsigned int size, float *offset_x, float *offset_y, float *offset_z,
-		      float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z)
-{
-	//Run Sphere Fit using Levenberg Marquardt LSq Fit
-	const float lma_damping = 10.0f;
-	float _samples_collected = size;
-	float fitness = _fitness;
-	float fit1 = 0.0f, fit2 = 0.0f;
-
-	matrix::SquareMatrix<float, 4> JTJ;
-	matrix::SquareMatrix<float, 4> JTJ2;
-	float JTFI[4] = {};
-	float residual = 0.0f;
-
-	// Gauss Newton Part common for all kind of extensions including LM
-	for (uint16_t k = 0; k < _samples_collected; k++) {
-
-		float sphere_jacob[4];
-		//Calculate Jacobian
-		float A = (*diag_x    * (x[k] - *offset_x)) + (*offdiag_x * (y[k] - *offset_y)) + (*offdiag_y * (z[k] - *offset_z));
-		float B = (*offdiag_x * (x[k] - *offset_x)) + (*diag_y    * (y[k] - *offset_y)) + (*offdiag_z * (z[k] - *offset_z));
-		float C = (*offdiag_y * (x[k] - *offset_x)) + (*offdiag_z * (y[k] - *offset_y)) + (*diag_z    * (z[k] - *offset_z));
-		float length = sqrtf(A * A + B * B + C * C);
-
-		// 0: partial derivative (radius wrt fitness fn) fn operated on sample
-		sphere_jacob[0] = 1.0f;
-		// 1-3: partial derivative (offsets wrt fitness fn) fn operated on sample
-		sphere_jacob[1] = 1.0f * (((*diag_x    * A) + (*offdiag_x * B) + (*offdiag_y * C)) / length);
-		sphere_jacob[2] = 1.0f * (((*offdiag_x * A) + (*diag_y    * B) + (*offdiag_z * C)) / length);
-		sphere_jacob[3] = 1.0f * (((*offdiag_y * A) + (*offdiag_z * B) + (*diag_z    * C)) / length);
-		residual = *sphere_radius - length;
-
-		for (uint8_t i = 0; i < 4; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 4; j++) {
-				JTJ(i, j) += sphere_jacob[i] * sphere_jacob[j];
-				JTJ2(i, j) += sphere_jacob[i] * sphere_jacob[j]; //a backup JTJ for LM
+			} else {
+				L[tri(i, j)] = sum / L[tri(j, j)];
 			}
-
-			JTFI[i] += sphere_jacob[i] * residual;
 		}
 	}
 
+	// forward and back substitution
+	double u[N];
 
-	//------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
-	//refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
-	float fit1_params[4] = {*sphere_radius, *offset_x, *offset_y, *offset_z};
-	float fit2_params[4];
-	memcpy(fit2_params, fit1_params, sizeof(fit1_params));
+	for (int i = 0; i < N; i++) {
+		double sum = _DTd[i];
 
-	for (uint8_t i = 0; i < 4; i++) {
-		JTJ(i, i) += _sphere_lambda;
-		JTJ2(i, i) += _sphere_lambda / lma_damping;
-	}
+		for (int k = 0; k < i; k++) {
+			sum -= L[tri(i, k)] * u[k];
+		}
 
-	if (!JTJ.I(JTJ)) {
-		return -1;
+		u[i] = sum / L[tri(i, i)];
 	}
 
-	if (!JTJ2.I(JTJ2)) {
-		return -1;
-	}
+	for (int i = N - 1; i >= 0; i--) {
+		double sum = u[i];
 
-	for (uint8_t row = 0; row < 4; row++) {
-		for (uint8_t col = 0; col < 4; col++) {
-			fit1_params[row] -= JTFI[col] * JTJ(row, col);
-			fit2_params[row] -= JTFI[col] * JTJ2(row, col);
+		for (int k = i + 1; k < N; k++) {
+			sum -= L[tri(k, i)] * u[k];
 		}
-	}
 
-	//Calculate mean squared residuals
-	for (uint16_t k = 0; k < _samples_collected; k++) {
-		float A = (*diag_x    * (x[k] - fit1_params[1])) + (*offdiag_x * (y[k] - fit1_params[2])) + (*offdiag_y *
-				(z[k] + fit1_params[3]));
-		float B = (*offdiag_x * (x[k] - fit1_params[1])) + (*diag_y    * (y[k] - fit1_params[2])) + (*offdiag_z *
-				(z[k] + fit1_params[3]));
-		float C = (*offdiag_y * (x[k] - fit1_params[1])) + (*offdiag_z * (y[k] - fit1_params[2])) + (*diag_z    *
-				(z[k] - fit1_params[3]));
-		float length = sqrtf(A * A + B * B + C * C);
-		residual = fit1_params[0] - length;
-		fit1 += residual * residual;
-
-		A = (*diag_x    * (x[k] - fit2_params[1])) + (*offdiag_x * (y[k] - fit2_params[2])) + (*offdiag_y *
-				(z[k] - fit2_params[3]));
-		B = (*offdiag_x * (x[k] - fit2_params[1])) + (*diag_y    * (y[k] - fit2_params[2])) + (*offdiag_z *
-				(z[k] - fit2_params[3]));
-		C = (*offdiag_y * (x[k] - fit2_params[1])) + (*offdiag_z * (y[k] - fit2_params[2])) + (*diag_z    *
-				(z[k] - fit2_params[3]));
-		length = sqrtf(A * A + B * B + C * C);
-		residual = fit2_params[0] - length;
-		fit2 += residual * residual;
+		u[i] = sum / L[tri(i, i)];
 	}
 
-	fit1 = sqrtf(fit1) / _samples_collected;
-	fit2 = sqrtf(fit2) / _samples_collected;
+	// residual sum of squares: d'd - 2 u'D'd + u'D'Du
+	double ssr = _dTd;
 
-	if (fit1 > _fitness && fit2 > _fitness) {
-		_sphere_lambda *= lma_damping;
+	for (int i = 0; i < N; i++) {
+		ssr -= 2.0 * u[i] * _DTd[i];
 
-	} else if (fit2 < _fitness && fit2 < fit1) {
-		_sphere_lambda /= lma_damping;
-		memcpy(fit1_params, fit2_params, sizeof(fit1_params));
-		fitness = fit2;
-
-	} else if (fit1 < _fitness) {
-		fitness = fit1;
+		for (int j = 0; j < N; j++) {
+			ssr += u[i] * u[j] * ((j <= i) ? _DTD[tri(i, j)] : _DTD[tri(j, i)]);
+		}
 	}
 
-	//--------------------Levenberg-Marquardt-part-ends-here--------------------------------//
+	// quadric x' Q x + 2 l' x + c = 0
+	const double Q[3][3] = {
+		{u[0] + u[1] - 1.0, u[2], u[3]},
+		{u[2], u[0] - 2.0 * u[1] - 1.0, u[4]},
+		{u[3], u[4], u[1] - 2.0 * u[0] - 1.0}
+	};
+	const double l[3] = {u[5], u[6], u[7]};
+	const double c = u[8];
 
-	if (PX4_ISFINITE(fitness) && fitness < _fitness) {
-		_fitness = fitness;
-		*sphere_radius = fit1_params[0];
-		*offset_x = fit1_params[1];
-		*offset_y = fit1_params[2];
-		*offset_z = fit1_params[3];
-		return 0;
+	// center = -Q^-1 * l
+	double Q_inv[3][3];
 
-	} else {
-		return -1;
+	if (!inverse3x3(Q, Q_inv)) {
+		return false;
 	}
-}
 
-int run_lm_ellipsoid_fit(const float x[], const float y[], const float z[], float &_fitness, float &_sphere_lambda,
-			 unsigned int size, float *offset_x, float *offset_y, float *offset_z,
-			 float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z)
-{
-	//Run Sphere Fit using Levenberg Marquardt LSq Fit
-	const float lma_damping = 10.0f;
-	float _samples_collected = size;
-	float fitness = _fitness;
-	float fit1 = 0.0f;
-	float fit2 = 0.0f;
-
-	float JTJ[81] = {};
-	float JTJ2[81] = {};
-	float JTFI[9] = {};
-	float residual = 0.0f;
-	float ellipsoid_jacob[9];
-
-	// Gauss Newton Part common for all kind of extensions including LM
-	for (uint16_t k = 0; k < _samples_collected; k++) {
-
-		//Calculate Jacobian
-		float A = (*diag_x    * (x[k] - *offset_x)) + (*offdiag_x * (y[k] - *offset_y)) + (*offdiag_y * (z[k] - *offset_z));
-		float B = (*offdiag_x * (x[k] - *offset_x)) + (*diag_y    * (y[k] - *offset_y)) + (*offdiag_z * (z[k] - *offset_z));
-		float C = (*offdiag_y * (x[k] - *offset_x)) + (*offdiag_z * (y[k] - *offset_y)) + (*diag_z    * (z[k] - *offset_z));
-		float length = sqrtf(A * A + B * B + C * C);
-		residual = *sphere_radius - length;
-		fit1 += residual * residual;
-		// 0-2: partial derivative (offset wrt fitness fn) fn operated on sample
-		ellipsoid_jacob[0] = 1.0f * (((*diag_x    * A) + (*offdiag_x * B) + (*offdiag_y * C)) / length);
-		ellipsoid_jacob[1] = 1.0f * (((*offdiag_x * A) + (*diag_y    * B) + (*offdiag_z * C)) / length);
-		ellipsoid_jacob[2] = 1.0f * (((*offdiag_y * A) + (*offdiag_z * B) + (*diag_z    * C)) / length);
-		// 3-5: partial derivative (diag offset wrt fitness fn) fn operated on sample
-		ellipsoid_jacob[3] = -1.0f * ((x[k] - *offset_x) * A) / length;
-		ellipsoid_jacob[4] = -1.0f * ((y[k] - *offset_y) * B) / length;
-		ellipsoid_jacob[5] = -1.0f * ((z[k] - *offset_z) * C) / length;
-		// 6-8: partial derivative (off-diag offset wrt fitness fn) fn operated on sample
-		ellipsoid_jacob[6] = -1.0f * (((y[k] - *offset_y) * A) + ((x[k] - *offset_x) * B)) / length;
-		ellipsoid_jacob[7] = -1.0f * (((z[k] - *offset_z) * A) + ((x[k] - *offset_x) * C)) / length;
-		ellipsoid_jacob[8] = -1.0f * (((z[k] - *offset_z) * B) + ((y[k] - *offset_y) * C)) / length;
-
-		for (uint8_t i = 0; i < 9; i++) {
-			// compute JTJ
-			for (uint8_t j = 0; j < 9; j++) {
-				JTJ[i * 9 + j] += ellipsoid_jacob[i] * ellipsoid_jacob[j];
-				JTJ2[i * 9 + j] += ellipsoid_jacob[i] * ellipsoid_jacob[j]; //a backup JTJ for LM
-			}
+	double center[3];
 
-			JTFI[i] += ellipsoid_jacob[i] * residual;
-		}
+	for (int i = 0; i < 3; i++) {
+		center[i] = -(Q_inv[i][0] * l[0] + Q_inv[i][1] * l[1] + Q_inv[i][2] * l[2]);
 	}
 
+	// (x - center)' M (x - center) = 1
+	double k = -c;
 
-	//------------------------Levenberg-Marquardt-part-starts-here---------------------------------//
-	//refer: http://en.wikipedia.org/wiki/Levenberg%E2%80%93Marquardt_algorithm#Choice_of_damping_parameter
-	float fit1_params[9] = {*offset_x, *offset_y, *offset_z, *diag_x, *diag_y, *diag_z, *offdiag_x, *offdiag_y, *offdiag_z};
-	float fit2_params[9];
-	memcpy(fit2_params, fit1_params, sizeof(fit1_params));
-
-	for (uint8_t i = 0; i < 9; i++) {
-		JTJ[i * 9 + i] += _sphere_lambda;
-		JTJ2[i * 9 + i] += _sphere_lambda / lma_damping;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			k += center[i] * Q[i][j] * center[j];
+		}
 	}
 
+	double M[3][3];
 
-	if (!mat_inverse(JTJ, JTJ, 9)) {
-		return -1;
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			M[i][j] = Q[i][j] / k;
+		}
 	}
 
-	if (!mat_inverse(JTJ2, JTJ2, 9)) {
-		return -1;
+	// M must be positive definite for an ellipsoid
+	const double det_M = det3x3(M);
+
+	if (!(M[0][0] > 0.0) || !(M[0][0] * M[1][1] - M[0][1] * M[1][0] > 0.0) || !(det_M > 0.0)) {
+		return false;
 	}
 
-	for (uint8_t row = 0; row < 9; row++) {
-		for (uint8_t col = 0; col < 9; col++) {
-			fit1_params[row] -= JTFI[col] * JTJ[row * 9 + col];
-			fit2_params[row] -= JTFI[col] * JTJ2[row * 9 + col];
+	// radius of the sphere with the same volume, M * radius^2 has unit determinant
+	const double radius = pow(det_M, -1.0 / 6.0);
+
+	// soft iron matrix W = sqrtm(M * radius^2) (Denman-Beavers iteration)
+	double Y[3][3];
+	double Z[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			Y[i][j] = M[i][j] * radius * radius;
 		}
 	}
 
-	//Calculate mean squared residuals
-	for (uint16_t k = 0; k < _samples_collected; k++) {
-		float A = (fit1_params[3]    * (x[k] - fit1_params[0])) + (fit1_params[6] * (y[k] - fit1_params[1])) + (fit1_params[7] *
-				(z[k] - fit1_params[2]));
-		float B = (fit1_params[6] * (x[k] - fit1_params[0])) + (fit1_params[4]   * (y[k] - fit1_params[1])) + (fit1_params[8] *
-				(z[k] - fit1_params[2]));
-		float C = (fit1_params[7] * (x[k] - fit1_params[0])) + (fit1_params[8] * (y[k] - fit1_params[1])) + (fit1_params[5]    *
-				(z[k] - fit1_params[2]));
-		float length = sqrtf(A * A + B * B + C * C);
-		residual = *sphere_radius - length;
-		fit1 += residual * residual;
-
-		A = (fit2_params[3]    * (x[k] - fit2_params[0])) + (fit2_params[6] * (y[k] - fit2_params[1])) + (fit2_params[7] *
-				(z[k] - fit2_params[2]));
-		B = (fit2_params[6] * (x[k] - fit2_params[0])) + (fit2_params[4]   * (y[k] - fit2_params[1])) + (fit2_params[8] *
-				(z[k] - fit2_params[2]));
-		C = (fit2_params[7] * (x[k] - fit2_params[0])) + (fit2_params[8] * (y[k] - fit2_params[1])) + (fit2_params[5]    *
-				(z[k] - fit2_params[2]));
-		length = sqrtf(A * A + B * B + C * C);
-		residual = *sphere_radius - length;
-		fit2 += residual * residual;
-	}
+	for (int iteration = 0; iteration < 20; iteration++) {
+		double Y_inv[3][3];
+		double Z_inv[3][3];
 
-	fit1 = sqrtf(fit1) / _samples_collected;
-	fit2 = sqrtf(fit2) / _samples_collected;
+		if (!inverse3x3(Y, Y_inv) || !inverse3x3(Z, Z_inv)) {
+			return false;
+		}
 
-	if (fit1 > _fitness && fit2 > _fitness) {
-		_sphere_lambda *= lma_damping;
+		double change = 0.0;
 
-	} else if (fit2 < _fitness && fit2 < fit1) {
-		_sphere_lambda /= lma_damping;
-		memcpy(fit1_params, fit2_params, sizeof(fit1_params));
-		fitness = fit2;
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				const double y_next = 0.5 * (Y[i][j] + Z_inv[i][j]);
+				change += fabs(y_next - Y[i][j]);
+				Y[i][j] = y_next;
+				Z[i][j] = 0.5 * (Z[i][j] + Y_inv[i][j]);
+			}
+		}
 
-	} else if (fit1 < _fitness) {
-		fitness = fit1;
+		if (change < 1e-12) {
+			break;
+		}
 	}
 
-	//--------------------Levenberg-Marquardt-part-ends-here--------------------------------//
-	if (PX4_ISFINITE(fitness) && fitness < _fitness) {
-		_fitness = fitness;
-		*offset_x = fit1_params[0];
-		*offset_y = fit1_params[1];
-		*offset_z = fit1_params[2];
-		*diag_x = fit1_params[3];
-		*diag_y = fit1_params[4];
-		*diag_z = fit1_params[5];
-		*offdiag_x = fit1_params[6];
-		*offdiag_y = fit1_params[7];
-		*offdiag_z = fit1_params[8];
-		return 0;
-
-	} else {
-		return -1;
-	}
+	*offset_x = static_cast<float>(center[0]);
+	*offset_y = static_cast<float>(center[1]);
+	*offset_z = static_cast<float>(center[2]);
+	*sphere_radius = static_cast<float>(radius);
+	*diag_x = static_cast<float>(Y[0][0]);
+	*diag_y = static_cast<float>(Y[1][1]);
+	*diag_z = static_cast<float>(Y[2][2]);
+	*offdiag_x = static_cast<float>(0.5 * (Y[0][1] + Y[1][0]));
+	*offdiag_y = static_cast<float>(0.5 * (Y[0][2] + Y[2][0]));
+	*offdiag_z = static_cast<float>(0.5 * (Y[1][2] + Y[2][1]));
+
+	// close to the surface the algebraic residual is ~2 * radius times the distance
+	*fitness = static_cast<float>(sqrt(fmax(ssr, 0.0) / _count) / (2.0 * radius));
+
+	return true;
 }
 
 enum detect_orientation_return detect_orientation(orb_advert_t *mavlink_log_pub, int cancel_sub, int accel_sub,
@@ -36,41 +36,55 @@
 
 #pragma once
 
+bool inverse4x4(float m[], float invOut[]);
+bool mat_inverse(float *A, float *inv, uint8_t n);
+
 /**
- * Least-squares fit of a sphere to a set of points.
- *
- * Fits a sphere to a set of points on the sphere surface.
+ * Streaming least-squares fit of an ellipsoid to a set of points.
  *
- * @param x point coordinates on the X axis
- * @param y point coordinates on the Y axis
- * @param z point coordinates on the Z axis
- * @param size number of points
- * @param max_iterations abort if maximum number of iterations have been reached. If unsure, set to 100.
- * @param delta abort if error is below delta. If unsure, set to 0 to run max_iterations times.
- * @param sphere_x coordinate of the sphere center on the X axis
- * @param sphere_y coordinate of the sphere center on the Y axis
- * @param sphere_z coordinate of the sphere center on the Z axis
- * @param sphere_radius sphere radius
- *
- * @return 0 on success, 1 on failure
+ * Only the normal equations of the linear (algebraic) ellipsoid fit are kept and updated for
+ * every sample, so the memory use does not depend on the number of samples and the fit can be
+ * solved at any time, e.g. to report the fit quality while samples are still being collected.
  */
-int sphere_fit_least_squares(const float x[], const float y[], const float z[],
-			     unsigned int size, unsigned int max_iterations, float delta, float *sphere_x, float *sphere_y, float *sphere_z,
-			     float *sphere_radius);
-int ellipsoid_fit_least_squares(const float x[], const float y[], const float z[],
-				unsigned int size, int max_iterations, float delta, float *offset_x, float *offset_y, float *offset_z,
-				float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y,
-				float *offdiag_z);
-int run_lm_sphere_fit(const float x[], const float y[], const float z[], float &_fitness, float &_sphere_lambda,
-		      unsigned int size, float *offset_x, float *offset_y, float *offset_z,
-		      float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y,
-		      float *offdiag_z);
-int run_lm_ellipsoid_fit(const float x[], const float y[], const float z[], float &_fitness, float &_sphere_lambda,
-			 unsigned int size, float *offset_x, float *offset_y, float *offset_z,
-			 float *sphere_radius, float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y,
-			 float *offdiag_z);
-bool inverse4x4(float m[], float invOut[]);
-bool mat_inverse(float *A, float *inv, uint8_t n);
+class EllipsoidFitAccumulator
+{
+public:
+	EllipsoidFitAccumulator() { reset(); }
+
+	void reset();
+
+	/**
+	 * Add a point (close to) the ellipsoid surface.
+	 */
+	void add_sample(float x, float y, float z);
+
+	unsigned sample_count() const { return _count; }
+
+	/**
+	 * Solve for the ellipsoid of the samples added so far.
+	 *
+	 * The symmetric matrix built from diag and offdiag maps the points minus the offset onto a sphere
+	 * of sphere_radius, it is normalized to unit determinant.
+	 *
+	 * @param fitness RMS distance of the points from the fitted ellipsoid (approximation, same unit as the points)
+	 *
+	 * @return true on success, false if the samples do not (yet) determine an ellipsoid
+	 */
+	bool solve(float *offset_x, float *offset_y, float *offset_z, float *sphere_radius,
+		   float *diag_x, float *diag_y, float *diag_z, float *offdiag_x, float *offdiag_y, float *offdiag_z,
+		   float *fitness) const;
+
+private:
+	static constexpr int N = 9; ///< number of free parameters of the ellipsoid
+
+	/// index of element (i, j), j <= i, of a packed lower triangular matrix
+	static constexpr int tri(int i, int j) { return i * (i + 1) / 2 + j; }
+
+	double _DTD[N * (N + 1) / 2];	///< normal matrix, packed lower triangle
+	double _DTd[N];		///< right hand side
+	double _dTd;		///< sum of the squared right hand side, for the residual
+	unsigned _count;
+};
 
 // FIXME: Change the name
 static const unsigned max_accel_sens = 3;
@@ -61,6 +61,7 @@
 #include <parameters/param.h>
 #include <systemlib/err.h>
 #include <uORB/topics/sensor_combined.h>
+#include <mathlib/mathlib.h>
 
 static const char *sensor_name = "mag";
 static constexpr unsigned max_mags = 4;
@@ -68,6 +69,7 @@ static constexpr float mag_sphere_radius = 0.2f;
 static unsigned int calibration_sides = 6;			///< The total number of sides
 static constexpr unsigned int calibration_total_points = 240;		///< The total points per magnetometer
 static constexpr unsigned int calibraton_duration_seconds = 42; 	///< The total duration the routine is allowed to take
+static constexpr unsigned int reject_history_len = 16;		///< Number of recent samples a new sample is checked against
 
 static constexpr float MAG_MAX_OFFSET_LEN =
 	1.3f;	///< The maximum measurement range is ~1.9 Ga, the earth field is ~0.6 Ga, so an offset larger than ~1.3 Ga means the mag will saturate in some directions.
@@ -80,6 +82,12 @@ static unsigned _last_mag_progress = 0;
 
 calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub);
 
+/// Calibration state of a single mag, only allocated for the available mags
+typedef struct {
+	EllipsoidFitAccumulator	fit;
+	float			recent_samples[reject_history_len][3];	///< Most recent accepted samples
+} mag_cal_state_t;
+
 /// Data passed to calibration worker routine
 typedef struct  {
 	orb_advert_t	*mavlink_log_pub;
@@ -90,9 +98,7 @@ typedef struct  {
 	uint64_t	calibration_interval_perside_useconds;
 	unsigned int	calibration_counter_total[max_mags];
 	bool		side_data_collected[detect_orientation_side_count];
-	float		*x[max_mags];
-	float		*y[max_mags];
-	float		*z[max_mags];
+	mag_cal_state_t	*state[max_mags];
 } mag_worker_data_t;
 
 
@@ -267,15 +273,18 @@ int do_mag_calibration(orb_advert_t *mavlink_log_pub)
 	return result;
 }
 
-static bool reject_sample(float sx, float sy, float sz, float x[], float y[], float z[], unsigned count,
+static bool reject_sample(float sx, float sy, float sz, const float recent[reject_history_len][3], unsigned count,
 			  unsigned max_count)
 {
 	float min_sample_dist = fabsf(5.4f * mag_sphere_radius / sqrtf(max_count)) / 3.0f;
 
-	for (size_t i = 0; i < count; i++) {
-		float dx = sx - x[i];
-		float dy = sy - y[i];
-		float dz = sz - z[i];
+	// only the most recent samples are kept, which covers the samples of the current rotation
+	const unsigned recent_count = math::min(count, reject_history_len);
+
+	for (size_t i = 0; i < recent_count; i++) {
+		float dx = sx - recent[i][0];
+		float dy = sy - recent[i][1];
+		float dz = sz - recent[i][2];
 		float dist = sqrtf(dx * dx + dy * dy + dz * dz);
 
 		if (dist < min_sample_dist) {
@@ -453,39 +462,37 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 
 		if (poll_ret > 0) {
 
-			int prev_count[max_mags];
+			struct mag_report mag[max_mags];
 			bool rejected = false;
 
 			for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
 
-				prev_count[cur_mag] = worker_data->calibration_counter_total[cur_mag];
-
 				if (worker_data->sub_mag[cur_mag] >= 0) {
-					struct mag_report mag;
-
-					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag);
+					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag[cur_mag]);
 
 					// Check if this measurement is good to go in
-					rejected = rejected || reject_sample(mag.x, mag.y, mag.z,
-									     worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
+					rejected = rejected || reject_sample(mag[cur_mag].x, mag[cur_mag].y, mag[cur_mag].z,
+									     worker_data->state[cur_mag]->recent_samples,
 									     worker_data->calibration_counter_total[cur_mag],
 									     calibration_sides * worker_data->calibration_points_perside);
-
-					worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.x;
-					worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.y;
-					worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.z;
-					worker_data->calibration_counter_total[cur_mag]++;
 				}
 			}
 
-			// Keep calibration of all mags in lockstep
-			if (rejected) {
-				// Reset counts, since one of the mags rejected the measurement
+			// Keep calibration of all mags in lockstep, only add the measurement if no mag rejected it
+			if (!rejected) {
 				for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-					worker_data->calibration_counter_total[cur_mag] = prev_count[cur_mag];
+					if (worker_data->sub_mag[cur_mag] >= 0) {
+						float *recent = worker_data->state[cur_mag]->recent_samples[worker_data->calibration_counter_total[cur_mag] %
+								reject_history_len];
+						recent[0] = mag[cur_mag].x;
+						recent[1] = mag[cur_mag].y;
+						recent[2] = mag[cur_mag].z;
+
+						worker_data->state[cur_mag]->fit.add_sample(mag[cur_mag].x, mag[cur_mag].y, mag[cur_mag].z);
+						worker_data->calibration_counter_total[cur_mag]++;
+					}
 				}
 
-			} else {
 				calibration_counter_side++;
 
 				unsigned new_progress = progress_percentage(worker_data) +
@@ -521,6 +528,20 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 		worker_data->done_count++;
 		px4_usleep(20000);
 		calibration_log_info(worker_data->mavlink_log_pub, CAL_QGC_PROGRESS_MSG, progress_percentage(worker_data));
+
+		// Report the fit quality so far, the fit only needs the accumulated statistics
+		for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
+			float offset[3], radius, diag[3], offdiag[3], fitness;
+
+			if (worker_data->sub_mag[cur_mag] >= 0 &&
+			    worker_data->state[cur_mag]->fit.solve(&offset[0], &offset[1], &offset[2], &radius,
+					    &diag[0], &diag[1], &diag[2], &offdiag[0], &offdiag[1], &offdiag[2], &fitness)) {
+
+				PX4_INFO("mag #%u: %u samples, off: x:%.2f y:%.2f z:%.2f Ga, fit error: %.4f Ga", (unsigned)cur_mag,
+					 worker_data->state[cur_mag]->fit.sample_count(), (double)offset[0], (double)offset[1], (double)offset[2],
+					 (double)fitness);
+			}
+		}
 	}
 
 	return result;
@@ -568,14 +589,10 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 		worker_data.sub_mag[cur_mag] = -1;
 
 		// Initialize to no memory allocated
-		worker_data.x[cur_mag] = nullptr;
-		worker_data.y[cur_mag] = nullptr;
-		worker_data.z[cur_mag] = nullptr;
+		worker_data.state[cur_mag] = nullptr;
 		worker_data.calibration_counter_total[cur_mag] = 0;
 	}
 
-	const unsigned int calibration_points_maxcount = calibration_sides * worker_data.calibration_points_perside;
-
 	char str[30];
 
 	// Get actual mag count and alloate only as much memory as needed
@@ -587,11 +604,9 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 	}
 
 	for (size_t cur_mag = 0; cur_mag < orb_mag_count && cur_mag < max_mags; cur_mag++) {
-		worker_data.x[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.y[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
-		worker_data.z[cur_mag] = reinterpret_cast<float *>(malloc(sizeof(float) * calibration_points_maxcount));
+		worker_data.state[cur_mag] = new mag_cal_state_t;
 
-		if (worker_data.x[cur_mag] == nullptr || worker_data.y[cur_mag] == nullptr || worker_data.z[cur_mag] == nullptr) {
+		if (worker_data.state[cur_mag] == nullptr) {
 			calibration_log_critical(mavlink_log_pub, "ERROR: out of memory");
 			result = calibrate_return_error;
 		}
@@ -720,19 +735,21 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 		offdiag_z[cur_mag] = 0.0f;
 	}
 
-	// Sphere fit the data to get calibration values
+	// Ellipsoid fit the accumulated data to get calibration values
 	if (result == calibrate_return_ok) {
 		for (unsigned cur_mag = 0; cur_mag < max_mags; cur_mag++) {
 			if (device_ids[cur_mag] != 0) {
 				// Mag in this slot is available and we should have values for it to calibrate
-
-				ellipsoid_fit_least_squares(worker_data.x[cur_mag], worker_data.y[cur_mag], worker_data.z[cur_mag],
-							    worker_data.calibration_counter_total[cur_mag],
-							    100, 0.0f,
-							    &sphere_x[cur_mag], &sphere_y[cur_mag], &sphere_z[cur_mag],
-							    &sphere_radius[cur_mag],
-							    &diag_x[cur_mag], &diag_y[cur_mag], &diag_z[cur_mag],
-							    &offdiag_x[cur_mag], &offdiag_y[cur_mag], &offdiag_z[cur_mag]);
+				float fitness = 0.0f;
+
+				if (worker_data.state[cur_mag] == nullptr ||
+				    !worker_data.state[cur_mag]->fit.solve(&sphere_x[cur_mag], &sphere_y[cur_mag], &sphere_z[cur_mag],
+						    &sphere_radius[cur_mag],
+						    &diag_x[cur_mag], &diag_y[cur_mag], &diag_z[cur_mag],
+						    &offdiag_x[cur_mag], &offdiag_y[cur_mag], &offdiag_z[cur_mag], &fitness)) {
+					// leave it to check_calibration_result() to report the failure
+					sphere_x[cur_mag] = NAN;
+				}
 
 				result = check_calibration_result(sphere_x[cur_mag], sphere_y[cur_mag], sphere_z[cur_mag],
 								  sphere_radius[cur_mag],
@@ -743,60 +760,15 @@ calibrate_return mag_calibrate_all(orb_advert_t *mavlink_log_pub)
 				if (result == calibrate_return_error) {
 					break;
 				}
+
+				PX4_INFO("mag #%u fit error: %.4f Ga", cur_mag, (double)fitness);
 			}
 		}
 	}
 
-	// Print uncalibrated data points
-	if (result == calibrate_return_ok) {
-
-		// DO NOT REMOVE! Critical validation data!
-
-		// printf("RAW DATA:\n--------------------\n");
-		// for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-
-		// 	if (worker_data.calibration_counter_total[cur_mag] == 0) {
-		// 		continue;
-		// 	}
-
-		// 	printf("RAW: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-		// 	for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-		// 		float x = worker_data.x[cur_mag][i];
-		// 		float y = worker_data.y[cur_mag][i];
-		// 		float z = worker_data.z[cur_mag][i];
-		// 		printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-		// 	}
-
-		// 	printf(">>>>>>>\n");
-		// }
-
-		// printf("CALIBRATED DATA:\n--------------------\n");
-		// for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-
-		// 	if (worker_data.calibration_counter_total[cur_mag] == 0) {
-		// 		continue;
-		// 	}
-
-		// 	printf("Calibrated: MAG %u with %u samples:\n", (unsigned)cur_mag, (unsigned)worker_data.calibration_counter_total[cur_mag]);
-
-		// 	for (size_t i = 0; i < worker_data.calibration_counter_total[cur_mag]; i++) {
-		// 		float x = worker_data.x[cur_mag][i] - sphere_x[cur_mag];
-		// 		float y = worker_data.y[cur_mag][i] - sphere_y[cur_mag];
-		// 		float z = worker_data.z[cur_mag][i] - sphere_z[cur_mag];
-		// 		printf("%8.4f, %8.4f, %8.4f\n", (double)x, (double)y, (double)z);
-		// 	}
-
-		// 	printf("SPHERE RADIUS: %8.4f\n", (double)sphere_radius[cur_mag]);
-		// 	printf(">>>>>>>\n");
-		// }
-	}
-
-	// Data points are no longer needed
+	// Fit data is no longer needed
 	for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-		free(worker_data.x[cur_mag]);
-		free(worker_data.y[cur_mag]);
-		free(worker_data.z[cur_mag]);
+		delete worker_data.state[cur_mag];
 	}
 
 	if (result == calibrate_return_ok) {
@@ -76,15 +76,22 @@ __END_DECLS
 static ssize_t _file_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
 			   size_t count);
 static ssize_t _file_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static ssize_t _file_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence,
+				 const void *buf, size_t item_len);
+static ssize_t _file_read_range(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len);
 static int  _file_clear(dm_item_t item);
 static int  _file_restart(dm_reset_reason reason);
 static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
+static int _file_wait(px4_sem_t *sem);
 
 /* Private Ram based Operations */
 static ssize_t _ram_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
 			  size_t count);
 static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static ssize_t _ram_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence,
+				const void *buf, size_t item_len);
+static ssize_t _ram_read_range(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len);
 static int  _ram_clear(dm_item_t item);
 static int  _ram_restart(dm_reset_reason reason);
 static int _ram_initialize(unsigned max_offset);
@@ -97,6 +104,8 @@ static void _ram_shutdown();
 static ssize_t _ram_flash_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
 				size_t count);
 static ssize_t _ram_flash_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static ssize_t _ram_flash_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence,
+				      const void *buf, size_t item_len);
 static int  _ram_flash_clear(dm_item_t item);
 static int  _ram_flash_restart(dm_reset_reason reason);
 static int _ram_flash_initialize(unsigned max_offset);
@@ -107,6 +116,9 @@ static int _ram_flash_wait(px4_sem_t *sem);
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
+	ssize_t (*write_range)(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence, const void *buf,
+			       size_t item_len);
+	ssize_t (*read_range)(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len);
 	int (*clear)(dm_item_t item);
 	int (*restart)(dm_reset_reason reason);
 	int (*initialize)(unsigned max_offset);
@@ -117,16 +129,20 @@ typedef struct dm_operations_t {
 static constexpr dm_operations_t dm_file_operations = {
 	.write   = _file_write,
 	.read    = _file_read,
+	.write_range = _file_write_range,
+	.read_range = _file_read_range,
 	.clear   = _file_clear,
 	.restart = _file_restart,
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
-	.wait = px4_sem_wait,
+	.wait = _file_wait,
 };
 
 static constexpr dm_operations_t dm_ram_operations = {
 	.write   = _ram_write,
 	.read    = _ram_read,
+	.write_range = _ram_write_range,
+	.read_range = _ram_read_range,
 	.clear   = _ram_clear,
 	.restart = _ram_restart,
 	.initialize = _ram_initialize,
@@ -138,6 +154,8 @@ static constexpr dm_operations_t dm_ram_operations = {
 static constexpr dm_operations_t dm_ram_flash_operations = {
 	.write   = _ram_flash_write,
 	.read    = _ram_flash_read,
+	.write_range = _ram_flash_write_range,
+	.read_range = _ram_read_range,
 	.clear   = _ram_flash_clear,
 	.restart = _ram_flash_restart,
 	.initialize = _ram_flash_initialize,
@@ -171,10 +189,11 @@ static struct {
 
 /** Types of function calls supported by the worker task */
 typedef enum {
-	dm_write_func = 0,
-	dm_read_func,
+	dm_read_func = 0,
 	dm_clear_func,
 	dm_restart_func,
+	dm_write_range_func,
+	dm_read_range_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -185,20 +204,30 @@ typedef struct {
 	unsigned char first;
 	unsigned char func;
 	ssize_t result;
+	dm_callback_t callback;	/**< asynchronous request: called by the worker task instead of posting wait_sem */
+	void *callback_arg;
 	union {
 		struct {
 			dm_item_t item;
 			unsigned index;
+			void *buf;
+			size_t count;
+		} read_params;
+		struct {
+			dm_item_t item;
+			unsigned index;
+			unsigned count;
 			dm_persitence_t persistence;
 			const void *buf;
-			size_t count;
-		} write_params;
+			size_t item_len;
+		} write_range_params;
 		struct {
 			dm_item_t item;
 			unsigned index;
+			unsigned count;
 			void *buf;
-			size_t count;
-		} read_params;
+			size_t item_len;
+		} read_range_params;
 		struct {
 			dm_item_t item;
 		} clear_params;
@@ -245,6 +274,56 @@ static px4_sem_t *g_item_locks[DM_KEY_NUM_KEYS];
 static px4_sem_t g_sys_state_mutex_mission;
 static px4_sem_t g_sys_state_mutex_fence;
 
+/* Number of items transferred per file access in range operations */
+static constexpr unsigned k_range_chunk_items = 16;
+
+/*
+ * File backend page cache
+ *
+ * Recently used records of the file backend are kept in RAM pages. A page holds consecutive records of one item type
+ * in their on-disk format, including the length and persistence header. Reads of cached records are served in the
+ * context of the caller without going through the worker task. Writes of DM_PERSIST_VOLATILE records only update
+ * the page: they are written back by the worker task with one sequential write per page within
+ * DM_CACHE_FLUSH_VOLATILE_USEC. Records which need to survive a reset are written by the worker task, which writes
+ * back the dirty pages and syncs the file before the write is confirmed, as without cache. Pages are written back or
+ * dropped before a restart or clear is applied to the file, so the persistence of the items is handled exactly as
+ * without cache.
+ */
+#if defined(MEMORY_CONSTRAINED_SYSTEM)
+static constexpr unsigned k_cache_page_size = 512;
+static constexpr unsigned k_cache_num_pages = 4;
+#elif defined(__PX4_NUTTX)
+static constexpr unsigned k_cache_page_size = 1024;
+static constexpr unsigned k_cache_num_pages = 8;
+#else
+static constexpr unsigned k_cache_page_size = 4096;
+static constexpr unsigned k_cache_num_pages = 32;
+#endif
+
+#define DM_CACHE_FLUSH_VOLATILE_USEC	(1000 * 1000)	/* write back delay of DM_PERSIST_VOLATILE items */
+
+typedef struct {
+	uint8_t *data;		/**< records in file format, k_cache_page_size bytes */
+	dm_item_t item;		/**< item type of the records */
+	unsigned first_index;	/**< index of the first record */
+	unsigned count;		/**< number of records, 0 if the page is unused */
+	unsigned dirty_first;	/**< first record which needs to be written back */
+	unsigned dirty_end;	/**< one past the last record which needs to be written back, 0 if the page is clean */
+	unsigned last_used;	/**< value of the use counter at the last access */
+} dm_cache_page_t;
+
+static struct {
+	dm_cache_page_t pages[k_cache_num_pages];
+	px4_sem_t mutex;		/**< protects the cache, taken by the callers and the worker task, never destroyed */
+	bool mutex_initialized;
+	hrt_abstime flush_deadline;	/**< time when dirty records need to be written back, 0 if all pages are clean */
+	unsigned use_counter;
+	unsigned hits;
+	unsigned misses;
+	unsigned flushes;
+	bool enabled;
+} g_file_cache;
+
 /* The data manager store file handle and file name */
 static const char *default_device_path = PX4_STORAGEDIR "/dataman";
 static char *k_data_manager_device_path = nullptr;
@@ -345,6 +424,9 @@ create_work_item()
 
 	/* If we got one then lock the item*/
 	if (item) {
+		item->callback = nullptr;
+		item->callback_arg = nullptr;
+
 		px4_sem_init(&item->wait_sem, 1, 0);        /* Caller will wait on this... initially locked */
 
 		/* item->wait_sem use case is a signal */
@@ -390,8 +472,8 @@ dequeue_work_item()
 	return work;
 }
 
-static int
-enqueue_work_item_and_wait_for_result(work_q_item_t *item)
+static void
+enqueue_work_item(work_q_item_t *item)
 {
 	/* put the work item at the end of the work queue */
 	lock_queue(&g_work_q);
@@ -406,6 +488,12 @@ enqueue_work_item_and_wait_for_result(work_q_item_t *item)
 
 	/* tell the work thread that work is available */
 	px4_sem_post(&g_work_queued_sema);
+}
+
+static int
+enqueue_work_item_and_wait_for_result(work_q_item_t *item)
+{
+	enqueue_work_item(item);
 
 	/* wait for the result */
 	px4_sem_wait(&item->wait_sem);
@@ -452,6 +540,349 @@ calculate_offset(dm_item_t item, unsigned index)
  * The total size must not exceed g_per_item_max_index[item]
  */
 
+/** Find the cache page holding a record. Must be called with g_file_cache.mutex held. */
+static dm_cache_page_t *
+_file_cache_find(dm_item_t item, unsigned index)
+{
+	for (unsigned i = 0; i < k_cache_num_pages; i++) {
+		dm_cache_page_t *page = &g_file_cache.pages[i];
+
+		if (page->count > 0 && page->item == item && index >= page->first_index
+		    && index < page->first_index + page->count) {
+			page->last_used = ++g_file_cache.use_counter;
+			return page;
+		}
+	}
+
+	return nullptr;
+}
+
+/** Write the dirty records of a page to the file. Worker task only, g_file_cache.mutex held. */
+static int
+_file_cache_write_back(dm_cache_page_t *page)
+{
+	if (page->dirty_end == 0) {
+		return 0;
+	}
+
+	const size_t item_size = g_per_item_size[page->item];
+	const int offset = calculate_offset(page->item, page->first_index + page->dirty_first);
+	const ssize_t len = (page->dirty_end - page->dirty_first) * item_size;
+
+	if (offset < 0 || lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+		return -1;
+	}
+
+	if (write(dm_operations_data.file.fd, &page->data[page->dirty_first * item_size], len) != len) {
+		return -1;
+	}
+
+	page->dirty_first = 0;
+	page->dirty_end = 0;
+	return 0;
+}
+
+/** Write all dirty records to physical media. Worker task only, g_file_cache.mutex held. */
+static int
+_file_cache_flush()
+{
+	int result = 0;
+	bool written = false;
+
+	for (unsigned i = 0; i < k_cache_num_pages; i++) {
+		if (g_file_cache.pages[i].dirty_end > 0) {
+			written = true;
+
+			if (_file_cache_write_back(&g_file_cache.pages[i]) < 0) {
+				result = -1;
+			}
+		}
+	}
+
+	if (written) {
+		fsync(dm_operations_data.file.fd);
+		g_file_cache.flushes++;
+	}
+
+	if (result < 0) {
+		PX4_WARN("Error writing back data manager cache");
+	}
+
+	/* reset the deadline even in error cases to avoid looping forever, the pages stay dirty for the next attempt */
+	g_file_cache.flush_deadline = 0;
+	return result;
+}
+
+/** Drop the cache pages of an item type (or all pages for DM_KEY_NUM_KEYS), discarding dirty records */
+static void
+_file_cache_drop(dm_item_t item)
+{
+	for (unsigned i = 0; i < k_cache_num_pages; i++) {
+		dm_cache_page_t *page = &g_file_cache.pages[i];
+
+		if (item == DM_KEY_NUM_KEYS || page->item == item) {
+			page->count = 0;
+			page->dirty_first = 0;
+			page->dirty_end = 0;
+		}
+	}
+}
+
+/**
+ * Get the cache page holding a record, reading it from the file into the least recently used page if necessary.
+ * Worker task only, g_file_cache.mutex held.
+ */
+static dm_cache_page_t *
+_file_cache_get(dm_item_t item, unsigned index)
+{
+	dm_cache_page_t *page = _file_cache_find(item, index);
+
+	if (page != nullptr) {
+		return page;
+	}
+
+	const size_t item_size = g_per_item_size[item];
+	const unsigned records_per_page = k_cache_page_size / item_size;
+
+	if (records_per_page == 0 || calculate_offset(item, index) < 0) {
+		return nullptr;
+	}
+
+	page = &g_file_cache.pages[0];
+
+	for (unsigned i = 0; i < k_cache_num_pages; i++) {
+		if (g_file_cache.pages[i].count == 0) {
+			page = &g_file_cache.pages[i];
+			break;
+		}
+
+		if (g_file_cache.pages[i].last_used < page->last_used) {
+			page = &g_file_cache.pages[i];
+		}
+	}
+
+	if (page->dirty_end > 0) {
+		if (_file_cache_write_back(page) < 0) {
+			return nullptr;
+		}
+
+		fsync(dm_operations_data.file.fd);
+	}
+
+	page->count = 0;
+
+	const unsigned first_index = index - (index % records_per_page);
+	unsigned count = g_per_item_max_index[item] - first_index;
+
+	if (count > records_per_page) {
+		count = records_per_page;
+	}
+
+	const int offset = calculate_offset(item, first_index);
+	const ssize_t len = count * item_size;
+
+	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+		return nullptr;
+	}
+
+	const ssize_t ret = read(dm_operations_data.file.fd, page->data, len);
+
+	if (ret < 0) {
+		return nullptr;
+	}
+
+	/* the file is not written beyond the last stored record, the remaining records are empty */
+	memset(&page->data[ret], 0, len - ret);
+
+	page->item = item;
+	page->first_index = first_index;
+	page->count = count;
+	page->last_used = ++g_file_cache.use_counter;
+	return page;
+}
+
+/** Copy a record out of a cache page, same semantics as _file_read */
+static ssize_t
+_file_cache_read_record(const dm_cache_page_t *page, unsigned index, void *buf, size_t count)
+{
+	const uint8_t *record = &page->data[(index - page->first_index) * g_per_item_size[page->item]];
+
+	/* See if we got data */
+	if (record[0] > 0) {
+		/* We got more than requested!!! */
+		if (record[0] > count) {
+			return -1;
+		}
+
+		memcpy(buf, record + DM_SECTOR_HDR_SIZE, record[0]);
+	}
+
+	return record[0];
+}
+
+/** Store a record in a cache page and schedule its write back. Must be called with g_file_cache.mutex held. */
+static ssize_t
+_file_cache_write_record(dm_cache_page_t *page, unsigned index, dm_persitence_t persistence, const void *buf,
+			 size_t count)
+{
+	const unsigned i = index - page->first_index;
+	uint8_t *record = &page->data[i * g_per_item_size[page->item]];
+
+	/* Write out the data, prefixed with length and persistence level */
+	record[0] = count;
+	record[1] = persistence;
+	record[2] = 0;
+	record[3] = 0;
+
+	if (count > 0) {
+		memcpy(record + DM_SECTOR_HDR_SIZE, buf, count);
+	}
+
+	if (page->dirty_end == 0) {
+		page->dirty_first = i;
+		page->dirty_end = i + 1;
+
+	} else {
+		page->dirty_first = (i < page->dirty_first) ? i : page->dirty_first;
+		page->dirty_end = (i + 1 > page->dirty_end) ? i + 1 : page->dirty_end;
+	}
+
+	/* records which survive a reset are written back by the caller right away */
+	const hrt_abstime deadline = hrt_absolute_time() + DM_CACHE_FLUSH_VOLATILE_USEC;
+
+	if (g_file_cache.flush_deadline == 0 || deadline < g_file_cache.flush_deadline) {
+		g_file_cache.flush_deadline = deadline;
+	}
+
+	return count;
+}
+
+/**
+ * Try to read a record from the file cache in the context of the caller.
+ * @return true if the record is cached, the result of the read is then stored in result
+ */
+static bool
+_file_cache_try_read(dm_item_t item, unsigned index, void *buf, size_t count, ssize_t *result)
+{
+	if (!g_file_cache.enabled || item >= DM_KEY_NUM_KEYS || count > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+		return false;
+	}
+
+	px4_sem_wait(&g_file_cache.mutex);
+
+	/* the cache might have been shut down while waiting for the lock */
+	dm_cache_page_t *page = g_file_cache.enabled ? _file_cache_find(item, index) : nullptr;
+
+	if (page != nullptr) {
+		*result = _file_cache_read_record(page, index, buf, count);
+		g_file_cache.hits++;
+
+	} else {
+		g_file_cache.misses++;
+	}
+
+	px4_sem_post(&g_file_cache.mutex);
+
+	return page != nullptr;
+}
+
+/**
+ * Try to read consecutive records from the file cache in the context of the caller.
+ * @return true if all records up to the end of the range (or the first record of a different size) are cached,
+ * the result of the range read is then stored in result
+ */
+static bool
+_file_cache_try_read_range(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len,
+			   ssize_t *result)
+{
+	if (!g_file_cache.enabled || item >= DM_KEY_NUM_KEYS || count == 0
+	    || item_len > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+		return false;
+	}
+
+	uint8_t *dst = (uint8_t *)buf;
+	unsigned i;
+
+	px4_sem_wait(&g_file_cache.mutex);
+
+	/* the cache might have been shut down while waiting for the lock */
+	bool cached = g_file_cache.enabled;
+
+	for (i = 0; i < count && cached; i++) {
+		dm_cache_page_t *page = _file_cache_find(item, index + i);
+
+		if (page == nullptr) {
+			cached = false;
+			break;
+		}
+
+		if (_file_cache_read_record(page, index + i, dst + i * item_len, item_len) != (ssize_t)item_len) {
+			break;
+		}
+	}
+
+	if (cached) {
+		*result = i;
+		g_file_cache.hits++;
+
+	} else {
+		g_file_cache.misses++;
+	}
+
+	px4_sem_post(&g_file_cache.mutex);
+
+	return cached;
+}
+
+/**
+ * Try to write consecutive records to the file cache in the context of the caller.
+ * @return true if all records are cached, the result of the range write is then stored in result
+ */
+static bool
+_file_cache_try_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence,
+			    const void *buf, size_t item_len, ssize_t *result)
+{
+	/* records which survive a reset must be on the media when the write returns, the worker task does that */
+	if (!g_file_cache.enabled || persistence != DM_PERSIST_VOLATILE || item >= DM_KEY_NUM_KEYS || count == 0
+	    || item_len > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+		return false;
+	}
+
+	const uint8_t *src = (const uint8_t *)buf;
+
+	px4_sem_wait(&g_file_cache.mutex);
+
+	/* the cache might have been shut down while waiting for the lock */
+	bool cached = g_file_cache.enabled;
+
+	const hrt_abstime previous_deadline = g_file_cache.flush_deadline;
+
+	/* either all or none of the records are written here, so that a range write is never split */
+	for (unsigned i = 0; i < count && cached; i++) {
+		cached = _file_cache_find(item, index + i) != nullptr;
+	}
+
+	if (cached) {
+		for (unsigned i = 0; i < count; i++) {
+			_file_cache_write_record(_file_cache_find(item, index + i), index + i, persistence, src + i * item_len,
+						 item_len);
+		}
+
+		*result = count;
+	}
+
+	const bool wakeup = g_file_cache.flush_deadline != previous_deadline;
+
+	px4_sem_post(&g_file_cache.mutex);
+
+	if (wakeup) {
+		/* let the worker task schedule the write back */
+		px4_sem_post(&g_work_queued_sema);
+	}
+
+	return cached;
+}
+
 /* write to the data manager RAM buffer  */
 static ssize_t _ram_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
 			  size_t count)
@@ -509,6 +940,26 @@ _file_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const v
 		return -E2BIG;
 	}
 
+	if (g_file_cache.enabled) {
+		px4_sem_wait(&g_file_cache.mutex);
+		dm_cache_page_t *page = _file_cache_get(item, index);
+		ssize_t ret = -1;
+
+		if (page != nullptr) {
+			ret = _file_cache_write_record(page, index, persistence, buf, count);
+
+			if (persistence != DM_PERSIST_VOLATILE && _file_cache_flush() < 0) {
+				ret = -1;
+			}
+		}
+
+		px4_sem_post(&g_file_cache.mutex);
+
+		if (page != nullptr) {
+			return ret;
+		}
+	}
+
 	/* Write out the data, prefixed with length and persistence level */
 	buffer[0] = count;
 	buffer[1] = persistence;
@@ -572,95 +1023,375 @@ static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count
 	}
 
 	/* Make sure the caller hasn't asked for more data than we can handle */
-	if (count > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+	if (count > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+		return -E2BIG;
+	}
+
+	/* Read the prefix and data */
+
+	uint8_t *buffer = &dm_operations_data.ram.data[offset];
+
+	if (buffer > dm_operations_data.ram.data_end) {
+		return -1;
+	}
+
+	/* See if we got data */
+	if (buffer[0] > 0) {
+		/* We got more than requested!!! */
+		if (buffer[0] > count) {
+			return -1;
+		}
+
+		/* Looks good, copy it to the caller's buffer */
+		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+	}
+
+	/* Return the number of bytes of caller data read */
+	return buffer[0];
+}
+
+/* Retrieve from the data manager file */
+static ssize_t
+_file_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	if (item >= DM_KEY_NUM_KEYS) {
+		return -1;
+	}
+
+	unsigned char buffer[g_per_item_size[item]];
+
+	/* Get the offset for this item */
+	int offset = calculate_offset(item, index);
+
+	/* If item type or index out of range, return error */
+	if (offset < 0) {
+		return -1;
+	}
+
+	/* Make sure the caller hasn't asked for more data than we can handle */
+	if (count > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
+		return -E2BIG;
+	}
+
+	if (g_file_cache.enabled) {
+		px4_sem_wait(&g_file_cache.mutex);
+		dm_cache_page_t *page = _file_cache_get(item, index);
+		ssize_t ret = -1;
+
+		if (page != nullptr) {
+			ret = _file_cache_read_record(page, index, buf, count);
+		}
+
+		px4_sem_post(&g_file_cache.mutex);
+
+		if (page != nullptr) {
+			return ret;
+		}
+	}
+
+	/* Read the prefix and data */
+	int len = -1;
+
+	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) == offset) {
+		len = read(dm_operations_data.file.fd, buffer, count + DM_SECTOR_HDR_SIZE);
+	}
+
+	/* Check for read error */
+	if (len < 0) {
+		return -errno;
+	}
+
+	/* A zero length entry is a empty entry */
+	if (len == 0) {
+		buffer[0] = 0;
+	}
+
+	/* See if we got data */
+	if (buffer[0] > 0) {
+		/* We got more than requested!!! */
+		if (buffer[0] > count) {
+			return -1;
+		}
+
+		/* Looks good, copy it to the caller's buffer */
+		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+	}
+
+	/* Return the number of bytes of caller data read */
+	return buffer[0];
+}
+
+#if defined(FLASH_BASED_DATAMAN)
+static ssize_t
+_ram_flash_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	return dm_ram_operations.read(item, index, buf, count);
+}
+#endif
+
+/* Range operations
+ *
+ * Items are passed as a contiguous array of item_len sized elements. A write returns the number of items written,
+ * a read returns the number of consecutive items which contain exactly item_len bytes of data (reading stops at the
+ * first empty item or item of different size).
+ */
+
+/* write consecutive items to the data manager RAM buffer */
+static ssize_t
+_ram_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence, const void *buf,
+		 size_t item_len)
+{
+	const uint8_t *src = (const uint8_t *)buf;
+
+	for (unsigned i = 0; i < count; i++) {
+		ssize_t ret = _ram_write(item, index + i, persistence, src + i * item_len, item_len);
+
+		if (ret != (ssize_t)item_len) {
+			return ret < 0 ? ret : -1;
+		}
+	}
+
+	return count;
+}
+
+/* retrieve consecutive items from the data manager RAM buffer */
+static ssize_t
+_ram_read_range(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len)
+{
+	uint8_t *dst = (uint8_t *)buf;
+	unsigned i;
+
+	for (i = 0; i < count; i++) {
+		ssize_t ret = _ram_read(item, index + i, dst + i * item_len, item_len);
+
+		if (ret < 0) {
+			return (i > 0) ? (ssize_t)i : ret;
+		}
+
+		if (ret != (ssize_t)item_len) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+#if defined(FLASH_BASED_DATAMAN)
+static ssize_t
+_ram_flash_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence,
+		       const void *buf, size_t item_len)
+{
+	ssize_t ret = _ram_write_range(item, index, count, persistence, buf, item_len);
+
+	if (ret < 1) {
+		return ret;
+	}
+
+	if (persistence == DM_PERSIST_POWER_ON_RESET) {
+		_ram_flash_update_flush_timeout();
+	}
+
+	return ret;
+}
+#endif
+
+/* write consecutive items to the data manager file, using one seek and large sequential writes */
+static ssize_t
+_file_write_range(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence, const void *buf,
+		  size_t item_len)
+{
+	if (item >= DM_KEY_NUM_KEYS) {
+		return -1;
+	}
+
+	const size_t item_size = g_per_item_size[item];
+
+	/* Make sure caller has not given us more data than we can handle */
+	if (item_len > (item_size - DM_SECTOR_HDR_SIZE)) {
+		return -E2BIG;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	/* Get the offset for the first item and make sure the last one is in range too */
+	const int offset = calculate_offset(item, index);
+
+	if (offset < 0 || calculate_offset(item, index + count - 1) < 0) {
+		return -1;
+	}
+
+	if (g_file_cache.enabled) {
+		/* store the records in the cache, they are written back page by page */
+		const uint8_t *src = (const uint8_t *)buf;
+		ssize_t result = count;
+
+		px4_sem_wait(&g_file_cache.mutex);
+
+		for (unsigned i = 0; i < count; i++) {
+			dm_cache_page_t *page = _file_cache_get(item, index + i);
+
+			if (page == nullptr) {
+				result = -1;
+				break;
+			}
+
+			_file_cache_write_record(page, index + i, persistence, src + i * item_len, item_len);
+		}
+
+		/* records which survive a reset are on the media before the write is confirmed */
+		if (result >= 0 && persistence != DM_PERSIST_VOLATILE && _file_cache_flush() < 0) {
+			result = -1;
+		}
+
+		px4_sem_post(&g_file_cache.mutex);
+
+		return result;
+	}
+
+	/* the task stack is small, so use the heap for the records */
+	uint8_t *buffer = (uint8_t *)malloc(k_range_chunk_items * item_size);
+
+	if (buffer == nullptr) {
+		return -1;
+	}
+
+	ssize_t result = count;
+
+	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+		result = -1;
+	}
+
+	const uint8_t *src = (const uint8_t *)buf;
+
+	for (unsigned written = 0; result >= 0 && written < count;) {
+		const unsigned chunk = (count - written < k_range_chunk_items) ? count - written : k_range_chunk_items;
+
+		for (unsigned i = 0; i < chunk; i++) {
+			/* Write out the data, prefixed with length and persistence level */
+			uint8_t *record = &buffer[i * item_size];
+			record[0] = item_len;
+			record[1] = persistence;
+			record[2] = 0;
+			record[3] = 0;
+			memcpy(record + DM_SECTOR_HDR_SIZE, src + (written + i) * item_len, item_len);
+			memset(record + DM_SECTOR_HDR_SIZE + item_len, 0, item_size - DM_SECTOR_HDR_SIZE - item_len);
+		}
+
+		const ssize_t len = chunk * item_size;
+
+		if (write(dm_operations_data.file.fd, buffer, len) != len) {
+			result = -1;
+		}
+
+		written += chunk;
+	}
+
+	free(buffer);
+
+	/* Make sure data is written to physical media */
+	fsync(dm_operations_data.file.fd);
+
+	return result;
+}
+
+/* retrieve consecutive items from the data manager file, using one seek and large sequential reads */
+static ssize_t
+_file_read_range(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len)
+{
+	if (item >= DM_KEY_NUM_KEYS) {
+		return -1;
+	}
+
+	const size_t item_size = g_per_item_size[item];
+
+	/* Make sure the caller hasn't asked for more data than we can handle */
+	if (item_len > (item_size - DM_SECTOR_HDR_SIZE)) {
 		return -E2BIG;
 	}
 
-	/* Read the prefix and data */
+	if (count == 0) {
+		return 0;
+	}
 
-	uint8_t *buffer = &dm_operations_data.ram.data[offset];
+	const int offset = calculate_offset(item, index);
 
-	if (buffer > dm_operations_data.ram.data_end) {
+	if (offset < 0 || calculate_offset(item, index + count - 1) < 0) {
 		return -1;
 	}
 
-	/* See if we got data */
-	if (buffer[0] > 0) {
-		/* We got more than requested!!! */
-		if (buffer[0] > count) {
-			return -1;
-		}
+	if (g_file_cache.enabled) {
+		uint8_t *dst = (uint8_t *)buf;
+		ssize_t result = count;
 
-		/* Looks good, copy it to the caller's buffer */
-		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
-	}
+		px4_sem_wait(&g_file_cache.mutex);
 
-	/* Return the number of bytes of caller data read */
-	return buffer[0];
-}
+		for (unsigned i = 0; i < count; i++) {
+			dm_cache_page_t *page = _file_cache_get(item, index + i);
 
-/* Retrieve from the data manager file */
-static ssize_t
-_file_read(dm_item_t item, unsigned index, void *buf, size_t count)
-{
-	if (item >= DM_KEY_NUM_KEYS) {
-		return -1;
-	}
+			if (page == nullptr) {
+				result = (i > 0) ? (ssize_t)i : -1;
+				break;
+			}
 
-	unsigned char buffer[g_per_item_size[item]];
+			if (_file_cache_read_record(page, index + i, dst + i * item_len, item_len) != (ssize_t)item_len) {
+				result = i;
+				break;
+			}
+		}
 
-	/* Get the offset for this item */
-	int offset = calculate_offset(item, index);
+		px4_sem_post(&g_file_cache.mutex);
 
-	/* If item type or index out of range, return error */
-	if (offset < 0) {
-		return -1;
+		return result;
 	}
 
-	/* Make sure the caller hasn't asked for more data than we can handle */
-	if (count > (g_per_item_size[item] - DM_SECTOR_HDR_SIZE)) {
-		return -E2BIG;
+	uint8_t *buffer = (uint8_t *)malloc(k_range_chunk_items * item_size);
+
+	if (buffer == nullptr) {
+		return -1;
 	}
 
-	/* Read the prefix and data */
-	int len = -1;
+	ssize_t result = 0;
 
-	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) == offset) {
-		len = read(dm_operations_data.file.fd, buffer, count + DM_SECTOR_HDR_SIZE);
+	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+		result = -1;
 	}
 
-	/* Check for read error */
-	if (len < 0) {
-		return -errno;
-	}
+	uint8_t *dst = (uint8_t *)buf;
+	bool done = false;
 
-	/* A zero length entry is a empty entry */
-	if (len == 0) {
-		buffer[0] = 0;
-	}
+	while (result >= 0 && !done && (unsigned)result < count) {
+		const unsigned remaining = count - (unsigned)result;
+		const unsigned chunk = (remaining < k_range_chunk_items) ? remaining : k_range_chunk_items;
+		const ssize_t len = read(dm_operations_data.file.fd, buffer, chunk * item_size);
 
-	/* See if we got data */
-	if (buffer[0] > 0) {
-		/* We got more than requested!!! */
-		if (buffer[0] > count) {
-			return -1;
+		if (len < 0) {
+			result = (result > 0) ? result : -errno;
+			break;
 		}
 
-		/* Looks good, copy it to the caller's buffer */
-		memcpy(buf, buffer + DM_SECTOR_HDR_SIZE, buffer[0]);
+		/* a short read means we hit the end of the file: the remaining items are empty */
+		const unsigned records = len / item_size;
+		done = records < chunk;
+
+		for (unsigned i = 0; i < records; i++) {
+			const uint8_t *record = &buffer[i * item_size];
+
+			if (record[0] != item_len) {
+				done = true;
+				break;
+			}
+
+			memcpy(dst + result * item_len, record + DM_SECTOR_HDR_SIZE, item_len);
+			result++;
+		}
 	}
 
-	/* Return the number of bytes of caller data read */
-	return buffer[0];
-}
+	free(buffer);
 
-#if defined(FLASH_BASED_DATAMAN)
-static ssize_t
-_ram_flash_read(dm_item_t item, unsigned index, void *buf, size_t count)
-{
-	return dm_ram_operations.read(item, index, buf, count);
+	return result;
 }
-#endif
 
 static int  _ram_clear(dm_item_t item)
 {
@@ -704,6 +1435,13 @@ _file_clear(dm_item_t item)
 		return -1;
 	}
 
+	if (g_file_cache.enabled) {
+		/* the cached records are cleared anyway, there is no need to write them back */
+		px4_sem_wait(&g_file_cache.mutex);
+		_file_cache_drop(item);
+		px4_sem_post(&g_file_cache.mutex);
+	}
+
 	/* Clear all items of this type */
 	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++) {
 		char buf[1];
@@ -801,6 +1539,15 @@ _file_restart(dm_reset_reason reason)
 {
 	int offset = 0;
 	int result = 0;
+
+	if (g_file_cache.enabled) {
+		/* the file needs to contain all records with their persistence before it is scanned */
+		px4_sem_wait(&g_file_cache.mutex);
+		result = _file_cache_flush();
+		_file_cache_drop(DM_KEY_NUM_KEYS);
+		px4_sem_post(&g_file_cache.mutex);
+	}
+
 	/* We need to scan the entire file and invalidate and data that should not persist after the last reset */
 
 	/* Loop through all of the data segments and delete those that are not persistent */
@@ -928,6 +1675,50 @@ _file_initialize(unsigned max_offset)
 	}
 
 	fsync(dm_operations_data.file.fd);
+
+	/*
+	 * Set up the page cache, without it all records are accessed directly in the file.
+	 * The lock is created once and kept across restarts of the task, as callers may still be about to take it
+	 * after a shutdown.
+	 */
+	if (!g_file_cache.mutex_initialized) {
+		px4_sem_init(&g_file_cache.mutex, 1, 1); /* Initially unlocked */
+		g_file_cache.mutex_initialized = true;
+	}
+
+	px4_sem_wait(&g_file_cache.mutex);
+
+	g_file_cache.enabled = true;
+
+	for (unsigned i = 0; i < k_cache_num_pages; i++) {
+		g_file_cache.pages[i].data = (uint8_t *)malloc(k_cache_page_size);
+		g_file_cache.pages[i].count = 0;
+		g_file_cache.pages[i].dirty_first = 0;
+		g_file_cache.pages[i].dirty_end = 0;
+		g_file_cache.pages[i].last_used = 0;
+
+		if (g_file_cache.pages[i].data == nullptr) {
+			g_file_cache.enabled = false;
+		}
+	}
+
+	if (!g_file_cache.enabled) {
+		PX4_WARN("Could not allocate data manager cache");
+
+		for (unsigned i = 0; i < k_cache_num_pages; i++) {
+			free(g_file_cache.pages[i].data);
+			g_file_cache.pages[i].data = nullptr;
+		}
+	}
+
+	g_file_cache.flush_deadline = 0;
+	g_file_cache.use_counter = 0;
+	g_file_cache.hits = 0;
+	g_file_cache.misses = 0;
+	g_file_cache.flushes = 0;
+
+	px4_sem_post(&g_file_cache.mutex);
+
 	dm_operations_data.running = true;
 
 	return 0;
@@ -993,6 +1784,20 @@ _ram_flash_initialize(unsigned max_offset)
 static void
 _file_shutdown()
 {
+	/* callers test the enabled flag again once they hold the lock, so the pages can be freed here */
+	if (g_file_cache.enabled) {
+		px4_sem_wait(&g_file_cache.mutex);
+		_file_cache_flush();
+		g_file_cache.enabled = false;
+
+		for (unsigned i = 0; i < k_cache_num_pages; i++) {
+			free(g_file_cache.pages[i].data);
+			g_file_cache.pages[i].data = nullptr;
+		}
+
+		px4_sem_post(&g_file_cache.mutex);
+	}
+
 	close(dm_operations_data.file.fd);
 	dm_operations_data.running = false;
 }
@@ -1004,6 +1809,55 @@ _ram_shutdown()
 	dm_operations_data.running = false;
 }
 
+/* wait for work, writing back the file cache when its deadline is reached */
+static int
+_file_wait(px4_sem_t *sem)
+{
+	hrt_abstime deadline = 0;
+
+	if (g_file_cache.enabled) {
+		px4_sem_wait(&g_file_cache.mutex);
+		deadline = g_file_cache.flush_deadline;
+		px4_sem_post(&g_file_cache.mutex);
+	}
+
+	if (deadline == 0) {
+		px4_sem_wait(sem);
+		return 0;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (now < deadline) {
+		/* sem_timedwait() expects an absolute time of the clock it is based on */
+		struct timespec abstime;
+#if defined(__PX4_NUTTX)
+		px4_clock_gettime(CLOCK_REALTIME, &abstime);
+#else
+		px4_clock_gettime(CLOCK_MONOTONIC, &abstime);
+#endif
+		const unsigned billion = (1000 * 1000 * 1000);
+		const uint64_t nsecs = abstime.tv_nsec + (deadline - now) * 1000;
+		abstime.tv_sec += nsecs / billion;
+		abstime.tv_nsec = nsecs % billion;
+
+		if (px4_sem_timedwait(sem, &abstime) == 0) {
+			/* work was queued before the deadline */
+			return 0;
+		}
+	}
+
+	px4_sem_wait(&g_file_cache.mutex);
+
+	if (g_file_cache.flush_deadline != 0 && hrt_absolute_time() >= g_file_cache.flush_deadline) {
+		_file_cache_flush();
+	}
+
+	px4_sem_post(&g_file_cache.mutex);
+
+	return 0;
+}
+
 #if defined(FLASH_BASED_DATAMAN)
 static void
 _ram_flash_flush()
@@ -1074,57 +1928,185 @@ _ram_flash_wait(px4_sem_t *sem)
 }
 #endif
 
-/** Write to the data manager file */
-__EXPORT ssize_t
-dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+/**
+ * Queue a request for the worker task. Without callback, wait for the result and return it. With callback, return 0
+ * once the request is queued, the result is then passed to the callback.
+ */
+static ssize_t
+_dm_submit(work_q_item_t *work, dm_callback_t callback, void *arg)
+{
+	if (callback == nullptr) {
+		/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+		return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	}
+
+	work->callback = callback;
+	work->callback_arg = arg;
+	enqueue_work_item(work);
+	return 0;
+}
+
+/** Queue a read request for the worker task */
+static ssize_t
+_dm_read_queued(dm_item_t item, unsigned index, void *buf, size_t count)
 {
 	work_q_item_t *work;
 
-	/* Make sure data manager has been started and is not shutting down */
-	if (!is_running() || g_task_should_exit) {
+	/* get a work item and queue up a read request */
+	if ((work = create_work_item()) == nullptr) {
 		return -1;
 	}
 
-	/* get a work item and queue up a write request */
+	work->func = dm_read_func;
+	work->read_params.item = item;
+	work->read_params.index = index;
+	work->read_params.buf = buf;
+	work->read_params.count = count;
+
+	return _dm_submit(work, nullptr, nullptr);
+}
+
+/** Queue a range write request for the worker task */
+static ssize_t
+_dm_write_range_queued(dm_item_t item, unsigned index, unsigned count, dm_persitence_t persistence, const void *buf,
+		       size_t item_len, dm_callback_t callback, void *arg)
+{
+	work_q_item_t *work;
+
 	if ((work = create_work_item()) == nullptr) {
 		return -1;
 	}
 
-	work->func = dm_write_func;
-	work->write_params.item = item;
-	work->write_params.index = index;
-	work->write_params.persistence = persistence;
-	work->write_params.buf = buf;
-	work->write_params.count = count;
+	work->func = dm_write_range_func;
+	work->write_range_params.item = item;
+	work->write_range_params.index = index;
+	work->write_range_params.count = count;
+	work->write_range_params.persistence = persistence;
+	work->write_range_params.buf = buf;
+	work->write_range_params.item_len = item_len;
 
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	return _dm_submit(work, callback, arg);
 }
 
-/** Retrieve from the data manager file */
-__EXPORT ssize_t
-dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
+/** Queue a range read request for the worker task */
+static ssize_t
+_dm_read_range_queued(dm_item_t item, unsigned index, unsigned count, void *buf, size_t item_len,
+		      dm_callback_t callback, void *arg)
 {
 	work_q_item_t *work;
 
+	if ((work = create_work_item()) == nullptr) {
+		return -1;
+	}
+
+	work->func = dm_read_range_func;
+	work->read_range_params.item = item;
+	work->read_range_params.index = index;
+	work->read_range_params.count = count;
+	work->read_range_params.buf = buf;
+	work->read_range_params.item_len = item_len;
+
+	return _dm_submit(work, callback, arg);
+}
+
+/** Write consecutive items to the data manager file */
+__EXPORT ssize_t
+dm_write_range(dm_item_t item, unsigned first_index, unsigned count, dm_persitence_t persistence, const void *buf,
+	       size_t item_len)
+{
 	/* Make sure data manager has been started and is not shutting down */
 	if (!is_running() || g_task_should_exit) {
 		return -1;
 	}
 
-	/* get a work item and queue up a read request */
-	if ((work = create_work_item()) == nullptr) {
+	ssize_t ret;
+
+	if (_file_cache_try_write_range(item, first_index, count, persistence, buf, item_len, &ret)) {
+		return ret;
+	}
+
+	return _dm_write_range_queued(item, first_index, count, persistence, buf, item_len, nullptr, nullptr);
+}
+
+/** Write consecutive items to the data manager file without waiting for completion */
+__EXPORT int
+dm_write_range_async(dm_item_t item, unsigned first_index, unsigned count, dm_persitence_t persistence,
+		     const void *buf, size_t item_len, dm_callback_t callback, void *arg)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit || callback == nullptr) {
 		return -1;
 	}
 
-	work->func = dm_read_func;
-	work->read_params.item = item;
-	work->read_params.index = index;
-	work->read_params.buf = buf;
-	work->read_params.count = count;
+	return _dm_write_range_queued(item, first_index, count, persistence, buf, item_len, callback, arg);
+}
 
-	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
-	return (ssize_t)enqueue_work_item_and_wait_for_result(work);
+/** Retrieve consecutive items from the data manager file */
+__EXPORT ssize_t
+dm_read_range(dm_item_t item, unsigned first_index, unsigned count, void *buf, size_t item_len)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	ssize_t ret;
+
+	if (_file_cache_try_read_range(item, first_index, count, buf, item_len, &ret)) {
+		return ret;
+	}
+
+	return _dm_read_range_queued(item, first_index, count, buf, item_len, nullptr, nullptr);
+}
+
+/** Retrieve consecutive items from the data manager file without waiting for completion */
+__EXPORT int
+dm_read_range_async(dm_item_t item, unsigned first_index, unsigned count, void *buf, size_t item_len,
+		    dm_callback_t callback, void *arg)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit || callback == nullptr) {
+		return -1;
+	}
+
+	return _dm_read_range_queued(item, first_index, count, buf, item_len, callback, arg);
+}
+
+/** Write to the data manager file */
+__EXPORT ssize_t
+dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	/* a single item is a range of one item of count bytes */
+	ssize_t ret = dm_write_range(item, index, 1, persistence, buf, count);
+
+	if (ret == 1) {
+		return count;
+	}
+
+	return (ret < 0) ? ret : -1;
+}
+
+/** Retrieve from the data manager file */
+__EXPORT ssize_t
+dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	ssize_t ret;
+
+	if (_file_cache_try_read(item, index, buf, count, &ret)) {
+		return ret;
+	}
+
+	return _dm_read_queued(item, index, buf, count);
 }
 
 /** Clear a data Item */
@@ -1373,14 +2355,6 @@ task_main(int argc, char *argv[])
 
 			/* handle each work item with the appropriate handler */
 			switch (work->func) {
-			case dm_write_func:
-				g_func_counts[dm_write_func]++;
-				work->result =
-					g_dm_ops->write(work->write_params.item, work->write_params.index, work->write_params.persistence,
-							work->write_params.buf,
-							work->write_params.count);
-				break;
-
 			case dm_read_func:
 				g_func_counts[dm_read_func]++;
 				work->result =
@@ -1397,13 +2371,35 @@ task_main(int argc, char *argv[])
 				work->result = g_dm_ops->restart(work->restart_params.reason);
 				break;
 
+			case dm_write_range_func:
+				g_func_counts[dm_write_range_func]++;
+				work->result =
+					g_dm_ops->write_range(work->write_range_params.item, work->write_range_params.index,
+							      work->write_range_params.count, work->write_range_params.persistence,
+							      work->write_range_params.buf, work->write_range_params.item_len);
+				break;
+
+			case dm_read_range_func:
+				g_func_counts[dm_read_range_func]++;
+				work->result =
+					g_dm_ops->read_range(work->read_range_params.item, work->read_range_params.index,
+							     work->read_range_params.count, work->read_range_params.buf,
+							     work->read_range_params.item_len);
+				break;
+
 			default: /* should never happen */
 				work->result = -1;
 				break;
 			}
 
 			/* Inform the caller that work is done */
-			px4_sem_post(&work->wait_sem);
+			if (work->callback != nullptr) {
+				work->callback(work->result, work->callback_arg);
+				destroy_work_item(work);
+
+			} else {
+				px4_sem_post(&work->wait_sem);
+			}
 		}
 
 		/* time to go???? */
@@ -1465,10 +2461,16 @@ static void
 status()
 {
 	/* display usage statistics */
-	PX4_INFO("Writes   %d", g_func_counts[dm_write_func]);
-	PX4_INFO("Reads    %d", g_func_counts[dm_read_func]);
+	PX4_INFO("Writes   %d", g_func_counts[dm_write_range_func]);
+	PX4_INFO("Reads    %d, range reads %d", g_func_counts[dm_read_func], g_func_counts[dm_read_range_func]);
 	PX4_INFO("Clears   %d", g_func_counts[dm_clear_func]);
 	PX4_INFO("Restarts %d", g_func_counts[dm_restart_func]);
+
+	if (g_file_cache.enabled) {
+		PX4_INFO("Cache hits %d, misses %d, write backs %d", g_file_cache.hits, g_file_cache.misses,
+			 g_file_cache.flushes);
+	}
+
 	PX4_INFO("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
 }
 
@@ -1505,6 +2507,11 @@ which stores the number of items for these types. These items are always updated
 the mavlink mission manager). During that time, navigator will try to acquire the geofence item lock, fail, and will not
 check for geofence violations.
 
+The file backend keeps recently used items in a RAM page cache. Cached items are read directly by the calling task.
+Writes of volatile items are collected and written back to the file in sequential blocks within 1s. Items which
+survive a reset are written to the file before the write returns. Mission transfers write items in blocks via
+`dm_write_range`.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
@@ -125,6 +125,76 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/**
+ * Write consecutive items to the data manager store in one transaction.
+ * This is much faster than writing each item with dm_write, as only a single request is queued and the storage
+ * backend can write the items in large blocks.
+ * @return the number of items written, -1 on error
+ */
+__EXPORT ssize_t
+dm_write_range(
+	dm_item_t  item,		/* The item type to store */
+	unsigned first_index,		/* The index of the first item */
+	unsigned count,			/* The number of items to store */
+	dm_persitence_t persistence,	/* The persistence level of the items */
+	const void *buffer,		/* Pointer to caller data buffer, holding count items of item_len bytes */
+	size_t item_len			/* Length in bytes of a single item */
+);
+
+/**
+ * Retrieve consecutive items from the data manager store in one transaction.
+ * Reading stops at the first empty item or item with a length different from item_len.
+ * @return the number of items read, -1 on error
+ */
+__EXPORT ssize_t
+dm_read_range(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned first_index,		/* The index of the first item */
+	unsigned count,			/* The maximum number of items to retrieve */
+	void *buffer,			/* Pointer to caller data buffer, with space for count items of item_len bytes */
+	size_t item_len			/* Length in bytes of a single item */
+);
+
+/**
+ * Completion callback of asynchronous requests.
+ * It is called from the dataman task: it must return quickly and must not call the blocking dm_* functions.
+ */
+typedef void (*dm_callback_t)(
+	ssize_t result,			/* The result of the request, as returned by the blocking function */
+	void *arg			/* The argument passed with the request */
+);
+
+/**
+ * Queue a range read without waiting for it. The buffer must stay valid until the callback is called.
+ * @return 0 if the request is queued, -1 on error (the callback is not called then)
+ */
+__EXPORT int
+dm_read_range_async(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned first_index,		/* The index of the first item */
+	unsigned count,			/* The maximum number of items to retrieve */
+	void *buffer,			/* Pointer to caller data buffer, with space for count items of item_len bytes */
+	size_t item_len,		/* Length in bytes of a single item */
+	dm_callback_t callback,		/* Called with the result of dm_read_range */
+	void *arg			/* Argument passed to the callback */
+);
+
+/**
+ * Queue a range write without waiting for it. The buffer must stay valid until the callback is called.
+ * @return 0 if the request is queued, -1 on error (the callback is not called then)
+ */
+__EXPORT int
+dm_write_range_async(
+	dm_item_t  item,		/* The item type to store */
+	unsigned first_index,		/* The index of the first item */
+	unsigned count,			/* The number of items to store */
+	dm_persitence_t persistence,	/* The persistence level of the items */
+	const void *buffer,		/* Pointer to caller data buffer, holding count items of item_len bytes */
+	size_t item_len,		/* Length in bytes of a single item */
+	dm_callback_t callback,		/* Called with the result of dm_write_range */
+	void *arg			/* Argument passed to the callback */
+);
+
 /**
  * Lock all items of a type. Can be used for atomic updates of multiple items (single items are always updated
  * atomically).
@@ -0,0 +1,454 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "EKF2Instance.hpp"
+
+#include <float.h>
+
+#include <lib/ecl/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
+#include <px4_log.h>
+
+using namespace matrix;
+using namespace time_literals;
+
+EKF2Instance::EKF2Instance(uint8_t imu_instance, const px4::wq_config_t &config) :
+	ModuleParams(nullptr),
+	WorkItem(config),
+	_imu_instance(imu_instance),
+	_params(_ekf.getParamHandle()),
+	_sensor_gyro_sub(this, ORB_ID(sensor_gyro), imu_instance),
+	_sensor_accel_sub(ORB_ID(sensor_accel), imu_instance),
+	_cycle_perf(perf_alloc(PC_ELAPSED, "ekf2 instance: cycle time")),
+	_interval_perf(perf_alloc(PC_INTERVAL, "ekf2 instance: interval"))
+{
+	pthread_mutex_init(&_params_mutex, nullptr);
+
+	// reserve the output topic instances now, the selector needs to know them
+	const int att_instance = _attitude_pub.advertise();
+	const int lpos_instance = _local_position_pub.advertise();
+	const int gpos_instance = _global_position_pub.advertise();
+	const int status_instance = _status_pub.advertise();
+
+	if ((att_instance >= 0) && (att_instance == lpos_instance) && (att_instance == gpos_instance)
+	    && (att_instance == status_instance)) {
+
+		_output_instance = att_instance;
+
+	} else {
+		PX4_ERR("IMU %d: output topic instances mismatch", _imu_instance);
+	}
+}
+
+EKF2Instance::~EKF2Instance()
+{
+	Stop();
+
+	perf_free(_cycle_perf);
+	perf_free(_interval_perf);
+
+	pthread_mutex_destroy(&_params_mutex);
+}
+
+bool
+EKF2Instance::Start()
+{
+	if (_output_instance < 0) {
+		return false;
+	}
+
+	updateParams();
+	parameters_update();
+	sensor_corrections_update(true);
+
+	return _sensor_gyro_sub.register_callback();
+}
+
+void
+EKF2Instance::Stop()
+{
+	_sensor_gyro_sub.unregister_callback();
+
+	Deinit();
+}
+
+void
+EKF2Instance::set_parameters(const parameters &params, float gps_health_time_s)
+{
+	pthread_mutex_lock(&_params_mutex);
+	_params_pending = params;
+	_gps_health_time_pending = gps_health_time_s;
+	_params_pending_updated = true;
+	pthread_mutex_unlock(&_params_mutex);
+}
+
+void
+EKF2Instance::parameters_update()
+{
+	if (_params_pending_updated) {
+		pthread_mutex_lock(&_params_mutex);
+		*_params = _params_pending;
+		_ekf.set_min_required_gps_health_time(_gps_health_time_pending * 1_s);
+		_params_pending_updated = false;
+		pthread_mutex_unlock(&_params_mutex);
+	}
+
+	if (_params_sub.updated()) {
+		// clear update
+		parameter_update_s param_update;
+		_params_sub.copy(&param_update);
+
+		updateParams();
+	}
+
+	// get transformation matrix from sensor/board to body frame
+	const Dcmf board_rotation = get_rot_matrix((enum Rotation)_param_sens_board_rot.get());
+
+	// fine tune the rotation
+	const Dcmf board_rotation_offset(Eulerf(
+			math::radians(_param_sens_board_x_off.get()),
+			math::radians(_param_sens_board_y_off.get()),
+			math::radians(_param_sens_board_z_off.get())));
+
+	_board_rotation = board_rotation_offset * board_rotation;
+}
+
+void
+EKF2Instance::sensor_corrections_update(bool force)
+{
+	if (_sensor_correction_sub.updated() || force) {
+		sensor_correction_s corrections{};
+		_sensor_correction_sub.copy(&corrections);
+
+		// the thermal corrections are indexed by the uORB instance of the sensor
+		const float *accel_offsets[MAX_CORRECTIONS] {corrections.accel_offset_0, corrections.accel_offset_1, corrections.accel_offset_2};
+		const float *accel_scales[MAX_CORRECTIONS] {corrections.accel_scale_0, corrections.accel_scale_1, corrections.accel_scale_2};
+		const float *gyro_offsets[MAX_CORRECTIONS] {corrections.gyro_offset_0, corrections.gyro_offset_1, corrections.gyro_offset_2};
+		const float *gyro_scales[MAX_CORRECTIONS] {corrections.gyro_scale_0, corrections.gyro_scale_1, corrections.gyro_scale_2};
+
+		if ((_imu_instance < MAX_CORRECTIONS) && (corrections.timestamp != 0)) {
+			_accel_offset = Vector3f{accel_offsets[_imu_instance]};
+			_accel_scale = Vector3f{accel_scales[_imu_instance]};
+			_gyro_offset = Vector3f{gyro_offsets[_imu_instance]};
+			_gyro_scale = Vector3f{gyro_scales[_imu_instance]};
+
+		} else {
+			_accel_offset.zero();
+			_accel_scale = Vector3f{1.f, 1.f, 1.f};
+			_gyro_offset.zero();
+			_gyro_scale = Vector3f{1.f, 1.f, 1.f};
+		}
+	}
+}
+
+void
+EKF2Instance::Run()
+{
+	sensor_gyro_s gyro;
+
+	if (!_sensor_gyro_sub.update(&gyro)) {
+		return;
+	}
+
+	perf_begin(_cycle_perf);
+	perf_count(_interval_perf);
+
+	if (_params_pending_updated || _params_sub.updated()) {
+		parameters_update();
+	}
+
+	sensor_corrections_update();
+
+	// the driver publishes the accel of the same sample just before the gyro
+	_sensor_accel_sub.update(&_accel);
+
+	if ((gyro.integral_dt == 0) || (_accel.integral_dt == 0)) {
+		perf_end(_cycle_perf);
+		return;
+	}
+
+	// convert the integrals to rates for the thermal corrections, same as the sensors module
+	const float gyro_dt = gyro.integral_dt * 1.e-6f;
+	const float accel_dt = _accel.integral_dt * 1.e-6f;
+
+	const Vector3f gyro_rate{(Vector3f{gyro.x_integral, gyro.y_integral, gyro.z_integral} / gyro_dt - _gyro_offset).emult(_gyro_scale)};
+	const Vector3f accel{(Vector3f{_accel.x_integral, _accel.y_integral, _accel.z_integral} / accel_dt - _accel_offset).emult(_accel_scale)};
+
+	imuSample imu_sample_new;
+	imu_sample_new.time_us = gyro.timestamp;
+	imu_sample_new.delta_ang_dt = gyro_dt;
+	imu_sample_new.delta_ang = _board_rotation * gyro_rate * gyro_dt;
+	imu_sample_new.delta_vel_dt = accel_dt;
+	imu_sample_new.delta_vel = _board_rotation * accel * accel_dt;
+
+	_ekf.setIMUData(imu_sample_new);
+
+	publish_attitude(gyro.timestamp);
+
+	if (_status_sub.updated()) {
+		vehicle_status_s vehicle_status;
+
+		if (_status_sub.copy(&vehicle_status)) {
+			_ekf.set_is_fixed_wing(vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING);
+		}
+	}
+
+	if (_vehicle_land_detected_sub.updated()) {
+		vehicle_land_detected_s vehicle_land_detected;
+
+		if (_vehicle_land_detected_sub.copy(&vehicle_land_detected)) {
+			_ekf.set_in_air_status(!vehicle_land_detected.landed);
+		}
+	}
+
+	// the EKF downsamples the observations to its minimum observation interval
+	if (_magnetometer_sub.updated()) {
+		vehicle_magnetometer_s magnetometer;
+
+		if (_magnetometer_sub.copy(&magnetometer)) {
+			float mag_data_ga[3] = {magnetometer.magnetometer_ga[0] - _param_ekf2_magbias_x.get(),
+						magnetometer.magnetometer_ga[1] - _param_ekf2_magbias_y.get(),
+						magnetometer.magnetometer_ga[2] - _param_ekf2_magbias_z.get()
+					       };
+
+			_ekf.setMagData(magnetometer.timestamp, mag_data_ga);
+		}
+	}
+
+	if (_airdata_sub.updated()) {
+		vehicle_air_data_s airdata;
+
+		if (_airdata_sub.copy(&airdata)) {
+			_ekf.set_air_density(airdata.rho);
+			_ekf.setBaroData(airdata.timestamp, airdata.baro_alt_meter);
+		}
+	}
+
+	if (_gps_sub.updated()) {
+		vehicle_gps_position_s gps;
+
+		if (_gps_sub.copy(&gps)) {
+			gps_message gps_msg{};
+			gps_msg.time_usec = gps.timestamp;
+			gps_msg.lat = gps.lat;
+			gps_msg.lon = gps.lon;
+			gps_msg.alt = gps.alt;
+			gps_msg.yaw = gps.heading;
+			gps_msg.yaw_offset = gps.heading_offset;
+			gps_msg.fix_type = gps.fix_type;
+			gps_msg.eph = gps.eph;
+			gps_msg.epv = gps.epv;
+			gps_msg.sacc = gps.s_variance_m_s;
+			gps_msg.vel_m_s = gps.vel_m_s;
+			gps_msg.vel_ned[0] = gps.vel_n_m_s;
+			gps_msg.vel_ned[1] = gps.vel_e_m_s;
+			gps_msg.vel_ned[2] = gps.vel_d_m_s;
+			gps_msg.vel_ned_valid = gps.vel_ned_valid;
+			gps_msg.nsats = gps.satellites_used;
+			gps_msg.gdop = 0.0f;
+
+			_ekf.setGpsData(gps_msg.time_usec, gps_msg);
+		}
+	}
+
+	if (_ekf.update()) {
+		publish_position(gyro.timestamp);
+		publish_status(gyro.timestamp);
+	}
+
+	perf_end(_cycle_perf);
+}
+
+void
+EKF2Instance::publish_attitude(const hrt_abstime &timestamp)
+{
+	if (_ekf.attitude_valid()) {
+		vehicle_attitude_s att;
+		att.timestamp = timestamp;
+
+		const Quatf q{_ekf.calculate_quaternion()};
+		q.copyTo(att.q);
+
+		_ekf.get_quat_reset(&att.delta_q_reset[0], &att.quat_reset_counter);
+
+		_attitude_pub.publish(att);
+	}
+}
+
+void
+EKF2Instance::publish_position(const hrt_abstime &timestamp)
+{
+	filter_control_status_u control_status;
+	_ekf.get_control_mode(&control_status.value);
+
+	// only publish position after successful alignment
+	if (!control_status.flags.tilt_align) {
+		return;
+	}
+
+	vehicle_local_position_s &lpos = _local_position;
+	lpos.timestamp = timestamp;
+
+	float position[3];
+	_ekf.get_position(position);
+	lpos.x = (_ekf.local_position_is_valid()) ? position[0] : 0.0f;
+	lpos.y = (_ekf.local_position_is_valid()) ? position[1] : 0.0f;
+	lpos.z = position[2];
+
+	float velocity[3];
+	_ekf.get_velocity(velocity);
+	lpos.vx = velocity[0];
+	lpos.vy = velocity[1];
+	lpos.vz = velocity[2];
+
+	_ekf.get_pos_d_deriv(&lpos.z_deriv);
+
+	float vel_deriv[3];
+	_ekf.get_vel_deriv_ned(vel_deriv);
+	lpos.ax = vel_deriv[0];
+	lpos.ay = vel_deriv[1];
+	lpos.az = vel_deriv[2];
+
+	lpos.xy_valid = _ekf.local_position_is_valid();
+	lpos.z_valid = true;
+	lpos.v_xy_valid = _ekf.local_position_is_valid();
+	lpos.v_z_valid = true;
+
+	map_projection_reference_s ekf_origin;
+	uint64_t origin_time;
+
+	const bool ekf_origin_valid = _ekf.get_ekf_origin(&origin_time, &ekf_origin, &lpos.ref_alt);
+	lpos.xy_global = ekf_origin_valid;
+	lpos.z_global = ekf_origin_valid;
+
+	if (ekf_origin_valid && (origin_time > lpos.ref_timestamp)) {
+		lpos.ref_timestamp = origin_time;
+		lpos.ref_lat = ekf_origin.lat_rad * 180.0 / M_PI;
+		lpos.ref_lon = ekf_origin.lon_rad * 180.0 / M_PI;
+	}
+
+	const Quatf q{_ekf.calculate_quaternion()};
+	lpos.yaw = Eulerf(q).psi();
+
+	lpos.dist_bottom_valid = _ekf.get_terrain_valid();
+
+	float terrain_vpos;
+	_ekf.get_terrain_vert_pos(&terrain_vpos);
+	lpos.dist_bottom = math::max(terrain_vpos - lpos.z, _param_ekf2_min_rng.get());
+	lpos.dist_bottom_rate = -lpos.vz;
+
+	_ekf.get_ekf_lpos_accuracy(&lpos.eph, &lpos.epv);
+	_ekf.get_ekf_vel_accuracy(&lpos.evh, &lpos.evv);
+
+	_ekf.get_posD_reset(&lpos.delta_z, &lpos.z_reset_counter);
+	_ekf.get_velD_reset(&lpos.delta_vz, &lpos.vz_reset_counter);
+	_ekf.get_posNE_reset(&lpos.delta_xy[0], &lpos.xy_reset_counter);
+	_ekf.get_velNE_reset(&lpos.delta_vxy[0], &lpos.vxy_reset_counter);
+
+	_ekf.get_ekf_ctrl_limits(&lpos.vxy_max, &lpos.vz_max, &lpos.hagl_min, &lpos.hagl_max);
+
+	lpos.vxy_max = PX4_ISFINITE(lpos.vxy_max) ? lpos.vxy_max : INFINITY;
+	lpos.vz_max = PX4_ISFINITE(lpos.vz_max) ? lpos.vz_max : INFINITY;
+	lpos.hagl_min = PX4_ISFINITE(lpos.hagl_min) ? lpos.hagl_min : INFINITY;
+	lpos.hagl_max = PX4_ISFINITE(lpos.hagl_max) ? lpos.hagl_max : INFINITY;
+
+	_local_position_pub.publish(lpos);
+
+	if (_ekf.global_position_is_valid()) {
+		vehicle_global_position_s global_pos{};
+		global_pos.timestamp = timestamp;
+
+		map_projection_reproject(&ekf_origin, lpos.x, lpos.y, &global_pos.lat, &global_pos.lon);
+
+		global_pos.lat_lon_reset_counter = lpos.xy_reset_counter;
+
+		global_pos.alt = -lpos.z + lpos.ref_alt;
+		global_pos.alt_ellipsoid = global_pos.alt;
+		global_pos.delta_alt = -lpos.delta_z;
+		global_pos.alt_reset_counter = lpos.z_reset_counter;
+
+		global_pos.vel_n = lpos.vx;
+		global_pos.vel_e = lpos.vy;
+		global_pos.vel_d = lpos.vz;
+
+		global_pos.yaw = lpos.yaw;
+
+		_ekf.get_ekf_gpos_accuracy(&global_pos.eph, &global_pos.epv);
+
+		global_pos.terrain_alt_valid = lpos.dist_bottom_valid;
+		global_pos.terrain_alt = lpos.dist_bottom_valid ? (lpos.ref_alt - terrain_vpos) : 0.0f;
+
+		global_pos.dead_reckoning = _ekf.inertial_dead_reckoning();
+
+		_global_position_pub.publish(global_pos);
+	}
+}
+
+void
+EKF2Instance::publish_status(const hrt_abstime &timestamp)
+{
+	filter_control_status_u control_status;
+	_ekf.get_control_mode(&control_status.value);
+
+	estimator_status_s status{};
+	status.timestamp = timestamp;
+	_ekf.get_state_delayed(status.states);
+	status.n_states = 24;
+	_ekf.covariances_diagonal().copyTo(status.covariances);
+	_ekf.get_gps_check_status(&status.gps_check_fail_flags);
+	status.gps_check_fail_flags &= ((uint16_t)_params->gps_check_mask << 1) | 1;
+	status.control_mode_flags = control_status.value;
+	_ekf.get_filter_fault_status(&status.filter_fault_flags);
+	_ekf.get_innovation_test_status(&status.innovation_check_flags, &status.mag_test_ratio,
+					&status.vel_test_ratio, &status.pos_test_ratio,
+					&status.hgt_test_ratio, &status.tas_test_ratio,
+					&status.hagl_test_ratio, &status.beta_test_ratio);
+
+	status.pos_horiz_accuracy = _local_position.eph;
+	status.pos_vert_accuracy = _local_position.epv;
+	_ekf.get_ekf_soln_status(&status.solution_status_flags);
+	_ekf.get_imu_vibe_metrics(status.vibe);
+
+	_status_pub.publish(status);
+}
+
+void
+EKF2Instance::print_status()
+{
+	PX4_INFO("IMU %d (output instance %d): local position %s, global position %s", _imu_instance, _output_instance,
+		 _ekf.local_position_is_valid() ? "valid" : "invalid",
+		 _ekf.global_position_is_valid() ? "valid" : "invalid");
+
+	perf_print_counter(_cycle_perf);
+	perf_print_counter(_interval_perf);
+}
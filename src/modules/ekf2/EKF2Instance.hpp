@@ -0,0 +1,167 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file EKF2Instance.hpp
+ *
+ * Secondary ekf2 filter instance, bound to one IMU.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/conversion/rotation.h>
+#include <lib/ecl/EKF/ekf.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <lib/perf/perf_counter.h>
+#include <px4_module_params.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/PublicationMulti.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/estimator_status.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/sensor_accel.h>
+#include <uORB/topics/sensor_correction.h>
+#include <uORB/topics/sensor_gyro.h>
+#include <uORB/topics/vehicle_air_data.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/vehicle_land_detected.h>
+#include <uORB/topics/vehicle_local_position.h>
+#include <uORB/topics/vehicle_magnetometer.h>
+#include <uORB/topics/vehicle_status.h>
+
+#include <pthread.h>
+
+/**
+ * An ekf2 filter running on the raw data of one sensor_gyro/sensor_accel instance.
+ *
+ * Each instance runs on its own work queue, triggered by its gyro, and only shares the
+ * read-only uORB topics with the main filter. It fuses the (voted) magnetometer, the
+ * barometer and the first GPS receiver. The outputs are published on the multi-instance
+ * topics estimator_attitude, estimator_local_position, estimator_global_position and
+ * estimator_instance_status, all on the uORB instance returned by output_instance().
+ */
+class EKF2Instance final : public ModuleParams, public px4::WorkItem
+{
+public:
+	EKF2Instance(uint8_t imu_instance, const px4::wq_config_t &config);
+	~EKF2Instance() override;
+
+	bool Start();
+	void Stop();
+
+	void Run() override;
+
+	/**
+	 * Hand over the main filter parameters, they are applied on the next run of this instance.
+	 * Safe to call from the main filter task.
+	 */
+	void set_parameters(const parameters &params, float gps_health_time_s);
+
+	uint8_t imu_instance() const { return _imu_instance; }
+
+	/** uORB instance of the output topics, -1 if they could not be advertised */
+	int output_instance() const { return _output_instance; }
+
+	void print_status();
+
+private:
+
+	void parameters_update();
+	void sensor_corrections_update(bool force = false);
+
+	void publish_attitude(const hrt_abstime &timestamp);
+	void publish_position(const hrt_abstime &timestamp);
+	void publish_status(const hrt_abstime &timestamp);
+
+	static constexpr uint8_t MAX_CORRECTIONS = 3;	///< instances covered by sensor_correction
+
+	const uint8_t _imu_instance;
+	int _output_instance{-1};
+
+	Ekf _ekf;
+	parameters *_params;	///< pointer to ekf parameter struct (located in _ekf class instance)
+
+	// parameters handed over by the main filter
+	pthread_mutex_t _params_mutex;
+	parameters _params_pending{};
+	float _gps_health_time_pending{0.f};
+	volatile bool _params_pending_updated{false};
+
+	uORB::SubscriptionCallbackWorkItem _sensor_gyro_sub;
+	uORB::Subscription _sensor_accel_sub;
+
+	uORB::Subscription _airdata_sub{ORB_ID(vehicle_air_data)};
+	uORB::Subscription _gps_sub{ORB_ID(vehicle_gps_position)};
+	uORB::Subscription _magnetometer_sub{ORB_ID(vehicle_magnetometer)};
+	uORB::Subscription _params_sub{ORB_ID(parameter_update)};
+	uORB::Subscription _sensor_correction_sub{ORB_ID(sensor_correction)};
+	uORB::Subscription _status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription _vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
+
+	uORB::PublicationMulti<vehicle_attitude_s>		_attitude_pub{ORB_ID(estimator_attitude)};
+	uORB::PublicationMulti<vehicle_local_position_s>	_local_position_pub{ORB_ID(estimator_local_position)};
+	uORB::PublicationMulti<vehicle_global_position_s>	_global_position_pub{ORB_ID(estimator_global_position)};
+	uORB::PublicationMulti<estimator_status_s>		_status_pub{ORB_ID(estimator_instance_status)};
+
+	sensor_accel_s _accel{};		///< latest sample of the bound accelerometer
+
+	matrix::Dcmf _board_rotation;		///< rotation matrix for the orientation that the board is mounted
+
+	matrix::Vector3f _accel_offset{};	///< thermal corrections of the bound IMU
+	matrix::Vector3f _accel_scale{1.f, 1.f, 1.f};
+	matrix::Vector3f _gyro_offset{};
+	matrix::Vector3f _gyro_scale{1.f, 1.f, 1.f};
+
+	vehicle_local_position_s _local_position{};	///< last local position, keeps the origin and limits
+
+	perf_counter_t _cycle_perf;
+	perf_counter_t _interval_perf;
+
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::SENS_BOARD_ROT>) _param_sens_board_rot,
+
+		(ParamFloat<px4::params::SENS_BOARD_X_OFF>) _param_sens_board_x_off,
+		(ParamFloat<px4::params::SENS_BOARD_Y_OFF>) _param_sens_board_y_off,
+		(ParamFloat<px4::params::SENS_BOARD_Z_OFF>) _param_sens_board_z_off,
+
+		(ParamFloat<px4::params::EKF2_MAGBIAS_X>) _param_ekf2_magbias_x,
+		(ParamFloat<px4::params::EKF2_MAGBIAS_Y>) _param_ekf2_magbias_y,
+		(ParamFloat<px4::params::EKF2_MAGBIAS_Z>) _param_ekf2_magbias_z,
+
+		(ParamFloat<px4::params::EKF2_MIN_RNG>) _param_ekf2_min_rng
+	)
+};
@@ -0,0 +1,300 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "EKF2Selector.hpp"
+
+#include <float.h>
+
+#include <lib/mathlib/mathlib.h>
+#include <px4_log.h>
+
+using matrix::Quatf;
+using matrix::Vector3f;
+
+bool
+EKF2Selector::add_instance(uint8_t instance, int output_instance)
+{
+	if ((instance == 0) || (instance >= MAX_INSTANCES) || (output_instance < 0)
+	    || (output_instance >= MAX_INSTANCES - 1)) {
+
+		return false;
+	}
+
+	_output_instance[instance] = output_instance;
+	_instances_available++;
+
+	return true;
+}
+
+uint8_t
+EKF2Selector::reset_counter(ResetCounter &counter, uint8_t source_count, bool instance_changed)
+{
+	if (!counter.initialised) {
+		counter.published_count = source_count;
+		counter.initialised = true;
+
+	} else if (instance_changed || (source_count != counter.source_count)) {
+		counter.published_count++;
+	}
+
+	counter.source_count = source_count;
+
+	return counter.published_count;
+}
+
+void
+EKF2Selector::update_instance(uint8_t instance, const estimator_status_s &status)
+{
+	const float combined_test_ratio = math::max(math::max(status.vel_test_ratio, status.pos_test_ratio),
+					  math::max(status.hgt_test_ratio, status.mag_test_ratio));
+
+	const bool tilt_align = status.control_mode_flags & (1 << estimator_status_s::CS_TILT_ALIGN);
+
+	_status_timestamp[instance] = status.timestamp;
+	_combined_test_ratio[instance] = combined_test_ratio;
+	_relative_test_ratio[instance] += TEST_RATIO_FILTER_ALPHA * (combined_test_ratio - _relative_test_ratio[instance]);
+	_healthy[instance] = tilt_align && (status.filter_fault_flags == 0) && (combined_test_ratio < 1.f);
+}
+
+bool
+EKF2Selector::update(const estimator_status_s &main_status)
+{
+	// all instances are timestamped with their IMU samples, use the main one as time reference
+	const hrt_abstime now = main_status.timestamp;
+
+	update_instance(0, main_status);
+
+	for (uint8_t i = 1; i < MAX_INSTANCES; i++) {
+		const int output_instance = _output_instance[i];
+
+		if (output_instance < 0) {
+			continue;
+		}
+
+		estimator_status_s status;
+
+		if (_status_subs[output_instance].update(&status) && (status.timestamp != 0)) {
+			update_instance(i, status);
+		}
+
+		if (now > _status_timestamp[i] + STATUS_TIMEOUT) {
+			_healthy[i] = false;
+		}
+	}
+
+	// healthy instance with the lowest relative test ratio
+	int8_t best = -1;
+
+	for (uint8_t i = 0; i < MAX_INSTANCES; i++) {
+		if (((i == 0) || (_output_instance[i] >= 0)) && _healthy[i]) {
+			if ((best < 0) || (_relative_test_ratio[i] < _relative_test_ratio[best])) {
+				best = i;
+			}
+		}
+	}
+
+	uint8_t selected = _selected;
+
+	if (!_healthy[_selected]) {
+		// leave an unhealthy instance immediately
+		if (best >= 0) {
+			selected = best;
+		}
+
+	} else if (now > _last_instance_change + SWITCH_HOLD_TIME) {
+		if ((_selected != 0) && _healthy[0] && (_relative_test_ratio[0] <= _relative_test_ratio[_selected])) {
+			// go back to the main filter, it fuses all the sensors
+			selected = 0;
+
+		} else if ((best >= 0) && (_relative_test_ratio[best] < _relative_test_ratio[_selected] - SWITCH_RATIO_MARGIN)) {
+			selected = best;
+		}
+	}
+
+	const bool changed = (selected != _selected);
+
+	if (changed) {
+		PX4_WARN("primary estimator instance changed %d -> %d", _selected, selected);
+
+		_selected = selected;
+		_instance_changed_count++;
+		_last_instance_change = now;
+	}
+
+	// publish the selection at 10 Hz, and immediately on changes
+	if (changed || (now > _last_status_publish + 100000)) {
+		publish_status(now);
+	}
+
+	return changed;
+}
+
+bool
+EKF2Selector::copy_attitude(vehicle_attitude_s &att)
+{
+	const int output_instance = _output_instance[_selected];
+
+	if ((_selected != 0) && (output_instance >= 0)) {
+		if (_attitude_subs[output_instance].update(&att) && (att.timestamp != 0)) {
+			adjust_resets(att, _selected);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+EKF2Selector::copy_local_position(vehicle_local_position_s &lpos)
+{
+	const int output_instance = _output_instance[_selected];
+
+	if ((_selected != 0) && (output_instance >= 0)) {
+		if (_local_position_subs[output_instance].update(&lpos) && (lpos.timestamp != 0)) {
+			adjust_resets(lpos, _selected);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+EKF2Selector::copy_global_position(vehicle_global_position_s &gpos)
+{
+	const int output_instance = _output_instance[_selected];
+
+	if ((_selected != 0) && (output_instance >= 0)) {
+		if (_global_position_subs[output_instance].update(&gpos) && (gpos.timestamp != 0)) {
+			adjust_resets(gpos, _selected);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+EKF2Selector::adjust_resets(vehicle_attitude_s &att, uint8_t instance)
+{
+	const bool changed = _attitude_published && (instance != _attitude_instance);
+	const Quatf q{att.q};
+
+	if (changed) {
+		// report the instance change as a reset from the last published attitude
+		const Quatf delta_q{q * _attitude_q.inversed()};
+		delta_q.copyTo(att.delta_q_reset);
+	}
+
+	att.quat_reset_counter = reset_counter(_quat_reset, att.quat_reset_counter, changed);
+
+	_attitude_q = q;
+	_attitude_instance = instance;
+	_attitude_published = true;
+}
+
+void
+EKF2Selector::adjust_resets(vehicle_local_position_s &lpos, uint8_t instance)
+{
+	const bool changed = _local_position_published && (instance != _local_position_instance);
+
+	if (changed) {
+		// report the instance change as a reset from the last published position and velocity
+		lpos.delta_xy[0] = lpos.x - _local_position(0);
+		lpos.delta_xy[1] = lpos.y - _local_position(1);
+		lpos.delta_z = lpos.z - _local_position(2);
+		lpos.delta_vxy[0] = lpos.vx - _local_velocity(0);
+		lpos.delta_vxy[1] = lpos.vy - _local_velocity(1);
+		lpos.delta_vz = lpos.vz - _local_velocity(2);
+	}
+
+	lpos.xy_reset_counter = reset_counter(_xy_reset, lpos.xy_reset_counter, changed);
+	lpos.z_reset_counter = reset_counter(_z_reset, lpos.z_reset_counter, changed);
+	lpos.vxy_reset_counter = reset_counter(_vxy_reset, lpos.vxy_reset_counter, changed);
+	lpos.vz_reset_counter = reset_counter(_vz_reset, lpos.vz_reset_counter, changed);
+
+	_local_position = Vector3f{lpos.x, lpos.y, lpos.z};
+	_local_velocity = Vector3f{lpos.vx, lpos.vy, lpos.vz};
+	_local_position_instance = instance;
+	_local_position_published = true;
+}
+
+void
+EKF2Selector::adjust_resets(vehicle_global_position_s &gpos, uint8_t instance)
+{
+	const bool changed = _global_position_published && (instance != _global_position_instance);
+
+	if (changed) {
+		gpos.delta_alt = gpos.alt - _global_alt;
+	}
+
+	gpos.lat_lon_reset_counter = reset_counter(_lat_lon_reset, gpos.lat_lon_reset_counter, changed);
+	gpos.alt_reset_counter = reset_counter(_alt_reset, gpos.alt_reset_counter, changed);
+
+	_global_alt = gpos.alt;
+	_global_position_instance = instance;
+	_global_position_published = true;
+}
+
+void
+EKF2Selector::publish_status(hrt_abstime now)
+{
+	estimator_selector_status_s status{};
+	status.timestamp = now;
+	status.primary_instance = _selected;
+	status.instances_available = _instances_available;
+	status.instance_changed_count = _instance_changed_count;
+	status.last_instance_change = _last_instance_change;
+
+	for (uint8_t i = 0; i < MAX_INSTANCES; i++) {
+		status.combined_test_ratio[i] = _combined_test_ratio[i];
+		status.relative_test_ratio[i] = _relative_test_ratio[i];
+		status.healthy[i] = _healthy[i];
+	}
+
+	_selector_status_pub.publish(status);
+	_last_status_publish = now;
+}
+
+void
+EKF2Selector::print_status()
+{
+	PX4_INFO("primary instance: %d, changed %d times", _selected, _instance_changed_count);
+
+	for (uint8_t i = 0; i < MAX_INSTANCES; i++) {
+		if ((i == 0) || (_output_instance[i] >= 0)) {
+			PX4_INFO("instance %d: %s, test ratio %.3f (filtered %.3f)", i, _healthy[i] ? "healthy" : "unhealthy",
+				 (double)_combined_test_ratio[i], (double)_relative_test_ratio[i]);
+		}
+	}
+}
@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file EKF2Selector.hpp
+ *
+ * Selection of the ekf2 filter instance providing the vehicle estimate.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/estimator_selector_status.h>
+#include <uORB/topics/estimator_status.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_local_position.h>
+
+/**
+ * Picks the healthiest of the ekf2 filter instances.
+ *
+ * Instance 0 is the main filter, its status is passed to update() directly. The status and
+ * outputs of the secondary instances are read from the estimator_* multi-instance topics.
+ * The selector runs in the main filter task and keeps the reset counters of the published
+ * vehicle_attitude, vehicle_local_position and vehicle_global_position continuous when the
+ * instance changes, so that the consumers handle the switch like an estimator reset.
+ */
+class EKF2Selector
+{
+public:
+	static constexpr uint8_t MAX_INSTANCES = 4;	///< main filter and up to 3 secondary instances
+
+	EKF2Selector() = default;
+	~EKF2Selector() = default;
+
+	/**
+	 * Register a secondary filter instance.
+	 * @param instance The filter instance (1..MAX_INSTANCES-1).
+	 * @param output_instance The uORB instance of its estimator_* output topics.
+	 */
+	bool add_instance(uint8_t instance, int output_instance);
+
+	bool enabled() const { return _instances_available > 1; }
+
+	/** the filter instance whose outputs are to be published */
+	uint8_t selected() const { return _selected; }
+
+	/**
+	 * Update the health of all instances and select the primary one.
+	 * @param main_status The latest status of the main filter.
+	 * @return true if the selected instance changed
+	 */
+	bool update(const estimator_status_s &main_status);
+
+	/**
+	 * Copy the latest outputs of the selected secondary instance.
+	 * @return true if there is new data to publish
+	 */
+	bool copy_attitude(vehicle_attitude_s &att);
+	bool copy_local_position(vehicle_local_position_s &lpos);
+	bool copy_global_position(vehicle_global_position_s &gpos);
+
+	/**
+	 * Rewrite the reset counters and deltas of an output of the given filter instance
+	 * before it is published.
+	 */
+	void adjust_resets(vehicle_attitude_s &att, uint8_t instance);
+	void adjust_resets(vehicle_local_position_s &lpos, uint8_t instance);
+	void adjust_resets(vehicle_global_position_s &gpos, uint8_t instance);
+
+	void print_status();
+
+private:
+
+	static constexpr hrt_abstime STATUS_TIMEOUT = 500000;		///< instance considered stopped without status (us)
+	static constexpr hrt_abstime SWITCH_HOLD_TIME = 1000000;	///< minimum time between two changes (us)
+	static constexpr float SWITCH_RATIO_MARGIN = 0.5f;	///< relative test ratio improvement to leave a healthy instance
+	static constexpr float TEST_RATIO_FILTER_ALPHA = 0.05f;	///< low pass filter coefficient of the relative test ratio
+
+	struct ResetCounter {
+		uint8_t source_count{0};	///< reset counter of the instance last published
+		uint8_t published_count{0};	///< reset counter last published
+		bool initialised{false};
+	};
+
+	/**
+	 * @return the reset counter to publish, incremented on an instance change or a reset of the instance
+	 */
+	static uint8_t reset_counter(ResetCounter &counter, uint8_t source_count, bool instance_changed);
+
+	void update_instance(uint8_t instance, const estimator_status_s &status);
+	void publish_status(hrt_abstime now);
+
+	uint8_t _instances_available{1};
+	uint8_t _selected{0};
+	int8_t _output_instance[MAX_INSTANCES] {-1, -1, -1, -1};
+
+	hrt_abstime _status_timestamp[MAX_INSTANCES] {};
+	float _combined_test_ratio[MAX_INSTANCES] {};
+	float _relative_test_ratio[MAX_INSTANCES] {};
+	bool _healthy[MAX_INSTANCES] {};
+
+	uint32_t _instance_changed_count{0};
+	hrt_abstime _last_instance_change{0};
+	hrt_abstime _last_status_publish{0};
+
+	// last published outputs and their reset counters
+	uint8_t _attitude_instance{0};
+	bool _attitude_published{false};
+	matrix::Quatf _attitude_q{};
+	ResetCounter _quat_reset{};
+
+	uint8_t _local_position_instance{0};
+	bool _local_position_published{false};
+	matrix::Vector3f _local_position{};
+	matrix::Vector3f _local_velocity{};
+	ResetCounter _xy_reset{};
+	ResetCounter _z_reset{};
+	ResetCounter _vxy_reset{};
+	ResetCounter _vz_reset{};
+
+	uint8_t _global_position_instance{0};
+	bool _global_position_published{false};
+	float _global_alt{0.f};
+	ResetCounter _lat_lon_reset{};
+	ResetCounter _alt_reset{};
+
+	uORB::Subscription _status_subs[MAX_INSTANCES - 1] {
+		{ORB_ID(estimator_instance_status), 0},
+		{ORB_ID(estimator_instance_status), 1},
+		{ORB_ID(estimator_instance_status), 2}
+	};
+
+	uORB::Subscription _attitude_subs[MAX_INSTANCES - 1] {
+		{ORB_ID(estimator_attitude), 0},
+		{ORB_ID(estimator_attitude), 1},
+		{ORB_ID(estimator_attitude), 2}
+	};
+
+	uORB::Subscription _local_position_subs[MAX_INSTANCES - 1] {
+		{ORB_ID(estimator_local_position), 0},
+		{ORB_ID(estimator_local_position), 1},
+		{ORB_ID(estimator_local_position), 2}
+	};
+
+	uORB::Subscription _global_position_subs[MAX_INSTANCES - 1] {
+		{ORB_ID(estimator_global_position), 0},
+		{ORB_ID(estimator_global_position), 1},
+		{ORB_ID(estimator_global_position), 2}
+	};
+
+	uORB::Publication<estimator_selector_status_s> _selector_status_pub{ORB_ID(estimator_selector_status)};
+};
@@ -47,12 +47,14 @@
 #include <px4_defines.h>
 #include <px4_module.h>
 #include <px4_module_params.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 #include <px4_posix.h>
 #include <px4_tasks.h>
 #include <px4_time.h>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/airspeed.h>
 #include <uORB/topics/distance_sensor.h>
 #include <uORB/topics/ekf2_innovations.h>
@@ -77,6 +79,9 @@
 #include <uORB/topics/vehicle_status.h>
 #include <uORB/topics/wind_estimate.h>
 
+#include "EKF2Instance.hpp"
+#include "EKF2Selector.hpp"
+
 // defines used to specify the mask position for use of different accuracy metrics in the GPS blending algorithm
 #define BLEND_MASK_USE_SPD_ACC      1
 #define BLEND_MASK_USE_HPOS_ACC     2
@@ -91,7 +96,7 @@ using namespace time_literals;
 
 extern "C" __EXPORT int ekf2_main(int argc, char *argv[]);
 
-class Ekf2 final : public ModuleBase<Ekf2>, public ModuleParams
+class Ekf2 final : public ModuleBase<Ekf2>, public ModuleParams, public px4::WorkItem
 {
 public:
 	Ekf2();
@@ -100,25 +105,46 @@ public:
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
 
-	/** @see ModuleBase */
-	static Ekf2 *instantiate(int argc, char *argv[]);
-
 	/** @see ModuleBase */
 	static int custom_command(int argc, char *argv[]);
 
 	/** @see ModuleBase */
 	static int print_usage(const char *reason = nullptr);
 
-	/** @see ModuleBase::run() */
-	void run() override;
-
 	void set_replay_mode(bool replay) { _replay_mode = replay; }
 
-	static void	task_main_trampoline(int argc, char *argv[]);
+	bool init();
 
 	int print_status() override;
 
 private:
+	void Run() override;
+
+	/**
+	 * Auxiliary topics, checked for updates once per IMU sample.
+	 */
+	enum AuxTopic : uint16_t {
+		AUX_PARAMS		= (1 << 0),
+		AUX_VEHICLE_STATUS	= (1 << 1),
+		AUX_SENSOR_SELECTION	= (1 << 2),
+		AUX_MAGNETOMETER	= (1 << 3),
+		AUX_AIR_DATA		= (1 << 4),
+		AUX_GPS1		= (1 << 5),
+		AUX_GPS2		= (1 << 6),
+		AUX_AIRSPEED		= (1 << 7),
+		AUX_OPTICAL_FLOW	= (1 << 8),
+		AUX_DISTANCE_SENSOR	= (1 << 9),
+		AUX_VISUAL_ODOMETRY	= (1 << 10),
+		AUX_LAND_DETECTED	= (1 << 11),
+		AUX_LANDING_TARGET	= (1 << 12),
+	};
+
+	/**
+	 * Check all auxiliary topics for new data in a single pass.
+	 * @return bitmask of AuxTopic, 0 if none of them changed since the last run
+	 */
+	uint16_t aux_topics_updated();
+
 	int getRangeSubIndex(); ///< get subscription index of first downward-facing range sensor
 
 	template<typename Param>
@@ -126,6 +152,20 @@ private:
 	template<typename Param>
 	bool update_mag_decl(Param &mag_decl_param);
 	bool publish_attitude(const sensor_combined_s &sensors, const hrt_abstime &now);
+
+	/**
+	 * Publish an output of the main filter, if it is the selected instance.
+	 */
+	template<typename T>
+	void publish_output(uORB::Publication<T> &pub, const T &data);
+
+	/**
+	 * Publish the outputs of the selected secondary filter instance.
+	 */
+	void publish_selected_instance();
+
+	void start_instances();
+	void stop_instances();
 	bool publish_wind_estimate(const hrt_abstime &timestamp);
 
 	const Vector3f get_vel_body_wind();
@@ -176,6 +216,13 @@ private:
 
 	perf_counter_t _perf_update_data;
 	perf_counter_t _perf_ekf_update;
+	perf_counter_t _perf_attitude_latency;	///< time from the IMU sample to the attitude publication
+
+	bool _imu_bias_reset_request{false};
+
+	sensor_selection_s _sensor_selection{};
+	vehicle_land_detected_s _vehicle_land_detected{};
+	vehicle_status_s _vehicle_status{};
 
 	// Initialise time stamps used to send sensor data to the EKF and for logging
 	uint8_t _invalid_mag_id_count = 0;	///< number of times an invalid magnetomer device ID has been detected
@@ -266,11 +313,12 @@ private:
 	uORB::Subscription _status_sub{ORB_ID(vehicle_status)};
 	uORB::Subscription _vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
 
-	int _sensors_sub{ -1};
+	uORB::SubscriptionCallbackWorkItem _sensors_sub{this, ORB_ID(sensor_combined)};
 
 	// because we can have several distance sensor instances with different orientations
 	uORB::Subscription _range_finder_subs[ORB_MULTI_MAX_INSTANCES] {{ORB_ID(distance_sensor), 0}, {ORB_ID(distance_sensor), 1}, {ORB_ID(distance_sensor), 2}, {ORB_ID(distance_sensor), 3}};
 	int _range_finder_sub_index = -1; // index for downward-facing range finder subscription
+	hrt_abstime _range_finder_search_time{0}; ///< last time a downward-facing range finder was searched for
 
 	// because we can have multiple GPS instances
 	uORB::Subscription _gps_subs[GPS_MAX_RECEIVERS] {{ORB_ID(vehicle_gps_position), 0}, {ORB_ID(vehicle_gps_position), 1}};
@@ -292,6 +340,9 @@ private:
 
 	parameters *_params;	///< pointer to ekf parameter struct (located in _ekf class instance)
 
+	EKF2Selector _selector;
+	EKF2Instance *_instances[EKF2Selector::MAX_INSTANCES - 1] {};	///< secondary filter instances, see EKF2_MULTI_IMU
+
 	DEFINE_PARAMETERS(
 		(ParamExtInt<px4::params::EKF2_MIN_OBS_DT>)
 		_param_ekf2_min_obs_dt,	///< Maximum time delay of any sensor used to increase buffer length to handle large timing jitter (mSec)
@@ -525,7 +576,9 @@ private:
 		(ParamExtFloat<px4::params::EKF2_MOVE_TEST>)
 		_param_ekf2_move_test,	///< scaling applied to IMU data thresholds used to determine if the vehicle is static or moving.
 
-		(ParamFloat<px4::params::EKF2_REQ_GPS_H>) _param_ekf2_req_gps_h	///< Required GPS health time
+		(ParamFloat<px4::params::EKF2_REQ_GPS_H>) _param_ekf2_req_gps_h,	///< Required GPS health time
+
+		(ParamInt<px4::params::EKF2_MULTI_IMU>) _param_ekf2_multi_imu	///< number of IMUs to run a filter instance on
 
 	)
 
@@ -533,8 +586,10 @@ private:
 
 Ekf2::Ekf2():
 	ModuleParams(nullptr),
+	WorkItem(px4::wq_configurations::INS0),
 	_perf_update_data(perf_alloc_once(PC_ELAPSED, "EKF2 data acquisition")),
 	_perf_ekf_update(perf_alloc_once(PC_ELAPSED, "EKF2 update")),
+	_perf_attitude_latency(perf_alloc_once(PC_ELAPSED, "EKF2 IMU to attitude latency")),
 	_params(_ekf.getParamHandle()),
 	_param_ekf2_min_obs_dt(_params->sensor_interval_min_ms),
 	_param_ekf2_mag_delay(_params->mag_delay_ms),
@@ -630,8 +685,6 @@ Ekf2::Ekf2():
 	_param_ekf2_bcoef_y(_params->bcoef_y),
 	_param_ekf2_move_test(_params->is_moving_scaler)
 {
-	_sensors_sub = orb_subscribe(ORB_ID(sensor_combined));
-
 	// initialise parameter cache
 	updateParams();
 
@@ -640,10 +693,25 @@ Ekf2::Ekf2():
 
 Ekf2::~Ekf2()
 {
+	stop_instances();
+
 	perf_free(_perf_update_data);
 	perf_free(_perf_ekf_update);
+	perf_free(_perf_attitude_latency);
+}
+
+bool Ekf2::init()
+{
+	if (!_replay_mode) {
+		start_instances();
+	}
+
+	if (!_sensors_sub.register_callback()) {
+		PX4_ERR("sensor combined callback registration failed!");
+		return false;
+	}
 
-	orb_unsubscribe(_sensors_sub);
+	return true;
 }
 
 int Ekf2::print_status()
@@ -655,10 +723,60 @@ int Ekf2::print_status()
 
 	perf_print_counter(_perf_update_data);
 	perf_print_counter(_perf_ekf_update);
+	perf_print_counter(_perf_attitude_latency);
+
+	if (_selector.enabled()) {
+		_selector.print_status();
+
+		for (EKF2Instance *instance : _instances) {
+			if (instance != nullptr) {
+				instance->print_status();
+			}
+		}
+	}
 
 	return 0;
 }
 
+void Ekf2::start_instances()
+{
+	static constexpr const px4::wq_config_t *wq_configs[EKF2Selector::MAX_INSTANCES - 1] {
+		&px4::wq_configurations::INS1,
+		&px4::wq_configurations::INS2,
+		&px4::wq_configurations::INS3
+	};
+
+	const int count = math::min(_param_ekf2_multi_imu.get(), (int32_t)EKF2Selector::MAX_INSTANCES);
+
+	// instance 0 is this task, running on the voted IMU data
+	for (int i = 1; i < count; i++) {
+		EKF2Instance *instance = new EKF2Instance(i, *wq_configs[i - 1]);
+
+		if (instance == nullptr) {
+			PX4_ERR("alloc failed");
+			break;
+		}
+
+		instance->set_parameters(*_params, _param_ekf2_req_gps_h.get());
+
+		if (instance->Start() && _selector.add_instance(i, instance->output_instance())) {
+			_instances[i - 1] = instance;
+
+		} else {
+			PX4_ERR("IMU %d filter instance start failed", i);
+			delete instance;
+		}
+	}
+}
+
+void Ekf2::stop_instances()
+{
+	for (EKF2Instance *&instance : _instances) {
+		delete instance;
+		instance = nullptr;
+	}
+}
+
 template<typename Param>
 void Ekf2::update_mag_bias(Param &mag_bias_param, int axis_index)
 {
@@ -693,1023 +811,1046 @@ bool Ekf2::update_mag_decl(Param &mag_decl_param)
 	return false;
 }
 
-void Ekf2::run()
+void Ekf2::Run()
 {
-	bool imu_bias_reset_request = false;
-
-	px4_pollfd_struct_t fds[1] = {};
-	fds[0].fd = _sensors_sub;
-	fds[0].events = POLLIN;
-
-	// initialize data structures outside of loop
-	// because they will else not always be
-	// properly populated
-	sensor_combined_s sensors = {};
-	vehicle_land_detected_s vehicle_land_detected = {};
-	vehicle_status_s vehicle_status = {};
-	sensor_selection_s sensor_selection = {};
-
-	while (!should_exit()) {
-		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), 1000);
-
-		if (!(fds[0].revents & POLLIN)) {
-			// no new data
-			continue;
-		}
+	if (should_exit()) {
+		_sensors_sub.unregister_callback();
+		exit_and_cleanup();
+		return;
+	}
 
-		if (ret < 0) {
-			// Poll error, sleep and try again
-			px4_usleep(10000);
-			continue;
+	sensor_combined_s sensors;
 
-		} else if (ret == 0) {
-			// Poll timeout or no new data, do nothing
-			continue;
-		}
+	if (!_sensors_sub.update(&sensors)) {
+		return;
+	}
 
-		perf_begin(_perf_update_data);
+	perf_begin(_perf_update_data);
 
-		if (_params_sub.updated()) {
-			// read from param to clear updated flag
-			parameter_update_s update;
-			_params_sub.copy(&update);
-			updateParams();
-		}
+	// check all auxiliary topics at once, most IMU samples arrive without any of them having changed
+	const uint16_t aux_updated = aux_topics_updated();
 
-		orb_copy(ORB_ID(sensor_combined), _sensors_sub, &sensors);
+	if (aux_updated & AUX_PARAMS) {
+		// read from param to clear updated flag
+		parameter_update_s update;
+		_params_sub.copy(&update);
+		updateParams();
 
-		// ekf2_timestamps (using 0.1 ms relative timestamps)
-		ekf2_timestamps_s ekf2_timestamps = {};
-		ekf2_timestamps.timestamp = sensors.timestamp;
+		for (EKF2Instance *instance : _instances) {
+			if (instance != nullptr) {
+				instance->set_parameters(*_params, _param_ekf2_req_gps_h.get());
+			}
+		}
+	}
 
-		ekf2_timestamps.airspeed_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.distance_sensor_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.gps_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.optical_flow_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.vehicle_air_data_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.vehicle_magnetometer_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
-		ekf2_timestamps.visual_odometry_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	// ekf2_timestamps (using 0.1 ms relative timestamps)
+	ekf2_timestamps_s ekf2_timestamps = {};
+	ekf2_timestamps.timestamp = sensors.timestamp;
 
-		// update all other topics if they have new data
-		if (_status_sub.update(&vehicle_status)) {
+	ekf2_timestamps.airspeed_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.distance_sensor_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.gps_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.optical_flow_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.vehicle_air_data_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.vehicle_magnetometer_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
+	ekf2_timestamps.visual_odometry_timestamp_rel = ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID;
 
-			bool is_fixed_wing = vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING;
+	// update all other topics if they have new data
+	if ((aux_updated & AUX_VEHICLE_STATUS) && _status_sub.copy(&_vehicle_status)) {
 
-			// only fuse synthetic sideslip measurements if conditions are met
-			_ekf.set_fuse_beta_flag(is_fixed_wing && (_param_ekf2_fuse_beta.get() == 1));
+		bool is_fixed_wing = _vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_FIXED_WING;
 
-			// let the EKF know if the vehicle motion is that of a fixed wing (forward flight only relative to wind)
-			_ekf.set_is_fixed_wing(is_fixed_wing);
-		}
+		// only fuse synthetic sideslip measurements if conditions are met
+		_ekf.set_fuse_beta_flag(is_fixed_wing && (_param_ekf2_fuse_beta.get() == 1));
 
-		// Always update sensor selction first time through if time stamp is non zero
-		if (_sensor_selection_sub.updated() || (sensor_selection.timestamp == 0)) {
-			const sensor_selection_s sensor_selection_prev = sensor_selection;
+		// let the EKF know if the vehicle motion is that of a fixed wing (forward flight only relative to wind)
+		_ekf.set_is_fixed_wing(is_fixed_wing);
+	}
 
-			if (_sensor_selection_sub.copy(&sensor_selection)) {
-				if ((sensor_selection_prev.timestamp > 0) && (sensor_selection.timestamp > sensor_selection_prev.timestamp)) {
-					if (sensor_selection.accel_device_id != sensor_selection_prev.accel_device_id) {
-						PX4_WARN("accel id changed, resetting IMU bias");
-						imu_bias_reset_request = true;
-					}
+	// Always update sensor selction first time through if time stamp is non zero
+	if ((aux_updated & AUX_SENSOR_SELECTION) || (_sensor_selection.timestamp == 0)) {
+		const sensor_selection_s sensor_selection_prev = _sensor_selection;
 
-					if (sensor_selection.gyro_device_id != sensor_selection_prev.gyro_device_id) {
-						PX4_WARN("gyro id changed, resetting IMU bias");
-						imu_bias_reset_request = true;
-					}
+		if (_sensor_selection_sub.copy(&_sensor_selection)) {
+			if ((sensor_selection_prev.timestamp > 0) && (_sensor_selection.timestamp > sensor_selection_prev.timestamp)) {
+				if (_sensor_selection.accel_device_id != sensor_selection_prev.accel_device_id) {
+					PX4_WARN("accel id changed, resetting IMU bias");
+					_imu_bias_reset_request = true;
+				}
+
+				if (_sensor_selection.gyro_device_id != sensor_selection_prev.gyro_device_id) {
+					PX4_WARN("gyro id changed, resetting IMU bias");
+					_imu_bias_reset_request = true;
 				}
 			}
 		}
+	}
 
-		// attempt reset until successful
-		if (imu_bias_reset_request) {
-			imu_bias_reset_request = !_ekf.reset_imu_bias();
-		}
+	// attempt reset until successful
+	if (_imu_bias_reset_request) {
+		_imu_bias_reset_request = !_ekf.reset_imu_bias();
+	}
 
-		const hrt_abstime now = sensors.timestamp;
-
-		// push imu data into estimator
-		imuSample imu_sample_new;
-		imu_sample_new.time_us = now;
-		imu_sample_new.delta_ang_dt = sensors.gyro_integral_dt * 1.e-6f;
-		imu_sample_new.delta_ang = Vector3f{sensors.gyro_rad} * imu_sample_new.delta_ang_dt;
-		imu_sample_new.delta_vel_dt = sensors.accelerometer_integral_dt * 1.e-6f;
-		imu_sample_new.delta_vel = Vector3f{sensors.accelerometer_m_s2} * imu_sample_new.delta_vel_dt;
-
-		_ekf.setIMUData(imu_sample_new);
-
-		// publish attitude immediately (uses quaternion from output predictor)
-		publish_attitude(sensors, now);
-
-		// read mag data
-		if (_magnetometer_sub.updated()) {
-			vehicle_magnetometer_s magnetometer;
-
-			if (_magnetometer_sub.copy(&magnetometer)) {
-				// Reset learned bias parameters if there has been a persistant change in magnetometer ID
-				// Do not reset parmameters when armed to prevent potential time slips casued by parameter set
-				// and notification events
-				// Check if there has been a persistant change in magnetometer ID
-				if (sensor_selection.mag_device_id != 0 && sensor_selection.mag_device_id != (uint32_t)_param_ekf2_magbias_id.get()) {
-					if (_invalid_mag_id_count < 200) {
-						_invalid_mag_id_count++;
-					}
+	const hrt_abstime now = sensors.timestamp;
 
-				} else {
-					if (_invalid_mag_id_count > 0) {
-						_invalid_mag_id_count--;
-					}
-				}
+	// push imu data into estimator
+	imuSample imu_sample_new;
+	imu_sample_new.time_us = now;
+	imu_sample_new.delta_ang_dt = sensors.gyro_integral_dt * 1.e-6f;
+	imu_sample_new.delta_ang = Vector3f{sensors.gyro_rad} * imu_sample_new.delta_ang_dt;
+	imu_sample_new.delta_vel_dt = sensors.accelerometer_integral_dt * 1.e-6f;
+	imu_sample_new.delta_vel = Vector3f{sensors.accelerometer_m_s2} * imu_sample_new.delta_vel_dt;
+
+	_ekf.setIMUData(imu_sample_new);
 
-				if ((vehicle_status.arming_state != vehicle_status_s::ARMING_STATE_ARMED) && (_invalid_mag_id_count > 100)) {
-					// the sensor ID used for the last saved mag bias is not confirmed to be the same as the current sensor ID
-					// this means we need to reset the learned bias values to zero
-					_param_ekf2_magbias_x.set(0.f);
-					_param_ekf2_magbias_x.commit_no_notification();
-					_param_ekf2_magbias_y.set(0.f);
-					_param_ekf2_magbias_y.commit_no_notification();
-					_param_ekf2_magbias_z.set(0.f);
-					_param_ekf2_magbias_z.commit_no_notification();
-					_param_ekf2_magbias_id.set(sensor_selection.mag_device_id);
-					_param_ekf2_magbias_id.commit();
-
-					_invalid_mag_id_count = 0;
-
-					PX4_INFO("Mag sensor ID changed to %i", _param_ekf2_magbias_id.get());
+	// publish attitude immediately (uses quaternion from output predictor)
+	publish_attitude(sensors, now);
+
+	if (_selector.enabled() && (_selector.selected() != 0)) {
+		publish_selected_instance();
+	}
+
+	if (!_replay_mode) {
+		perf_set_elapsed(_perf_attitude_latency, hrt_elapsed_time(&sensors.timestamp));
+	}
+
+	// read mag data
+	if (aux_updated & AUX_MAGNETOMETER) {
+		vehicle_magnetometer_s magnetometer;
+
+		if (_magnetometer_sub.copy(&magnetometer)) {
+			// Reset learned bias parameters if there has been a persistant change in magnetometer ID
+			// Do not reset parmameters when armed to prevent potential time slips casued by parameter set
+			// and notification events
+			// Check if there has been a persistant change in magnetometer ID
+			if (_sensor_selection.mag_device_id != 0 && _sensor_selection.mag_device_id != (uint32_t)_param_ekf2_magbias_id.get()) {
+				if (_invalid_mag_id_count < 200) {
+					_invalid_mag_id_count++;
 				}
 
-				// If the time last used by the EKF is less than specified, then accumulate the
-				// data and push the average when the specified interval is reached.
-				_mag_time_sum_ms += magnetometer.timestamp / 1000;
-				_mag_sample_count++;
-				_mag_data_sum[0] += magnetometer.magnetometer_ga[0];
-				_mag_data_sum[1] += magnetometer.magnetometer_ga[1];
-				_mag_data_sum[2] += magnetometer.magnetometer_ga[2];
-				int32_t mag_time_ms = _mag_time_sum_ms / _mag_sample_count;
-
-				if ((mag_time_ms - _mag_time_ms_last_used) > _params->sensor_interval_min_ms) {
-					const float mag_sample_count_inv = 1.0f / _mag_sample_count;
-					// calculate mean of measurements and correct for learned bias offsets
-					float mag_data_avg_ga[3] = {_mag_data_sum[0] *mag_sample_count_inv - _param_ekf2_magbias_x.get(),
-								    _mag_data_sum[1] *mag_sample_count_inv - _param_ekf2_magbias_y.get(),
-								    _mag_data_sum[2] *mag_sample_count_inv - _param_ekf2_magbias_z.get()
-								   };
-
-					_ekf.setMagData(1000 * (uint64_t)mag_time_ms, mag_data_avg_ga);
-
-					_mag_time_ms_last_used = mag_time_ms;
-					_mag_time_sum_ms = 0;
-					_mag_sample_count = 0;
-					_mag_data_sum[0] = 0.0f;
-					_mag_data_sum[1] = 0.0f;
-					_mag_data_sum[2] = 0.0f;
+			} else {
+				if (_invalid_mag_id_count > 0) {
+					_invalid_mag_id_count--;
 				}
+			}
 
-				ekf2_timestamps.vehicle_magnetometer_timestamp_rel = (int16_t)((int64_t)magnetometer.timestamp / 100 -
-						(int64_t)ekf2_timestamps.timestamp / 100);
+			if ((_vehicle_status.arming_state != vehicle_status_s::ARMING_STATE_ARMED) && (_invalid_mag_id_count > 100)) {
+				// the sensor ID used for the last saved mag bias is not confirmed to be the same as the current sensor ID
+				// this means we need to reset the learned bias values to zero
+				_param_ekf2_magbias_x.set(0.f);
+				_param_ekf2_magbias_x.commit_no_notification();
+				_param_ekf2_magbias_y.set(0.f);
+				_param_ekf2_magbias_y.commit_no_notification();
+				_param_ekf2_magbias_z.set(0.f);
+				_param_ekf2_magbias_z.commit_no_notification();
+				_param_ekf2_magbias_id.set(_sensor_selection.mag_device_id);
+				_param_ekf2_magbias_id.commit();
+
+				_invalid_mag_id_count = 0;
+
+				PX4_INFO("Mag sensor ID changed to %i", _param_ekf2_magbias_id.get());
 			}
-		}
 
-		// read baro data
-		if (_airdata_sub.updated()) {
-			vehicle_air_data_s airdata;
+			// If the time last used by the EKF is less than specified, then accumulate the
+			// data and push the average when the specified interval is reached.
+			_mag_time_sum_ms += magnetometer.timestamp / 1000;
+			_mag_sample_count++;
+			_mag_data_sum[0] += magnetometer.magnetometer_ga[0];
+			_mag_data_sum[1] += magnetometer.magnetometer_ga[1];
+			_mag_data_sum[2] += magnetometer.magnetometer_ga[2];
+			int32_t mag_time_ms = _mag_time_sum_ms / _mag_sample_count;
+
+			if ((mag_time_ms - _mag_time_ms_last_used) > _params->sensor_interval_min_ms) {
+				const float mag_sample_count_inv = 1.0f / _mag_sample_count;
+				// calculate mean of measurements and correct for learned bias offsets
+				float mag_data_avg_ga[3] = {_mag_data_sum[0] *mag_sample_count_inv - _param_ekf2_magbias_x.get(),
+							    _mag_data_sum[1] *mag_sample_count_inv - _param_ekf2_magbias_y.get(),
+							    _mag_data_sum[2] *mag_sample_count_inv - _param_ekf2_magbias_z.get()
+							   };
+
+				_ekf.setMagData(1000 * (uint64_t)mag_time_ms, mag_data_avg_ga);
+
+				_mag_time_ms_last_used = mag_time_ms;
+				_mag_time_sum_ms = 0;
+				_mag_sample_count = 0;
+				_mag_data_sum[0] = 0.0f;
+				_mag_data_sum[1] = 0.0f;
+				_mag_data_sum[2] = 0.0f;
+			}
 
-			if (_airdata_sub.copy(&airdata)) {
-				// If the time last used by the EKF is less than specified, then accumulate the
-				// data and push the average when the specified interval is reached.
-				_balt_time_sum_ms += airdata.timestamp / 1000;
-				_balt_sample_count++;
-				_balt_data_sum += airdata.baro_alt_meter;
-				uint32_t balt_time_ms = _balt_time_sum_ms / _balt_sample_count;
+			ekf2_timestamps.vehicle_magnetometer_timestamp_rel = (int16_t)((int64_t)magnetometer.timestamp / 100 -
+					(int64_t)ekf2_timestamps.timestamp / 100);
+		}
+	}
 
-				if (balt_time_ms - _balt_time_ms_last_used > (uint32_t)_params->sensor_interval_min_ms) {
-					// take mean across sample period
-					float balt_data_avg = _balt_data_sum / (float)_balt_sample_count;
+	// read baro data
+	if (aux_updated & AUX_AIR_DATA) {
+		vehicle_air_data_s airdata;
 
-					_ekf.set_air_density(airdata.rho);
+		if (_airdata_sub.copy(&airdata)) {
+			// If the time last used by the EKF is less than specified, then accumulate the
+			// data and push the average when the specified interval is reached.
+			_balt_time_sum_ms += airdata.timestamp / 1000;
+			_balt_sample_count++;
+			_balt_data_sum += airdata.baro_alt_meter;
+			uint32_t balt_time_ms = _balt_time_sum_ms / _balt_sample_count;
 
-					// calculate static pressure error = Pmeas - Ptruth
-					// model position error sensitivity as a body fixed ellipse with a different scale in the positive and
-					// negative X and Y directions
-					const Vector3f vel_body_wind = get_vel_body_wind();
+			if (balt_time_ms - _balt_time_ms_last_used > (uint32_t)_params->sensor_interval_min_ms) {
+				// take mean across sample period
+				float balt_data_avg = _balt_data_sum / (float)_balt_sample_count;
 
-					float K_pstatic_coef_x;
+				_ekf.set_air_density(airdata.rho);
 
-					if (vel_body_wind(0) >= 0.0f) {
-						K_pstatic_coef_x = _param_ekf2_pcoef_xp.get();
+				// calculate static pressure error = Pmeas - Ptruth
+				// model position error sensitivity as a body fixed ellipse with a different scale in the positive and
+				// negative X and Y directions
+				const Vector3f vel_body_wind = get_vel_body_wind();
 
-					} else {
-						K_pstatic_coef_x = _param_ekf2_pcoef_xn.get();
-					}
+				float K_pstatic_coef_x;
 
-					float K_pstatic_coef_y;
+				if (vel_body_wind(0) >= 0.0f) {
+					K_pstatic_coef_x = _param_ekf2_pcoef_xp.get();
 
-					if (vel_body_wind(1) >= 0.0f) {
-						K_pstatic_coef_y = _param_ekf2_pcoef_yp.get();
+				} else {
+					K_pstatic_coef_x = _param_ekf2_pcoef_xn.get();
+				}
 
-					} else {
-						K_pstatic_coef_y = _param_ekf2_pcoef_yn.get();
-					}
+				float K_pstatic_coef_y;
 
-					const float max_airspeed_sq = _param_ekf2_aspd_max.get() * _param_ekf2_aspd_max.get();
-					const float x_v2 = fminf(vel_body_wind(0) * vel_body_wind(0), max_airspeed_sq);
-					const float y_v2 = fminf(vel_body_wind(1) * vel_body_wind(1), max_airspeed_sq);
-					const float z_v2 = fminf(vel_body_wind(2) * vel_body_wind(2), max_airspeed_sq);
+				if (vel_body_wind(1) >= 0.0f) {
+					K_pstatic_coef_y = _param_ekf2_pcoef_yp.get();
 
-					const float pstatic_err = 0.5f * airdata.rho * (
-									  K_pstatic_coef_x * x_v2 + K_pstatic_coef_y * y_v2 + _param_ekf2_pcoef_z.get() * z_v2);
+				} else {
+					K_pstatic_coef_y = _param_ekf2_pcoef_yn.get();
+				}
 
-					// correct baro measurement using pressure error estimate and assuming sea level gravity
-					balt_data_avg += pstatic_err / (airdata.rho * CONSTANTS_ONE_G);
+				const float max_airspeed_sq = _param_ekf2_aspd_max.get() * _param_ekf2_aspd_max.get();
+				const float x_v2 = fminf(vel_body_wind(0) * vel_body_wind(0), max_airspeed_sq);
+				const float y_v2 = fminf(vel_body_wind(1) * vel_body_wind(1), max_airspeed_sq);
+				const float z_v2 = fminf(vel_body_wind(2) * vel_body_wind(2), max_airspeed_sq);
 
-					// push to estimator
-					_ekf.setBaroData(1000 * (uint64_t)balt_time_ms, balt_data_avg);
+				const float pstatic_err = 0.5f * airdata.rho * (
+								  K_pstatic_coef_x * x_v2 + K_pstatic_coef_y * y_v2 + _param_ekf2_pcoef_z.get() * z_v2);
 
-					_balt_time_ms_last_used = balt_time_ms;
-					_balt_time_sum_ms = 0;
-					_balt_sample_count = 0;
-					_balt_data_sum = 0.0f;
-				}
+				// correct baro measurement using pressure error estimate and assuming sea level gravity
+				balt_data_avg += pstatic_err / (airdata.rho * CONSTANTS_ONE_G);
 
-				ekf2_timestamps.vehicle_air_data_timestamp_rel = (int16_t)((int64_t)airdata.timestamp / 100 -
-						(int64_t)ekf2_timestamps.timestamp / 100);
-			}
-		}
+				// push to estimator
+				_ekf.setBaroData(1000 * (uint64_t)balt_time_ms, balt_data_avg);
 
-		// read gps1 data if available
-		bool gps1_updated = _gps_subs[0].updated();
-
-		if (gps1_updated) {
-			vehicle_gps_position_s gps;
-
-			if (_gps_subs[0].copy(&gps)) {
-				_gps_state[0].time_usec = gps.timestamp;
-				_gps_state[0].lat = gps.lat;
-				_gps_state[0].lon = gps.lon;
-				_gps_state[0].alt = gps.alt;
-				_gps_state[0].yaw = gps.heading;
-				_gps_state[0].yaw_offset = gps.heading_offset;
-				_gps_state[0].fix_type = gps.fix_type;
-				_gps_state[0].eph = gps.eph;
-				_gps_state[0].epv = gps.epv;
-				_gps_state[0].sacc = gps.s_variance_m_s;
-				_gps_state[0].vel_m_s = gps.vel_m_s;
-				_gps_state[0].vel_ned[0] = gps.vel_n_m_s;
-				_gps_state[0].vel_ned[1] = gps.vel_e_m_s;
-				_gps_state[0].vel_ned[2] = gps.vel_d_m_s;
-				_gps_state[0].vel_ned_valid = gps.vel_ned_valid;
-				_gps_state[0].nsats = gps.satellites_used;
-				//TODO: add gdop to gps topic
-				_gps_state[0].gdop = 0.0f;
-				_gps_alttitude_ellipsoid[0] = gps.alt_ellipsoid;
-
-				ekf2_timestamps.gps_timestamp_rel = (int16_t)((int64_t)gps.timestamp / 100 - (int64_t)ekf2_timestamps.timestamp / 100);
+				_balt_time_ms_last_used = balt_time_ms;
+				_balt_time_sum_ms = 0;
+				_balt_sample_count = 0;
+				_balt_data_sum = 0.0f;
 			}
-		}
 
-		// check for second GPS receiver data
-		bool gps2_updated = _gps_subs[1].updated();
-
-		if (gps2_updated) {
-			vehicle_gps_position_s gps;
-
-			if (_gps_subs[1].copy(&gps)) {
-				_gps_state[1].time_usec = gps.timestamp;
-				_gps_state[1].lat = gps.lat;
-				_gps_state[1].lon = gps.lon;
-				_gps_state[1].alt = gps.alt;
-				_gps_state[1].yaw = gps.heading;
-				_gps_state[1].yaw_offset = gps.heading_offset;
-				_gps_state[1].fix_type = gps.fix_type;
-				_gps_state[1].eph = gps.eph;
-				_gps_state[1].epv = gps.epv;
-				_gps_state[1].sacc = gps.s_variance_m_s;
-				_gps_state[1].vel_m_s = gps.vel_m_s;
-				_gps_state[1].vel_ned[0] = gps.vel_n_m_s;
-				_gps_state[1].vel_ned[1] = gps.vel_e_m_s;
-				_gps_state[1].vel_ned[2] = gps.vel_d_m_s;
-				_gps_state[1].vel_ned_valid = gps.vel_ned_valid;
-				_gps_state[1].nsats = gps.satellites_used;
-				//TODO: add gdop to gps topic
-				_gps_state[1].gdop = 0.0f;
-				_gps_alttitude_ellipsoid[1] = gps.alt_ellipsoid;
-			}
+			ekf2_timestamps.vehicle_air_data_timestamp_rel = (int16_t)((int64_t)airdata.timestamp / 100 -
+					(int64_t)ekf2_timestamps.timestamp / 100);
 		}
+	}
 
-		if ((_param_ekf2_gps_mask.get() == 0) && gps1_updated) {
-			// When GPS blending is disabled we always use the first receiver instance
-			_ekf.setGpsData(_gps_state[0].time_usec, _gps_state[0]);
+	// read gps1 data if available
+	const bool gps1_updated = (aux_updated & AUX_GPS1);
+
+	if (gps1_updated) {
+		vehicle_gps_position_s gps;
+
+		if (_gps_subs[0].copy(&gps)) {
+			_gps_state[0].time_usec = gps.timestamp;
+			_gps_state[0].lat = gps.lat;
+			_gps_state[0].lon = gps.lon;
+			_gps_state[0].alt = gps.alt;
+			_gps_state[0].yaw = gps.heading;
+			_gps_state[0].yaw_offset = gps.heading_offset;
+			_gps_state[0].fix_type = gps.fix_type;
+			_gps_state[0].eph = gps.eph;
+			_gps_state[0].epv = gps.epv;
+			_gps_state[0].sacc = gps.s_variance_m_s;
+			_gps_state[0].vel_m_s = gps.vel_m_s;
+			_gps_state[0].vel_ned[0] = gps.vel_n_m_s;
+			_gps_state[0].vel_ned[1] = gps.vel_e_m_s;
+			_gps_state[0].vel_ned[2] = gps.vel_d_m_s;
+			_gps_state[0].vel_ned_valid = gps.vel_ned_valid;
+			_gps_state[0].nsats = gps.satellites_used;
+			//TODO: add gdop to gps topic
+			_gps_state[0].gdop = 0.0f;
+			_gps_alttitude_ellipsoid[0] = gps.alt_ellipsoid;
+
+			ekf2_timestamps.gps_timestamp_rel = (int16_t)((int64_t)gps.timestamp / 100 - (int64_t)ekf2_timestamps.timestamp / 100);
+		}
+	}
 
-		} else if ((_param_ekf2_gps_mask.get() > 0) && (gps1_updated || gps2_updated)) {
-			// blend dual receivers if available
+	// check for second GPS receiver data
+	const bool gps2_updated = (aux_updated & AUX_GPS2);
+
+	if (gps2_updated) {
+		vehicle_gps_position_s gps;
+
+		if (_gps_subs[1].copy(&gps)) {
+			_gps_state[1].time_usec = gps.timestamp;
+			_gps_state[1].lat = gps.lat;
+			_gps_state[1].lon = gps.lon;
+			_gps_state[1].alt = gps.alt;
+			_gps_state[1].yaw = gps.heading;
+			_gps_state[1].yaw_offset = gps.heading_offset;
+			_gps_state[1].fix_type = gps.fix_type;
+			_gps_state[1].eph = gps.eph;
+			_gps_state[1].epv = gps.epv;
+			_gps_state[1].sacc = gps.s_variance_m_s;
+			_gps_state[1].vel_m_s = gps.vel_m_s;
+			_gps_state[1].vel_ned[0] = gps.vel_n_m_s;
+			_gps_state[1].vel_ned[1] = gps.vel_e_m_s;
+			_gps_state[1].vel_ned[2] = gps.vel_d_m_s;
+			_gps_state[1].vel_ned_valid = gps.vel_ned_valid;
+			_gps_state[1].nsats = gps.satellites_used;
+			//TODO: add gdop to gps topic
+			_gps_state[1].gdop = 0.0f;
+			_gps_alttitude_ellipsoid[1] = gps.alt_ellipsoid;
+		}
+	}
 
-			// calculate blending weights
-			if (!blend_gps_data()) {
-				// handle case where the blended states cannot be updated
-				if (_gps_state[0].fix_type > _gps_state[1].fix_type) {
-					// GPS 1 has the best fix status so use that
-					_gps_select_index = 0;
+	if ((_param_ekf2_gps_mask.get() == 0) && gps1_updated) {
+		// When GPS blending is disabled we always use the first receiver instance
+		_ekf.setGpsData(_gps_state[0].time_usec, _gps_state[0]);
 
-				} else if (_gps_state[1].fix_type > _gps_state[0].fix_type) {
-					// GPS 2 has the best fix status so use that
-					_gps_select_index = 1;
+	} else if ((_param_ekf2_gps_mask.get() > 0) && (gps1_updated || gps2_updated)) {
+		// blend dual receivers if available
 
-				} else if (_gps_select_index == 2) {
-					// use last receiver we received data from
-					if (gps1_updated) {
-						_gps_select_index = 0;
+		// calculate blending weights
+		if (!blend_gps_data()) {
+			// handle case where the blended states cannot be updated
+			if (_gps_state[0].fix_type > _gps_state[1].fix_type) {
+				// GPS 1 has the best fix status so use that
+				_gps_select_index = 0;
 
-					} else if (gps2_updated) {
-						_gps_select_index = 1;
-					}
-				}
+			} else if (_gps_state[1].fix_type > _gps_state[0].fix_type) {
+				// GPS 2 has the best fix status so use that
+				_gps_select_index = 1;
 
-				// Only use selected receiver data if it has been updated
-				if ((gps1_updated && _gps_select_index == 0) || (gps2_updated && _gps_select_index == 1)) {
-					_gps_new_output_data = true;
+			} else if (_gps_select_index == 2) {
+				// use last receiver we received data from
+				if (gps1_updated) {
+					_gps_select_index = 0;
 
-				} else {
-					_gps_new_output_data = false;
+				} else if (gps2_updated) {
+					_gps_select_index = 1;
 				}
 			}
 
-			if (_gps_new_output_data) {
-				// correct the _gps_state data for steady state offsets and write to _gps_output
-				apply_gps_offsets();
+			// Only use selected receiver data if it has been updated
+			if ((gps1_updated && _gps_select_index == 0) || (gps2_updated && _gps_select_index == 1)) {
+				_gps_new_output_data = true;
 
-				// calculate a blended output from the offset corrected receiver data
-				if (_gps_select_index == 2) {
-					calc_gps_blend_output();
-				}
-
-				// write selected GPS to EKF
-				_ekf.setGpsData(_gps_output[_gps_select_index].time_usec, _gps_output[_gps_select_index]);
-
-				// log blended solution as a third GPS instance
-				ekf_gps_position_s gps;
-				gps.timestamp = _gps_output[_gps_select_index].time_usec;
-				gps.lat = _gps_output[_gps_select_index].lat;
-				gps.lon = _gps_output[_gps_select_index].lon;
-				gps.alt = _gps_output[_gps_select_index].alt;
-				gps.fix_type = _gps_output[_gps_select_index].fix_type;
-				gps.eph = _gps_output[_gps_select_index].eph;
-				gps.epv = _gps_output[_gps_select_index].epv;
-				gps.s_variance_m_s = _gps_output[_gps_select_index].sacc;
-				gps.vel_m_s = _gps_output[_gps_select_index].vel_m_s;
-				gps.vel_n_m_s = _gps_output[_gps_select_index].vel_ned[0];
-				gps.vel_e_m_s = _gps_output[_gps_select_index].vel_ned[1];
-				gps.vel_d_m_s = _gps_output[_gps_select_index].vel_ned[2];
-				gps.vel_ned_valid = _gps_output[_gps_select_index].vel_ned_valid;
-				gps.satellites_used = _gps_output[_gps_select_index].nsats;
-				gps.heading = _gps_output[_gps_select_index].yaw;
-				gps.heading_offset = _gps_output[_gps_select_index].yaw_offset;
-				gps.selected = _gps_select_index;
-
-				// Publish to the EKF blended GPS topic
-				_blended_gps_pub.publish(gps);
-
-				// clear flag to avoid re-use of the same data
+			} else {
 				_gps_new_output_data = false;
 			}
 		}
 
-		if (_airspeed_sub.updated()) {
-			airspeed_s airspeed;
+		if (_gps_new_output_data) {
+			// correct the _gps_state data for steady state offsets and write to _gps_output
+			apply_gps_offsets();
 
-			if (_airspeed_sub.copy(&airspeed)) {
-				// only set airspeed data if condition for airspeed fusion are met
-				if ((_param_ekf2_arsp_thr.get() > FLT_EPSILON) && (airspeed.true_airspeed_m_s > _param_ekf2_arsp_thr.get())) {
+			// calculate a blended output from the offset corrected receiver data
+			if (_gps_select_index == 2) {
+				calc_gps_blend_output();
+			}
 
-					const float eas2tas = airspeed.true_airspeed_m_s / airspeed.indicated_airspeed_m_s;
-					_ekf.setAirspeedData(airspeed.timestamp, airspeed.true_airspeed_m_s, eas2tas);
-				}
+			// write selected GPS to EKF
+			_ekf.setGpsData(_gps_output[_gps_select_index].time_usec, _gps_output[_gps_select_index]);
+
+			// log blended solution as a third GPS instance
+			ekf_gps_position_s gps;
+			gps.timestamp = _gps_output[_gps_select_index].time_usec;
+			gps.lat = _gps_output[_gps_select_index].lat;
+			gps.lon = _gps_output[_gps_select_index].lon;
+			gps.alt = _gps_output[_gps_select_index].alt;
+			gps.fix_type = _gps_output[_gps_select_index].fix_type;
+			gps.eph = _gps_output[_gps_select_index].eph;
+			gps.epv = _gps_output[_gps_select_index].epv;
+			gps.s_variance_m_s = _gps_output[_gps_select_index].sacc;
+			gps.vel_m_s = _gps_output[_gps_select_index].vel_m_s;
+			gps.vel_n_m_s = _gps_output[_gps_select_index].vel_ned[0];
+			gps.vel_e_m_s = _gps_output[_gps_select_index].vel_ned[1];
+			gps.vel_d_m_s = _gps_output[_gps_select_index].vel_ned[2];
+			gps.vel_ned_valid = _gps_output[_gps_select_index].vel_ned_valid;
+			gps.satellites_used = _gps_output[_gps_select_index].nsats;
+			gps.heading = _gps_output[_gps_select_index].yaw;
+			gps.heading_offset = _gps_output[_gps_select_index].yaw_offset;
+			gps.selected = _gps_select_index;
+
+			// Publish to the EKF blended GPS topic
+			_blended_gps_pub.publish(gps);
+
+			// clear flag to avoid re-use of the same data
+			_gps_new_output_data = false;
+		}
+	}
 
-				ekf2_timestamps.airspeed_timestamp_rel = (int16_t)((int64_t)airspeed.timestamp / 100 -
-						(int64_t)ekf2_timestamps.timestamp / 100);
+	if (aux_updated & AUX_AIRSPEED) {
+		airspeed_s airspeed;
+
+		if (_airspeed_sub.copy(&airspeed)) {
+			// only set airspeed data if condition for airspeed fusion are met
+			if ((_param_ekf2_arsp_thr.get() > FLT_EPSILON) && (airspeed.true_airspeed_m_s > _param_ekf2_arsp_thr.get())) {
+
+				const float eas2tas = airspeed.true_airspeed_m_s / airspeed.indicated_airspeed_m_s;
+				_ekf.setAirspeedData(airspeed.timestamp, airspeed.true_airspeed_m_s, eas2tas);
 			}
+
+			ekf2_timestamps.airspeed_timestamp_rel = (int16_t)((int64_t)airspeed.timestamp / 100 -
+					(int64_t)ekf2_timestamps.timestamp / 100);
 		}
+	}
 
-		if (_optical_flow_sub.updated()) {
-			optical_flow_s optical_flow;
+	if (aux_updated & AUX_OPTICAL_FLOW) {
+		optical_flow_s optical_flow;
 
-			if (_optical_flow_sub.copy(&optical_flow)) {
-				flow_message flow;
-				flow.flowdata(0) = optical_flow.pixel_flow_x_integral;
-				flow.flowdata(1) = optical_flow.pixel_flow_y_integral;
-				flow.quality = optical_flow.quality;
-				flow.gyrodata(0) = optical_flow.gyro_x_rate_integral;
-				flow.gyrodata(1) = optical_flow.gyro_y_rate_integral;
-				flow.gyrodata(2) = optical_flow.gyro_z_rate_integral;
-				flow.dt = optical_flow.integration_timespan;
+		if (_optical_flow_sub.copy(&optical_flow)) {
+			flow_message flow;
+			flow.flowdata(0) = optical_flow.pixel_flow_x_integral;
+			flow.flowdata(1) = optical_flow.pixel_flow_y_integral;
+			flow.quality = optical_flow.quality;
+			flow.gyrodata(0) = optical_flow.gyro_x_rate_integral;
+			flow.gyrodata(1) = optical_flow.gyro_y_rate_integral;
+			flow.gyrodata(2) = optical_flow.gyro_z_rate_integral;
+			flow.dt = optical_flow.integration_timespan;
 
-				if (PX4_ISFINITE(optical_flow.pixel_flow_y_integral) &&
-				    PX4_ISFINITE(optical_flow.pixel_flow_x_integral)) {
+			if (PX4_ISFINITE(optical_flow.pixel_flow_y_integral) &&
+			    PX4_ISFINITE(optical_flow.pixel_flow_x_integral)) {
 
-					_ekf.setOpticalFlowData(optical_flow.timestamp, &flow);
-				}
+				_ekf.setOpticalFlowData(optical_flow.timestamp, &flow);
+			}
 
-				// Save sensor limits reported by the optical flow sensor
-				_ekf.set_optical_flow_limits(optical_flow.max_flow_rate, optical_flow.min_ground_distance,
-							     optical_flow.max_ground_distance);
+			// Save sensor limits reported by the optical flow sensor
+			_ekf.set_optical_flow_limits(optical_flow.max_flow_rate, optical_flow.min_ground_distance,
+						     optical_flow.max_ground_distance);
 
-				ekf2_timestamps.optical_flow_timestamp_rel = (int16_t)((int64_t)optical_flow.timestamp / 100 -
-						(int64_t)ekf2_timestamps.timestamp / 100);
-			}
+			ekf2_timestamps.optical_flow_timestamp_rel = (int16_t)((int64_t)optical_flow.timestamp / 100 -
+					(int64_t)ekf2_timestamps.timestamp / 100);
 		}
+	}
 
-		if (_range_finder_sub_index >= 0) {
-			bool range_finder_updated = _range_finder_subs[_range_finder_sub_index].updated();
+	if (_range_finder_sub_index >= 0) {
+		bool range_finder_updated = (aux_updated & AUX_DISTANCE_SENSOR);
 
-			if (range_finder_updated) {
-				distance_sensor_s range_finder;
+		if (range_finder_updated) {
+			distance_sensor_s range_finder;
 
-				if (_range_finder_subs[_range_finder_sub_index].copy(&range_finder)) {
-					// check distance sensor data quality
-					// TODO - move this check inside the ecl library
-					if (range_finder.signal_quality == 0) {
-						// use rng_gnd_clearance if on ground
-						if (_ekf.get_in_air_status()) {
-							range_finder_updated = false;
+			if (_range_finder_subs[_range_finder_sub_index].copy(&range_finder)) {
+				// check distance sensor data quality
+				// TODO - move this check inside the ecl library
+				if (range_finder.signal_quality == 0) {
+					// use rng_gnd_clearance if on ground
+					if (_ekf.get_in_air_status()) {
+						range_finder_updated = false;
 
-						} else {
-							range_finder.current_distance = _param_ekf2_min_rng.get();
-						}
+					} else {
+						range_finder.current_distance = _param_ekf2_min_rng.get();
 					}
+				}
 
-					if (range_finder_updated) {
-						_ekf.setRangeData(range_finder.timestamp, range_finder.current_distance);
-					}
+				if (range_finder_updated) {
+					_ekf.setRangeData(range_finder.timestamp, range_finder.current_distance);
+				}
 
-					// Save sensor limits reported by the rangefinder
-					_ekf.set_rangefinder_limits(range_finder.min_distance, range_finder.max_distance);
+				// Save sensor limits reported by the rangefinder
+				_ekf.set_rangefinder_limits(range_finder.min_distance, range_finder.max_distance);
 
-					ekf2_timestamps.distance_sensor_timestamp_rel = (int16_t)((int64_t)range_finder.timestamp / 100 -
-							(int64_t)ekf2_timestamps.timestamp / 100);
-				}
+				ekf2_timestamps.distance_sensor_timestamp_rel = (int16_t)((int64_t)range_finder.timestamp / 100 -
+						(int64_t)ekf2_timestamps.timestamp / 100);
 			}
-
-		} else {
-			_range_finder_sub_index = getRangeSubIndex();
 		}
 
-		// get external vision data
-		// if error estimates are unavailable, use parameter defined defaults
-		if (_ev_odom_sub.updated()) {
-			// copy both attitude & position, we need both to fill a single ext_vision_message
-			vehicle_odometry_s ev_odom;
-			_ev_odom_sub.copy(&ev_odom);
-
-			ext_vision_message ev_data;
-
-			// check for valid position data
-			if (PX4_ISFINITE(ev_odom.x) && PX4_ISFINITE(ev_odom.y) && PX4_ISFINITE(ev_odom.z)) {
-				ev_data.posNED(0) = ev_odom.x;
-				ev_data.posNED(1) = ev_odom.y;
-				ev_data.posNED(2) = ev_odom.z;
-
-				// position measurement error from parameters
-				if (PX4_ISFINITE(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_X_VARIANCE])) {
-					ev_data.posErr = fmaxf(_param_ekf2_evp_noise.get(),
-							       sqrtf(fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_X_VARIANCE],
-									   ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_Y_VARIANCE])));
-					ev_data.hgtErr = fmaxf(_param_ekf2_evp_noise.get(),
-							       sqrtf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_Z_VARIANCE]));
+	} else if (now > _range_finder_search_time + 1_s) {
+		// looking for a downward facing range finder polls every instance, do it at a low rate
+		_range_finder_search_time = now;
+		_range_finder_sub_index = getRangeSubIndex();
+	}
 
-				} else {
-					ev_data.posErr = _param_ekf2_evp_noise.get();
-					ev_data.hgtErr = _param_ekf2_evp_noise.get();
-				}
-			}
+	// get external vision data
+	// if error estimates are unavailable, use parameter defined defaults
+	if (aux_updated & AUX_VISUAL_ODOMETRY) {
+		// copy both attitude & position, we need both to fill a single ext_vision_message
+		vehicle_odometry_s ev_odom;
+		_ev_odom_sub.copy(&ev_odom);
+
+		ext_vision_message ev_data;
+
+		// check for valid position data
+		if (PX4_ISFINITE(ev_odom.x) && PX4_ISFINITE(ev_odom.y) && PX4_ISFINITE(ev_odom.z)) {
+			ev_data.posNED(0) = ev_odom.x;
+			ev_data.posNED(1) = ev_odom.y;
+			ev_data.posNED(2) = ev_odom.z;
+
+			// position measurement error from parameters
+			if (PX4_ISFINITE(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_X_VARIANCE])) {
+				ev_data.posErr = fmaxf(_param_ekf2_evp_noise.get(),
+						       sqrtf(fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_X_VARIANCE],
+								   ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_Y_VARIANCE])));
+				ev_data.hgtErr = fmaxf(_param_ekf2_evp_noise.get(),
+						       sqrtf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_Z_VARIANCE]));
 
-			// check for valid orientation data
-			if (PX4_ISFINITE(ev_odom.q[0])) {
-				ev_data.quat = matrix::Quatf(ev_odom.q);
+			} else {
+				ev_data.posErr = _param_ekf2_evp_noise.get();
+				ev_data.hgtErr = _param_ekf2_evp_noise.get();
+			}
+		}
 
-				// orientation measurement error from parameters
-				if (PX4_ISFINITE(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_ROLL_VARIANCE])) {
-					ev_data.angErr = fmaxf(_param_ekf2_eva_noise.get(),
-							       sqrtf(fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_ROLL_VARIANCE],
-									   fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_PITCH_VARIANCE],
-											   ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_YAW_VARIANCE]))));
+		// check for valid orientation data
+		if (PX4_ISFINITE(ev_odom.q[0])) {
+			ev_data.quat = matrix::Quatf(ev_odom.q);
 
-				} else {
-					ev_data.angErr = _param_ekf2_eva_noise.get();
-				}
-			}
+			// orientation measurement error from parameters
+			if (PX4_ISFINITE(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_ROLL_VARIANCE])) {
+				ev_data.angErr = fmaxf(_param_ekf2_eva_noise.get(),
+						       sqrtf(fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_ROLL_VARIANCE],
+								   fmaxf(ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_PITCH_VARIANCE],
+										   ev_odom.pose_covariance[ev_odom.COVARIANCE_MATRIX_YAW_VARIANCE]))));
 
-			// only set data if all positions and orientation are valid
-			if (ev_data.posErr < ep_max_std_dev && ev_data.angErr < eo_max_std_dev) {
-				// use timestamp from external computer, clocks are synchronized when using MAVROS
-				_ekf.setExtVisionData(ev_odom.timestamp, &ev_data);
+			} else {
+				ev_data.angErr = _param_ekf2_eva_noise.get();
 			}
+		}
 
-			ekf2_timestamps.visual_odometry_timestamp_rel = (int16_t)((int64_t)ev_odom.timestamp / 100 -
-					(int64_t)ekf2_timestamps.timestamp / 100);
+		// only set data if all positions and orientation are valid
+		if (ev_data.posErr < ep_max_std_dev && ev_data.angErr < eo_max_std_dev) {
+			// use timestamp from external computer, clocks are synchronized when using MAVROS
+			_ekf.setExtVisionData(ev_odom.timestamp, &ev_data);
 		}
 
-		bool vehicle_land_detected_updated = _vehicle_land_detected_sub.updated();
+		ekf2_timestamps.visual_odometry_timestamp_rel = (int16_t)((int64_t)ev_odom.timestamp / 100 -
+				(int64_t)ekf2_timestamps.timestamp / 100);
+	}
 
-		if (vehicle_land_detected_updated) {
-			if (_vehicle_land_detected_sub.copy(&vehicle_land_detected)) {
-				_ekf.set_in_air_status(!vehicle_land_detected.landed);
-			}
+	if (aux_updated & AUX_LAND_DETECTED) {
+		if (_vehicle_land_detected_sub.copy(&_vehicle_land_detected)) {
+			_ekf.set_in_air_status(!_vehicle_land_detected.landed);
 		}
+	}
 
-		// use the landing target pose estimate as another source of velocity data
-		if (_landing_target_pose_sub.updated()) {
-			landing_target_pose_s landing_target_pose;
-
-			if (_landing_target_pose_sub.copy(&landing_target_pose)) {
-				// we can only use the landing target if it has a fixed position and  a valid velocity estimate
-				if (landing_target_pose.is_static && landing_target_pose.rel_vel_valid) {
-					// velocity of vehicle relative to target has opposite sign to target relative to vehicle
-					float velocity[2] = { -landing_target_pose.vx_rel, -landing_target_pose.vy_rel};
-					float variance[2] = {landing_target_pose.cov_vx_rel, landing_target_pose.cov_vy_rel};
-					_ekf.setAuxVelData(landing_target_pose.timestamp, velocity, variance);
-				}
+	// use the landing target pose estimate as another source of velocity data
+	if (aux_updated & AUX_LANDING_TARGET) {
+		landing_target_pose_s landing_target_pose;
+
+		if (_landing_target_pose_sub.copy(&landing_target_pose)) {
+			// we can only use the landing target if it has a fixed position and  a valid velocity estimate
+			if (landing_target_pose.is_static && landing_target_pose.rel_vel_valid) {
+				// velocity of vehicle relative to target has opposite sign to target relative to vehicle
+				float velocity[2] = { -landing_target_pose.vx_rel, -landing_target_pose.vy_rel};
+				float variance[2] = {landing_target_pose.cov_vx_rel, landing_target_pose.cov_vy_rel};
+				_ekf.setAuxVelData(landing_target_pose.timestamp, velocity, variance);
 			}
 		}
+	}
 
-		perf_end(_perf_update_data);
+	perf_end(_perf_update_data);
 
-		// run the EKF update and output
-		perf_begin(_perf_ekf_update);
-		const bool updated = _ekf.update();
-		perf_end(_perf_ekf_update);
+	// run the EKF update and output
+	perf_begin(_perf_ekf_update);
+	const bool updated = _ekf.update();
+	perf_end(_perf_ekf_update);
 
-		// integrate time to monitor time slippage
-		if (_start_time_us == 0) {
-			_start_time_us = now;
-			_last_time_slip_us = 0;
+	// integrate time to monitor time slippage
+	if (_start_time_us == 0) {
+		_start_time_us = now;
+		_last_time_slip_us = 0;
 
-		} else if (_start_time_us > 0) {
-			_integrated_time_us += sensors.gyro_integral_dt;
-			_last_time_slip_us = (now - _start_time_us) - _integrated_time_us;
-		}
+	} else if (_start_time_us > 0) {
+		_integrated_time_us += sensors.gyro_integral_dt;
+		_last_time_slip_us = (now - _start_time_us) - _integrated_time_us;
+	}
 
-		if (updated) {
-
-			filter_control_status_u control_status;
-			_ekf.get_control_mode(&control_status.value);
-
-			// only publish position after successful alignment
-			if (control_status.flags.tilt_align) {
-				// generate vehicle local position data
-				vehicle_local_position_s &lpos = _vehicle_local_position_pub.get();
-
-				// generate vehicle odometry data
-				vehicle_odometry_s odom{};
-
-				lpos.timestamp = now;
-				odom.timestamp = lpos.timestamp;
-
-				odom.local_frame = odom.LOCAL_FRAME_NED;
-
-				// Position of body origin in local NED frame
-				float position[3];
-				_ekf.get_position(position);
-				const float lpos_x_prev = lpos.x;
-				const float lpos_y_prev = lpos.y;
-				lpos.x = (_ekf.local_position_is_valid()) ? position[0] : 0.0f;
-				lpos.y = (_ekf.local_position_is_valid()) ? position[1] : 0.0f;
-				lpos.z = position[2];
-
-				// Vehicle odometry position
-				odom.x = lpos.x;
-				odom.y = lpos.y;
-				odom.z = lpos.z;
-
-				// Velocity of body origin in local NED frame (m/s)
-				float velocity[3];
-				_ekf.get_velocity(velocity);
-				lpos.vx = velocity[0];
-				lpos.vy = velocity[1];
-				lpos.vz = velocity[2];
-
-				// Vehicle odometry linear velocity
-				odom.vx = lpos.vx;
-				odom.vy = lpos.vy;
-				odom.vz = lpos.vz;
-
-				// vertical position time derivative (m/s)
-				_ekf.get_pos_d_deriv(&lpos.z_deriv);
-
-				// Acceleration of body origin in local NED frame
-				float vel_deriv[3];
-				_ekf.get_vel_deriv_ned(vel_deriv);
-				lpos.ax = vel_deriv[0];
-				lpos.ay = vel_deriv[1];
-				lpos.az = vel_deriv[2];
-
-				// TODO: better status reporting
-				lpos.xy_valid = _ekf.local_position_is_valid() && !_preflt_horiz_fail;
-				lpos.z_valid = !_preflt_vert_fail;
-				lpos.v_xy_valid = _ekf.local_position_is_valid() && !_preflt_horiz_fail;
-				lpos.v_z_valid = !_preflt_vert_fail;
-
-				// Position of local NED origin in GPS / WGS84 frame
-				map_projection_reference_s ekf_origin;
-				uint64_t origin_time;
-
-				// true if position (x,y,z) has a valid WGS-84 global reference (ref_lat, ref_lon, alt)
-				const bool ekf_origin_valid = _ekf.get_ekf_origin(&origin_time, &ekf_origin, &lpos.ref_alt);
-				lpos.xy_global = ekf_origin_valid;
-				lpos.z_global = ekf_origin_valid;
-
-				if (ekf_origin_valid && (origin_time > lpos.ref_timestamp)) {
-					lpos.ref_timestamp = origin_time;
-					lpos.ref_lat = ekf_origin.lat_rad * 180.0 / M_PI; // Reference point latitude in degrees
-					lpos.ref_lon = ekf_origin.lon_rad * 180.0 / M_PI; // Reference point longitude in degrees
-				}
+	if (updated) {
+
+		filter_control_status_u control_status;
+		_ekf.get_control_mode(&control_status.value);
+
+		// only publish position after successful alignment
+		if (control_status.flags.tilt_align) {
+			// generate vehicle local position data
+			vehicle_local_position_s &lpos = _vehicle_local_position_pub.get();
+
+			// generate vehicle odometry data
+			vehicle_odometry_s odom{};
+
+			lpos.timestamp = now;
+			odom.timestamp = lpos.timestamp;
+
+			odom.local_frame = odom.LOCAL_FRAME_NED;
+
+			// Position of body origin in local NED frame
+			float position[3];
+			_ekf.get_position(position);
+			const float lpos_x_prev = lpos.x;
+			const float lpos_y_prev = lpos.y;
+			lpos.x = (_ekf.local_position_is_valid()) ? position[0] : 0.0f;
+			lpos.y = (_ekf.local_position_is_valid()) ? position[1] : 0.0f;
+			lpos.z = position[2];
+
+			// Vehicle odometry position
+			odom.x = lpos.x;
+			odom.y = lpos.y;
+			odom.z = lpos.z;
+
+			// Velocity of body origin in local NED frame (m/s)
+			float velocity[3];
+			_ekf.get_velocity(velocity);
+			lpos.vx = velocity[0];
+			lpos.vy = velocity[1];
+			lpos.vz = velocity[2];
+
+			// Vehicle odometry linear velocity
+			odom.vx = lpos.vx;
+			odom.vy = lpos.vy;
+			odom.vz = lpos.vz;
+
+			// vertical position time derivative (m/s)
+			_ekf.get_pos_d_deriv(&lpos.z_deriv);
+
+			// Acceleration of body origin in local NED frame
+			float vel_deriv[3];
+			_ekf.get_vel_deriv_ned(vel_deriv);
+			lpos.ax = vel_deriv[0];
+			lpos.ay = vel_deriv[1];
+			lpos.az = vel_deriv[2];
+
+			// TODO: better status reporting
+			lpos.xy_valid = _ekf.local_position_is_valid() && !_preflt_horiz_fail;
+			lpos.z_valid = !_preflt_vert_fail;
+			lpos.v_xy_valid = _ekf.local_position_is_valid() && !_preflt_horiz_fail;
+			lpos.v_z_valid = !_preflt_vert_fail;
+
+			// Position of local NED origin in GPS / WGS84 frame
+			map_projection_reference_s ekf_origin;
+			uint64_t origin_time;
+
+			// true if position (x,y,z) has a valid WGS-84 global reference (ref_lat, ref_lon, alt)
+			const bool ekf_origin_valid = _ekf.get_ekf_origin(&origin_time, &ekf_origin, &lpos.ref_alt);
+			lpos.xy_global = ekf_origin_valid;
+			lpos.z_global = ekf_origin_valid;
+
+			if (ekf_origin_valid && (origin_time > lpos.ref_timestamp)) {
+				lpos.ref_timestamp = origin_time;
+				lpos.ref_lat = ekf_origin.lat_rad * 180.0 / M_PI; // Reference point latitude in degrees
+				lpos.ref_lon = ekf_origin.lon_rad * 180.0 / M_PI; // Reference point longitude in degrees
+			}
 
-				// The rotation of the tangent plane vs. geographical north
-				matrix::Quatf q;
-				_ekf.copy_quaternion(q.data());
+			// The rotation of the tangent plane vs. geographical north
+			matrix::Quatf q;
+			_ekf.copy_quaternion(q.data());
 
-				lpos.yaw = matrix::Eulerf(q).psi();
+			lpos.yaw = matrix::Eulerf(q).psi();
 
-				// Vehicle odometry quaternion
-				q.copyTo(odom.q);
+			// Vehicle odometry quaternion
+			q.copyTo(odom.q);
 
-				// Vehicle odometry angular rates
-				float gyro_bias[3];
-				_ekf.get_gyro_bias(gyro_bias);
-				odom.rollspeed = sensors.gyro_rad[0] - gyro_bias[0];
-				odom.pitchspeed = sensors.gyro_rad[1] - gyro_bias[1];
-				odom.yawspeed = sensors.gyro_rad[2] - gyro_bias[2];
+			// Vehicle odometry angular rates
+			float gyro_bias[3];
+			_ekf.get_gyro_bias(gyro_bias);
+			odom.rollspeed = sensors.gyro_rad[0] - gyro_bias[0];
+			odom.pitchspeed = sensors.gyro_rad[1] - gyro_bias[1];
+			odom.yawspeed = sensors.gyro_rad[2] - gyro_bias[2];
 
-				lpos.dist_bottom_valid = _ekf.get_terrain_valid();
+			lpos.dist_bottom_valid = _ekf.get_terrain_valid();
 
-				float terrain_vpos;
-				_ekf.get_terrain_vert_pos(&terrain_vpos);
-				lpos.dist_bottom = terrain_vpos - lpos.z; // Distance to bottom surface (ground) in meters
+			float terrain_vpos;
+			_ekf.get_terrain_vert_pos(&terrain_vpos);
+			lpos.dist_bottom = terrain_vpos - lpos.z; // Distance to bottom surface (ground) in meters
 
-				// constrain the distance to ground to _rng_gnd_clearance
-				if (lpos.dist_bottom < _param_ekf2_min_rng.get()) {
-					lpos.dist_bottom = _param_ekf2_min_rng.get();
-				}
-
-				if (!_had_valid_terrain) {
-					_had_valid_terrain = lpos.dist_bottom_valid;
-				}
+			// constrain the distance to ground to _rng_gnd_clearance
+			if (lpos.dist_bottom < _param_ekf2_min_rng.get()) {
+				lpos.dist_bottom = _param_ekf2_min_rng.get();
+			}
 
-				// only consider ground effect if compensation is configured and the vehicle is armed (props spinning)
-				if (_param_ekf2_gnd_eff_dz.get() > 0.0f && vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) {
-					// set ground effect flag if vehicle is closer than a specified distance to the ground
-					if (lpos.dist_bottom_valid) {
-						_ekf.set_gnd_effect_flag(lpos.dist_bottom < _param_ekf2_gnd_max_hgt.get());
+			if (!_had_valid_terrain) {
+				_had_valid_terrain = lpos.dist_bottom_valid;
+			}
 
-						// if we have no valid terrain estimate and never had one then use ground effect flag from land detector
-						// _had_valid_terrain is used to make sure that we don't fall back to using this option
-						// if we temporarily lose terrain data due to the distance sensor getting out of range
+			// only consider ground effect if compensation is configured and the vehicle is armed (props spinning)
+			if (_param_ekf2_gnd_eff_dz.get() > 0.0f && _vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) {
+				// set ground effect flag if vehicle is closer than a specified distance to the ground
+				if (lpos.dist_bottom_valid) {
+					_ekf.set_gnd_effect_flag(lpos.dist_bottom < _param_ekf2_gnd_max_hgt.get());
 
-					} else if (vehicle_land_detected_updated && !_had_valid_terrain) {
-						// update ground effect flag based on land detector state
-						_ekf.set_gnd_effect_flag(vehicle_land_detected.in_ground_effect);
-					}
+					// if we have no valid terrain estimate and never had one then use ground effect flag from land detector
+					// _had_valid_terrain is used to make sure that we don't fall back to using this option
+					// if we temporarily lose terrain data due to the distance sensor getting out of range
 
-				} else {
-					_ekf.set_gnd_effect_flag(false);
+				} else if ((aux_updated & AUX_LAND_DETECTED) && !_had_valid_terrain) {
+					// update ground effect flag based on land detector state
+					_ekf.set_gnd_effect_flag(_vehicle_land_detected.in_ground_effect);
 				}
 
-				lpos.dist_bottom_rate = -lpos.vz; // Distance to bottom surface (ground) change rate
-
-				_ekf.get_ekf_lpos_accuracy(&lpos.eph, &lpos.epv);
-				_ekf.get_ekf_vel_accuracy(&lpos.evh, &lpos.evv);
+			} else {
+				_ekf.set_gnd_effect_flag(false);
+			}
 
-				// get state reset information of position and velocity
-				_ekf.get_posD_reset(&lpos.delta_z, &lpos.z_reset_counter);
-				_ekf.get_velD_reset(&lpos.delta_vz, &lpos.vz_reset_counter);
-				_ekf.get_posNE_reset(&lpos.delta_xy[0], &lpos.xy_reset_counter);
-				_ekf.get_velNE_reset(&lpos.delta_vxy[0], &lpos.vxy_reset_counter);
+			lpos.dist_bottom_rate = -lpos.vz; // Distance to bottom surface (ground) change rate
 
-				// get control limit information
-				_ekf.get_ekf_ctrl_limits(&lpos.vxy_max, &lpos.vz_max, &lpos.hagl_min, &lpos.hagl_max);
+			_ekf.get_ekf_lpos_accuracy(&lpos.eph, &lpos.epv);
+			_ekf.get_ekf_vel_accuracy(&lpos.evh, &lpos.evv);
 
-				// convert NaN to INFINITY
-				if (!PX4_ISFINITE(lpos.vxy_max)) {
-					lpos.vxy_max = INFINITY;
-				}
+			// get state reset information of position and velocity
+			_ekf.get_posD_reset(&lpos.delta_z, &lpos.z_reset_counter);
+			_ekf.get_velD_reset(&lpos.delta_vz, &lpos.vz_reset_counter);
+			_ekf.get_posNE_reset(&lpos.delta_xy[0], &lpos.xy_reset_counter);
+			_ekf.get_velNE_reset(&lpos.delta_vxy[0], &lpos.vxy_reset_counter);
 
-				if (!PX4_ISFINITE(lpos.vz_max)) {
-					lpos.vz_max = INFINITY;
-				}
+			// get control limit information
+			_ekf.get_ekf_ctrl_limits(&lpos.vxy_max, &lpos.vz_max, &lpos.hagl_min, &lpos.hagl_max);
 
-				if (!PX4_ISFINITE(lpos.hagl_min)) {
-					lpos.hagl_min = INFINITY;
-				}
+			// convert NaN to INFINITY
+			if (!PX4_ISFINITE(lpos.vxy_max)) {
+				lpos.vxy_max = INFINITY;
+			}
 
-				if (!PX4_ISFINITE(lpos.hagl_max)) {
-					lpos.hagl_max = INFINITY;
-				}
+			if (!PX4_ISFINITE(lpos.vz_max)) {
+				lpos.vz_max = INFINITY;
+			}
 
-				// Get covariances to vehicle odometry
-				float covariances[24];
-				_ekf.covariances_diagonal().copyTo(covariances);
+			if (!PX4_ISFINITE(lpos.hagl_min)) {
+				lpos.hagl_min = INFINITY;
+			}
 
-				// get the covariance matrix size
-				const size_t POS_URT_SIZE = sizeof(odom.pose_covariance) / sizeof(odom.pose_covariance[0]);
-				const size_t VEL_URT_SIZE = sizeof(odom.velocity_covariance) / sizeof(odom.velocity_covariance[0]);
+			if (!PX4_ISFINITE(lpos.hagl_max)) {
+				lpos.hagl_max = INFINITY;
+			}
 
-				// initially set pose covariances to 0
-				for (size_t i = 0; i < POS_URT_SIZE; i++) {
-					odom.pose_covariance[i] = 0.0;
-				}
+			// Get covariances to vehicle odometry
+			float covariances[24];
+			_ekf.covariances_diagonal().copyTo(covariances);
 
-				// set the position variances
-				odom.pose_covariance[odom.COVARIANCE_MATRIX_X_VARIANCE] = covariances[7];
-				odom.pose_covariance[odom.COVARIANCE_MATRIX_Y_VARIANCE] = covariances[8];
-				odom.pose_covariance[odom.COVARIANCE_MATRIX_Z_VARIANCE] = covariances[9];
+			// get the covariance matrix size
+			const size_t POS_URT_SIZE = sizeof(odom.pose_covariance) / sizeof(odom.pose_covariance[0]);
+			const size_t VEL_URT_SIZE = sizeof(odom.velocity_covariance) / sizeof(odom.velocity_covariance[0]);
 
-				// TODO: implement propagation from quaternion covariance to Euler angle covariance
-				// by employing the covariance law
+			// initially set pose covariances to 0
+			for (size_t i = 0; i < POS_URT_SIZE; i++) {
+				odom.pose_covariance[i] = 0.0;
+			}
 
-				// initially set velocity covariances to 0
-				for (size_t i = 0; i < VEL_URT_SIZE; i++) {
-					odom.velocity_covariance[i] = 0.0;
-				}
+			// set the position variances
+			odom.pose_covariance[odom.COVARIANCE_MATRIX_X_VARIANCE] = covariances[7];
+			odom.pose_covariance[odom.COVARIANCE_MATRIX_Y_VARIANCE] = covariances[8];
+			odom.pose_covariance[odom.COVARIANCE_MATRIX_Z_VARIANCE] = covariances[9];
 
-				// set the linear velocity variances
-				odom.velocity_covariance[odom.COVARIANCE_MATRIX_VX_VARIANCE] = covariances[4];
-				odom.velocity_covariance[odom.COVARIANCE_MATRIX_VY_VARIANCE] = covariances[5];
-				odom.velocity_covariance[odom.COVARIANCE_MATRIX_VZ_VARIANCE] = covariances[6];
+			// TODO: implement propagation from quaternion covariance to Euler angle covariance
+			// by employing the covariance law
 
-				// publish vehicle local position data
-				_vehicle_local_position_pub.update();
+			// initially set velocity covariances to 0
+			for (size_t i = 0; i < VEL_URT_SIZE; i++) {
+				odom.velocity_covariance[i] = 0.0;
+			}
 
-				// publish vehicle odometry data
-				_vehicle_odometry_pub.publish(odom);
+			// set the linear velocity variances
+			odom.velocity_covariance[odom.COVARIANCE_MATRIX_VX_VARIANCE] = covariances[4];
+			odom.velocity_covariance[odom.COVARIANCE_MATRIX_VY_VARIANCE] = covariances[5];
+			odom.velocity_covariance[odom.COVARIANCE_MATRIX_VZ_VARIANCE] = covariances[6];
 
-				if (_ekf.global_position_is_valid() && !_preflt_fail) {
-					// generate and publish global position data
-					vehicle_global_position_s &global_pos = _vehicle_global_position_pub.get();
+			// publish vehicle local position data
+			publish_output<vehicle_local_position_s>(_vehicle_local_position_pub, lpos);
 
-					global_pos.timestamp = now;
+			// publish vehicle odometry data
+			_vehicle_odometry_pub.publish(odom);
 
-					if (fabsf(lpos_x_prev - lpos.x) > FLT_EPSILON || fabsf(lpos_y_prev - lpos.y) > FLT_EPSILON) {
-						map_projection_reproject(&ekf_origin, lpos.x, lpos.y, &global_pos.lat, &global_pos.lon);
-					}
+			if (_ekf.global_position_is_valid() && !_preflt_fail) {
+				// generate and publish global position data
+				vehicle_global_position_s &global_pos = _vehicle_global_position_pub.get();
 
-					global_pos.lat_lon_reset_counter = lpos.xy_reset_counter;
+				global_pos.timestamp = now;
 
-					global_pos.alt = -lpos.z + lpos.ref_alt; // Altitude AMSL in meters
-					global_pos.alt_ellipsoid = filter_altitude_ellipsoid(global_pos.alt);
+				if (fabsf(lpos_x_prev - lpos.x) > FLT_EPSILON || fabsf(lpos_y_prev - lpos.y) > FLT_EPSILON) {
+					map_projection_reproject(&ekf_origin, lpos.x, lpos.y, &global_pos.lat, &global_pos.lon);
+				}
 
-					// global altitude has opposite sign of local down position
-					global_pos.delta_alt = -lpos.delta_z;
+				global_pos.lat_lon_reset_counter = lpos.xy_reset_counter;
 
-					global_pos.vel_n = lpos.vx; // Ground north velocity, m/s
-					global_pos.vel_e = lpos.vy; // Ground east velocity, m/s
-					global_pos.vel_d = lpos.vz; // Ground downside velocity, m/s
+				global_pos.alt = -lpos.z + lpos.ref_alt; // Altitude AMSL in meters
+				global_pos.alt_ellipsoid = filter_altitude_ellipsoid(global_pos.alt);
 
-					global_pos.yaw = lpos.yaw; // Yaw in radians -PI..+PI.
+				// global altitude has opposite sign of local down position
+				global_pos.delta_alt = -lpos.delta_z;
 
-					_ekf.get_ekf_gpos_accuracy(&global_pos.eph, &global_pos.epv);
+				global_pos.vel_n = lpos.vx; // Ground north velocity, m/s
+				global_pos.vel_e = lpos.vy; // Ground east velocity, m/s
+				global_pos.vel_d = lpos.vz; // Ground downside velocity, m/s
 
-					global_pos.terrain_alt_valid = lpos.dist_bottom_valid;
+				global_pos.yaw = lpos.yaw; // Yaw in radians -PI..+PI.
 
-					if (global_pos.terrain_alt_valid) {
-						global_pos.terrain_alt = lpos.ref_alt - terrain_vpos; // Terrain altitude in m, WGS84
+				_ekf.get_ekf_gpos_accuracy(&global_pos.eph, &global_pos.epv);
 
-					} else {
-						global_pos.terrain_alt = 0.0f; // Terrain altitude in m, WGS84
-					}
+				global_pos.terrain_alt_valid = lpos.dist_bottom_valid;
 
-					global_pos.dead_reckoning = _ekf.inertial_dead_reckoning(); // True if this position is estimated through dead-reckoning
+				if (global_pos.terrain_alt_valid) {
+					global_pos.terrain_alt = lpos.ref_alt - terrain_vpos; // Terrain altitude in m, WGS84
 
-					_vehicle_global_position_pub.update();
+				} else {
+					global_pos.terrain_alt = 0.0f; // Terrain altitude in m, WGS84
 				}
+
+				global_pos.dead_reckoning = _ekf.inertial_dead_reckoning(); // True if this position is estimated through dead-reckoning
+
+				publish_output<vehicle_global_position_s>(_vehicle_global_position_pub, global_pos);
 			}
+		}
 
-			{
-				// publish all corrected sensor readings and bias estimates after mag calibration is updated above
-				sensor_bias_s bias{};
+		{
+			// publish all corrected sensor readings and bias estimates after mag calibration is updated above
+			sensor_bias_s bias{};
 
-				bias.timestamp = now;
+			bias.timestamp = now;
 
-				// In-run bias estimates
-				_ekf.get_gyro_bias(bias.gyro_bias);
-				_ekf.get_accel_bias(bias.accel_bias);
+			// In-run bias estimates
+			_ekf.get_gyro_bias(bias.gyro_bias);
+			_ekf.get_accel_bias(bias.accel_bias);
 
-				bias.mag_bias[0] = _last_valid_mag_cal[0];
-				bias.mag_bias[1] = _last_valid_mag_cal[1];
-				bias.mag_bias[2] = _last_valid_mag_cal[2];
+			bias.mag_bias[0] = _last_valid_mag_cal[0];
+			bias.mag_bias[1] = _last_valid_mag_cal[1];
+			bias.mag_bias[2] = _last_valid_mag_cal[2];
 
-				_sensor_bias_pub.publish(bias);
-			}
+			_sensor_bias_pub.publish(bias);
+		}
 
-			// publish estimator status
-			estimator_status_s status;
-			status.timestamp = now;
-			_ekf.get_state_delayed(status.states);
-			status.n_states = 24;
-			_ekf.covariances_diagonal().copyTo(status.covariances);
-			_ekf.get_gps_check_status(&status.gps_check_fail_flags);
-			// only report enabled GPS check failures (the param indexes are shifted by 1 bit, because they don't include
-			// the GPS Fix bit, which is always checked)
-			status.gps_check_fail_flags &= ((uint16_t)_params->gps_check_mask << 1) | 1;
-			status.control_mode_flags = control_status.value;
-			_ekf.get_filter_fault_status(&status.filter_fault_flags);
-			_ekf.get_innovation_test_status(&status.innovation_check_flags, &status.mag_test_ratio,
-							&status.vel_test_ratio, &status.pos_test_ratio,
-							&status.hgt_test_ratio, &status.tas_test_ratio,
-							&status.hagl_test_ratio, &status.beta_test_ratio);
-
-			status.pos_horiz_accuracy = _vehicle_local_position_pub.get().eph;
-			status.pos_vert_accuracy = _vehicle_local_position_pub.get().epv;
-			_ekf.get_ekf_soln_status(&status.solution_status_flags);
-			_ekf.get_imu_vibe_metrics(status.vibe);
-			status.time_slip = _last_time_slip_us / 1e6f;
-			status.health_flags = 0.0f; // unused
-			status.timeout_flags = 0.0f; // unused
-			status.pre_flt_fail = _preflt_fail;
-
-			_estimator_status_pub.publish(status);
-
-			// publish GPS drift data only when updated to minimise overhead
-			float gps_drift[3];
-			bool blocked;
-
-			if (_ekf.get_gps_drift_metrics(gps_drift, &blocked)) {
-				ekf_gps_drift_s drift_data;
-				drift_data.timestamp = now;
-				drift_data.hpos_drift_rate = gps_drift[0];
-				drift_data.vpos_drift_rate = gps_drift[1];
-				drift_data.hspd = gps_drift[2];
-				drift_data.blocked = blocked;
-
-				_ekf_gps_drift_pub.publish(drift_data);
-			}
+		// publish estimator status
+		estimator_status_s status;
+		status.timestamp = now;
+		_ekf.get_state_delayed(status.states);
+		status.n_states = 24;
+		_ekf.covariances_diagonal().copyTo(status.covariances);
+		_ekf.get_gps_check_status(&status.gps_check_fail_flags);
+		// only report enabled GPS check failures (the param indexes are shifted by 1 bit, because they don't include
+		// the GPS Fix bit, which is always checked)
+		status.gps_check_fail_flags &= ((uint16_t)_params->gps_check_mask << 1) | 1;
+		status.control_mode_flags = control_status.value;
+		_ekf.get_filter_fault_status(&status.filter_fault_flags);
+		_ekf.get_innovation_test_status(&status.innovation_check_flags, &status.mag_test_ratio,
+						&status.vel_test_ratio, &status.pos_test_ratio,
+						&status.hgt_test_ratio, &status.tas_test_ratio,
+						&status.hagl_test_ratio, &status.beta_test_ratio);
+
+		status.pos_horiz_accuracy = _vehicle_local_position_pub.get().eph;
+		status.pos_vert_accuracy = _vehicle_local_position_pub.get().epv;
+		_ekf.get_ekf_soln_status(&status.solution_status_flags);
+		_ekf.get_imu_vibe_metrics(status.vibe);
+		status.time_slip = _last_time_slip_us / 1e6f;
+		status.health_flags = 0.0f; // unused
+		status.timeout_flags = 0.0f; // unused
+		status.pre_flt_fail = _preflt_fail;
+
+		_estimator_status_pub.publish(status);
+
+		if (_selector.enabled()) {
+			_selector.update(status);
+		}
 
-			{
-				/* Check and save learned magnetometer bias estimates */
+		// publish GPS drift data only when updated to minimise overhead
+		float gps_drift[3];
+		bool blocked;
 
-				// Check if conditions are OK for learning of magnetometer bias values
-				if (!vehicle_land_detected.landed && // not on ground
-				    (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) && // vehicle is armed
-				    !status.filter_fault_flags && // there are no filter faults
-				    control_status.flags.mag_3D) { // the EKF is operating in the correct mode
+		if (_ekf.get_gps_drift_metrics(gps_drift, &blocked)) {
+			ekf_gps_drift_s drift_data;
+			drift_data.timestamp = now;
+			drift_data.hpos_drift_rate = gps_drift[0];
+			drift_data.vpos_drift_rate = gps_drift[1];
+			drift_data.hspd = gps_drift[2];
+			drift_data.blocked = blocked;
 
-					if (_last_magcal_us == 0) {
-						_last_magcal_us = now;
+			_ekf_gps_drift_pub.publish(drift_data);
+		}
 
-					} else {
-						_total_cal_time_us += now - _last_magcal_us;
-						_last_magcal_us = now;
-					}
+		{
+			/* Check and save learned magnetometer bias estimates */
 
-				} else if (status.filter_fault_flags != 0) {
-					// if a filter fault has occurred, assume previous learning was invalid and do not
-					// count it towards total learning time.
-					_total_cal_time_us = 0;
+			// Check if conditions are OK for learning of magnetometer bias values
+			if (!_vehicle_land_detected.landed && // not on ground
+			    (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_ARMED) && // vehicle is armed
+			    !status.filter_fault_flags && // there are no filter faults
+			    control_status.flags.mag_3D) { // the EKF is operating in the correct mode
 
-					for (bool &cal_available : _valid_cal_available) {
-						cal_available = false;
-					}
+				if (_last_magcal_us == 0) {
+					_last_magcal_us = now;
+
+				} else {
+					_total_cal_time_us += now - _last_magcal_us;
+					_last_magcal_us = now;
+				}
+
+			} else if (status.filter_fault_flags != 0) {
+				// if a filter fault has occurred, assume previous learning was invalid and do not
+				// count it towards total learning time.
+				_total_cal_time_us = 0;
+
+				for (bool &cal_available : _valid_cal_available) {
+					cal_available = false;
 				}
+			}
 
-				// Start checking mag bias estimates when we have accumulated sufficient calibration time
-				if (_total_cal_time_us > 120_s) {
-					// we have sufficient accumulated valid flight time to form a reliable bias estimate
-					// check that the state variance for each axis is within a range indicating filter convergence
-					const float max_var_allowed = 100.0f * _param_ekf2_magb_vref.get();
-					const float min_var_allowed = 0.01f * _param_ekf2_magb_vref.get();
+			// Start checking mag bias estimates when we have accumulated sufficient calibration time
+			if (_total_cal_time_us > 120_s) {
+				// we have sufficient accumulated valid flight time to form a reliable bias estimate
+				// check that the state variance for each axis is within a range indicating filter convergence
+				const float max_var_allowed = 100.0f * _param_ekf2_magb_vref.get();
+				const float min_var_allowed = 0.01f * _param_ekf2_magb_vref.get();
 
-					// Declare all bias estimates invalid if any variances are out of range
-					bool all_estimates_invalid = false;
+				// Declare all bias estimates invalid if any variances are out of range
+				bool all_estimates_invalid = false;
 
-					for (uint8_t axis_index = 0; axis_index <= 2; axis_index++) {
-						if (status.covariances[axis_index + 19] < min_var_allowed
-						    || status.covariances[axis_index + 19] > max_var_allowed) {
-							all_estimates_invalid = true;
-						}
+				for (uint8_t axis_index = 0; axis_index <= 2; axis_index++) {
+					if (status.covariances[axis_index + 19] < min_var_allowed
+					    || status.covariances[axis_index + 19] > max_var_allowed) {
+						all_estimates_invalid = true;
 					}
+				}
 
-					// Store valid estimates and their associated variances
-					if (!all_estimates_invalid) {
-						for (uint8_t axis_index = 0; axis_index <= 2; axis_index++) {
-							_last_valid_mag_cal[axis_index] = status.states[axis_index + 19];
-							_valid_cal_available[axis_index] = true;
-							_last_valid_variance[axis_index] = status.covariances[axis_index + 19];
-						}
+				// Store valid estimates and their associated variances
+				if (!all_estimates_invalid) {
+					for (uint8_t axis_index = 0; axis_index <= 2; axis_index++) {
+						_last_valid_mag_cal[axis_index] = status.states[axis_index + 19];
+						_valid_cal_available[axis_index] = true;
+						_last_valid_variance[axis_index] = status.covariances[axis_index + 19];
 					}
 				}
+			}
 
-				// Check and save the last valid calibration when we are disarmed
-				if ((vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
-				    && (status.filter_fault_flags == 0)
-				    && (sensor_selection.mag_device_id == (uint32_t)_param_ekf2_magbias_id.get())) {
-
-					update_mag_bias(_param_ekf2_magbias_x, 0);
-					update_mag_bias(_param_ekf2_magbias_y, 1);
-					update_mag_bias(_param_ekf2_magbias_z, 2);
+			// Check and save the last valid calibration when we are disarmed
+			if ((_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
+			    && (status.filter_fault_flags == 0)
+			    && (_sensor_selection.mag_device_id == (uint32_t)_param_ekf2_magbias_id.get())) {
 
-					// reset to prevent data being saved too frequently
-					_total_cal_time_us = 0;
-				}
+				update_mag_bias(_param_ekf2_magbias_x, 0);
+				update_mag_bias(_param_ekf2_magbias_y, 1);
+				update_mag_bias(_param_ekf2_magbias_z, 2);
 
+				// reset to prevent data being saved too frequently
+				_total_cal_time_us = 0;
 			}
 
-			publish_wind_estimate(now);
+		}
 
-			if (!_mag_decl_saved && (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)) {
-				_mag_decl_saved = update_mag_decl(_param_ekf2_mag_decl);
-			}
+		publish_wind_estimate(now);
 
-			{
-				// publish estimator innovation data
-				ekf2_innovations_s innovations;
-				innovations.timestamp = now;
-				_ekf.get_vel_pos_innov(&innovations.vel_pos_innov[0]);
-				_ekf.get_aux_vel_innov(&innovations.aux_vel_innov[0]);
-				_ekf.get_mag_innov(&innovations.mag_innov[0]);
-				_ekf.get_heading_innov(&innovations.heading_innov);
-				_ekf.get_airspeed_innov(&innovations.airspeed_innov);
-				_ekf.get_beta_innov(&innovations.beta_innov);
-				_ekf.get_flow_innov(&innovations.flow_innov[0]);
-				_ekf.get_hagl_innov(&innovations.hagl_innov);
-				_ekf.get_drag_innov(&innovations.drag_innov[0]);
-
-				_ekf.get_vel_pos_innov_var(&innovations.vel_pos_innov_var[0]);
-				_ekf.get_mag_innov_var(&innovations.mag_innov_var[0]);
-				_ekf.get_heading_innov_var(&innovations.heading_innov_var);
-				_ekf.get_airspeed_innov_var(&innovations.airspeed_innov_var);
-				_ekf.get_beta_innov_var(&innovations.beta_innov_var);
-				_ekf.get_flow_innov_var(&innovations.flow_innov_var[0]);
-				_ekf.get_hagl_innov_var(&innovations.hagl_innov_var);
-				_ekf.get_drag_innov_var(&innovations.drag_innov_var[0]);
-
-				_ekf.get_output_tracking_error(&innovations.output_tracking_error[0]);
-
-				// calculate noise filtered velocity innovations which are used for pre-flight checking
-				if (vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY) {
-					// calculate coefficients for LPF applied to innovation sequences
-					float alpha = constrain(sensors.accelerometer_integral_dt / 1.e6f * _innov_lpf_tau_inv, 0.0f, 1.0f);
-					float beta = 1.0f - alpha;
-
-					// filter the velocity and innvovations
-					_vel_ne_innov_lpf(0) = beta * _vel_ne_innov_lpf(0) + alpha * constrain(innovations.vel_pos_innov[0],
-							       -_vel_innov_spike_lim, _vel_innov_spike_lim);
-					_vel_ne_innov_lpf(1) = beta * _vel_ne_innov_lpf(1) + alpha * constrain(innovations.vel_pos_innov[1],
-							       -_vel_innov_spike_lim, _vel_innov_spike_lim);
-					_vel_d_innov_lpf = beta * _vel_d_innov_lpf + alpha * constrain(innovations.vel_pos_innov[2],
-							   -_vel_innov_spike_lim, _vel_innov_spike_lim);
-
-					// set the max allowed yaw innovaton depending on whether we are not aiding navigation using
-					// observations in the NE reference frame.
-					bool doing_ne_aiding = control_status.flags.gps ||  control_status.flags.ev_pos;
-
-					float yaw_test_limit;
-
-					if (doing_ne_aiding && vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
-						// use a smaller tolerance when doing NE inertial frame aiding as a rotary wing
-						// vehicle which cannot use GPS course to realign heading in flight
-						yaw_test_limit = _nav_yaw_innov_test_lim;
+		if (!_mag_decl_saved && (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)) {
+			_mag_decl_saved = update_mag_decl(_param_ekf2_mag_decl);
+		}
 
-					} else {
-						// use a larger tolerance when not doing NE inertial frame aiding or
-						// if a fixed wing vehicle which can realign heading using GPS course
-						yaw_test_limit = _yaw_innov_test_lim;
-					}
+		{
+			// publish estimator innovation data
+			ekf2_innovations_s innovations;
+			innovations.timestamp = now;
+			_ekf.get_vel_pos_innov(&innovations.vel_pos_innov[0]);
+			_ekf.get_aux_vel_innov(&innovations.aux_vel_innov[0]);
+			_ekf.get_mag_innov(&innovations.mag_innov[0]);
+			_ekf.get_heading_innov(&innovations.heading_innov);
+			_ekf.get_airspeed_innov(&innovations.airspeed_innov);
+			_ekf.get_beta_innov(&innovations.beta_innov);
+			_ekf.get_flow_innov(&innovations.flow_innov[0]);
+			_ekf.get_hagl_innov(&innovations.hagl_innov);
+			_ekf.get_drag_innov(&innovations.drag_innov[0]);
+
+			_ekf.get_vel_pos_innov_var(&innovations.vel_pos_innov_var[0]);
+			_ekf.get_mag_innov_var(&innovations.mag_innov_var[0]);
+			_ekf.get_heading_innov_var(&innovations.heading_innov_var);
+			_ekf.get_airspeed_innov_var(&innovations.airspeed_innov_var);
+			_ekf.get_beta_innov_var(&innovations.beta_innov_var);
+			_ekf.get_flow_innov_var(&innovations.flow_innov_var[0]);
+			_ekf.get_hagl_innov_var(&innovations.hagl_innov_var);
+			_ekf.get_drag_innov_var(&innovations.drag_innov_var[0]);
+
+			_ekf.get_output_tracking_error(&innovations.output_tracking_error[0]);
+
+			// calculate noise filtered velocity innovations which are used for pre-flight checking
+			if (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY) {
+				// calculate coefficients for LPF applied to innovation sequences
+				float alpha = constrain(sensors.accelerometer_integral_dt / 1.e6f * _innov_lpf_tau_inv, 0.0f, 1.0f);
+				float beta = 1.0f - alpha;
+
+				// filter the velocity and innvovations
+				_vel_ne_innov_lpf(0) = beta * _vel_ne_innov_lpf(0) + alpha * constrain(innovations.vel_pos_innov[0],
+						       -_vel_innov_spike_lim, _vel_innov_spike_lim);
+				_vel_ne_innov_lpf(1) = beta * _vel_ne_innov_lpf(1) + alpha * constrain(innovations.vel_pos_innov[1],
+						       -_vel_innov_spike_lim, _vel_innov_spike_lim);
+				_vel_d_innov_lpf = beta * _vel_d_innov_lpf + alpha * constrain(innovations.vel_pos_innov[2],
+						   -_vel_innov_spike_lim, _vel_innov_spike_lim);
+
+				// set the max allowed yaw innovaton depending on whether we are not aiding navigation using
+				// observations in the NE reference frame.
+				bool doing_ne_aiding = control_status.flags.gps ||  control_status.flags.ev_pos;
+
+				float yaw_test_limit;
+
+				if (doing_ne_aiding && _vehicle_status.vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING) {
+					// use a smaller tolerance when doing NE inertial frame aiding as a rotary wing
+					// vehicle which cannot use GPS course to realign heading in flight
+					yaw_test_limit = _nav_yaw_innov_test_lim;
 
-					// filter the yaw innovations
-					_yaw_innov_magnitude_lpf = beta * _yaw_innov_magnitude_lpf + alpha * constrain(innovations.heading_innov,
-								   -2.0f * yaw_test_limit, 2.0f * yaw_test_limit);
+				} else {
+					// use a larger tolerance when not doing NE inertial frame aiding or
+					// if a fixed wing vehicle which can realign heading using GPS course
+					yaw_test_limit = _yaw_innov_test_lim;
+				}
 
-					_hgt_innov_lpf = beta * _hgt_innov_lpf + alpha * constrain(innovations.vel_pos_innov[5], -_hgt_innov_spike_lim,
-							 _hgt_innov_spike_lim);
+				// filter the yaw innovations
+				_yaw_innov_magnitude_lpf = beta * _yaw_innov_magnitude_lpf + alpha * constrain(innovations.heading_innov,
+							   -2.0f * yaw_test_limit, 2.0f * yaw_test_limit);
 
-					// check the yaw and horizontal velocity innovations
-					float vel_ne_innov_length = sqrtf(innovations.vel_pos_innov[0] * innovations.vel_pos_innov[0] +
-									  innovations.vel_pos_innov[1] * innovations.vel_pos_innov[1]);
-					_preflt_horiz_fail = (_vel_ne_innov_lpf.norm() > _vel_innov_test_lim)
-							     || (vel_ne_innov_length > 2.0f * _vel_innov_test_lim)
-							     || (_yaw_innov_magnitude_lpf > yaw_test_limit);
+				_hgt_innov_lpf = beta * _hgt_innov_lpf + alpha * constrain(innovations.vel_pos_innov[5], -_hgt_innov_spike_lim,
+						 _hgt_innov_spike_lim);
 
-					// check the vertical velocity and position innovations
-					_preflt_vert_fail = (fabsf(_vel_d_innov_lpf) > _vel_innov_test_lim)
-							    || (fabsf(innovations.vel_pos_innov[2]) > 2.0f * _vel_innov_test_lim)
-							    || (fabsf(_hgt_innov_lpf) > _hgt_innov_test_lim);
+				// check the yaw and horizontal velocity innovations
+				float vel_ne_innov_length = sqrtf(innovations.vel_pos_innov[0] * innovations.vel_pos_innov[0] +
+								  innovations.vel_pos_innov[1] * innovations.vel_pos_innov[1]);
+				_preflt_horiz_fail = (_vel_ne_innov_lpf.norm() > _vel_innov_test_lim)
+						     || (vel_ne_innov_length > 2.0f * _vel_innov_test_lim)
+						     || (_yaw_innov_magnitude_lpf > yaw_test_limit);
 
-					// master pass-fail status
-					_preflt_fail = _preflt_horiz_fail || _preflt_vert_fail;
+				// check the vertical velocity and position innovations
+				_preflt_vert_fail = (fabsf(_vel_d_innov_lpf) > _vel_innov_test_lim)
+						    || (fabsf(innovations.vel_pos_innov[2]) > 2.0f * _vel_innov_test_lim)
+						    || (fabsf(_hgt_innov_lpf) > _hgt_innov_test_lim);
 
-				} else {
-					_vel_ne_innov_lpf.zero();
-					_vel_d_innov_lpf = 0.0f;
-					_hgt_innov_lpf = 0.0f;
-					_preflt_horiz_fail = false;
-					_preflt_vert_fail = false;
-					_preflt_fail = false;
-				}
+				// master pass-fail status
+				_preflt_fail = _preflt_horiz_fail || _preflt_vert_fail;
 
-				_estimator_innovations_pub.publish(innovations);
+			} else {
+				_vel_ne_innov_lpf.zero();
+				_vel_d_innov_lpf = 0.0f;
+				_hgt_innov_lpf = 0.0f;
+				_preflt_horiz_fail = false;
+				_preflt_vert_fail = false;
+				_preflt_fail = false;
 			}
+
+			_estimator_innovations_pub.publish(innovations);
 		}
+	}
+
+	// publish ekf2_timestamps
+	_ekf2_timestamps_pub.publish(ekf2_timestamps);
+}
 
-		// publish ekf2_timestamps
-		_ekf2_timestamps_pub.publish(ekf2_timestamps);
+uint16_t Ekf2::aux_topics_updated()
+{
+	uint16_t updated = 0;
+
+	updated |= _params_sub.updated() ? AUX_PARAMS : 0;
+	updated |= _status_sub.updated() ? AUX_VEHICLE_STATUS : 0;
+	updated |= _sensor_selection_sub.updated() ? AUX_SENSOR_SELECTION : 0;
+	updated |= _magnetometer_sub.updated() ? AUX_MAGNETOMETER : 0;
+	updated |= _airdata_sub.updated() ? AUX_AIR_DATA : 0;
+	updated |= _gps_subs[0].updated() ? AUX_GPS1 : 0;
+	updated |= _gps_subs[1].updated() ? AUX_GPS2 : 0;
+	updated |= _airspeed_sub.updated() ? AUX_AIRSPEED : 0;
+	updated |= _optical_flow_sub.updated() ? AUX_OPTICAL_FLOW : 0;
+
+	if (_range_finder_sub_index >= 0) {
+		updated |= _range_finder_subs[_range_finder_sub_index].updated() ? AUX_DISTANCE_SENSOR : 0;
 	}
+
+	updated |= _ev_odom_sub.updated() ? AUX_VISUAL_ODOMETRY : 0;
+	updated |= _vehicle_land_detected_sub.updated() ? AUX_LAND_DETECTED : 0;
+	updated |= _landing_target_pose_sub.updated() ? AUX_LANDING_TARGET : 0;
+
+	return updated;
 }
 
 int Ekf2::getRangeSubIndex()
@@ -1741,7 +1882,7 @@ bool Ekf2::publish_attitude(const sensor_combined_s &sensors, const hrt_abstime
 
 		_ekf.get_quat_reset(&att.delta_q_reset[0], &att.quat_reset_counter);
 
-		_att_pub.publish(att);
+		publish_output(_att_pub, att);
 
 		return true;
 
@@ -1755,6 +1896,41 @@ bool Ekf2::publish_attitude(const sensor_combined_s &sensors, const hrt_abstime
 	return false;
 }
 
+template<typename T>
+void Ekf2::publish_output(uORB::Publication<T> &pub, const T &data)
+{
+	if (!_selector.enabled()) {
+		pub.publish(data);
+
+	} else if (_selector.selected() == 0) {
+		// keep the reset counters continuous across changes of the selected instance
+		T out{data};
+		_selector.adjust_resets(out, 0);
+		pub.publish(out);
+	}
+}
+
+void Ekf2::publish_selected_instance()
+{
+	vehicle_attitude_s att;
+
+	if (_selector.copy_attitude(att)) {
+		_att_pub.publish(att);
+	}
+
+	vehicle_local_position_s lpos;
+
+	if (_selector.copy_local_position(lpos)) {
+		_vehicle_local_position_pub.publish(lpos);
+	}
+
+	vehicle_global_position_s gpos;
+
+	if (_selector.copy_global_position(gpos)) {
+		_vehicle_global_position_pub.publish(gpos);
+	}
+}
+
 bool Ekf2::publish_wind_estimate(const hrt_abstime &timestamp)
 {
 	if (_ekf.get_wind_status()) {
@@ -2377,19 +2553,6 @@ float Ekf2::filter_altitude_ellipsoid(float amsl_hgt)
 	return amsl_hgt + _wgs84_hgt_offset;
 }
 
-Ekf2 *Ekf2::instantiate(int argc, char *argv[])
-{
-	Ekf2 *instance = new Ekf2();
-
-	if (instance) {
-		if (argc >= 2 && !strcmp(argv[1], "-r")) {
-			instance->set_replay_mode(true);
-		}
-	}
-
-	return instance;
-}
-
 int Ekf2::custom_command(int argc, char *argv[])
 {
 	return print_usage("unknown command");
@@ -2411,6 +2574,10 @@ The documentation can be found on the [ECL/EKF Overview & Tuning](https://docs.p
 ekf2 can be started in replay mode (`-r`): in this mode it does not access the system time, but only uses the
 timestamps from the sensor topics.
 
+With EKF2_MULTI_IMU set to N > 1, N-1 secondary filter instances run on the individual IMUs, each on its own
+work queue. The healthiest instance, based on the innovation test ratios, provides the vehicle attitude and position
+(estimator_selector_status). This is disabled in replay mode.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("ekf2", "estimator");
@@ -2423,19 +2590,29 @@ timestamps from the sensor topics.
 
 int Ekf2::task_spawn(int argc, char *argv[])
 {
-	_task_id = px4_task_spawn_cmd("ekf2",
-				      SCHED_DEFAULT,
-				      SCHED_PRIORITY_ESTIMATOR,
-				      6600,
-				      (px4_main_t)&run_trampoline,
-				      (char *const *)argv);
-
-	if (_task_id < 0) {
-		_task_id = -1;
-		return -errno;
+	Ekf2 *instance = new Ekf2();
+
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (argc >= 2 && !strcmp(argv[1], "-r")) {
+			instance->set_replay_mode(true);
+		}
+
+		if (instance->init()) {
+			return PX4_OK;
+		}
+
+	} else {
+		PX4_ERR("alloc failed");
 	}
 
-	return 0;
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
 }
 
 int ekf2_main(int argc, char *argv[])
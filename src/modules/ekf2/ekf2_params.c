@@ -1371,3 +1371,19 @@ PARAM_DEFINE_FLOAT(EKF2_MOVE_TEST, 1.0f);
  * @reboot_required true
  */
 PARAM_DEFINE_FLOAT(EKF2_REQ_GPS_H, 10.0f);
+
+/**
+ * Number of IMUs to run an estimator instance on
+ *
+ * 0 or 1 runs a single filter on the voted IMU data (sensor_combined).
+ * With N > 1 the main filter is complemented by N-1 secondary filters, each running on its own
+ * work queue with the data of sensor_gyro/sensor_accel instance 1..N-1. The secondary filters only fuse
+ * the magnetometer, barometer and the first GPS receiver. The instance with the lowest innovation
+ * test ratios provides the vehicle attitude and position (see estimator_selector_status).
+ *
+ * @group EKF2
+ * @min 0
+ * @max 4
+ * @reboot_required true
+ */
+PARAM_DEFINE_INT32(EKF2_MULTI_IMU, 0);
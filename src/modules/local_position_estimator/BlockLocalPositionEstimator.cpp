@@ -1,10 +1,14 @@
 #include "BlockLocalPositionEstimator.hpp"
+#include "SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <fcntl.h>
 #include <systemlib/err.h>
 #include <matrix/math.hpp>
 #include <cstdlib>
 
+static_assert(lpe::n_x == BlockLocalPositionEstimator::n_x && lpe::X_vx == BlockLocalPositionEstimator::X_vx
+	      && lpe::X_bx == BlockLocalPositionEstimator::X_bx, "state layout mismatch with SparseCovariance.hpp");
+
 orb_advert_t mavlink_log_pub = nullptr;
 
 // required standard deviation of estimate for estimator to publish data
@@ -959,8 +963,8 @@ void BlockLocalPositionEstimator::predict()
 
 	// propagate
 	_x += dx;
-	Matrix<float, n_x, n_x> dP = (_A * _P + _P * _A.transpose() +
-				      _B * _R * _B.transpose() + _Q) * getDt();
+	Matrix<float, n_x, n_x> dP;
+	lpe::predictCovariance(_P, _R_att, _R, _Q, getDt(), dP);
 
 	// covariance propagation logic
 	for (size_t i = 0; i < n_x; i++) {
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <math.h>
+#include <matrix/math.hpp>
+
+/**
+ * Covariance propagation and correction for the local position estimator,
+ * written out for the known structure of its matrices.
+ *
+ * The dynamics matrix A only couples velocity into position (identity) and
+ * the accelerometer bias into velocity (-R_att), the input matrix B maps the
+ * NED acceleration into the velocity states, and every measurement matrix C
+ * has one or two +-1 entries per row. P is kept symmetric, so only its lower
+ * triangle is computed and then mirrored.
+ */
+namespace lpe
+{
+
+using matrix::Matrix;
+
+// state layout, must match BlockLocalPositionEstimator
+enum {X_x = 0, X_y, X_z, X_vx, X_vy, X_vz, X_bx, X_by, X_bz, X_tz, n_x};
+
+/**
+ * Covariance increment dP = (A * P + P * A' + B * R * B' + Q) * dt.
+ *
+ * @param P	state covariance (symmetric)
+ * @param R_att	body to NED rotation, the bias block of A is -R_att
+ * @param R	input (acceleration) noise covariance (symmetric)
+ * @param Q	process noise covariance (symmetric)
+ * @param dt	time step (s)
+ * @param dP	covariance increment
+ */
+inline void predictCovariance(const Matrix<float, n_x, n_x> &P, const Matrix<float, 3, 3> &R_att,
+			      const Matrix<float, 3, 3> &R, const Matrix<float, n_x, n_x> &Q, float dt,
+			      Matrix<float, n_x, n_x> &dP)
+{
+	// M = A * P, only the position and velocity rows are non-zero
+	float M[X_vz + 1][n_x];
+
+	for (size_t j = 0; j < n_x; j++) {
+		M[X_x][j] = P(X_vx, j);
+		M[X_y][j] = P(X_vy, j);
+		M[X_z][j] = P(X_vz, j);
+
+		const float p_bx = P(X_bx, j);
+		const float p_by = P(X_by, j);
+		const float p_bz = P(X_bz, j);
+
+		M[X_vx][j] = -(R_att(0, 0) * p_bx + R_att(0, 1) * p_by + R_att(0, 2) * p_bz);
+		M[X_vy][j] = -(R_att(1, 0) * p_bx + R_att(1, 1) * p_by + R_att(1, 2) * p_bz);
+		M[X_vz][j] = -(R_att(2, 0) * p_bx + R_att(2, 1) * p_by + R_att(2, 2) * p_bz);
+	}
+
+	for (size_t i = 0; i < n_x; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			// A * P + (A * P)'
+			float d = Q(i, j);
+
+			if (i <= X_vz) {
+				d += M[i][j];
+			}
+
+			if (j <= X_vz) {
+				d += M[j][i];
+			}
+
+			// B * R * B' only has the velocity block
+			if (j >= X_vx && i <= X_vz) {
+				d += R(i - X_vx, j - X_vx);
+			}
+
+			dP(i, j) = d * dt;
+			dP(j, i) = dP(i, j);
+		}
+	}
+}
+
+/**
+ * P * C', skipping the zero entries of the measurement matrix C.
+ */
+template<size_t n_y>
+Matrix<float, n_x, n_y> covarianceTimesCt(const Matrix<float, n_x, n_x> &P, const Matrix<float, n_y, n_x> &C)
+{
+	Matrix<float, n_x, n_y> PCt;
+	PCt.setZero();
+
+	for (size_t k = 0; k < n_y; k++) {
+		for (size_t j = 0; j < n_x; j++) {
+			const float c = C(k, j);
+
+			if (fabsf(c) > 0.f) {
+				for (size_t i = 0; i < n_x; i++) {
+					PCt(i, k) += P(i, j) * c;
+				}
+			}
+		}
+	}
+
+	return PCt;
+}
+
+/**
+ * Kalman covariance correction P -= K * C * P, with C * P = (P * C')' for the symmetric P.
+ *
+ * @param P	state covariance, updated in place
+ * @param K	kalman gain
+ * @param PCt	P * C' from covarianceTimesCt(), taken before the update
+ */
+template<size_t n_y>
+void correctCovariance(Matrix<float, n_x, n_x> &P, const Matrix<float, n_x, n_y> &K, const Matrix<float, n_x, n_y> &PCt)
+{
+	for (size_t i = 0; i < n_x; i++) {
+		for (size_t j = 0; j <= i; j++) {
+			float d = 0.f;
+
+			for (size_t k = 0; k < n_y; k++) {
+				d += K(i, k) * PCt(j, k);
+			}
+
+			P(i, j) -= d;
+			P(j, i) = P(i, j);
+		}
+	}
+}
+
+} // namespace lpe
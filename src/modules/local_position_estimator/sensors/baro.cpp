@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -66,9 +67,12 @@ void BlockLocalPositionEstimator::baroCorrect()
 	R.setZero();
 	R(0, 0) = _param_lpe_bar_z.get() * _param_lpe_bar_z.get();
 
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_baro> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual
 	Matrix<float, n_y_baro, n_y_baro> S_I =
-		inv<float, n_y_baro>((C * _P * C.transpose()) + R);
+		inv<float, n_y_baro>((C * PCt) + R);
 	Vector<float, n_y_baro> r = y - (C * _x);
 
 	// fault detection
@@ -87,10 +91,10 @@ void BlockLocalPositionEstimator::baroCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_baro> K = _P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_baro> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 }
 
 void BlockLocalPositionEstimator::baroCheckTimeout()
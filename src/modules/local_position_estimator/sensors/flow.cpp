@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -168,8 +169,11 @@ void BlockLocalPositionEstimator::flowCorrect()
 	// residual
 	Vector<float, 2> r = y - C * _x;
 
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_flow> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_flow, n_y_flow> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_flow, n_y_flow> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().flow_innov[0] = r(0);
@@ -196,10 +200,10 @@ void BlockLocalPositionEstimator::flowCorrect()
 
 	if (!(_sensorFault & SENSOR_FLOW)) {
 		Matrix<float, n_x, n_y_flow> K =
-			_P * C.transpose() * S_I;
+			PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		_P -= K * C * _P;
+		lpe::correctCovariance(_P, K, PCt);
 	}
 }
 
@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -185,8 +186,11 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	// residual
 	Vector<float, n_y_gps> r = y - C * x0;
 
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_gps> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_gps, n_y_gps> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_gps, n_y_gps> S = C * PCt + R;
 
 	// publish innovations
 	for (size_t i = 0; i < 6; i++) {
@@ -217,10 +221,10 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	}
 
 	// kalman filter correction always for GPS
-	Matrix<float, n_x, n_y_gps> K = _P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_gps> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 }
 
 void BlockLocalPositionEstimator::gpsCheckTimeout()
@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -58,8 +59,11 @@ void BlockLocalPositionEstimator::landCorrect()
 	R(Y_land_vy, Y_land_vy) = _param_lpe_land_vxy.get() * _param_lpe_land_vxy.get();
 	R(Y_land_agl, Y_land_agl) = _param_lpe_land_z.get() * _param_lpe_land_z.get();
 
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_land> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual
-	Matrix<float, n_y_land, n_y_land> S_I = inv<float, n_y_land>((C * _P * C.transpose()) + R);
+	Matrix<float, n_y_land, n_y_land> S_I = inv<float, n_y_land>((C * PCt) + R);
 	Vector<float, n_y_land> r = y - C * _x;
 	_pub_innov.get().hagl_innov = r(Y_land_agl);
 	_pub_innov.get().hagl_innov_var = R(Y_land_agl, Y_land_agl);
@@ -85,10 +89,10 @@ void BlockLocalPositionEstimator::landCorrect()
 	}
 
 	// kalman filter correction always for land detector
-	Matrix<float, n_x, n_y_land> K = _P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_land> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 }
 
 void BlockLocalPositionEstimator::landCheckTimeout()
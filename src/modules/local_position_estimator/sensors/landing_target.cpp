@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -80,9 +81,12 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 	// residual
 	Vector<float, n_y_target> r = y - C * _x;
 
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_target> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance, (inverse)
 	Matrix<float, n_y_target, n_y_target> S_I =
-		inv<float, n_y_target>(C * _P * C.transpose() + R);
+		inv<float, n_y_target>(C * PCt + R);
 
 	// fault detection
 	float beta = (r.transpose()  * (S_I * r))(0, 0);
@@ -103,10 +107,10 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 
 	// kalman filter correction
 	Matrix<float, n_x, n_y_target> K =
-		_P * C.transpose() * S_I;
+		PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 
 }
 
@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -88,8 +89,12 @@ void BlockLocalPositionEstimator::lidarCorrect()
 
 	// residual
 	Vector<float, n_y_lidar> r = y - C * _x;
+
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_lidar> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_lidar, n_y_lidar> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_lidar, n_y_lidar> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().hagl_innov = r(0);
@@ -116,10 +121,10 @@ void BlockLocalPositionEstimator::lidarCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_lidar> K = _P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_lidar> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 }
 
 void BlockLocalPositionEstimator::lidarCheckTimeout()
@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -140,8 +141,12 @@ void BlockLocalPositionEstimator::mocapCorrect()
 
 	// residual
 	Vector<float, n_y_mocap> r = y - C * _x;
+
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_mocap> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_mocap, n_y_mocap> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_mocap, n_y_mocap> S = C * PCt + R;
 
 	// publish innovations
 	for (size_t i = 0; i < 3; i++) {
@@ -172,10 +177,10 @@ void BlockLocalPositionEstimator::mocapCorrect()
 	}
 
 	// kalman filter correction always
-	Matrix<float, n_x, n_y_mocap> K = _P * C.transpose() * S_I;
+	Matrix<float, n_x, n_y_mocap> K = PCt * S_I;
 	Vector<float, n_x> dx = K * r;
 	_x += dx;
-	_P -= K * C * _P;
+	lpe::correctCovariance(_P, K, PCt);
 }
 
 void BlockLocalPositionEstimator::mocapCheckTimeout()
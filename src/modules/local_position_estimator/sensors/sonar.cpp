@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -108,8 +109,12 @@ void BlockLocalPositionEstimator::sonarCorrect()
 
 	// residual
 	Vector<float, n_y_sonar> r = y - C * _x;
+
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_sonar> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_sonar, n_y_sonar> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_sonar, n_y_sonar> S = C * PCt + R;
 
 	// publish innovations
 	_pub_innov.get().hagl_innov = r(0);
@@ -138,10 +143,10 @@ void BlockLocalPositionEstimator::sonarCorrect()
 	// kalman filter correction if no fault
 	if (!(_sensorFault & SENSOR_SONAR)) {
 		Matrix<float, n_x, n_y_sonar> K =
-			_P * C.transpose() * S_I;
+			PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		_P -= K * C * _P;
+		lpe::correctCovariance(_P, K, PCt);
 	}
 }
 
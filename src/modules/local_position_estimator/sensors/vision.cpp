@@ -1,4 +1,5 @@
 #include "../BlockLocalPositionEstimator.hpp"
+#include "../SparseCovariance.hpp"
 #include <systemlib/mavlink_log.h>
 #include <matrix/math.hpp>
 
@@ -157,8 +158,12 @@ void BlockLocalPositionEstimator::visionCorrect()
 
 	// residual
 	Matrix<float, n_y_vision, 1> r = y - C * x0;
+
+	// P * C', C has only a few non-zero entries
+	const Matrix<float, n_x, n_y_vision> PCt = lpe::covarianceTimesCt(_P, C);
+
 	// residual covariance
-	Matrix<float, n_y_vision, n_y_vision> S = C * _P * C.transpose() + R;
+	Matrix<float, n_y_vision, n_y_vision> S = C * PCt + R;
 
 	// publish innovations
 	for (size_t i = 0; i < 3; i++) {
@@ -190,10 +195,10 @@ void BlockLocalPositionEstimator::visionCorrect()
 
 	// kalman filter correction if no fault
 	if (!(_sensorFault & SENSOR_VISION)) {
-		Matrix<float, n_x, n_y_vision> K = _P * C.transpose() * S_I;
+		Matrix<float, n_x, n_y_vision> K = PCt * S_I;
 		Vector<float, n_x> dx = K * r;
 		_x += dx;
-		_P -= K * C * _P;
+		lpe::correctCovariance(_P, K, PCt);
 	}
 }
 
@@ -519,6 +519,7 @@ void Logger::add_default_topics()
 	add_topic("ekf2_innovations", 200);
 	add_topic("ekf_gps_drift");
 	add_topic("esc_status", 250);
+	add_topic("estimator_selector_status", 200);
 	add_topic("estimator_status", 200);
 	add_topic("home_position");
 	add_topic("input_rc", 200);
@@ -553,6 +554,7 @@ void Logger::add_default_topics()
 	add_topic_multi("actuator_outputs", 100);
 	add_topic_multi("battery_status", 500);
 	add_topic_multi("distance_sensor", 100);
+	add_topic_multi("estimator_instance_status", 500);
 	add_topic_multi("telemetry_status");
 	add_topic_multi("vehicle_gps_position");
 	add_topic_multi("wind_estimate", 200);
@@ -64,6 +64,10 @@ MavlinkFTP::~MavlinkFTP()
 	if (_work_buffer2) {
 		delete[] _work_buffer2;
 	}
+
+	if (_read_ahead_buffer) {
+		delete[] _read_ahead_buffer;
+	}
 }
 
 unsigned
@@ -296,6 +300,78 @@ out:
 	}
 }
 
+int MavlinkFTP::_read_session(uint32_t offset, uint8_t *dst, unsigned len)
+{
+	if (!_read_ahead_buffer) {
+		_read_ahead_buffer = new uint8_t[_read_ahead_buffer_len];
+		_invalidate_read_ahead();
+	}
+
+	if (!_read_ahead_buffer) {
+		// no memory for read-ahead: fall back to reading directly
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		return ::read(_session_info.fd, dst, len);
+	}
+
+	// Refill if the request is not completely inside the buffered range, unless the buffer ended at EOF.
+	// EOF is taken from a short read and not from the size at open, the file might have grown since then.
+	// A request starting past the buffer always refills, so appended data is still read.
+	const uint32_t buffer_end = _read_ahead_offset + _read_ahead_len;
+
+	if (offset < _read_ahead_offset || offset >= buffer_end || (offset + len > buffer_end && !_read_ahead_eof)) {
+		_invalidate_read_ahead();
+
+		// start at a block boundary, as long as the whole request still fits into the buffer
+		uint32_t read_offset = offset - offset % _read_ahead_align;
+
+		if (offset - read_offset + len > (unsigned)_read_ahead_buffer_len) {
+			read_offset = offset;
+		}
+
+		if (lseek(_session_info.fd, read_offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		int bytes_read = ::read(_session_info.fd, _read_ahead_buffer, _read_ahead_buffer_len);
+
+		if (bytes_read < 0) {
+			return bytes_read;
+		}
+
+		_read_ahead_offset = read_offset;
+		_read_ahead_len = bytes_read;
+		_read_ahead_eof = (bytes_read < _read_ahead_buffer_len);
+
+		if (offset >= read_offset + bytes_read) {
+			// at or past EOF
+			return 0;
+		}
+	}
+
+	const unsigned available = _read_ahead_offset + _read_ahead_len - offset;
+	const unsigned bytes_read = (len < available) ? len : available;
+	memcpy(dst, &_read_ahead_buffer[offset - _read_ahead_offset], bytes_read);
+
+	return bytes_read;
+}
+
+unsigned MavlinkFTP::_burst_chunk_size()
+{
+	// perform transfers in 35K chunks at least - this is determined empirical. On fast links (USB, UDP)
+	// the chunk is scaled to about half a second of link bandwidth, so that the GCS round-trip to request
+	// the next burst does not dominate the transfer time.
+	static constexpr unsigned min_chunk_size = 35000;
+#ifdef MAVLINK_FTP_UNIT_TEST
+	return min_chunk_size;
+#else
+	const unsigned rate_chunk_size = _mavlink->get_data_rate() / 2;
+	return (rate_chunk_size > min_chunk_size) ? rate_chunk_size : min_chunk_size;
+#endif
+}
+
 bool MavlinkFTP::_ensure_buffers_exist()
 {
 	_last_work_buffer_access = hrt_absolute_time();
@@ -531,6 +607,7 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	_session_info.fd = fd;
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
+	_invalidate_read_ahead();
 
 	payload->session = 0;
 	payload->size = sizeof(uint32_t);
@@ -557,12 +634,7 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 		return kErrEOF;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		PX4_ERR("seek fail");
-		return kErrFailErrno;
-	}
-
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+	int bytes_read = _read_session(payload->offset, &payload->data[0], kMaxDataLength);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -611,6 +683,8 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 		return kErrFailErrno;
 	}
 
+	_invalidate_read_ahead();
+
 	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
@@ -653,6 +727,9 @@ MavlinkFTP::_workTruncateFile(PayloadHeader *payload)
 	_work_buffer1[_work_buffer1_len - 1] = '\0';
 	payload->size = 0;
 
+	// the file might be the one of the open session
+	_invalidate_read_ahead();
+
 #ifdef __PX4_NUTTX
 
 	// emulate truncate(_work_buffer1, payload->offset) by
@@ -748,6 +825,7 @@ MavlinkFTP::_workTerminate(PayloadHeader *payload)
 	::close(_session_info.fd);
 	_session_info.fd = -1;
 	_session_info.stream_download = false;
+	_invalidate_read_ahead();
 
 	payload->size = 0;
 
@@ -762,6 +840,7 @@ MavlinkFTP::_workReset(PayloadHeader *payload)
 		::close(_session_info.fd);
 		_session_info.fd = -1;
 		_session_info.stream_download = false;
+		_invalidate_read_ahead();
 	}
 
 	payload->size = 0;
@@ -953,7 +1032,7 @@ MavlinkFTP::_copy_file(const char *src_path, const char *dst_path, size_t length
 void MavlinkFTP::send(const hrt_abstime t)
 {
 
-	if (_work_buffer1 || _work_buffer2) {
+	if (_work_buffer1 || _work_buffer2 || _read_ahead_buffer) {
 		// free the work buffers if they are not used for a while
 		if (hrt_elapsed_time(&_last_work_buffer_access) > 2000000) {
 			if (_work_buffer1) {
@@ -965,6 +1044,12 @@ void MavlinkFTP::send(const hrt_abstime t)
 				delete[] _work_buffer2;
 				_work_buffer2 = nullptr;
 			}
+
+			if (_read_ahead_buffer && !_session_info.stream_download) {
+				delete[] _read_ahead_buffer;
+				_read_ahead_buffer = nullptr;
+				_invalidate_read_ahead();
+			}
 		}
 	}
 
@@ -1018,16 +1103,7 @@ void MavlinkFTP::send(const hrt_abstime t)
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-#ifdef MAVLINK_FTP_DEBUG
-				PX4_WARN("stream download: seek fail");
-#endif
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _read_session(payload->offset, &payload->data[0], kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
@@ -1063,8 +1139,7 @@ void MavlinkFTP::send(const hrt_abstime t)
 			if (max_bytes_to_send < (get_size() * 2)) {
 				more_data = false;
 
-				/* perform transfers in 35K chunks - this is determined empirical */
-				if (_session_info.stream_chunk_transmitted > 35000) {
+				if (_session_info.stream_chunk_transmitted > _burst_chunk_size()) {
 					payload->burst_complete = true;
 					_session_info.stream_download = false;
 					_session_info.stream_chunk_transmitted = 0;
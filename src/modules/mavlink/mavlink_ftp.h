@@ -146,6 +146,22 @@ private:
 	ErrorCode	_workRename(PayloadHeader *payload);
 	ErrorCode	_workCalcFileCRC32(PayloadHeader *payload);
 
+	/**
+	 * Read from the open session file through the read-ahead buffer. Sequential reads (as done by
+	 * burst and read sessions) are served from memory and only refill the buffer with one large read.
+	 * @param offset file offset to read from
+	 * @param dst destination buffer
+	 * @param len maximum number of bytes to read
+	 * @return number of bytes read, 0 on EOF, <0 on error (errno is set)
+	 */
+	int		_read_session(uint32_t offset, uint8_t *dst, unsigned len);
+
+	/// invalidate the read-ahead buffer, e.g. if the session file changed
+	void		_invalidate_read_ahead() { _read_ahead_offset = 0; _read_ahead_len = 0; _read_ahead_eof = false; }
+
+	/// maximum number of bytes sent in a single burst before the GCS has to re-request the next one
+	unsigned	_burst_chunk_size();
+
 	uint8_t _getServerSystemId(void);
 	uint8_t _getServerComponentId(void);
 	uint8_t _getServerChannel(void);
@@ -191,6 +207,18 @@ private:
 	static constexpr int _work_buffer2_len = 256;
 	hrt_abstime _last_work_buffer_access{0}; ///< timestamp when the buffers were last accessed
 
+	/* read-ahead buffer for read and burst sessions: allocated on the first read, freed together with the work buffers */
+	uint8_t *_read_ahead_buffer{nullptr};
+#ifdef __PX4_NUTTX
+	static constexpr int _read_ahead_buffer_len = 4096;
+#else
+	static constexpr int _read_ahead_buffer_len = kMaxDataLength * 64;
+#endif
+	static constexpr uint32_t _read_ahead_align = 512; ///< refills start at a multiple of this (SD card block size)
+	uint32_t _read_ahead_offset{0}; ///< file offset of the first byte in _read_ahead_buffer
+	uint32_t _read_ahead_len{0}; ///< number of valid bytes in _read_ahead_buffer
+	bool _read_ahead_eof{false}; ///< the last refill was short, i.e. the buffer ended at EOF when it was read
+
 	// prepend a root directory to each file/dir access to avoid enumerating the full FS tree (e.g. on Linux).
 	// Note that requests can still fall outside of the root dir by using ../..
 #ifdef MAVLINK_FTP_UNIT_TEST
@@ -78,6 +78,8 @@
 
 static Mavlink *_mavlink_instances = nullptr;
 
+constexpr float Mavlink::MIN_RATE_MULT[];
+
 /**
  * Mavlink app start / stop handling function.
  *
@@ -784,21 +786,59 @@ Mavlink::send_packet()
 {
 	int ret = -1;
 
-#if defined(CONFIG_NET) || defined(__PX4_POSIX)
-
 	/* Only send packets if there is something in the buffer. */
-	if (_network_buf_len == 0) {
+	if (_tx_buf_len == 0) {
+		_tx_buf_overflow = false;
 		pthread_mutex_unlock(&_send_mutex);
 		return 0;
 	}
 
-	if (get_protocol() == UDP) {
+	/* If the wait until transmit flag is on, only transmit after we've received messages.
+	   Otherwise, transmit all the time. */
+	if (!should_transmit()) {
+		_tx_buf_len = 0;
+		_tx_buf_overflow = false;
+		pthread_mutex_unlock(&_send_mutex);
+		return 0;
+	}
+
+	_last_write_try_time = hrt_absolute_time();
+
+	if (_mavlink_start_time == 0) {
+		_mavlink_start_time = _last_write_try_time;
+	}
+
+	if (_tx_buf_overflow) {
+		/* incomplete packet, drop it */
+		count_txerrbytes(_tx_buf_len);
+
+	} else if (get_protocol() == SERIAL) {
+		/* check if there is space in the buffer for the whole packet, drop it else */
+		if (get_free_tx_buf() >= _tx_buf_len) {
+			ret = ::write(_uart_fd, _tx_buf, _tx_buf_len);
+		}
+
+		if (ret == (int)_tx_buf_len) {
+			_last_write_success_time = _last_write_try_time;
+			count_txbytes(_tx_buf_len);
+
+		} else {
+			count_txerrbytes(_tx_buf_len);
+		}
+	}
+
+#if defined(CONFIG_NET) || defined(__PX4_POSIX)
+
+	else if (get_protocol() == UDP) {
+
+		_last_write_success_time = _last_write_try_time;
+		count_txbytes(_tx_buf_len);
 
 #ifdef CONFIG_NET
 
 		if (_src_addr_initialized) {
 #endif
-			ret = sendto(_socket_fd, _network_buf, _network_buf_len, 0,
+			ret = sendto(_socket_fd, _tx_buf, _tx_buf_len, 0,
 				     (struct sockaddr *)&_src_addr, sizeof(_src_addr));
 #ifdef CONFIG_NET
 		}
@@ -814,9 +854,9 @@ Mavlink::send_packet()
 				find_broadcast_address();
 			}
 
-			if (_broadcast_address_found && _network_buf_len > 0) {
+			if (_broadcast_address_found) {
 
-				int bret = sendto(_socket_fd, _network_buf, _network_buf_len, 0,
+				int bret = sendto(_socket_fd, _tx_buf, _tx_buf_len, 0,
 						  (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
 
 				if (bret <= 0) {
@@ -836,9 +876,11 @@ Mavlink::send_packet()
 		PX4_ERR("TCP transport pending implementation");
 	}
 
-	_network_buf_len = 0;
 #endif
 
+	_tx_buf_len = 0;
+	_tx_buf_overflow = false;
+
 	pthread_mutex_unlock(&_send_mutex);
 	return ret;
 }
@@ -846,55 +888,14 @@ Mavlink::send_packet()
 void
 Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 {
-	/* If the wait until transmit flag is on, only transmit after we've received messages.
-	   Otherwise, transmit all the time. */
-	if (!should_transmit()) {
-		return;
-	}
-
-	_last_write_try_time = hrt_absolute_time();
-
-	if (_mavlink_start_time == 0) {
-		_mavlink_start_time = _last_write_try_time;
-	}
-
-	if (get_protocol() == SERIAL) {
-		/* check if there is space in the buffer, let it overflow else */
-		unsigned buf_free = get_free_tx_buf();
-
-		if (buf_free < packet_len) {
-			/* not enough space in buffer to send */
-			count_txerrbytes(packet_len);
-			return;
-		}
-	}
-
-	size_t ret = -1;
-
-	/* send message to UART */
-	if (get_protocol() == SERIAL) {
-		ret = ::write(_uart_fd, buf, packet_len);
-	}
-
-#if defined(CONFIG_NET) || defined(__PX4_POSIX)
-
-	else {
-		if (_network_buf_len + packet_len < sizeof(_network_buf) / sizeof(_network_buf[0])) {
-			memcpy(&_network_buf[_network_buf_len], buf, packet_len);
-			_network_buf_len += packet_len;
-
-			ret = packet_len;
-		}
-	}
-
-#endif
-
-	if (ret != (size_t) packet_len) {
-		count_txerrbytes(packet_len);
+	/* the MAVLink encoder hands over a packet in a few pieces (header, payload, checksum, signature):
+	 * collect them, so that the packet can go out with a single write once it is complete */
+	if (_tx_buf_len + packet_len <= sizeof(_tx_buf)) {
+		memcpy(&_tx_buf[_tx_buf_len], buf, packet_len);
+		_tx_buf_len += packet_len;
 
 	} else {
-		_last_write_success_time = _last_write_try_time;
-		count_txbytes(packet_len);
+		_tx_buf_overflow = true;
 	}
 }
 
@@ -1511,14 +1512,18 @@ Mavlink::update_rate_mult()
 {
 	float const_rate = 0.0f;
 	float rate = 0.0f;
+	float rate_priority[MavlinkStream::PRIORITY_COUNT] {};
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
+		const float stream_rate = (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+
 		if (stream->const_rate()) {
-			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			const_rate += stream_rate;
 
 		} else {
-			rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			rate += stream_rate;
+			rate_priority[stream->get_priority()] += stream_rate;
 		}
 	}
 
@@ -1528,13 +1533,8 @@ Mavlink::update_rate_mult()
 		mavlink_ulog_streaming_rate_inv = 1.0f - _mavlink_ulog->current_data_rate();
 	}
 
-	/* scale up and down as the link permits */
-	float bandwidth_mult = (float)(_datarate * mavlink_ulog_streaming_rate_inv - const_rate) / rate;
-
-	/* if we do not have flow control, limit to the set data rate */
-	if (!get_flow_control_enabled()) {
-		bandwidth_mult = fminf(1.0f, bandwidth_mult);
-	}
+	/* bandwidth left for the adjustable streams at the configured data rate */
+	const float bandwidth = _datarate * mavlink_ulog_streaming_rate_inv - const_rate;
 
 	float hardware_mult = 1.0f;
 
@@ -1557,11 +1557,63 @@ Mavlink::update_rate_mult()
 		hardware_mult *= _radio_status_mult;
 	}
 
-	/* pick the minimum from bandwidth mult and hardware mult as limit */
-	_rate_mult = fminf(bandwidth_mult, hardware_mult);
+	/* a serial TX buffer that does not drain between loop iterations means we send faster than the link */
+	if (get_protocol() == SERIAL) {
+		const float tx_buf_free = get_free_tx_buf();
 
-	/* ensure the rate multiplier never drops below 5% so that something is always sent */
-	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
+		/* filter the free space, a single burst of messages must not change the rates */
+		if (_tx_buf_free_filtered < 0.0f) {
+			_tx_buf_free_filtered = tx_buf_free;
+
+		} else {
+			_tx_buf_free_filtered += TX_BUFFER_FILTER_GAIN * (tx_buf_free - _tx_buf_free_filtered);
+		}
+
+		/* change the limit at most every hold time, with hysteresis between the low and high threshold */
+		if (hrt_elapsed_time(&_tx_buf_mult_last_change) >= TX_BUFFER_MULT_HOLD) {
+			if (_tx_buf_free_filtered < TX_BUFFER_LOW_BYTES) {
+				_tx_buf_mult = math::max(_tx_buf_mult * 0.8f, MIN_RATE_MULT[MavlinkStream::PRIORITY_LOW]);
+				_tx_buf_mult_last_change = hrt_absolute_time();
+
+			} else if (_tx_buf_free_filtered > TX_BUFFER_HIGH_BYTES && _tx_buf_mult < 1.0f) {
+				_tx_buf_mult = math::min(_tx_buf_mult * 1.1f, 1.0f);
+				_tx_buf_mult_last_change = hrt_absolute_time();
+			}
+		}
+
+		hardware_mult *= _tx_buf_mult;
+	}
+
+	/* the byte budget is limited by the configured data rate and by the measured link capacity */
+	const float budget = fminf(bandwidth, hardware_mult * rate);
+
+	/*
+	 * First reserve the minimum rate of every priority class, then hand out the rest
+	 * of the budget in priority order, so that critical streams keep their configured
+	 * rate as long as possible on a saturated link.
+	 */
+	float remaining = budget;
+
+	for (int i = 0; i < MavlinkStream::PRIORITY_COUNT; i++) {
+		remaining -= rate_priority[i] * MIN_RATE_MULT[i];
+	}
+
+	float rate_allocated = 0.0f;
+
+	for (int i = 0; i < MavlinkStream::PRIORITY_COUNT; i++) {
+		if (rate_priority[i] > FLT_EPSILON) {
+			const float extra = math::constrain(remaining, 0.0f, rate_priority[i] * (1.0f - MIN_RATE_MULT[i]));
+			remaining -= extra;
+			_rate_mult_priority[i] = MIN_RATE_MULT[i] + extra / rate_priority[i];
+			rate_allocated += rate_priority[i] * _rate_mult_priority[i];
+
+		} else {
+			_rate_mult_priority[i] = 1.0f;
+		}
+	}
+
+	/* overall multiplier, reported in telemetry_status */
+	_rate_mult = (rate > FLT_EPSILON) ? rate_allocated / rate : 1.0f;
 }
 
 void
@@ -2731,7 +2783,10 @@ Mavlink::display_status()
 	printf("\trates:\n");
 	printf("\t  tx: %.3f kB/s\n", (double)_tstatus.rate_tx);
 	printf("\t  txerr: %.3f kB/s\n", (double)_tstatus.rate_txerr);
-	printf("\t  tx rate mult: %.3f\n", (double)_rate_mult);
+	printf("\t  tx rate mult: %.3f (critical %.3f, normal %.3f, low %.3f)\n", (double)_rate_mult,
+	       (double)_rate_mult_priority[MavlinkStream::PRIORITY_CRITICAL],
+	       (double)_rate_mult_priority[MavlinkStream::PRIORITY_NORMAL],
+	       (double)_rate_mult_priority[MavlinkStream::PRIORITY_LOW]);
 	printf("\t  tx rate max: %i B/s\n", _datarate);
 	printf("\t  rx: %.3f kB/s\n", (double)_tstatus.rate_rx);
 
@@ -2784,8 +2839,6 @@ Mavlink::display_status_streams()
 {
 	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
 
-	const float rate_mult = _rate_mult;
-
 	for (const auto &stream : _streams) {
 		const int interval = stream->get_interval();
 		const unsigned size = stream->get_size();
@@ -2798,7 +2851,7 @@ Mavlink::display_status_streams()
 			float rate = 1000000.0f / (float)interval;
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
-			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+			float rate_current = stream->const_rate() ? rate : rate * get_rate_mult(stream->get_priority());
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
@@ -87,6 +87,7 @@
 #define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
 #define DEFAULT_DEVICE_NAME     "/dev/ttyS1"
 #define HASH_PARAM              "_HASH_CHECK"
+#define DELTA_SYNC_PARAM        "_DELTA_SYNC"
 
 enum Protocol {
 	SERIAL = 0,
@@ -318,14 +319,14 @@ public:
 	void 			begin_send() { pthread_mutex_lock(&_send_mutex); }
 
 	/**
-	 * Send bytes out on the link.
+	 * Append bytes of the current packet to the transmit buffer.
 	 *
-	 * On a network port these might actually get buffered to form a packet.
+	 * Nothing goes out on the link until send_packet() is called.
 	 */
 	void			send_bytes(const uint8_t *buf, unsigned packet_len);
 
 	/**
-	 * Flush the transmit buffer and send one MAVLink packet
+	 * Flush the transmit buffer and send one MAVLink packet with a single write
 	 *
 	 * @return the number of bytes sent or -1 in case of error
 	 */
@@ -408,6 +409,11 @@ public:
 
 	float			get_rate_mult() const { return _rate_mult; }
 
+	/**
+	 * Get the rate multiplier assigned to a stream priority class
+	 */
+	float			get_rate_mult(MavlinkStream::Priority priority) const { return _rate_mult_priority[priority]; }
+
 	float			get_baudrate() { return _baudrate; }
 
 	/* Functions for waiting to start transmission until message received. */
@@ -586,7 +592,11 @@ private:
 
 	int			_baudrate{57600};
 	int			_datarate{1000};		///< data rate for normal streams (attitude, position, etc.)
-	float			_rate_mult{1.0f};
+	float			_rate_mult{1.0f};			///< overall rate multiplier of the adjustable streams
+	float			_rate_mult_priority[MavlinkStream::PRIORITY_COUNT] {1.0f, 1.0f, 1.0f};
+	float			_tx_buf_mult{1.0f};			///< rate limit from a congested serial TX buffer
+	float			_tx_buf_free_filtered{-1.0f};		///< low-pass filtered free serial TX buffer [bytes], negative before the first sample
+	hrt_abstime		_tx_buf_mult_last_change{0};
 
 	bool			_radio_status_available{false};
 	bool			_radio_status_critical{false};
@@ -627,10 +637,12 @@ private:
 	bool			_broadcast_address_found{false};
 	bool			_broadcast_address_not_found_warned{false};
 	bool			_broadcast_failed_warned{false};
-	uint8_t			_network_buf[MAVLINK_MAX_PACKET_LEN] {};
-	unsigned		_network_buf_len{0};
 #endif
 
+	uint8_t			_tx_buf[MAVLINK_MAX_PACKET_LEN] {};	///< packet being assembled between begin_send() and send_packet()
+	unsigned		_tx_buf_len{0};
+	bool			_tx_buf_overflow{false};
+
 	const char 		*_interface_name{nullptr};
 
 	int			_socket_fd{-1};
@@ -685,6 +697,17 @@ private:
 	static constexpr unsigned RADIO_BUFFER_LOW_PERCENTAGE = 35;
 	static constexpr unsigned RADIO_BUFFER_HALF_PERCENTAGE = 50;
 
+	static constexpr unsigned TX_BUFFER_LOW_BYTES = 64;	///< filtered free serial TX buffer below which the link is considered congested
+	static constexpr unsigned TX_BUFFER_HIGH_BYTES = 128;	///< filtered free serial TX buffer above which the rate limit is relaxed again
+	static constexpr float TX_BUFFER_FILTER_GAIN = 0.1f;	///< low-pass gain of the free TX buffer, per main loop iteration
+	static constexpr hrt_abstime TX_BUFFER_MULT_HOLD = 500_ms;	///< minimum time between two changes of the TX buffer rate limit
+
+	/**
+	 * Minimum rate multiplier of each stream priority class, so that every
+	 * stream still gets through at a reduced rate on a saturated link.
+	 */
+	static constexpr float MIN_RATE_MULT[MavlinkStream::PRIORITY_COUNT] = {0.2f, 0.05f, 0.02f};
+
 	/**
 	 * Configure a single stream.
 	 * @param stream_name
@@ -901,6 +901,7 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			_transfer_dataman_id = (_dataman_id == DM_KEY_WAYPOINTS_OFFBOARD_0 ? DM_KEY_WAYPOINTS_OFFBOARD_1 :
 						DM_KEY_WAYPOINTS_OFFBOARD_0);	// use inactive storage for transmission
 			_transfer_current_seq = -1;
+			_transfer_write_buffer_count = 0;
 
 			if (_mission_type == MAV_MISSION_TYPE_FENCE) {
 				// We're about to write new geofence items, so take the lock. It will be released when
@@ -957,9 +958,27 @@ MavlinkMissionManager::switch_to_idle_state()
 		PX4_DEBUG("unlocking geofence");
 	}
 
+	// drop any mission items of an aborted upload that were not yet written
+	_transfer_write_buffer_count = 0;
+
 	_state = MAVLINK_WPM_STATE_IDLE;
 }
 
+bool
+MavlinkMissionManager::flush_transfer_write_buffer()
+{
+	if (_transfer_write_buffer_count == 0) {
+		return true;
+	}
+
+	const ssize_t written = dm_write_range(_transfer_dataman_id, _transfer_write_buffer_first, _transfer_write_buffer_count,
+					       DM_PERSIST_POWER_ON_RESET, _transfer_write_buffer, sizeof(struct mission_item_s));
+
+	const bool success = (written == _transfer_write_buffer_count);
+	_transfer_write_buffer_count = 0;
+	return success;
+}
+
 
 void
 MavlinkMissionManager::handle_mission_item(const mavlink_message_t *msg)
@@ -1066,10 +1085,16 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					check_failed = true;
 
 				} else {
-					dm_item_t dm_item = _transfer_dataman_id;
+					// items arrive strictly in sequence: collect them and write them to dataman in blocks
+					if (_transfer_write_buffer_count == 0) {
+						_transfer_write_buffer_first = wp.seq;
+					}
 
-					write_failed = dm_write(dm_item, wp.seq, DM_PERSIST_POWER_ON_RESET, &mission_item,
-								sizeof(struct mission_item_s)) != sizeof(struct mission_item_s);
+					_transfer_write_buffer[_transfer_write_buffer_count++] = mission_item;
+
+					if (_transfer_write_buffer_count == MISSION_WRITE_BLOCK_SIZE || wp.seq + 1 == _transfer_count) {
+						write_failed = !flush_transfer_write_buffer();
+					}
 
 					if (!write_failed) {
 						/* waypoint marked as current */
@@ -126,6 +126,12 @@ private:
 
 	static bool		_transfer_in_progress;			///< Global variable checking for current transmission
 
+	static constexpr uint16_t	MISSION_WRITE_BLOCK_SIZE = 8;	///< Mission items buffered before one batched dataman write
+
+	mission_item_s		_transfer_write_buffer[MISSION_WRITE_BLOCK_SIZE] {};	///< Received mission items not yet written to dataman
+	uint16_t		_transfer_write_buffer_first{0};	///< Sequence of the first buffered item
+	uint16_t		_transfer_write_buffer_count{0};	///< Number of buffered items
+
 	uORB::Subscription	_mission_result_sub{ORB_ID(mission_result)};
 
 	uORB::Publication<mission_s>	_offboard_mission_pub{ORB_ID(mission)};
@@ -241,6 +247,13 @@ private:
 	int format_mavlink_mission_item(const struct mission_item_s *mission_item,
 					mavlink_mission_item_t *mavlink_mission_item);
 
+	/**
+	 * Write the buffered mission items of the current upload to dataman in one batch.
+	 *
+	 * @return true on success (or if nothing was buffered)
+	 */
+	bool flush_transfer_write_buffer();
+
 	/**
 	 * set _state to idle (and do necessary cleanup)
 	 */
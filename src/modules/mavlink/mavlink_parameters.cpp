@@ -42,9 +42,14 @@
 
 #include <stdio.h>
 
+#include <crc32.h>
+#include <px4_atomic.h>
+
 #include "mavlink_parameters.h"
 #include "mavlink_main.h"
 
+static px4::atomic<uint32_t> delta_sync_offset_value{0};	///< see delta_sync_offset(), 0 until chosen
+
 MavlinkParametersManager::MavlinkParametersManager(Mavlink *mavlink) :
 	_mavlink(mavlink)
 {
@@ -67,6 +72,8 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 
 			if (req_list.target_system == mavlink_system.sysid &&
 			    (req_list.target_component == mavlink_system.compid || req_list.target_component == MAV_COMP_ID_ALL)) {
+				_send_delta = false;
+
 				if (_send_all_index < 0) {
 					_send_all_index = PARAM_HASH;
 
@@ -115,6 +122,17 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 					return;
 				}
 
+				/* Send only the parameters changed since the epoch the GCS knows about */
+				if (strncmp(name, DELTA_SYNC_PARAM, sizeof(name)) == 0) {
+					uint32_t gcs_epoch;
+					memcpy(&gcs_epoch, &set.param_value, sizeof(gcs_epoch));
+					_send_delta_epoch = gcs_epoch - delta_sync_offset();
+					_send_delta_start_epoch = param_get_epoch();
+					_send_delta = true;
+					_send_all_index = 0;
+					return;
+				}
+
 				/* attempt to find parameter, set and send it */
 				param_t param = param_find_no_notification(name);
 
@@ -181,6 +199,9 @@ MavlinkParametersManager::handle_message(const mavlink_message_t *msg)
 						memcpy(&param_value.param_value, &hash, sizeof(hash));
 						mavlink_msg_param_value_send_struct(_mavlink->get_channel(), &param_value);
 
+					} else if (strncmp(req_read.param_id, DELTA_SYNC_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) == 0) {
+						send_epoch(param_get_epoch());
+
 					} else {
 						/* local name buffer to enforce null-terminated string */
 						char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1];
@@ -448,7 +469,7 @@ MavlinkParametersManager::send_one()
 			/* walk through all parameters, including unused ones */
 			p = param_for_index(_send_all_index);
 			_send_all_index++;
-		} while (p != PARAM_INVALID && !param_used(p));
+		} while (p != PARAM_INVALID && (!param_used(p) || (_send_delta && !param_changed_since(p, _send_delta_epoch))));
 
 		if (p != PARAM_INVALID) {
 			send_param(p);
@@ -456,6 +477,15 @@ MavlinkParametersManager::send_one()
 
 		if ((p == PARAM_INVALID) || (_send_all_index >= (int) param_count())) {
 			_send_all_index = -1;
+
+			if (_send_delta) {
+				/* finish the delta sync with the epoch it started at, so the GCS knows it is complete.
+				 * Changes during the transfer will be part of the next delta. */
+				_send_delta = false;
+				send_epoch(_send_delta_start_epoch);
+				return true;
+			}
+
 			return false;
 
 		} else {
@@ -471,6 +501,33 @@ MavlinkParametersManager::send_one()
 	return false;
 }
 
+uint32_t
+MavlinkParametersManager::delta_sync_offset()
+{
+	if (delta_sync_offset_value.load() == 0) {
+		// the time of the first request after boot varies by many microseconds, spread it over all 32 bits
+		const hrt_abstime now = hrt_absolute_time();
+		uint32_t expected = 0;
+		delta_sync_offset_value.compare_exchange(&expected, crc32part((const uint8_t *)&now, sizeof(now), 0) | 1);
+	}
+
+	return delta_sync_offset_value.load();
+}
+
+void
+MavlinkParametersManager::send_epoch(uint32_t epoch)
+{
+	epoch += delta_sync_offset();
+
+	mavlink_param_value_t msg;
+	msg.param_count = param_count_used();
+	msg.param_index = -1;
+	strncpy(msg.param_id, DELTA_SYNC_PARAM, MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+	msg.param_type = MAV_PARAM_TYPE_UINT32;
+	memcpy(&msg.param_value, &epoch, sizeof(epoch));
+	mavlink_msg_param_value_send_struct(_mavlink->get_channel(), &msg);
+}
+
 int
 MavlinkParametersManager::send_param(param_t param, int component_id)
 {
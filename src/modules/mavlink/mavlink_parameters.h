@@ -74,6 +74,9 @@ public:
 
 private:
 	int		_send_all_index{-1};
+	bool		_send_delta{false};	///< only send the parameters changed since _send_delta_epoch
+	uint32_t	_send_delta_epoch{0};
+	uint32_t	_send_delta_start_epoch{0};	///< epoch when the delta sync started, reported to the GCS at the end
 
 	/* do not allow top copying this class */
 	MavlinkParametersManager(MavlinkParametersManager &);
@@ -101,6 +104,20 @@ protected:
 
 	int send_param(param_t param, int component_id = -1);
 
+	/**
+	 * Send the current parameter change epoch (DELTA_SYNC_PARAM). A GCS can pass it back with a
+	 * PARAM_SET of DELTA_SYNC_PARAM on reconnect to only get the parameters changed since then.
+	 */
+	void send_epoch(uint32_t epoch);
+
+	/**
+	 * Offset between the parameter change epoch and the value exchanged with the GCS. The epoch
+	 * starts again at every boot, so it is sent with an offset chosen at random once per boot:
+	 * an epoch kept by the GCS from an earlier boot then maps to an unknown epoch here, which
+	 * makes the delta sync send all parameters.
+	 */
+	static uint32_t delta_sync_offset();
+
 	// Item of a single-linked list to store requested uavcan parameters
 	struct _uavcan_open_request_list_item {
 		uavcan_parameter_request_s req;
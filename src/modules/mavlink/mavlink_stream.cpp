@@ -50,6 +50,40 @@ MavlinkStream::MavlinkStream(Mavlink *mavlink) :
 	_last_sent = hrt_absolute_time();
 }
 
+MavlinkStream::Priority
+MavlinkStream::get_priority()
+{
+	switch (get_id()) {
+	case MAVLINK_MSG_ID_HEARTBEAT:
+	case MAVLINK_MSG_ID_SYS_STATUS:
+	case MAVLINK_MSG_ID_EXTENDED_SYS_STATE:
+	case MAVLINK_MSG_ID_ATTITUDE:
+	case MAVLINK_MSG_ID_ATTITUDE_QUATERNION:
+	case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+	case MAVLINK_MSG_ID_GPS_RAW_INT:
+	case MAVLINK_MSG_ID_VFR_HUD:
+	case MAVLINK_MSG_ID_HOME_POSITION:
+	case MAVLINK_MSG_ID_MISSION_CURRENT:
+	case MAVLINK_MSG_ID_BATTERY_STATUS:
+		return PRIORITY_CRITICAL;
+
+	case MAVLINK_MSG_ID_DEBUG:
+	case MAVLINK_MSG_ID_DEBUG_VECT:
+	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
+	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
+	case MAVLINK_MSG_ID_HIGHRES_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU2:
+	case MAVLINK_MSG_ID_SCALED_IMU3:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE:
+	case MAVLINK_MSG_ID_ACTUATOR_CONTROL_TARGET:
+		return PRIORITY_LOW;
+
+	default:
+		return PRIORITY_NORMAL;
+	}
+}
+
 /**
  * Update subscriptions and send message if necessary
  */
@@ -85,7 +119,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	int interval = (_interval > 0) ? _interval : 0;
 
 	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
+		interval /= _mavlink->get_rate_mult(get_priority());
 	}
 
 	// Send the message if it is due or
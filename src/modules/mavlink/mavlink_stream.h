@@ -87,6 +87,22 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * Stream priority classes. If the link cannot carry all streams at their
+	 * configured rate, the available bandwidth is handed out in this order.
+	 */
+	enum Priority : uint8_t {
+		PRIORITY_CRITICAL = 0,	///< vehicle state required to safely monitor the vehicle
+		PRIORITY_NORMAL,
+		PRIORITY_LOW,		///< debug and raw sensor data
+		PRIORITY_COUNT
+	};
+
+	/**
+	 * @return the priority class of the stream, by default derived from the message ID
+	 */
+	virtual Priority get_priority();
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -96,20 +96,49 @@ void Geofence::_updateFence()
 		_update_counter = stats.update_counter;
 	}
 
-	// iterate over all polygons and store their starting vertices
+	delete[](_polygons);
+	_polygons = nullptr;
 	_num_polygons = 0;
+	_geometry.reset(0, 0);
+
+	if (num_fence_items <= 0) {
+		return;
+	}
+
+	// load all fence items with a single request. There cannot be more polygons or vertices than items.
+	mission_fence_point_s *fence_points = new mission_fence_point_s[num_fence_items];
+	float *vertices = new float[2 * num_fence_items];
+	_polygons = new PolygonInfo[num_fence_items];
+
+	if (!fence_points || !vertices || !_polygons || !_geometry.reset(num_fence_items, num_fence_items)) {
+		PX4_ERR("alloc failed");
+		delete[](fence_points);
+		delete[](vertices);
+		delete[](_polygons);
+		_polygons = nullptr;
+		return;
+	}
+
+	const ssize_t num_read = dm_read_range(DM_KEY_FENCE_POINTS, 1, num_fence_items, fence_points,
+					       sizeof(mission_fence_point_s));
+
+	if (num_read < num_fence_items) {
+		PX4_ERR("dm_read failed");
+		num_fence_items = (num_read > 0) ? num_read : 0;
+	}
+
+	if (num_fence_items > 0) {
+		// all geometry is precomputed in a local frame around the first fence item
+		map_projection_init(&_projection_reference, fence_points[0].lat, fence_points[0].lon);
+	}
+
+	// iterate over all polygons and store their starting vertices
 	int current_seq = 1;
 
 	while (current_seq <= num_fence_items) {
-		mission_fence_point_s mission_fence_point;
+		const mission_fence_point_s &mission_fence_point = fence_points[current_seq - 1];
 		bool is_circle_area = false;
 
-		if (dm_read(DM_KEY_FENCE_POINTS, current_seq, &mission_fence_point, sizeof(mission_fence_point_s)) !=
-		    sizeof(mission_fence_point_s)) {
-			PX4_ERR("dm_read failed");
-			break;
-		}
-
 		switch (mission_fence_point.nav_cmd) {
 		case NAV_CMD_FENCE_RETURN_POINT:
 			// TODO: do we need to store this?
@@ -127,38 +156,48 @@ void Geofence::_updateFence()
 				++current_seq; // avoid endless loop
 				PX4_ERR("Polygon with 0 vertices. Skipping");
 
+			} else if (!is_circle_area && current_seq + mission_fence_point.vertex_count - 1 > num_fence_items) {
+				PX4_ERR("Polygon with missing vertices. Skipping");
+				current_seq = num_fence_items + 1;
+
 			} else {
-				if (_polygons) {
-					// resize: this is somewhat inefficient, but we do not expect there to be many polygons
-					PolygonInfo *new_polygons = new PolygonInfo[_num_polygons + 1];
+				PolygonInfo &polygon = _polygons[_num_polygons];
+				polygon.dataman_index = current_seq;
+				polygon.fence_type = mission_fence_point.nav_cmd;
 
-					if (new_polygons) {
-						memcpy(new_polygons, _polygons, sizeof(PolygonInfo) * _num_polygons);
+				const int vertex_count = is_circle_area ? 1 : mission_fence_point.vertex_count;
+				const bool inclusion = mission_fence_point.nav_cmd == NAV_CMD_FENCE_CIRCLE_INCLUSION
+						       || mission_fence_point.nav_cmd == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION;
+				bool frame_supported = true;
+
+				// convert the vertices to the local frame
+				float *x = &vertices[0];
+				float *y = &vertices[num_fence_items];
+
+				for (int i = 0; i < vertex_count; ++i) {
+					const mission_fence_point_s &vertex = fence_points[current_seq - 1 + i];
+
+					if (vertex.frame != NAV_FRAME_GLOBAL && vertex.frame != NAV_FRAME_GLOBAL_INT
+					    && vertex.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
+					    && vertex.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+						// TODO: handle different frames
+						PX4_ERR("Frame type %i not supported", (int)vertex.frame);
+						frame_supported = false;
+						break;
 					}
 
-					delete[](_polygons);
-					_polygons = new_polygons;
-
-				} else {
-					_polygons = new PolygonInfo[1];
-				}
-
-				if (!_polygons) {
-					_num_polygons = 0;
-					PX4_ERR("alloc failed");
-					return;
+					map_projection_project(&_projection_reference, vertex.lat, vertex.lon, &x[i], &y[i]);
 				}
 
-				PolygonInfo &polygon = _polygons[_num_polygons];
-				polygon.dataman_index = current_seq;
-				polygon.fence_type = mission_fence_point.nav_cmd;
-
+				// an area with unsupported frame does not contain any point
 				if (is_circle_area) {
 					polygon.circle_radius = mission_fence_point.circle_radius;
+					_geometry.addCircle(x[0], y[0], frame_supported ? mission_fence_point.circle_radius : 0.f, inclusion);
 					current_seq += 1;
 
 				} else {
 					polygon.vertex_count = mission_fence_point.vertex_count;
+					_geometry.addPolygon(x, y, frame_supported ? vertex_count : 0, inclusion);
 					current_seq += mission_fence_point.vertex_count;
 				}
 
@@ -175,6 +214,8 @@ void Geofence::_updateFence()
 
 	}
 
+	delete[](fence_points);
+	delete[](vertices);
 }
 
 bool Geofence::checkAll(const struct vehicle_global_position_s &global_position)
@@ -278,12 +319,12 @@ bool Geofence::checkAll(double lat, double lon, float altitude)
 }
 
 
-bool Geofence::checkPolygons(double lat, double lon, float altitude)
+bool Geofence::updateFenceIfChanged()
 {
-	// the following uses dm_read, so first we try to lock all items. If that fails, it (most likely) means
-	// the data is currently being updated (via a mavlink geofence transfer), and we do not check for a violation now
+	// the fence is checked in RAM, but it can be changed at any time via a mavlink geofence transfer. If the lock
+	// cannot be taken, it (most likely) means the data is currently being updated.
 	if (dm_trylock(DM_KEY_FENCE_POINTS) != 0) {
-		return true;
+		return false;
 	}
 
 	// we got the lock, now check if the fence data got updated
@@ -294,8 +335,18 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 		_updateFence();
 	}
 
+	dm_unlock(DM_KEY_FENCE_POINTS);
+	return true;
+}
+
+bool Geofence::checkPolygons(double lat, double lon, float altitude)
+{
+	// do not check for a violation while the fence is being updated
+	if (!updateFenceIfChanged()) {
+		return true;
+	}
+
 	if (isEmpty()) {
-		dm_unlock(DM_KEY_FENCE_POINTS);
 		/* Empty fence -> accept all points */
 		return true;
 	}
@@ -303,127 +354,15 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 	/* Vertical check */
 	if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
 		if (altitude > _altitude_max || altitude < _altitude_min) {
-			dm_unlock(DM_KEY_FENCE_POINTS);
 			return false;
 		}
 	}
 
+	/* Horizontal check: all polygons & circles */
+	float x, y;
+	map_projection_project(&_projection_reference, lat, lon, &x, &y);
 
-	/* Horizontal check: iterate all polygons & circles */
-	bool outside_exclusion = true;
-	bool inside_inclusion = false;
-	bool had_inclusion_areas = false;
-
-	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
-		if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION) {
-			bool inside = insideCircle(_polygons[polygon_idx], lat, lon, altitude);
-
-			if (inside) {
-				inside_inclusion = true;
-			}
-
-			had_inclusion_areas = true;
-
-		} else if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
-			bool inside = insideCircle(_polygons[polygon_idx], lat, lon, altitude);
-
-			if (inside) {
-				outside_exclusion = false;
-			}
-
-		} else { // it's a polygon
-			bool inside = insidePolygon(_polygons[polygon_idx], lat, lon, altitude);
-
-			if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
-				if (inside) {
-					inside_inclusion = true;
-				}
-
-				had_inclusion_areas = true;
-
-			} else { // exclusion
-				if (inside) {
-					outside_exclusion = false;
-				}
-			}
-		}
-	}
-
-	dm_unlock(DM_KEY_FENCE_POINTS);
-
-	return (!had_inclusion_areas || inside_inclusion) && outside_exclusion;
-}
-
-bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
-{
-
-	/* Adaptation of algorithm originally presented as
-	 * PNPOLY - Point Inclusion in Polygon Test
-	 * W. Randolph Franklin (WRF)
-	 * Only supports non-complex polygons (not self intersecting)
-	 */
-
-	mission_fence_point_s temp_vertex_i;
-	mission_fence_point_s temp_vertex_j;
-	bool c = false;
-
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &temp_vertex_i,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + j, &temp_vertex_j,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (temp_vertex_i.frame != NAV_FRAME_GLOBAL && temp_vertex_i.frame != NAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-			c = !c;
-		}
-	}
-
-	return c;
-}
-
-bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
-{
-
-	mission_fence_point_s circle_point;
-
-	if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index, &circle_point,
-		    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-		PX4_ERR("dm_read failed");
-		return false;
-	}
-
-	if (circle_point.frame != NAV_FRAME_GLOBAL && circle_point.frame != NAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
-	}
-
-	if (!map_projection_initialized(&_projection_reference)) {
-		map_projection_init(&_projection_reference, lat, lon);
-	}
-
-	float x1, y1, x2, y2;
-	map_projection_project(&_projection_reference, lat, lon, &x1, &y1);
-	map_projection_project(&_projection_reference, circle_point.lat, circle_point.lon, &x2, &y2);
-	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	return _geometry.inside(x, y);
 }
 
 bool
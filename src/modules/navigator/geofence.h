@@ -45,6 +45,7 @@
 #include <px4_module_params.h>
 #include <drivers/drv_hrt.h>
 #include <lib/ecl/geo/geo.h>
+#include <lib/geofence/GeofenceGeometry.hpp>
 #include <px4_defines.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
@@ -155,6 +156,8 @@ private:
 	PolygonInfo *_polygons{nullptr};
 	int _num_polygons{0};
 
+	GeofenceGeometry _geometry; ///< polygons & circles in the local frame, in the same order as _polygons
+
 	map_projection_reference_s _projection_reference = {}; ///< reference to convert (lon, lat) to local [m]
 
 	DEFINE_PARAMETERS(
@@ -200,15 +203,8 @@ private:
 	bool checkAll(const vehicle_global_position_s &global_position, float baro_altitude_amsl);
 
 	/**
-	 * Check if a single point is within a polygon
-	 * @return true if within polygon
-	 */
-	bool insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude);
-
-	/**
-	 * Check if a single point is within a circle
-	 * @param polygon must be a circle!
-	 * @return true if within polygon the circle
+	 * Check if the fence data in dataman changed and reload it if needed.
+	 * @return false if the fence is currently being updated (locked)
 	 */
-	bool insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	bool updateFenceIfChanged();
 };
@@ -61,10 +61,16 @@
 
 Mission::Mission(Navigator *navigator) :
 	MissionBlock(navigator),
-	ModuleParams(navigator)
+	ModuleParams(navigator),
+	_set_mission_items_perf(perf_alloc(PC_ELAPSED, "navigator: set mission items"))
 {
 }
 
+Mission::~Mission()
+{
+	perf_free(_set_mission_items_perf);
+}
+
 void
 Mission::on_inactive()
 {
@@ -110,6 +116,7 @@ Mission::on_inactive()
 			_mission.dataman_id = mission_state.dataman_id;
 			_mission.count = mission_state.count;
 			_current_mission_index = mission_state.current_seq;
+			_prefetch.reset((dm_item_t)_mission.dataman_id, _mission.count);
 
 			// find and store landing start marker (if available)
 			find_mission_land_start();
@@ -274,6 +281,11 @@ Mission::on_active()
 			_navigator->get_precland()->on_active();
 		}
 	}
+
+	/* keep the items ahead cached */
+	if (_mission_type != MISSION_TYPE_NONE) {
+		prefetch_mission_items();
+	}
 }
 
 bool
@@ -382,13 +394,10 @@ Mission::find_mission_land_start()
 	 * TODO: implement full spec and find closest landing point geographically
 	 */
 
-	const dm_item_t dm_current = (dm_item_t)_mission.dataman_id;
-
 	for (size_t i = 0; i < _mission.count; i++) {
 		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(missionitem);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (!_prefetch.scan(i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			PX4_ERR("dataman read failure");
 			break;
@@ -507,6 +516,8 @@ Mission::update_mission()
 		PX4_ERR("mission check failed");
 	}
 
+	_prefetch.reset((dm_item_t)_mission.dataman_id, _mission.count);
+
 	// find and store landing start marker (if available)
 	find_mission_land_start();
 
@@ -533,13 +544,10 @@ Mission::advance_mission()
 
 		case mission_result_s::MISSION_EXECUTION_MODE_REVERSE: {
 				// find next position item in reverse order
-				dm_item_t dm_current = (dm_item_t)(_mission.dataman_id);
-
 				for (int32_t i = _current_mission_index - 1; i >= 0; i--) {
 					struct mission_item_s missionitem = {};
-					const ssize_t len = sizeof(missionitem);
 
-					if (dm_read(dm_current, i, &missionitem, len) != len) {
+					if (!_prefetch.read(i, missionitem)) {
 						/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 						PX4_ERR("dataman read failure");
 						break;
@@ -571,6 +579,8 @@ Mission::advance_mission()
 void
 Mission::set_mission_items()
 {
+	perf_begin(_set_mission_items_perf);
+
 	/* reset the altitude foh (first order hold) logic, if altitude foh is enabled (param) a new foh element starts now */
 	_min_current_sp_distance_xy = FLT_MAX;
 
@@ -653,6 +663,7 @@ Mission::set_mission_items()
 		}
 
 		_navigator->set_position_setpoint_triplet_updated();
+		perf_end(_set_mission_items_perf);
 		return;
 	}
 
@@ -1086,6 +1097,10 @@ Mission::set_mission_items()
 	}
 
 	_navigator->set_position_setpoint_triplet_updated();
+
+	prefetch_mission_items();
+
+	perf_end(_set_mission_items_perf);
 }
 
 bool
@@ -1487,8 +1502,8 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the prefetched items or the datamanager */
+		if (!_prefetch.read(*mission_index_ptr, mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Waypoint could not be read.");
 			return false;
@@ -1513,6 +1528,8 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 						return false;
 					}
 
+					_prefetch.update(*mission_index_ptr, mission_item_tmp);
+
 					report_do_jump_mission_changed(*mission_index_ptr, mission_item_tmp.do_jump_repeat_count);
 				}
 
@@ -1546,6 +1563,37 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 	return false;
 }
 
+void
+Mission::prefetch_mission_items()
+{
+	/* walk the items ahead like read_mission_item() does, without counting the DO_JUMPs,
+	 * and request the first one that is not cached yet */
+	const bool reverse = _mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_REVERSE;
+	const bool execute_jumps = _mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_NORMAL;
+	int index = _current_mission_index;
+
+	for (int i = 0; i < MissionPrefetch::NUM_SLOTS / 2; i++) {
+		if (index < 0 || index >= (int)_mission.count) {
+			return;
+		}
+
+		struct mission_item_s mission_item;
+
+		if (!_prefetch.get(index, mission_item)) {
+			_prefetch.prefetch(index, reverse);
+			return;
+		}
+
+		if (mission_item.nav_cmd == NAV_CMD_DO_JUMP && execute_jumps
+		    && mission_item.do_jump_current_count < mission_item.do_jump_repeat_count) {
+			index = mission_item.do_jump_mission_index;
+
+		} else {
+			index += reverse ? -1 : 1;
+		}
+	}
+}
+
 void
 Mission::save_mission_state()
 {
@@ -1701,6 +1749,9 @@ Mission::reset_mission(struct mission_s &mission)
 	}
 
 	dm_unlock(DM_KEY_MISSION_STATE);
+
+	/* the jump counters were rewritten */
+	_prefetch.reset((dm_item_t)mission.dataman_id, mission.count);
 }
 
 bool
@@ -1731,18 +1782,15 @@ Mission::generate_waypoint_from_heading(struct position_setpoint_s *setpoint, fl
 }
 
 int32_t
-Mission::index_closest_mission_item() const
+Mission::index_closest_mission_item()
 {
 	int32_t min_dist_index(0);
 	float min_dist(FLT_MAX), dist_xy(FLT_MAX), dist_z(FLT_MAX);
 
-	dm_item_t dm_current = (dm_item_t)(_mission.dataman_id);
-
 	for (size_t i = 0; i < _mission.count; i++) {
 		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(missionitem);
 
-		if (dm_read(dm_current, i, &missionitem, len) != len) {
+		if (!_prefetch.scan(i, missionitem)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			PX4_ERR("dataman read failure");
 			break;
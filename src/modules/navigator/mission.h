@@ -46,12 +46,14 @@
 
 #include "mission_block.h"
 #include "mission_feasibility_checker.h"
+#include "mission_prefetch.h"
 #include "navigator_mode.h"
 
 #include <float.h>
 
 #include <dataman/dataman.h>
 #include <drivers/drv_hrt.h>
+#include <lib/perf/perf_counter.h>
 #include <px4_module_params.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/home_position.h>
@@ -69,7 +71,7 @@ class Mission : public MissionBlock, public ModuleParams
 {
 public:
 	Mission(Navigator *navigator);
-	~Mission() override = default;
+	~Mission() override;
 
 	void on_inactive() override;
 	void on_inactivation() override;
@@ -184,6 +186,12 @@ private:
 	 */
 	bool read_mission_item(int offset, struct mission_item_s *mission_item);
 
+	/**
+	 * Request the mission items ahead of the current one (following DO_JUMPS)
+	 * that are not cached yet, so that advancing the mission does not block on dataman
+	 */
+	void prefetch_mission_items();
+
 	/**
 	 * Save current mission state to dataman
 	 */
@@ -232,7 +240,7 @@ private:
 	/**
 	 * Return the index of the closest mission item to the current global position.
 	 */
-	int32_t index_closest_mission_item() const;
+	int32_t index_closest_mission_item();
 
 	bool position_setpoint_equal(const position_setpoint_s *p1, const position_setpoint_s *p2) const;
 
@@ -248,6 +256,9 @@ private:
 
 	int32_t _current_mission_index{-1};
 
+	MissionPrefetch _prefetch;				/**< read-ahead cache of the mission items */
+	perf_counter_t _set_mission_items_perf;
+
 	// track location of planned mission landing
 	bool	_land_start_available{false};
 	uint16_t _land_start_index{UINT16_MAX};		/**< index of DO_LAND_START, INVALID_DO_LAND_START if no planned landing */
@@ -40,6 +40,7 @@
  * @author Nuno Marques <nuno.marques@dronesolutions.io>
  */
 
+
 #include "mission_feasibility_checker.h"
 
 #include "mission_block.h"
@@ -51,348 +52,553 @@
 #include <lib/landing_slope/Landingslope.hpp>
 #include <systemlib/mavlink_log.h>
 #include <uORB/Subscription.hpp>
-#include <uORB/topics/position_controller_landing_status.h>
+
+/* commands the mission checker accepts */
+static bool
+nav_cmd_supported(uint16_t nav_cmd)
+{
+	switch (nav_cmd) {
+	case NAV_CMD_IDLE:
+	case NAV_CMD_WAYPOINT:
+	case NAV_CMD_LOITER_UNLIMITED:
+	case NAV_CMD_LOITER_TIME_LIMIT:
+	case NAV_CMD_RETURN_TO_LAUNCH:
+	case NAV_CMD_LAND:
+	case NAV_CMD_TAKEOFF:
+	case NAV_CMD_LOITER_TO_ALT:
+	case NAV_CMD_VTOL_TAKEOFF:
+	case NAV_CMD_VTOL_LAND:
+	case NAV_CMD_DELAY:
+	case NAV_CMD_DO_JUMP:
+	case NAV_CMD_DO_CHANGE_SPEED:
+	case NAV_CMD_DO_SET_HOME:
+	case NAV_CMD_DO_SET_SERVO:
+	case NAV_CMD_DO_LAND_START:
+	case NAV_CMD_DO_TRIGGER_CONTROL:
+	case NAV_CMD_DO_DIGICAM_CONTROL:
+	case NAV_CMD_IMAGE_START_CAPTURE:
+	case NAV_CMD_IMAGE_STOP_CAPTURE:
+	case NAV_CMD_VIDEO_START_CAPTURE:
+	case NAV_CMD_VIDEO_STOP_CAPTURE:
+	case NAV_CMD_DO_MOUNT_CONFIGURE:
+	case NAV_CMD_DO_MOUNT_CONTROL:
+	case NAV_CMD_DO_SET_ROI:
+	case NAV_CMD_DO_SET_ROI_LOCATION:
+	case NAV_CMD_DO_SET_ROI_WPNEXT_OFFSET:
+	case NAV_CMD_DO_SET_ROI_NONE:
+	case NAV_CMD_DO_SET_CAM_TRIGG_DIST:
+	case NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL:
+	case NAV_CMD_SET_CAMERA_MODE:
+	case NAV_CMD_DO_VTOL_TRANSITION:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+/* commands that may precede the takeoff waypoint, i.e. that do not move the vehicle */
+static bool
+nav_cmd_allowed_before_takeoff(uint16_t nav_cmd)
+{
+	switch (nav_cmd) {
+	case NAV_CMD_IDLE:
+	case NAV_CMD_DELAY:
+	case NAV_CMD_DO_JUMP:
+	case NAV_CMD_DO_CHANGE_SPEED:
+	case NAV_CMD_DO_SET_HOME:
+	case NAV_CMD_DO_SET_SERVO:
+	case NAV_CMD_DO_LAND_START:
+	case NAV_CMD_DO_TRIGGER_CONTROL:
+	case NAV_CMD_DO_DIGICAM_CONTROL:
+	case NAV_CMD_IMAGE_START_CAPTURE:
+	case NAV_CMD_IMAGE_STOP_CAPTURE:
+	case NAV_CMD_VIDEO_START_CAPTURE:
+	case NAV_CMD_VIDEO_STOP_CAPTURE:
+	case NAV_CMD_DO_MOUNT_CONFIGURE:
+	case NAV_CMD_DO_MOUNT_CONTROL:
+	case NAV_CMD_DO_SET_ROI:
+	case NAV_CMD_DO_SET_ROI_LOCATION:
+	case NAV_CMD_DO_SET_ROI_WPNEXT_OFFSET:
+	case NAV_CMD_DO_SET_ROI_NONE:
+	case NAV_CMD_DO_SET_CAM_TRIGG_DIST:
+	case NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL:
+	case NAV_CMD_SET_CAMERA_MODE:
+	case NAV_CMD_DO_VTOL_TRANSITION:
+		return true;
+
+	default:
+		return false;
+	}
+}
 
 bool
 MissionFeasibilityChecker::checkMissionFeasible(const mission_s &mission,
 		float max_distance_to_1st_waypoint, float max_distance_between_waypoints,
 		bool land_start_req)
 {
-	bool failed = false;
-	bool warned = false;
-
 	// first check if we have a valid position
-	const bool home_valid = _navigator->home_position_valid();
-	const bool home_alt_valid = _navigator->home_alt_valid();
+	_home_valid = _navigator->home_position_valid();
+	_home_alt_valid = _navigator->home_alt_valid();
 
-	if (!home_alt_valid) {
-		failed = true;
-		warned = true;
+	if (!_home_alt_valid) {
 		mavlink_log_info(_navigator->get_mavlink_log_pub(), "Not yet ready for mission, no position lock.");
+		return false;
+	}
 
-	} else {
-		failed = failed || !checkDistanceToFirstWaypoint(mission, max_distance_to_1st_waypoint);
+	_home_alt = _navigator->get_home_position()->alt;
+	_max_distance_to_1st_waypoint = max_distance_to_1st_waypoint;
+	_max_distance_between_waypoints = max_distance_between_waypoints;
+
+	// VTOL always respects rotary wing feasibility
+	const bool rotary_wing = _navigator->get_vstatus()->vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING
+				 || _navigator->get_vstatus()->is_vtol;
+
+	if (!rotary_wing) {
+		uORB::SubscriptionData<position_controller_landing_status_s> landing_status{ORB_ID(position_controller_landing_status)};
+		_landing_status = landing_status.get();
+	}
+
+	resetChecks();
+
+	if (_navigator->get_geofence().isHomeRequired() && !_home_valid) {
+		_geofence.failure = GeofenceState::Failure::HomeRequired;
 	}
 
-	const float home_alt = _navigator->get_home_position()->alt;
+	const bool geofence_valid = _navigator->get_geofence().valid();
+
+	// stream the mission once and hand every item to all checks
+	for (size_t first = 0; first < mission.count; first += MISSION_READ_CHUNK) {
+		const unsigned count = math::min((size_t)MISSION_READ_CHUNK, mission.count - first);
+
+		if (dm_read_range((dm_item_t)mission.dataman_id, first, count, _items, sizeof(mission_item_s)) != (ssize_t)count) {
+			// not supposed to happen unless the datamanager can't access the SD card, etc.
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Cannot access SD card");
+			return false;
+		}
+
+		for (unsigned j = 0; j < count; j++) {
+			const mission_item_s &item = _items[j];
+			const size_t i = first + j;
+
+			visitMissionItemValidity(item, i);
+			visitDistanceToFirstWaypoint(item);
+			visitDistancesBetweenWaypoints(item);
+
+			if (geofence_valid) {
+				visitGeofence(item, i);
+			}
+
+			visitHomePositionAltitude(item, i);
+			visitTakeoff(item, i);
+
+			if (!rotary_wing) {
+				visitFixedWingLanding(item, (i > 0) ? &_previous_item : nullptr, i);
+			}
+
+			_previous_item = item;
+		}
+	}
+
+	// report in the order the checks are prioritized, the first failing check rejects the mission
+	bool failed = !checkDistanceToFirstWaypoint();
+	bool warned = false;
 
 	// check if all mission item commands are supported
-	failed = failed || !checkMissionItemValidity(mission);
-	failed = failed || !checkDistancesBetweenWaypoints(mission, max_distance_between_waypoints);
-	failed = failed || !checkGeofence(mission, home_alt, home_valid);
-	failed = failed || !checkHomePositionAltitude(mission, home_alt, home_alt_valid, warned);
+	failed = failed || !checkMissionItemValidity();
+	failed = failed || !checkDistancesBetweenWaypoints();
+	failed = failed || !checkGeofence();
+	failed = failed || !checkHomePositionAltitude(warned);
 
-	// VTOL always respects rotary wing feasibility
-	if (_navigator->get_vstatus()->vehicle_type == vehicle_status_s::VEHICLE_TYPE_ROTARY_WING
-	    || _navigator->get_vstatus()->is_vtol) {
-		failed = failed || !checkRotarywing(mission, home_alt);
+	if (rotary_wing) {
+		failed = failed || !checkRotarywing();
 
 	} else {
-		failed = failed || !checkFixedwing(mission, home_alt, land_start_req);
+		failed = failed || !checkFixedwing(land_start_req);
 	}
 
 	return !failed;
 }
 
-bool
-MissionFeasibilityChecker::checkRotarywing(const mission_s &mission, float home_alt)
+void
+MissionFeasibilityChecker::resetChecks()
 {
-	/*
-	 * Perform check and issue feedback to the user
-	 * Mission is only marked as feasible if takeoff check passes
-	 */
-	return checkTakeoff(mission, home_alt);
+	_validity = {};
+	_distance_to_first = {};
+	_distances_between = {};
+	_geofence = {};
+	_home_altitude = {};
+	_takeoff = {};
+	_landing = {};
 }
 
-bool
-MissionFeasibilityChecker::checkFixedwing(const mission_s &mission, float home_alt, bool land_start_req)
+void
+MissionFeasibilityChecker::visitMissionItemValidity(const mission_item_s &item, size_t index)
 {
-	/* Perform checks and issue feedback to the user for all checks */
-	bool resTakeoff = checkTakeoff(mission, home_alt);
-	bool resLanding = checkFixedWingLanding(mission, land_start_req);
+	if (_validity.failure != ValidityState::Failure::None) {
+		return;
+	}
 
-	/* Mission is only marked as feasible if all checks return true */
-	return (resTakeoff && resLanding);
+	_validity.index = index;
+
+	// check if we find unsupported items and reject mission if so
+	if (!nav_cmd_supported(item.nav_cmd)) {
+		_validity.failure = ValidityState::Failure::UnsupportedCmd;
+		_validity.value = item.nav_cmd;
+		return;
+	}
+
+	/* Check non navigation item */
+	if (item.nav_cmd == NAV_CMD_DO_SET_SERVO) {
+
+		/* check actuator number */
+		if (item.params[0] < 0 || item.params[0] > 5) {
+			_validity.failure = ValidityState::Failure::ActuatorNumber;
+			_validity.value = (int)item.params[0];
+			return;
+		}
+
+		/* check actuator value */
+		if (item.params[1] < -PWM_DEFAULT_MAX || item.params[1] > PWM_DEFAULT_MAX) {
+			_validity.failure = ValidityState::Failure::ActuatorValue;
+			_validity.value = (int)item.params[1];
+			return;
+		}
+	}
+
+	// check if the mission starts with a land command while the vehicle is landed
+	if ((index == 0) && item.nav_cmd == NAV_CMD_LAND && _navigator->get_land_detected()->landed) {
+		_validity.failure = ValidityState::Failure::StartsWithLanding;
+	}
 }
 
-bool
-MissionFeasibilityChecker::checkGeofence(const mission_s &mission, float home_alt, bool home_valid)
+void
+MissionFeasibilityChecker::visitDistanceToFirstWaypoint(const mission_item_s &item)
 {
-	if (_navigator->get_geofence().isHomeRequired() && !home_valid) {
-		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
-		return false;
+	/* only the first waypoint (with lat/lon) is checked */
+	if (_distance_to_first.done || _max_distance_to_1st_waypoint <= 0.0f || !MissionBlock::item_contains_position(item)) {
+		return;
 	}
 
-	/* Check if all mission items are inside the geofence (if we have a valid geofence) */
-	if (_navigator->get_geofence().valid()) {
-		for (size_t i = 0; i < mission.count; i++) {
-			struct mission_item_s missionitem = {};
-			const ssize_t len = sizeof(missionitem);
-
-			if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+	/* check distance from current position to item */
+	_distance_to_first.distance = get_distance_to_next_waypoint(item.lat, item.lon,
+				      _navigator->get_home_position()->lat, _navigator->get_home_position()->lon);
+	_distance_to_first.failed = !(_distance_to_first.distance < _max_distance_to_1st_waypoint);
+	_distance_to_first.done = true;
+}
 
-			if (missionitem.altitude_is_relative && !home_valid) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
-				return false;
-			}
+void
+MissionFeasibilityChecker::visitDistancesBetweenWaypoints(const mission_item_s &item)
+{
+	/* check only items with valid lat/lon */
+	if (_distances_between.failed || _max_distance_between_waypoints <= 0.0f || !MissionBlock::item_contains_position(item)) {
+		return;
+	}
 
-			// Geofence function checks against home altitude amsl
-			missionitem.altitude = missionitem.altitude_is_relative ? missionitem.altitude + home_alt : missionitem.altitude;
+	/* Compare it to last waypoint if already available. */
+	if (PX4_ISFINITE(_distances_between.last_lat) && PX4_ISFINITE(_distances_between.last_lon)) {
 
-			if (MissionBlock::item_contains_position(missionitem) && !_navigator->get_geofence().check(missionitem)) {
+		_distances_between.distance = get_distance_to_next_waypoint(item.lat, item.lon,
+					      _distances_between.last_lat, _distances_between.last_lon);
 
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu", i + 1);
-				return false;
-			}
+		if (_distances_between.distance > _max_distance_between_waypoints) {
+			_distances_between.failed = true;
+			return;
 		}
 	}
 
-	return true;
+	_distances_between.last_lat = item.lat;
+	_distances_between.last_lon = item.lon;
 }
 
-bool
-MissionFeasibilityChecker::checkHomePositionAltitude(const mission_s &mission, float home_alt, bool home_alt_valid,
-		bool throw_error)
+void
+MissionFeasibilityChecker::visitGeofence(const mission_item_s &item, size_t index)
 {
-	/* Check if all waypoints are above the home altitude */
-	for (size_t i = 0; i < mission.count; i++) {
-		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
+	if (_geofence.failure != GeofenceState::Failure::None) {
+		return;
+	}
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-			_navigator->get_mission_result()->warning = true;
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
+	if (item.altitude_is_relative && !_home_valid) {
+		_geofence.failure = GeofenceState::Failure::HomeRequired;
+		return;
+	}
+
+	if (MissionBlock::item_contains_position(item)) {
+		// Geofence function checks against home altitude amsl
+		mission_item_s item_amsl = item;
+		item_amsl.altitude = item.altitude_is_relative ? item.altitude + _home_alt : item.altitude;
+
+		if (!_navigator->get_geofence().check(item_amsl)) {
+			_geofence.failure = GeofenceState::Failure::Violation;
+			_geofence.index = index;
 		}
+	}
+}
 
-		/* reject relative alt without home set */
-		if (missionitem.altitude_is_relative && !home_alt_valid && MissionBlock::item_contains_position(missionitem)) {
+void
+MissionFeasibilityChecker::visitHomePositionAltitude(const mission_item_s &item, size_t index)
+{
+	/* only the first waypoint below home (or without home) is reported */
+	if (_home_altitude.failure != HomeAltitudeState::Failure::None || !MissionBlock::item_contains_position(item)) {
+		return;
+	}
 
-			_navigator->get_mission_result()->warning = true;
+	/* reject relative alt without home set */
+	if (item.altitude_is_relative && !_home_alt_valid) {
+		_home_altitude.failure = HomeAltitudeState::Failure::RelativeAltNoHome;
+		_home_altitude.index = index;
+		return;
+	}
 
-			if (throw_error) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: No home pos, WP %zu uses rel alt", i + 1);
-				return false;
+	/* calculate the global waypoint altitude */
+	const float wp_alt = item.altitude_is_relative ? item.altitude + _home_alt : item.altitude;
 
-			} else	{
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: No home pos, WP %zu uses rel alt", i + 1);
-				return true;
-			}
-		}
+	if (_home_alt > wp_alt) {
+		_home_altitude.failure = HomeAltitudeState::Failure::BelowHome;
+		_home_altitude.index = index;
+	}
+}
+
+void
+MissionFeasibilityChecker::visitTakeoff(const mission_item_s &item, size_t index)
+{
+	if (_takeoff.too_low) {
+		return;
+	}
 
-		/* calculate the global waypoint altitude */
-		float wp_alt = (missionitem.altitude_is_relative) ? missionitem.altitude + home_alt : missionitem.altitude;
+	// look for a takeoff waypoint
+	if (item.nav_cmd == NAV_CMD_TAKEOFF) {
+		// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
+		// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
 
-		if ((home_alt > wp_alt) && MissionBlock::item_contains_position(missionitem)) {
+		const float takeoff_alt = item.altitude_is_relative
+					  ? item.altitude
+					  : item.altitude - _home_alt;
 
-			_navigator->get_mission_result()->warning = true;
+		// check if we should use default acceptance radius
+		float acceptance_radius = _navigator->get_default_acceptance_radius();
 
-			if (throw_error) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Waypoint %zu below home", i + 1);
-				return false;
+		if (item.acceptance_radius > NAV_EPSILON_POSITION) {
+			acceptance_radius = item.acceptance_radius;
+		}
 
-			} else	{
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: Waypoint %zu below home", i + 1);
-				return true;
-			}
+		if (takeoff_alt - 1.0f < acceptance_radius) {
+			_takeoff.too_low = true;
+			return;
+		}
+
+		// tell that mission has a takeoff waypoint
+		_takeoff.has_takeoff = true;
+
+		// tell that a takeoff waypoint is the first "waypoint"
+		// mission item
+		if (index == 0) {
+			_takeoff.takeoff_first = true;
+
+		} else if (_takeoff.takeoff_index == -1) {
+			// stores the index of the first takeoff waypoint, which is only the first
+			// waypoint item if the item before it does not change position or attitude
+			_takeoff.takeoff_index = index;
+			_takeoff.takeoff_first = _takeoff.previous_non_position;
 		}
 	}
 
-	return true;
+	_takeoff.previous_non_position = nav_cmd_allowed_before_takeoff(item.nav_cmd);
 }
 
-bool
-MissionFeasibilityChecker::checkMissionItemValidity(const mission_s &mission)
+void
+MissionFeasibilityChecker::visitFixedWingLanding(const mission_item_s &item, const mission_item_s *previous,
+		size_t index)
 {
-	// do not allow mission if we find unsupported item
-	for (size_t i = 0; i < mission.count; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(struct mission_item_s);
+	/* Search for a landing waypoint. If found, the previous waypoint is checked to be
+	 * at a feasible distance and altitude given the landing slope */
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-			// not supposed to happen unless the datamanager can't access the SD card, etc.
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Cannot access SD card");
-			return false;
-		}
+	if (_landing.failure != LandingState::Failure::None) {
+		return;
+	}
 
-		// check if we find unsupported items and reject mission if so
-		if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-		    missionitem.nav_cmd != NAV_CMD_WAYPOINT &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_UNLIMITED &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_TIME_LIMIT &&
-		    missionitem.nav_cmd != NAV_CMD_RETURN_TO_LAUNCH &&
-		    missionitem.nav_cmd != NAV_CMD_LAND &&
-		    missionitem.nav_cmd != NAV_CMD_TAKEOFF &&
-		    missionitem.nav_cmd != NAV_CMD_LOITER_TO_ALT &&
-		    missionitem.nav_cmd != NAV_CMD_VTOL_TAKEOFF &&
-		    missionitem.nav_cmd != NAV_CMD_VTOL_LAND &&
-		    missionitem.nav_cmd != NAV_CMD_DELAY &&
-		    missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-		    missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_HOME &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
-		    missionitem.nav_cmd != NAV_CMD_DO_LAND_START &&
-		    missionitem.nav_cmd != NAV_CMD_DO_TRIGGER_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_IMAGE_START_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_IMAGE_STOP_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_VIDEO_START_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_VIDEO_STOP_CAPTURE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONFIGURE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONTROL &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_LOCATION &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_WPNEXT_OFFSET &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_NONE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
-		    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL &&
-		    missionitem.nav_cmd != NAV_CMD_SET_CAMERA_MODE &&
-		    missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
-
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: item %i: unsupported cmd: %d", (int)(i + 1),
-					     (int)missionitem.nav_cmd);
-			return false;
+	// if DO_LAND_START found then require valid landing AFTER
+	if (item.nav_cmd == NAV_CMD_DO_LAND_START) {
+		if (_landing.land_start_found) {
+			_landing.failure = LandingState::Failure::MultipleLandStart;
+			return;
+
+		} else {
+			_landing.land_start_found = true;
+			_landing.do_land_start_index = index;
 		}
+	}
 
-		/* Check non navigation item */
-		if (missionitem.nav_cmd == NAV_CMD_DO_SET_SERVO) {
+	if (item.nav_cmd != NAV_CMD_LAND) {
+		return;
+	}
 
-			/* check actuator number */
-			if (missionitem.params[0] < 0 || missionitem.params[0] > 5) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Actuator number %d is out of bounds 0..5",
-						     (int)missionitem.params[0]);
-				return false;
-			}
+	if (previous == nullptr) {
+		_landing.failure = LandingState::Failure::StartsWithLand;
+		return;
+	}
 
-			/* check actuator value */
-			if (missionitem.params[1] < -PWM_DEFAULT_MAX || missionitem.params[1] > PWM_DEFAULT_MAX) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(),
-						     "Actuator value %d is out of bounds -PWM_DEFAULT_MAX..PWM_DEFAULT_MAX", (int)missionitem.params[1]);
-				return false;
-			}
-		}
+	_landing.landing_approach_index = index - 1;
 
-		// check if the mission starts with a land command while the vehicle is landed
-		if ((i == 0) && missionitem.nav_cmd == NAV_CMD_LAND && _navigator->get_land_detected()->landed) {
+	if (!MissionBlock::item_contains_position(*previous)) {
+		// mission item before land doesn't have a position
+		_landing.failure = LandingState::Failure::NeedApproach;
+		return;
+	}
 
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with landing");
-			return false;
-		}
+	const bool landing_status_valid = (_landing_status.timestamp > 0);
+	const float wp_distance = get_distance_to_next_waypoint(previous->lat, previous->lon, item.lat, item.lon);
+
+	if (!(landing_status_valid && (wp_distance > _landing_status.flare_length))) {
+		/* Last wp is in flare region */
+		_landing.failure = LandingState::Failure::WithinFlare;
+		return;
 	}
 
-	return true;
+	/* Last wp is before flare region */
+	const float delta_altitude = item.altitude - previous->altitude;
+
+	if (!(delta_altitude < 0)) {
+		/* Landing waypoint is above last waypoint */
+		_landing.failure = LandingState::Failure::AboveLastWaypoint;
+		return;
+	}
+
+	const float horizontal_slope_displacement = _landing_status.horizontal_slope_displacement;
+	const float slope_angle_rad = _landing_status.slope_angle_rad;
+	const float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, item.altitude,
+				    horizontal_slope_displacement, slope_angle_rad);
+
+	if (previous->altitude > slope_alt_req + 1.0f) {
+		/* Landing waypoint is above altitude of slope at the given waypoint distance (with small tolerance for floating point discrepancies) */
+		const float wp_distance_req = Landingslope::getLandingSlopeWPDistance(previous->altitude,
+					      item.altitude, horizontal_slope_displacement, slope_angle_rad);
+
+		_landing.failure = LandingState::Failure::AdjustApproach;
+		_landing.move_down = (int)ceilf(slope_alt_req - previous->altitude);
+		_landing.move_away = (int)ceilf(wp_distance_req - wp_distance);
+		return;
+	}
+
+	_landing.landing_valid = true;
 }
 
 bool
-MissionFeasibilityChecker::checkTakeoff(const mission_s &mission, float home_alt)
+MissionFeasibilityChecker::checkRotarywing()
 {
-	bool has_takeoff = false;
-	bool takeoff_first = false;
-	int takeoff_index = -1;
+	/*
+	 * Perform check and issue feedback to the user
+	 * Mission is only marked as feasible if takeoff check passes
+	 */
+	return checkTakeoff();
+}
 
-	for (size_t i = 0; i < mission.count; i++) {
-		struct mission_item_s missionitem = {};
-		const ssize_t len = sizeof(struct mission_item_s);
+bool
+MissionFeasibilityChecker::checkFixedwing(bool land_start_req)
+{
+	/* Perform checks and issue feedback to the user for all checks */
+	bool resTakeoff = checkTakeoff();
+	bool resLanding = checkFixedWingLanding(land_start_req);
 
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
+	/* Mission is only marked as feasible if all checks return true */
+	return (resTakeoff && resLanding);
+}
 
-		// look for a takeoff waypoint
-		if (missionitem.nav_cmd == NAV_CMD_TAKEOFF) {
-			// make sure that the altitude of the waypoint is at least one meter larger than the acceptance radius
-			// this makes sure that the takeoff waypoint is not reached before we are at least one meter in the air
+bool
+MissionFeasibilityChecker::checkGeofence()
+{
+	switch (_geofence.failure) {
+	case GeofenceState::Failure::HomeRequired:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence requires valid home position");
+		return false;
 
-			float takeoff_alt = missionitem.altitude_is_relative
-					    ? missionitem.altitude
-					    : missionitem.altitude - home_alt;
+	case GeofenceState::Failure::Violation:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Geofence violation for waypoint %zu", _geofence.index + 1);
+		return false;
 
-			// check if we should use default acceptance radius
-			float acceptance_radius = _navigator->get_default_acceptance_radius();
+	default:
+		return true;
+	}
+}
 
-			if (missionitem.acceptance_radius > NAV_EPSILON_POSITION) {
-				acceptance_radius = missionitem.acceptance_radius;
-			}
+bool
+MissionFeasibilityChecker::checkHomePositionAltitude(bool throw_error)
+{
+	/* Check if all waypoints are above the home altitude */
+	if (_home_altitude.failure == HomeAltitudeState::Failure::None) {
+		return true;
+	}
 
-			if (takeoff_alt - 1.0f < acceptance_radius) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Takeoff altitude too low!");
-				return false;
-			}
+	_navigator->get_mission_result()->warning = true;
 
-			// tell that mission has a takeoff waypoint
-			has_takeoff = true;
+	const size_t wp = _home_altitude.index + 1;
 
-			// tell that a takeoff waypoint is the first "waypoint"
-			// mission item
-			if (i == 0) {
-				takeoff_first = true;
+	if (_home_altitude.failure == HomeAltitudeState::Failure::RelativeAltNoHome) {
+		if (throw_error) {
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: No home pos, WP %zu uses rel alt", wp);
+			return false;
 
-			} else if (takeoff_index == -1) {
-				// stores the index of the first takeoff waypoint
-				takeoff_index = i;
-			}
+		} else	{
+			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: No home pos, WP %zu uses rel alt", wp);
+			return true;
 		}
 	}
 
-	if (takeoff_index != -1) {
-		// checks if all the mission items before the first takeoff waypoint
-		// are not waypoints or position-related items;
-		// this means that, before a takeoff waypoint, one can set
-		// one of the bellow mission items
-		for (size_t i = 0; i < (size_t)takeoff_index; i++) {
-			struct mission_item_s missionitem = {};
-			const ssize_t len = sizeof(struct mission_item_s);
+	if (throw_error) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Waypoint %zu below home", wp);
+		return false;
 
-			if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-				/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-				return false;
-			}
+	} else	{
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Warning: Waypoint %zu below home", wp);
+		return true;
+	}
+}
 
-			if (missionitem.nav_cmd != NAV_CMD_IDLE &&
-			    missionitem.nav_cmd != NAV_CMD_DELAY &&
-			    missionitem.nav_cmd != NAV_CMD_DO_JUMP &&
-			    missionitem.nav_cmd != NAV_CMD_DO_CHANGE_SPEED &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_HOME &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_SERVO &&
-			    missionitem.nav_cmd != NAV_CMD_DO_LAND_START &&
-			    missionitem.nav_cmd != NAV_CMD_DO_TRIGGER_CONTROL &&
-			    missionitem.nav_cmd != NAV_CMD_DO_DIGICAM_CONTROL &&
-			    missionitem.nav_cmd != NAV_CMD_IMAGE_START_CAPTURE &&
-			    missionitem.nav_cmd != NAV_CMD_IMAGE_STOP_CAPTURE &&
-			    missionitem.nav_cmd != NAV_CMD_VIDEO_START_CAPTURE &&
-			    missionitem.nav_cmd != NAV_CMD_VIDEO_STOP_CAPTURE &&
-			    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONFIGURE &&
-			    missionitem.nav_cmd != NAV_CMD_DO_MOUNT_CONTROL &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_LOCATION &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_WPNEXT_OFFSET &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_ROI_NONE &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_DIST &&
-			    missionitem.nav_cmd != NAV_CMD_DO_SET_CAM_TRIGG_INTERVAL &&
-			    missionitem.nav_cmd != NAV_CMD_SET_CAMERA_MODE &&
-			    missionitem.nav_cmd != NAV_CMD_DO_VTOL_TRANSITION) {
-				takeoff_first = false;
-
-			} else {
-				takeoff_first = true;
+bool
+MissionFeasibilityChecker::checkMissionItemValidity()
+{
+	// do not allow mission if we find unsupported item
+	switch (_validity.failure) {
+	case ValidityState::Failure::UnsupportedCmd:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: item %i: unsupported cmd: %d",
+				     (int)(_validity.index + 1), _validity.value);
+		return false;
 
-			}
-		}
+	case ValidityState::Failure::ActuatorNumber:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Actuator number %d is out of bounds 0..5", _validity.value);
+		return false;
+
+	case ValidityState::Failure::ActuatorValue:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(),
+				     "Actuator value %d is out of bounds -PWM_DEFAULT_MAX..PWM_DEFAULT_MAX", _validity.value);
+		return false;
+
+	case ValidityState::Failure::StartsWithLanding:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with landing");
+		return false;
+
+	default:
+		return true;
+	}
+}
+
+bool
+MissionFeasibilityChecker::checkTakeoff()
+{
+	if (_takeoff.too_low) {
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: Takeoff altitude too low!");
+		return false;
 	}
 
 	if (_navigator->get_takeoff_required() && _navigator->get_land_detected()->landed) {
 		// check for a takeoff waypoint, after the above conditions have been met
 		// MIS_TAKEOFF_REQ param has to be set and the vehicle has to be landed - one can load a mission
 		// while the vehicle is flying and it does not require a takeoff waypoint
-		if (!has_takeoff) {
+		if (!_takeoff.has_takeoff) {
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: takeoff waypoint required.");
 			return false;
 
-		} else if (!takeoff_first) {
+		} else if (!_takeoff.takeoff_first) {
 			// check if the takeoff waypoint is the first waypoint item on the mission
 			// i.e, an item with position/attitude change modification
 			// if it is not, the mission should be rejected
@@ -406,116 +612,46 @@ MissionFeasibilityChecker::checkTakeoff(const mission_s &mission, float home_alt
 }
 
 bool
-MissionFeasibilityChecker::checkFixedWingLanding(const mission_s &mission, bool land_start_req)
+MissionFeasibilityChecker::checkFixedWingLanding(bool land_start_req)
 {
-	/* Go through all mission items and search for a landing waypoint
-	 * if landing waypoint is found: the previous waypoint is checked to be at a feasible distance and altitude given the landing slope */
-
-	bool landing_valid = false;
-
-	bool land_start_found = false;
-	size_t do_land_start_index = 0;
-	size_t landing_approach_index = 0;
-
-	for (size_t i = 0; i < mission.count; i++) {
-		struct mission_item_s missionitem;
-		const ssize_t len = sizeof(missionitem);
-
-		if (dm_read((dm_item_t)mission.dataman_id, i, &missionitem, len) != len) {
-			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-			return false;
-		}
-
-		// if DO_LAND_START found then require valid landing AFTER
-		if (missionitem.nav_cmd == NAV_CMD_DO_LAND_START) {
-			if (land_start_found) {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: more than one land start.");
-				return false;
-
-			} else {
-				land_start_found = true;
-				do_land_start_index = i;
-			}
-		}
-
-		if (missionitem.nav_cmd == NAV_CMD_LAND) {
-			mission_item_s missionitem_previous {};
-
-			if (i > 0) {
-				landing_approach_index = i - 1;
-
-				if (dm_read((dm_item_t)mission.dataman_id, landing_approach_index, &missionitem_previous, len) != len) {
-					/* not supposed to happen unless the datamanager can't access the SD card, etc. */
-					return false;
-				}
-
-				if (MissionBlock::item_contains_position(missionitem_previous)) {
-
-					uORB::SubscriptionData<position_controller_landing_status_s> landing_status{ORB_ID(position_controller_landing_status)};
-
-					const bool landing_status_valid = (landing_status.get().timestamp > 0);
-					const float wp_distance = get_distance_to_next_waypoint(missionitem_previous.lat, missionitem_previous.lon,
-								  missionitem.lat, missionitem.lon);
-
-					if (landing_status_valid && (wp_distance > landing_status.get().flare_length)) {
-						/* Last wp is before flare region */
-
-						const float delta_altitude = missionitem.altitude - missionitem_previous.altitude;
-
-						if (delta_altitude < 0) {
-
-							const float horizontal_slope_displacement = landing_status.get().horizontal_slope_displacement;
-							const float slope_angle_rad = landing_status.get().slope_angle_rad;
-							const float slope_alt_req = Landingslope::getLandingSlopeAbsoluteAltitude(wp_distance, missionitem.altitude,
-										    horizontal_slope_displacement, slope_angle_rad);
-
-							if (missionitem_previous.altitude > slope_alt_req + 1.0f) {
-								/* Landing waypoint is above altitude of slope at the given waypoint distance (with small tolerance for floating point discrepancies) */
-								mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: adjust landing approach.");
-
-								const float wp_distance_req = Landingslope::getLandingSlopeWPDistance(missionitem_previous.altitude,
-											      missionitem.altitude, horizontal_slope_displacement, slope_angle_rad);
-
-								mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Move down %d m or move further away by %d m.",
-										     (int)ceilf(slope_alt_req - missionitem_previous.altitude),
-										     (int)ceilf(wp_distance_req - wp_distance));
+	switch (_landing.failure) {
+	case LandingState::Failure::MultipleLandStart:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: more than one land start.");
+		return false;
 
-								return false;
-							}
+	case LandingState::Failure::AdjustApproach:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: adjust landing approach.");
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Move down %d m or move further away by %d m.",
+				     _landing.move_down, _landing.move_away);
+		return false;
 
-						} else {
-							/* Landing waypoint is above last waypoint */
-							mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: landing above last waypoint.");
-							return false;
-						}
+	case LandingState::Failure::AboveLastWaypoint:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: landing above last waypoint.");
+		return false;
 
-					} else {
-						/* Last wp is in flare region */
-						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: waypoint within landing flare.");
-						return false;
-					}
+	case LandingState::Failure::WithinFlare:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: waypoint within landing flare.");
+		return false;
 
-					landing_valid = true;
+	case LandingState::Failure::NeedApproach:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: need landing approach.");
+		return false;
 
-				} else {
-					// mission item before land doesn't have a position
-					mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: need landing approach.");
-					return false;
-				}
+	case LandingState::Failure::StartsWithLand:
+		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with land waypoint.");
+		return false;
 
-			} else {
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: starts with land waypoint.");
-				return false;
-			}
-		}
+	default:
+		break;
 	}
 
-	if (land_start_req && !land_start_found) {
+	if (land_start_req && !_landing.land_start_found) {
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: landing pattern required.");
 		return false;
 	}
 
-	if (land_start_found && (!landing_valid || (do_land_start_index > landing_approach_index))) {
+	if (_landing.land_start_found && (!_landing.landing_valid
+					  || (_landing.do_land_start_index > _landing.landing_approach_index))) {
 		mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Mission rejected: invalid land start.");
 		return false;
 	}
@@ -525,103 +661,34 @@ MissionFeasibilityChecker::checkFixedWingLanding(const mission_s &mission, bool
 }
 
 bool
-MissionFeasibilityChecker::checkDistanceToFirstWaypoint(const mission_s &mission, float max_distance)
+MissionFeasibilityChecker::checkDistanceToFirstWaypoint()
 {
-	if (max_distance <= 0.0f) {
-		/* param not set, check is ok */
+	if (!_distance_to_first.failed) {
+		/* param not set, no waypoints or first waypoint close enough */
 		return true;
 	}
 
-	/* find first waypoint (with lat/lon) item in datamanager */
-	for (size_t i = 0; i < mission.count; i++) {
-
-		struct mission_item_s mission_item {};
-
-		if (!(dm_read((dm_item_t)mission.dataman_id, i, &mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s))) {
-			/* error reading, mission is invalid */
-			mavlink_log_info(_navigator->get_mavlink_log_pub(), "Error reading offboard mission.");
-			return false;
-		}
-
-		/* check only items with valid lat/lon */
-		if (!MissionBlock::item_contains_position(mission_item)) {
-			continue;
-		}
-
-		/* check distance from current position to item */
-		float dist_to_1wp = get_distance_to_next_waypoint(
-					    mission_item.lat, mission_item.lon,
-					    _navigator->get_home_position()->lat, _navigator->get_home_position()->lon);
-
-		if (dist_to_1wp < max_distance) {
-
-			return true;
+	/* item is too far from home */
+	mavlink_log_critical(_navigator->get_mavlink_log_pub(),
+			     "First waypoint too far away: %d meters, %d max.",
+			     (int)_distance_to_first.distance, (int)_max_distance_to_1st_waypoint);
 
-		} else {
-			/* item is too far from home */
-			mavlink_log_critical(_navigator->get_mavlink_log_pub(),
-					     "First waypoint too far away: %d meters, %d max.",
-					     (int)dist_to_1wp, (int)max_distance);
-
-			_navigator->get_mission_result()->warning = true;
-			return false;
-		}
-	}
-
-	/* no waypoints found in mission, then we will not fly far away */
-	return true;
+	_navigator->get_mission_result()->warning = true;
+	return false;
 }
 
 bool
-MissionFeasibilityChecker::checkDistancesBetweenWaypoints(const mission_s &mission, float max_distance)
+MissionFeasibilityChecker::checkDistancesBetweenWaypoints()
 {
-	if (max_distance <= 0.0f) {
-		/* param not set, check is ok */
+	if (!_distances_between.failed) {
+		/* We ran through all waypoints and have not found any distances between waypoints that are too far. */
 		return true;
 	}
 
-	double last_lat = (double)NAN;
-	double last_lon = (double)NAN;
-
-	/* Go through all waypoints */
-	for (size_t i = 0; i < mission.count; i++) {
+	mavlink_log_critical(_navigator->get_mavlink_log_pub(),
+			     "Distance between waypoints too far: %d meters, %d max.",
+			     (int)_distances_between.distance, (int)_max_distance_between_waypoints);
 
-		struct mission_item_s mission_item {};
-
-		if (!(dm_read((dm_item_t)mission.dataman_id, i, &mission_item, sizeof(mission_item_s)) == sizeof(mission_item_s))) {
-			/* error reading, mission is invalid */
-			mavlink_log_info(_navigator->get_mavlink_log_pub(), "Error reading offboard mission.");
-			return false;
-		}
-
-		/* check only items with valid lat/lon */
-		if (!MissionBlock::item_contains_position(mission_item)) {
-			continue;
-		}
-
-		/* Compare it to last waypoint if already available. */
-		if (PX4_ISFINITE(last_lat) && PX4_ISFINITE(last_lon)) {
-
-			/* check distance from current position to item */
-			const float dist_between_waypoints = get_distance_to_next_waypoint(
-					mission_item.lat, mission_item.lon,
-					last_lat, last_lon);
-
-			if (dist_between_waypoints > max_distance) {
-				/* item is too far from home */
-				mavlink_log_critical(_navigator->get_mavlink_log_pub(),
-						     "Distance between waypoints too far: %d meters, %d max.",
-						     (int)dist_between_waypoints, (int)max_distance);
-
-				_navigator->get_mission_result()->warning = true;
-				return false;
-			}
-		}
-
-		last_lat = mission_item.lat;
-		last_lon = mission_item.lon;
-	}
-
-	/* We ran through all waypoints and have not found any distances between waypoints that are too far. */
-	return true;
+	_navigator->get_mission_result()->warning = true;
+	return false;
 }
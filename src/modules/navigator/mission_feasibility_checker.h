@@ -42,34 +42,120 @@
 
 #pragma once
 
+#include "navigation.h"
+
 #include <dataman/dataman.h>
+#include <math.h>
 #include <uORB/topics/mission.h>
+#include <uORB/topics/position_controller_landing_status.h>
 
 class Geofence;
 class Navigator;
 
+/**
+ * Mission feasibility checks.
+ *
+ * The mission is streamed from dataman once, in chunks of MISSION_READ_CHUNK items, and every
+ * item is passed to all checks. Each check keeps its own state across the pass (visit*()) and
+ * reports its verdict and messages at the end (check*()), in the same order and with the same
+ * short-circuiting as if every check had walked the mission on its own.
+ */
 class MissionFeasibilityChecker
 {
 private:
 	Navigator *_navigator{nullptr};
 
+	/* number of mission items read from dataman at once */
+	static constexpr unsigned MISSION_READ_CHUNK = 8;
+
+	/* context of the current pass */
+	float _home_alt{0.f};
+	bool _home_valid{false};
+	bool _home_alt_valid{false};
+	float _max_distance_to_1st_waypoint{0.f};
+	float _max_distance_between_waypoints{0.f};
+	position_controller_landing_status_s _landing_status{};
+
+	/* chunk of mission items read from dataman and the item preceding the one being visited */
+	mission_item_s _items[MISSION_READ_CHUNK] {};
+	mission_item_s _previous_item{};
+
+	/* per check state of the current pass, reset in resetChecks() */
+	struct ValidityState {
+		enum class Failure : uint8_t { None, UnsupportedCmd, ActuatorNumber, ActuatorValue, StartsWithLanding } failure{Failure::None};
+		size_t index{0};
+		int value{0};
+	} _validity;
+
+	struct DistanceToFirstState {
+		bool done{false};
+		bool failed{false};
+		float distance{0.f};
+	} _distance_to_first;
+
+	struct DistancesBetweenState {
+		bool failed{false};
+		float distance{0.f};
+		double last_lat{(double)NAN};
+		double last_lon{(double)NAN};
+	} _distances_between;
+
+	struct GeofenceState {
+		enum class Failure : uint8_t { None, HomeRequired, Violation } failure{Failure::None};
+		size_t index{0};
+	} _geofence;
+
+	struct HomeAltitudeState {
+		enum class Failure : uint8_t { None, RelativeAltNoHome, BelowHome } failure{Failure::None};
+		size_t index{0};
+	} _home_altitude;
+
+	struct TakeoffState {
+		bool has_takeoff{false};
+		bool takeoff_first{false};
+		bool too_low{false};
+		int takeoff_index{-1};
+		bool previous_non_position{false};
+	} _takeoff;
+
+	struct LandingState {
+		enum class Failure : uint8_t { None, MultipleLandStart, AdjustApproach, AboveLastWaypoint, WithinFlare, NeedApproach, StartsWithLand } failure{Failure::None};
+		bool landing_valid{false};
+		bool land_start_found{false};
+		size_t do_land_start_index{0};
+		size_t landing_approach_index{0};
+		int move_down{0};
+		int move_away{0};
+	} _landing;
+
+	void resetChecks();
+
+	/* Per item visitors, called once for every mission item in order */
+	void visitMissionItemValidity(const mission_item_s &item, size_t index);
+	void visitDistanceToFirstWaypoint(const mission_item_s &item);
+	void visitDistancesBetweenWaypoints(const mission_item_s &item);
+	void visitGeofence(const mission_item_s &item, size_t index);
+	void visitHomePositionAltitude(const mission_item_s &item, size_t index);
+	void visitTakeoff(const mission_item_s &item, size_t index);
+	void visitFixedWingLanding(const mission_item_s &item, const mission_item_s *previous, size_t index);
+
 	/* Checks for all airframes */
-	bool checkGeofence(const mission_s &mission, float home_alt, bool home_valid);
+	bool checkGeofence();
 
-	bool checkHomePositionAltitude(const mission_s &mission, float home_alt, bool home_alt_valid, bool throw_error);
+	bool checkHomePositionAltitude(bool throw_error);
 
-	bool checkMissionItemValidity(const mission_s &mission);
+	bool checkMissionItemValidity();
 
-	bool checkDistanceToFirstWaypoint(const mission_s &mission, float max_distance);
-	bool checkDistancesBetweenWaypoints(const mission_s &mission, float max_distance);
+	bool checkDistanceToFirstWaypoint();
+	bool checkDistancesBetweenWaypoints();
 
 	/* Checks specific to fixedwing airframes */
-	bool checkFixedwing(const mission_s &mission, float home_alt, bool land_start_req);
-	bool checkTakeoff(const mission_s &mission, float home_alt);
-	bool checkFixedWingLanding(const mission_s &mission, bool land_start_req);
+	bool checkFixedwing(bool land_start_req);
+	bool checkTakeoff();
+	bool checkFixedWingLanding(bool land_start_req);
 
 	/* Checks specific to rotarywing airframes */
-	bool checkRotarywing(const mission_s &mission, float home_alt);
+	bool checkRotarywing();
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator) : _navigator(navigator) {}
@@ -0,0 +1,209 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_prefetch.cpp
+ *
+ * Read-ahead cache of mission items.
+ */
+
+#include "mission_prefetch.h"
+
+#include <string.h>
+
+#include <px4_time.h>
+
+MissionPrefetch::MissionPrefetch() :
+	_hit_perf(perf_alloc(PC_COUNT, "navigator: mission item cached")),
+	_miss_perf(perf_alloc(PC_COUNT, "navigator: mission item read"))
+{
+}
+
+MissionPrefetch::~MissionPrefetch()
+{
+	/*
+	 * dataman still owns the read buffer while a read is pending. The dataman task completes every queued
+	 * request before it exits, so the callback is guaranteed to come.
+	 */
+	while (_read_state.load() == READ_PENDING) {
+		px4_usleep(10000);
+	}
+
+	perf_free(_hit_perf);
+	perf_free(_miss_perf);
+}
+
+void
+MissionPrefetch::reset(dm_item_t dm_item, uint16_t count)
+{
+	_generation++;
+	_dm_item = dm_item;
+	_count = count;
+
+	for (Slot &slot : _slots) {
+		slot.index = -1;
+	}
+}
+
+bool
+MissionPrefetch::get(int index, mission_item_s &item)
+{
+	apply_read();
+
+	if (index < 0) {
+		return false;
+	}
+
+	const Slot &slot = _slots[index % NUM_SLOTS];
+
+	if (slot.index != index) {
+		return false;
+	}
+
+	memcpy(&item, &slot.item, sizeof(mission_item_s));
+	return true;
+}
+
+bool
+MissionPrefetch::read(int index, mission_item_s &item)
+{
+	if (get(index, item)) {
+		perf_count(_hit_perf);
+		return true;
+	}
+
+	perf_count(_miss_perf);
+
+	if (index < 0 || index >= _count) {
+		return false;
+	}
+
+	const ssize_t len = sizeof(mission_item_s);
+
+	if (dm_read(_dm_item, index, &item, len) != len) {
+		return false;
+	}
+
+	store(index, item);
+	return true;
+}
+
+bool
+MissionPrefetch::scan(int index, mission_item_s &item)
+{
+	if (get(index, item)) {
+		perf_count(_hit_perf);
+		return true;
+	}
+
+	perf_count(_miss_perf);
+
+	if (index < 0 || index >= _count) {
+		return false;
+	}
+
+	const ssize_t len = sizeof(mission_item_s);
+
+	return dm_read(_dm_item, index, &item, len) == len;
+}
+
+void
+MissionPrefetch::update(int index, const mission_item_s &item)
+{
+	/* the read in flight might have been served before the write, drop it */
+	if (_read_state.load() != READ_IDLE) {
+		_generation++;
+	}
+
+	store(index, item);
+}
+
+void
+MissionPrefetch::prefetch(int index, bool reverse)
+{
+	apply_read();
+
+	if (_read_state.load() != READ_IDLE || index < 0 || index >= _count) {
+		return;
+	}
+
+	int count;
+
+	if (reverse) {
+		_read_first = (index >= READ_CHUNK - 1) ? index - (READ_CHUNK - 1) : 0;
+		count = index - _read_first + 1;
+
+	} else {
+		_read_first = index;
+		count = (_count - index < READ_CHUNK) ? _count - index : READ_CHUNK;
+	}
+
+	_read_generation = _generation;
+	_read_state.store(READ_PENDING);
+
+	if (dm_read_range_async(_dm_item, _read_first, count, _read_buffer, sizeof(mission_item_s), &read_done, this) != 0) {
+		_read_state.store(READ_IDLE);
+	}
+}
+
+void
+MissionPrefetch::read_done(ssize_t result, void *arg)
+{
+	/* called from the dataman task */
+	MissionPrefetch *prefetch = static_cast<MissionPrefetch *>(arg);
+	prefetch->_read_result = result;
+	prefetch->_read_state.store(READ_DONE);
+}
+
+void
+MissionPrefetch::apply_read()
+{
+	if (_read_state.load() != READ_DONE) {
+		return;
+	}
+
+	if (_read_generation == _generation) {
+		for (int i = 0; i < _read_result; i++) {
+			store(_read_first + i, _read_buffer[i]);
+		}
+	}
+
+	_read_state.store(READ_IDLE);
+}
+
+void
+MissionPrefetch::store(int index, const mission_item_s &item)
+{
+	Slot &slot = _slots[index % NUM_SLOTS];
+	slot.index = index;
+	memcpy(&slot.item, &item, sizeof(mission_item_s));
+}
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file mission_prefetch.h
+ *
+ * Read-ahead cache of mission items.
+ */
+
+#pragma once
+
+#include "navigation.h"
+
+#include <dataman/dataman.h>
+#include <lib/perf/perf_counter.h>
+#include <px4_atomic.h>
+
+/**
+ * Mission items are kept in a direct mapped table indexed by their mission index, so the
+ * items behind a DO_JUMP get their own slots next to the items ahead of the vehicle.
+ * Items that are missing are read from dataman asynchronously (see prefetch()), so the
+ * navigator only blocks on storage for items that could not be prefetched in time.
+ */
+class MissionPrefetch
+{
+public:
+	MissionPrefetch();
+	~MissionPrefetch();
+
+	MissionPrefetch(const MissionPrefetch &) = delete;
+	MissionPrefetch &operator=(const MissionPrefetch &) = delete;
+
+	/**
+	 * Drop all cached items and select the mission to read from.
+	 * Must be called whenever the mission changed or was rewritten.
+	 */
+	void reset(dm_item_t dm_item, uint16_t count);
+
+	/**
+	 * Get a mission item if it is cached, without accessing dataman.
+	 * @return true if the item is cached
+	 */
+	bool get(int index, mission_item_s &item);
+
+	/**
+	 * Get a mission item, from the cache if possible or from dataman otherwise.
+	 * @return true on success
+	 */
+	bool read(int index, mission_item_s &item);
+
+	/**
+	 * Get a mission item like read(), but without caching an item read from dataman.
+	 * Meant for passes over the whole mission, which would otherwise evict the items ahead of the vehicle.
+	 * @return true on success
+	 */
+	bool scan(int index, mission_item_s &item);
+
+	/**
+	 * Update a cached item after it was written to dataman (e.g. DO_JUMP counters).
+	 */
+	void update(int index, const mission_item_s &item);
+
+	/**
+	 * Queue an asynchronous read of the items starting at index (and counting down if reverse).
+	 * Only one read is in flight at a time, a request while a read is pending is ignored.
+	 */
+	void prefetch(int index, bool reverse);
+
+	/* number of items the cache can hold */
+#if defined(MEMORY_CONSTRAINED_SYSTEM)
+	static constexpr int NUM_SLOTS = 8;
+#else
+	static constexpr int NUM_SLOTS = 16;
+#endif
+
+private:
+	/* number of items read from dataman per request */
+	static constexpr int READ_CHUNK = NUM_SLOTS / 2;
+
+	enum ReadState : int {
+		READ_IDLE = 0,
+		READ_PENDING,
+		READ_DONE
+	};
+
+	static void read_done(ssize_t result, void *arg);
+
+	/* copy the items of a completed read into the cache */
+	void apply_read();
+
+	void store(int index, const mission_item_s &item);
+
+	struct Slot {
+		int32_t index{-1};
+		mission_item_s item;
+	};
+
+	Slot _slots[NUM_SLOTS] {};
+
+	dm_item_t _dm_item{DM_KEY_WAYPOINTS_OFFBOARD_0};
+	uint16_t _count{0};
+
+	/* buffer of the read in flight, owned by dataman while the read is pending */
+	mission_item_s _read_buffer[READ_CHUNK] {};
+	int _read_first{0};
+	ssize_t _read_result{0};
+	uint32_t _read_generation{0};
+	px4::atomic_int _read_state{READ_IDLE};
+
+	/* incremented to discard the read in flight */
+	uint32_t _generation{0};
+
+	perf_counter_t _hit_perf;
+	perf_counter_t _miss_perf;
+};
@@ -57,11 +57,14 @@
 
 #include "navigation.h"
 
+#include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_module.h>
 #include <px4_module_params.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/PublicationQueued.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/geofence_result.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/mission.h>
@@ -86,7 +89,7 @@
 #define NAVIGATOR_MODE_ARRAY_SIZE 11
 
 
-class Navigator : public ModuleBase<Navigator>, public ModuleParams
+class Navigator : public ModuleBase<Navigator>, public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
 	Navigator();
@@ -98,17 +101,13 @@ public:
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
 
-	/** @see ModuleBase */
-	static Navigator *instantiate(int argc, char *argv[]);
-
 	/** @see ModuleBase */
 	static int custom_command(int argc, char *argv[]);
 
 	/** @see ModuleBase */
 	static int print_usage(const char *reason = nullptr);
 
-	/** @see ModuleBase::run() */
-	void run() override;
+	bool init();
 
 	/** @see ModuleBase::print_status() */
 	int print_status() override;
@@ -311,17 +310,19 @@ private:
 		(ParamFloat<px4::params::MIS_YAW_ERR>) _param_mis_yaw_err
 	)
 
-	int		_local_pos_sub{-1};		/**< local position subscription */
+	// Subscriptions that trigger a navigator update
+	uORB::SubscriptionCallbackWorkItem _local_pos_sub{this, ORB_ID(vehicle_local_position)};	/**< local position subscription */
+	uORB::SubscriptionCallbackWorkItem _home_pos_sub{this, ORB_ID(home_position)};		/**< home position subscription */
+	uORB::SubscriptionCallbackWorkItem _land_detected_sub{this, ORB_ID(vehicle_land_detected)};	/**< vehicle land detected subscription */
+	uORB::SubscriptionCallbackWorkItem _mission_sub{this, ORB_ID(mission)};			/**< mission subscription, to wake up on mission changes */
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub{this, ORB_ID(vehicle_command)};	/**< vehicle commands (onboard and offboard) */
+	uORB::SubscriptionCallbackWorkItem _vstatus_sub{this, ORB_ID(vehicle_status)};		/**< vehicle status subscription */
 
 	uORB::Subscription _global_pos_sub{ORB_ID(vehicle_global_position)};	/**< global position subscription */
 	uORB::Subscription _gps_pos_sub{ORB_ID(vehicle_gps_position)};		/**< gps position subscription */
-	uORB::Subscription _home_pos_sub{ORB_ID(home_position)};		/**< home position subscription */
-	uORB::Subscription _land_detected_sub{ORB_ID(vehicle_land_detected)};	/**< vehicle land detected subscription */
 	uORB::Subscription _param_update_sub{ORB_ID(parameter_update)};		/**< param update subscription */
 	uORB::Subscription _pos_ctrl_landing_status_sub{ORB_ID(position_controller_landing_status)};	/**< position controller landing status subscription */
 	uORB::Subscription _traffic_sub{ORB_ID(transponder_report)};		/**< traffic subscription */
-	uORB::Subscription _vehicle_command_sub{ORB_ID(vehicle_command)};	/**< vehicle commands (onboard and offboard) */
-	uORB::Subscription _vstatus_sub{ORB_ID(vehicle_status)};		/**< vehicle status subscription */
 
 	uORB::SubscriptionData<position_controller_status_s>	_position_controller_status_sub{ORB_ID(position_controller_status)};
 
@@ -355,6 +356,11 @@ private:
 
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
+	bool		_initialized{false};		/**< geofence file and parameters loaded */
+	bool		_have_geofence_position_data{false};	/**< new position for the geofence check since the last check */
+	hrt_abstime	_last_geofence_check{0};
+	hrt_abstime	_last_modes_update{0};		/**< last time all navigation modes were run */
+
 	Geofence	_geofence;			/**< class that handles the geofence */
 	bool		_geofence_violation_warning_sent{false}; /**< prevents spaming to mavlink */
 
@@ -387,9 +393,26 @@ private:
 	float _mission_cruising_speed_fw{-1.0f};
 	float _mission_throttle{-1.0f};
 
+	void		Run() override;
+
 	// update subscriptions
 	void		params_update();
 
+	/**
+	 * Handle a vehicle command for the navigator
+	 */
+	void		handle_vehicle_command(const vehicle_command_s &cmd);
+
+	/**
+	 * Check the geofence if there is new position data and publish the result
+	 */
+	void		geofence_update();
+
+	/**
+	 * Select the navigation mode from the nav_state set by commander
+	 */
+	NavigatorMode	*select_navigation_mode();
+
 	/**
 	 * Publish a new position setpoint triplet for position controllers
 	 */
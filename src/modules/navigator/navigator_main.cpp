@@ -76,6 +76,7 @@ Navigator	*g_navigator;
 
 Navigator::Navigator() :
 	ModuleParams(nullptr),
+	ScheduledWorkItem(px4::wq_configurations::nav_and_controllers),
 	_loop_perf(perf_alloc(PC_ELAPSED, "navigator")),
 	_geofence(this),
 	_mission(this),
@@ -106,14 +107,34 @@ Navigator::Navigator() :
 	_handle_back_trans_dec_mss = param_find("VT_B_DEC_MSS");
 	_handle_reverse_delay = param_find("VT_B_REV_DEL");
 
-	_local_pos_sub = orb_subscribe(ORB_ID(vehicle_local_position));
+	/* rate-limit position updates to 20 Hz / 50 ms */
+	_local_pos_sub.set_interval_ms(50);
 
 	reset_triplets();
 }
 
 Navigator::~Navigator()
 {
-	orb_unsubscribe(_local_pos_sub);
+	perf_free(_loop_perf);
+}
+
+bool
+Navigator::init()
+{
+	if (!_local_pos_sub.register_callback()
+	    || !_home_pos_sub.register_callback()
+	    || !_land_detected_sub.register_callback()
+	    || !_mission_sub.register_callback()
+	    || !_vehicle_command_sub.register_callback()
+	    || !_vstatus_sub.register_callback()) {
+
+		PX4_ERR("callback registration failed");
+		return false;
+	}
+
+	ScheduleNow();
+
+	return true;
 }
 
 void
@@ -134,580 +155,606 @@ Navigator::params_update()
 }
 
 void
-Navigator::run()
+Navigator::Run()
 {
-	bool have_geofence_position_data = false;
-
-	/* Try to load the geofence:
-	 * if /fs/microsd/etc/geofence.txt load from this file */
-	struct stat buffer;
-
-	if (stat(GEOFENCE_FILENAME, &buffer) == 0) {
-		PX4_INFO("Loading geofence from %s", GEOFENCE_FILENAME);
-		_geofence.loadFromFile(GEOFENCE_FILENAME);
+	if (should_exit()) {
+		_local_pos_sub.unregister_callback();
+		_home_pos_sub.unregister_callback();
+		_land_detected_sub.unregister_callback();
+		_mission_sub.unregister_callback();
+		_vehicle_command_sub.unregister_callback();
+		_vstatus_sub.unregister_callback();
+		ScheduleClear();
+		exit_and_cleanup();
+		return;
 	}
 
-	params_update();
+	if (!_initialized) {
+		/* Try to load the geofence:
+		 * if /fs/microsd/etc/geofence.txt load from this file */
+		struct stat buffer;
 
-	/* wakeup source(s) */
-	px4_pollfd_struct_t fds[1] = {};
+		if (stat(GEOFENCE_FILENAME, &buffer) == 0) {
+			PX4_INFO("Loading geofence from %s", GEOFENCE_FILENAME);
+			_geofence.loadFromFile(GEOFENCE_FILENAME);
+		}
 
-	/* Setup of loop */
-	fds[0].fd = _local_pos_sub;
-	fds[0].events = POLLIN;
+		params_update();
+		_initialized = true;
+	}
 
-	/* rate-limit position subscription to 20 Hz / 50 ms */
-	orb_set_interval(_local_pos_sub, 50);
+	perf_begin(_loop_perf);
 
-	hrt_abstime last_geofence_check = 0;
+	/* run at least once per second if no topic triggers an update */
+	ScheduleDelayed(1_s);
 
-	while (!should_exit()) {
+	_local_pos_sub.update(&_local_pos);
 
-		/* wait for up to 1000ms for data */
-		int pret = px4_poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 1000);
+	/* gps updated */
+	if (_gps_pos_sub.updated()) {
+		_gps_pos_sub.copy(&_gps_pos);
 
-		if (pret == 0) {
-			/* Let the loop run anyway, don't do `continue` here. */
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
+			_have_geofence_position_data = true;
+		}
+	}
 
-		} else if (pret < 0) {
-			/* this is undesirable but not much we can do - might want to flag unhappy status */
-			PX4_ERR("poll error %d, %d", pret, errno);
-			px4_usleep(10000);
-			continue;
+	/* global position updated */
+	if (_global_pos_sub.updated()) {
+		_global_pos_sub.copy(&_global_pos);
 
-		} else {
-			if (fds[0].revents & POLLIN) {
-				/* success, local pos is available */
-				orb_copy(ORB_ID(vehicle_local_position), _local_pos_sub, &_local_pos);
-			}
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
+			_have_geofence_position_data = true;
 		}
+	}
 
-		perf_begin(_loop_perf);
+	/* changes of the vehicle state, the mission or the parameters require all navigation modes to run,
+	 * position updates only drive the active one */
+	bool vehicle_state_updated = false;
 
-		/* gps updated */
-		if (_gps_pos_sub.updated()) {
-			_gps_pos_sub.copy(&_gps_pos);
+	/* parameters updated */
+	if (_param_update_sub.updated()) {
+		params_update();
+		vehicle_state_updated = true;
+	}
 
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
-				have_geofence_position_data = true;
-			}
-		}
+	vehicle_state_updated |= _vstatus_sub.update(&_vstatus);
+	vehicle_state_updated |= _land_detected_sub.update(&_land_detected);
+	vehicle_state_updated |= _home_pos_sub.update(&_home_pos);
+	_position_controller_status_sub.update();
 
-		/* global position updated */
-		if (_global_pos_sub.updated()) {
-			_global_pos_sub.copy(&_global_pos);
+	if (_mission_sub.updated()) {
+		/* the mission itself is copied by the mission mode, only clear the update flag */
+		mission_s mission;
+		_mission_sub.copy(&mission);
+		vehicle_state_updated = true;
+	}
 
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
-				have_geofence_position_data = true;
-			}
-		}
+	while (_vehicle_command_sub.updated()) {
+		vehicle_command_s cmd{};
+		_vehicle_command_sub.copy(&cmd);
+		handle_vehicle_command(cmd);
+		vehicle_state_updated = true;
+	}
 
-		/* parameters updated */
-		if (_param_update_sub.updated()) {
-			params_update();
-		}
+	/* Check for traffic */
+	check_traffic();
 
-		_vstatus_sub.update(&_vstatus);
-		_land_detected_sub.update(&_land_detected);
-		_position_controller_status_sub.update();
-		_home_pos_sub.update(&_home_pos);
+	/* Check geofence violation */
+	geofence_update();
 
-		if (_vehicle_command_sub.updated()) {
-			vehicle_command_s cmd{};
-			_vehicle_command_sub.copy(&cmd);
+	NavigatorMode *navigation_mode_new = select_navigation_mode();
 
-			if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_GO_AROUND) {
+	// update the vehicle status
+	_previous_nav_state = _vstatus.nav_state;
 
-				// DO_GO_AROUND is currently handled by the position controller (unacknowledged)
-				// TODO: move DO_GO_AROUND handling to navigator
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+	const bool navigation_mode_changed = (_navigation_mode != navigation_mode_new);
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_REPOSITION) {
+	/* we have a new navigation mode: reset triplet */
+	if (navigation_mode_changed) {
+		// We don't reset the triplet if we just did an auto-takeoff and are now
+		// going to loiter. Otherwise, we lose the takeoff altitude and end up lower
+		// than where we wanted to go.
+		//
+		// FIXME: a better solution would be to add reset where they are needed and remove
+		//        this general reset here.
+		if (!(_navigation_mode == &_takeoff &&
+		      navigation_mode_new == &_loiter)) {
+			reset_triplets();
+		}
+	}
 
-				position_setpoint_triplet_s *rep = get_reposition_triplet();
-				position_setpoint_triplet_s *curr = get_position_setpoint_triplet();
+	_navigation_mode = navigation_mode_new;
 
-				// store current position as previous position and goal as next
-				rep->previous.yaw = get_global_position()->yaw;
-				rep->previous.lat = get_global_position()->lat;
-				rep->previous.lon = get_global_position()->lon;
-				rep->previous.alt = get_global_position()->alt;
+	/* iterate through navigation modes and set active/inactive for each. Only the active mode
+	 * follows the position, the inactive ones are updated on vehicle state changes, mode switches
+	 * and at least once per second */
+	const bool update_all_modes = vehicle_state_updated || navigation_mode_changed
+				      || (hrt_elapsed_time(&_last_modes_update) > 1_s);
 
-				rep->current.loiter_radius = get_loiter_radius();
-				rep->current.loiter_direction = 1;
-				rep->current.type = position_setpoint_s::SETPOINT_TYPE_LOITER;
+	if (update_all_modes) {
+		_last_modes_update = hrt_absolute_time();
+	}
 
-				// If no argument for ground speed, use default value.
-				if (cmd.param1 <= 0 || !PX4_ISFINITE(cmd.param1)) {
-					rep->current.cruising_speed = get_cruising_speed();
+	for (unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
+		NavigatorMode *mode = _navigation_mode_array[i];
 
-				} else {
-					rep->current.cruising_speed = cmd.param1;
-				}
+		if (update_all_modes || (mode == _navigation_mode)) {
+			mode->run(mode == _navigation_mode);
+		}
+	}
 
-				rep->current.cruising_throttle = get_cruising_throttle();
-				rep->current.acceptance_radius = get_acceptance_radius();
+	/* if we landed and have not received takeoff setpoint then stay in idle */
+	if (_land_detected.landed &&
+	    !((_vstatus.nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF)
+	      || (_vstatus.nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION))) {
 
-				// Go on and check which changes had been requested
-				if (PX4_ISFINITE(cmd.param4)) {
-					rep->current.yaw = cmd.param4;
-					rep->current.yaw_valid = true;
+		_pos_sp_triplet.current.type = position_setpoint_s::SETPOINT_TYPE_IDLE;
+		_pos_sp_triplet.current.valid = true;
+		_pos_sp_triplet.previous.valid = false;
+		_pos_sp_triplet.next.valid = false;
 
-				} else {
-					rep->current.yaw = NAN;
-					rep->current.yaw_valid = false;
-				}
+	}
 
-				if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+	/* if nothing is running, set position setpoint triplet invalid once */
+	if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
+		_pos_sp_triplet_published_invalid_once = true;
+		reset_triplets();
+	}
 
-					// Position change with optional altitude change
-					rep->current.lat = (cmd.param5 < 1000) ? cmd.param5 : cmd.param5 / (double)1e7;
-					rep->current.lon = (cmd.param6 < 1000) ? cmd.param6 : cmd.param6 / (double)1e7;
+	if (_pos_sp_triplet_updated) {
+		publish_position_setpoint_triplet();
+	}
 
-					if (PX4_ISFINITE(cmd.param7)) {
-						rep->current.alt = cmd.param7;
+	if (_mission_result_updated) {
+		publish_mission_result();
+	}
 
-					} else {
-						rep->current.alt = get_global_position()->alt;
-					}
+	perf_end(_loop_perf);
+}
 
-				} else if (PX4_ISFINITE(cmd.param7) && curr->current.valid
-					   && PX4_ISFINITE(curr->current.lat)
-					   && PX4_ISFINITE(curr->current.lon)) {
+void
+Navigator::handle_vehicle_command(const vehicle_command_s &cmd)
+{
+	if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_GO_AROUND) {
 
-					// Altitude without position change
-					rep->current.lat = curr->current.lat;
-					rep->current.lon = curr->current.lon;
-					rep->current.alt = cmd.param7;
+		// DO_GO_AROUND is currently handled by the position controller (unacknowledged)
+		// TODO: move DO_GO_AROUND handling to navigator
+		publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-				} else {
-					// All three set to NaN - hold in current position
-					rep->current.lat = get_global_position()->lat;
-					rep->current.lon = get_global_position()->lon;
-					rep->current.alt = get_global_position()->alt;
-				}
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_REPOSITION) {
 
-				rep->previous.valid = true;
-				rep->current.valid = true;
-				rep->next.valid = false;
+		position_setpoint_triplet_s *rep = get_reposition_triplet();
+		position_setpoint_triplet_s *curr = get_position_setpoint_triplet();
 
-				// CMD_DO_REPOSITION is acknowledged by commander
+		// store current position as previous position and goal as next
+		rep->previous.yaw = get_global_position()->yaw;
+		rep->previous.lat = get_global_position()->lat;
+		rep->previous.lon = get_global_position()->lon;
+		rep->previous.alt = get_global_position()->alt;
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_TAKEOFF) {
-				position_setpoint_triplet_s *rep = get_takeoff_triplet();
+		rep->current.loiter_radius = get_loiter_radius();
+		rep->current.loiter_direction = 1;
+		rep->current.type = position_setpoint_s::SETPOINT_TYPE_LOITER;
 
-				// store current position as previous position and goal as next
-				rep->previous.yaw = get_global_position()->yaw;
-				rep->previous.lat = get_global_position()->lat;
-				rep->previous.lon = get_global_position()->lon;
-				rep->previous.alt = get_global_position()->alt;
+		// If no argument for ground speed, use default value.
+		if (cmd.param1 <= 0 || !PX4_ISFINITE(cmd.param1)) {
+			rep->current.cruising_speed = get_cruising_speed();
 
-				rep->current.loiter_radius = get_loiter_radius();
-				rep->current.loiter_direction = 1;
-				rep->current.type = position_setpoint_s::SETPOINT_TYPE_TAKEOFF;
+		} else {
+			rep->current.cruising_speed = cmd.param1;
+		}
 
-				if (home_position_valid()) {
-					rep->current.yaw = cmd.param4;
-					rep->previous.valid = true;
+		rep->current.cruising_throttle = get_cruising_throttle();
+		rep->current.acceptance_radius = get_acceptance_radius();
 
-				} else {
-					rep->current.yaw = get_local_position()->yaw;
-					rep->previous.valid = false;
-				}
+		// Go on and check which changes had been requested
+		if (PX4_ISFINITE(cmd.param4)) {
+			rep->current.yaw = cmd.param4;
+			rep->current.yaw_valid = true;
 
-				if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
-					rep->current.lat = (cmd.param5 < 1000) ? cmd.param5 : cmd.param5 / (double)1e7;
-					rep->current.lon = (cmd.param6 < 1000) ? cmd.param6 : cmd.param6 / (double)1e7;
+		} else {
+			rep->current.yaw = NAN;
+			rep->current.yaw_valid = false;
+		}
 
-				} else {
-					// If one of them is non-finite, reset both
-					rep->current.lat = (double)NAN;
-					rep->current.lon = (double)NAN;
-				}
+		if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+
+			// Position change with optional altitude change
+			rep->current.lat = (cmd.param5 < 1000) ? cmd.param5 : cmd.param5 / (double)1e7;
+			rep->current.lon = (cmd.param6 < 1000) ? cmd.param6 : cmd.param6 / (double)1e7;
 
+			if (PX4_ISFINITE(cmd.param7)) {
 				rep->current.alt = cmd.param7;
 
-				rep->current.valid = true;
-				rep->next.valid = false;
+			} else {
+				rep->current.alt = get_global_position()->alt;
+			}
 
-				// CMD_NAV_TAKEOFF is acknowledged by commander
+		} else if (PX4_ISFINITE(cmd.param7) && curr->current.valid
+			   && PX4_ISFINITE(curr->current.lat)
+			   && PX4_ISFINITE(curr->current.lon)) {
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_LAND_START) {
+			// Altitude without position change
+			rep->current.lat = curr->current.lat;
+			rep->current.lon = curr->current.lon;
+			rep->current.alt = cmd.param7;
 
-				/* find NAV_CMD_DO_LAND_START in the mission and
-				 * use MAV_CMD_MISSION_START to start the mission there
-				 */
-				if (_mission.land_start()) {
-					vehicle_command_s vcmd = {};
-					vcmd.command = vehicle_command_s::VEHICLE_CMD_MISSION_START;
-					vcmd.param1 = _mission.get_land_start_index();
-					publish_vehicle_cmd(&vcmd);
+		} else {
+			// All three set to NaN - hold in current position
+			rep->current.lat = get_global_position()->lat;
+			rep->current.lon = get_global_position()->lon;
+			rep->current.alt = get_global_position()->alt;
+		}
 
-				} else {
-					PX4_WARN("planned mission landing not available");
-				}
+		rep->previous.valid = true;
+		rep->current.valid = true;
+		rep->next.valid = false;
 
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+		// CMD_DO_REPOSITION is acknowledged by commander
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_MISSION_START) {
-				if (_mission_result.valid && PX4_ISFINITE(cmd.param1) && (cmd.param1 >= 0)) {
-					if (!_mission.set_current_mission_index(cmd.param1)) {
-						PX4_WARN("CMD_MISSION_START failed");
-					}
-				}
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_TAKEOFF) {
+		position_setpoint_triplet_s *rep = get_takeoff_triplet();
 
-				// CMD_MISSION_START is acknowledged by commander
+		// store current position as previous position and goal as next
+		rep->previous.yaw = get_global_position()->yaw;
+		rep->previous.lat = get_global_position()->lat;
+		rep->previous.lon = get_global_position()->lon;
+		rep->previous.alt = get_global_position()->alt;
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_CHANGE_SPEED) {
-				if (cmd.param2 > FLT_EPSILON) {
-					// XXX not differentiating ground and airspeed yet
-					set_cruising_speed(cmd.param2);
+		rep->current.loiter_radius = get_loiter_radius();
+		rep->current.loiter_direction = 1;
+		rep->current.type = position_setpoint_s::SETPOINT_TYPE_TAKEOFF;
 
-				} else {
-					set_cruising_speed();
+		if (home_position_valid()) {
+			rep->current.yaw = cmd.param4;
+			rep->previous.valid = true;
 
-					/* if no speed target was given try to set throttle */
-					if (cmd.param3 > FLT_EPSILON) {
-						set_cruising_throttle(cmd.param3 / 100);
+		} else {
+			rep->current.yaw = get_local_position()->yaw;
+			rep->previous.valid = false;
+		}
 
-					} else {
-						set_cruising_throttle();
-					}
-				}
+		if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+			rep->current.lat = (cmd.param5 < 1000) ? cmd.param5 : cmd.param5 / (double)1e7;
+			rep->current.lon = (cmd.param6 < 1000) ? cmd.param6 : cmd.param6 / (double)1e7;
 
-				// TODO: handle responses for supported DO_CHANGE_SPEED options?
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
-
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_ROI
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE) {
-				_vroi = {};
-
-				switch (cmd.command) {
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI:
-				case vehicle_command_s::VEHICLE_CMD_NAV_ROI:
-					_vroi.mode = cmd.param1;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_LOCATION;
-					_vroi.lat = cmd.param5;
-					_vroi.lon = cmd.param6;
-					_vroi.alt = cmd.param7;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_WPNEXT;
-					_vroi.pitch_offset = (float)cmd.param5 * M_DEG_TO_RAD_F;
-					_vroi.roll_offset = (float)cmd.param6 * M_DEG_TO_RAD_F;
-					_vroi.yaw_offset = (float)cmd.param7 * M_DEG_TO_RAD_F;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
-					break;
-
-				default:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
-					break;
-				}
+		} else {
+			// If one of them is non-finite, reset both
+			rep->current.lat = (double)NAN;
+			rep->current.lon = (double)NAN;
+		}
 
-				_vroi.timestamp = hrt_absolute_time();
+		rep->current.alt = cmd.param7;
 
-				_vehicle_roi_pub.publish(_vroi);
+		rep->current.valid = true;
+		rep->next.valid = false;
 
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
-			}
+		// CMD_NAV_TAKEOFF is acknowledged by commander
+
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_LAND_START) {
+
+		/* find NAV_CMD_DO_LAND_START in the mission and
+		 * use MAV_CMD_MISSION_START to start the mission there
+		 */
+		if (_mission.land_start()) {
+			vehicle_command_s vcmd = {};
+			vcmd.command = vehicle_command_s::VEHICLE_CMD_MISSION_START;
+			vcmd.param1 = _mission.get_land_start_index();
+			publish_vehicle_cmd(&vcmd);
+
+		} else {
+			PX4_WARN("planned mission landing not available");
 		}
 
-		/* Check for traffic */
-		check_traffic();
+		publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-		/* Check geofence violation */
-		if (have_geofence_position_data &&
-		    (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
-		    (hrt_elapsed_time(&last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_MISSION_START) {
+		if (_mission_result.valid && PX4_ISFINITE(cmd.param1) && (cmd.param1 >= 0)) {
+			if (!_mission.set_current_mission_index(cmd.param1)) {
+				PX4_WARN("CMD_MISSION_START failed");
+			}
+		}
 
-			bool inside = _geofence.check(_global_pos, _gps_pos, _home_pos,
-						      home_position_valid());
-			last_geofence_check = hrt_absolute_time();
-			have_geofence_position_data = false;
+		// CMD_MISSION_START is acknowledged by commander
 
-			_geofence_result.timestamp = hrt_absolute_time();
-			_geofence_result.geofence_action = _geofence.getGeofenceAction();
-			_geofence_result.home_required = _geofence.isHomeRequired();
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_CHANGE_SPEED) {
+		if (cmd.param2 > FLT_EPSILON) {
+			// XXX not differentiating ground and airspeed yet
+			set_cruising_speed(cmd.param2);
 
-			if (!inside) {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = true;
+		} else {
+			set_cruising_speed();
 
-				/* Issue a warning about the geofence violation once */
-				if (!_geofence_violation_warning_sent) {
-					mavlink_log_critical(&_mavlink_log_pub, "Geofence violation");
-					_geofence_violation_warning_sent = true;
-				}
+			/* if no speed target was given try to set throttle */
+			if (cmd.param3 > FLT_EPSILON) {
+				set_cruising_throttle(cmd.param3 / 100);
 
 			} else {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = false;
-
-				/* Reset the _geofence_violation_warning_sent field */
-				_geofence_violation_warning_sent = false;
+				set_cruising_throttle();
 			}
-
-			_geofence_result_pub.publish(_geofence_result);
 		}
 
-		/* Do stuff according to navigation state set by commander */
-		NavigatorMode *navigation_mode_new{nullptr};
+		// TODO: handle responses for supported DO_CHANGE_SPEED options?
+		publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-		switch (_vstatus.nav_state) {
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
-			_pos_sp_triplet_published_invalid_once = false;
+	} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI
+		   || cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_ROI
+		   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION
+		   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET
+		   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE) {
+		_vroi = {};
 
-			_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_NORMAL);
-			navigation_mode_new = &_mission;
+		switch (cmd.command) {
+		case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI:
+		case vehicle_command_s::VEHICLE_CMD_NAV_ROI:
+			_vroi.mode = cmd.param1;
+			break;
 
+		case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION:
+			_vroi.mode = vehicle_command_s::VEHICLE_ROI_LOCATION;
+			_vroi.lat = cmd.param5;
+			_vroi.lon = cmd.param6;
+			_vroi.alt = cmd.param7;
 			break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_loiter;
+		case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET:
+			_vroi.mode = vehicle_command_s::VEHICLE_ROI_WPNEXT;
+			_vroi.pitch_offset = (float)cmd.param5 * M_DEG_TO_RAD_F;
+			_vroi.roll_offset = (float)cmd.param6 * M_DEG_TO_RAD_F;
+			_vroi.yaw_offset = (float)cmd.param7 * M_DEG_TO_RAD_F;
 			break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_rcLoss;
+		case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE:
+			_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
 			break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL: {
-				_pos_sp_triplet_published_invalid_once = false;
+		default:
+			_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
+			break;
+		}
 
-				const bool rtl_activated = _previous_nav_state != vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+		_vroi.timestamp = hrt_absolute_time();
 
-				switch (rtl_type()) {
-				case RTL::RTL_LAND:
-					if (rtl_activated) {
-						mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL LAND activated");
-					}
+		_vehicle_roi_pub.publish(_vroi);
 
-					// if RTL is set to use a mission landing and mission has a planned landing, then use MISSION to fly there directly
-					if (on_mission_landing() && !get_land_detected()->landed) {
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
-						navigation_mode_new = &_mission;
+		publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+	}
+}
 
-					} else {
-						navigation_mode_new = &_rtl;
-					}
+void
+Navigator::geofence_update()
+{
+	if (_have_geofence_position_data &&
+	    (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
+	    (hrt_elapsed_time(&_last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
+
+		bool inside = _geofence.check(_global_pos, _gps_pos, _home_pos,
+					      home_position_valid());
+		_last_geofence_check = hrt_absolute_time();
+		_have_geofence_position_data = false;
+
+		_geofence_result.timestamp = hrt_absolute_time();
+		_geofence_result.geofence_action = _geofence.getGeofenceAction();
+		_geofence_result.home_required = _geofence.isHomeRequired();
+
+		if (!inside) {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = true;
+
+			/* Issue a warning about the geofence violation once */
+			if (!_geofence_violation_warning_sent) {
+				mavlink_log_critical(&_mavlink_log_pub, "Geofence violation");
+				_geofence_violation_warning_sent = true;
+			}
 
-					break;
+		} else {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = false;
 
-				case RTL::RTL_MISSION:
-					if (_mission.get_land_start_available() && !get_land_detected()->landed) {
-						// the mission contains a landing spot
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
+			/* Reset the _geofence_violation_warning_sent field */
+			_geofence_violation_warning_sent = false;
+		}
 
-						if (_navigation_mode != &_mission) {
-							if (_navigation_mode == nullptr) {
-								// switching from an manual mode, go to landing if not already landing
-								if (!on_mission_landing()) {
-									start_mission_landing();
-								}
+		_geofence_result_pub.publish(_geofence_result);
+	}
+}
 
-							} else {
-								// switching from an auto mode, continue the mission from the closest item
-								_mission.set_closest_item_as_current();
-							}
-						}
+NavigatorMode *
+Navigator::select_navigation_mode()
+{
+	/* Do stuff according to navigation state set by commander */
+	NavigatorMode *navigation_mode_new{nullptr};
 
-						if (rtl_activated) {
-							mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, continue mission");
-						}
+	switch (_vstatus.nav_state) {
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
+		_pos_sp_triplet_published_invalid_once = false;
 
-						navigation_mode_new = &_mission;
+		_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_NORMAL);
+		navigation_mode_new = &_mission;
 
-					} else {
-						// fly the mission in reverse if switching from a non-manual mode
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_REVERSE);
-
-						if ((_navigation_mode != nullptr && (_navigation_mode != &_rtl || _mission.get_mission_changed())) &&
-						    (! _mission.get_mission_finished()) &&
-						    (!get_land_detected()->landed)) {
-							// determine the closest mission item if switching from a non-mission mode, and we are either not already
-							// mission mode or the mission waypoints changed.
-							// The seconds condition is required so that when no mission was uploaded and one is available the closest
-							// mission item is determined and also that if the user changes the active mission index while rtl is active
-							// always that waypoint is tracked first.
-							if ((_navigation_mode != &_mission) && (rtl_activated || _mission.get_mission_waypoints_changed())) {
-								_mission.set_closest_item_as_current();
-							}
+		break;
 
-							if (rtl_activated) {
-								mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly mission in reverse");
-							}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_loiter;
+		break;
 
-							navigation_mode_new = &_mission;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_RCRECOVER:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_rcLoss;
+		break;
 
-						} else {
-							if (rtl_activated) {
-								mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly to home");
-							}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL: {
+			_pos_sp_triplet_published_invalid_once = false;
 
-							navigation_mode_new = &_rtl;
-						}
-					}
+			const bool rtl_activated = _previous_nav_state != vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
 
-					break;
+			switch (rtl_type()) {
+			case RTL::RTL_LAND:
+				if (rtl_activated) {
+					mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL LAND activated");
+				}
 
-				default:
-					if (rtl_activated) {
-						mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL HOME activated");
-					}
+				// if RTL is set to use a mission landing and mission has a planned landing, then use MISSION to fly there directly
+				if (on_mission_landing() && !get_land_detected()->landed) {
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
+					navigation_mode_new = &_mission;
 
+				} else {
 					navigation_mode_new = &_rtl;
-					break;
 				}
 
 				break;
-			}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_takeoff;
-			break;
+			case RTL::RTL_MISSION:
+				if (_mission.get_land_start_available() && !get_land_detected()->landed) {
+					// the mission contains a landing spot
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LAND:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_land;
-			break;
+					if (_navigation_mode != &_mission) {
+						if (_navigation_mode == nullptr) {
+							// switching from an manual mode, go to landing if not already landing
+							if (!on_mission_landing()) {
+								start_mission_landing();
+							}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_precland;
-			_precland.set_mode(PrecLandMode::Required);
-			break;
+						} else {
+							// switching from an auto mode, continue the mission from the closest item
+							_mission.set_closest_item_as_current();
+						}
+					}
 
-		case vehicle_status_s::NAVIGATION_STATE_DESCEND:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_land;
-			break;
+					if (rtl_activated) {
+						mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, continue mission");
+					}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_dataLinkLoss;
-			break;
+					navigation_mode_new = &_mission;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_engineFailure;
-			break;
+				} else {
+					// fly the mission in reverse if switching from a non-manual mode
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_REVERSE);
+
+					if ((_navigation_mode != nullptr && (_navigation_mode != &_rtl || _mission.get_mission_changed())) &&
+					    (! _mission.get_mission_finished()) &&
+					    (!get_land_detected()->landed)) {
+						// determine the closest mission item if switching from a non-mission mode, and we are either not already
+						// mission mode or the mission waypoints changed.
+						// The seconds condition is required so that when no mission was uploaded and one is available the closest
+						// mission item is determined and also that if the user changes the active mission index while rtl is active
+						// always that waypoint is tracked first.
+						if ((_navigation_mode != &_mission) && (rtl_activated || _mission.get_mission_waypoints_changed())) {
+							_mission.set_closest_item_as_current();
+						}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_gpsFailure;
-			break;
+						if (rtl_activated) {
+							mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly mission in reverse");
+						}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_follow_target;
-			break;
+						navigation_mode_new = &_mission;
 
-		case vehicle_status_s::NAVIGATION_STATE_MANUAL:
-		case vehicle_status_s::NAVIGATION_STATE_ACRO:
-		case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
-		case vehicle_status_s::NAVIGATION_STATE_POSCTL:
-		case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
-		case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
-		case vehicle_status_s::NAVIGATION_STATE_STAB:
-		default:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = nullptr;
-			_can_loiter_at_sp = false;
-			break;
-		}
+					} else {
+						if (rtl_activated) {
+							mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly to home");
+						}
 
-		// update the vehicle status
-		_previous_nav_state = _vstatus.nav_state;
-
-		/* we have a new navigation mode: reset triplet */
-		if (_navigation_mode != navigation_mode_new) {
-			// We don't reset the triplet if we just did an auto-takeoff and are now
-			// going to loiter. Otherwise, we lose the takeoff altitude and end up lower
-			// than where we wanted to go.
-			//
-			// FIXME: a better solution would be to add reset where they are needed and remove
-			//        this general reset here.
-			if (!(_navigation_mode == &_takeoff &&
-			      navigation_mode_new == &_loiter)) {
-				reset_triplets();
+						navigation_mode_new = &_rtl;
+					}
+				}
+
+				break;
+
+			default:
+				if (rtl_activated) {
+					mavlink_and_console_log_info(get_mavlink_log_pub(), "RTL HOME activated");
+				}
+
+				navigation_mode_new = &_rtl;
+				break;
 			}
+
+			break;
 		}
 
-		_navigation_mode = navigation_mode_new;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_takeoff;
+		break;
 
-		/* iterate through navigation modes and set active/inactive for each */
-		for (unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
-			_navigation_mode_array[i]->run(_navigation_mode == _navigation_mode_array[i]);
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LAND:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_land;
+		break;
 
-		/* if we landed and have not received takeoff setpoint then stay in idle */
-		if (_land_detected.landed &&
-		    !((_vstatus.nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF)
-		      || (_vstatus.nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION))) {
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_precland;
+		_precland.set_mode(PrecLandMode::Required);
+		break;
 
-			_pos_sp_triplet.current.type = position_setpoint_s::SETPOINT_TYPE_IDLE;
-			_pos_sp_triplet.current.valid = true;
-			_pos_sp_triplet.previous.valid = false;
-			_pos_sp_triplet.next.valid = false;
+	case vehicle_status_s::NAVIGATION_STATE_DESCEND:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_land;
+		break;
 
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_RTGS:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_dataLinkLoss;
+		break;
 
-		/* if nothing is running, set position setpoint triplet invalid once */
-		if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
-			_pos_sp_triplet_published_invalid_once = true;
-			reset_triplets();
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_engineFailure;
+		break;
 
-		if (_pos_sp_triplet_updated) {
-			publish_position_setpoint_triplet();
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_gpsFailure;
+		break;
 
-		if (_mission_result_updated) {
-			publish_mission_result();
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_follow_target;
+		break;
 
-		perf_end(_loop_perf);
+	case vehicle_status_s::NAVIGATION_STATE_MANUAL:
+	case vehicle_status_s::NAVIGATION_STATE_ACRO:
+	case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
+	case vehicle_status_s::NAVIGATION_STATE_POSCTL:
+	case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
+	case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
+	case vehicle_status_s::NAVIGATION_STATE_STAB:
+	default:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = nullptr;
+		_can_loiter_at_sp = false;
+		break;
 	}
+
+	return navigation_mode_new;
 }
 
 int Navigator::task_spawn(int argc, char *argv[])
 {
-	_task_id = px4_task_spawn_cmd("navigator",
-				      SCHED_DEFAULT,
-				      SCHED_PRIORITY_NAVIGATION,
-				      1800,
-				      (px4_main_t)&run_trampoline,
-				      (char *const *)argv);
-
-	if (_task_id < 0) {
-		_task_id = -1;
-		return -errno;
-	}
+	Navigator *instance = new Navigator();
 
-	return 0;
-}
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
 
-Navigator *Navigator::instantiate(int argc, char *argv[])
-{
-	Navigator *instance = new Navigator();
+		if (instance->init()) {
+			return PX4_OK;
+		}
 
-	if (instance == nullptr) {
+	} else {
 		PX4_ERR("alloc failed");
 	}
 
-	return instance;
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
 }
 
 int
@@ -1183,6 +1230,10 @@ The member `_navigation_mode` contains the current active mode.
 Navigator publishes position setpoint triplets (`position_setpoint_triplet_s`), which are then used by the position
 controller.
 
+Navigator runs on a work queue and is updated on new local position (at most 20 Hz), vehicle status, land detector,
+home position, mission and vehicle command updates, and at least once per second. Only the active mode runs on
+position updates, the other modes are updated when the vehicle state changes.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("navigator", "controller");
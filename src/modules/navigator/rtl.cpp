@@ -56,6 +56,11 @@ RTL::on_inactive()
 {
 	// Reset RTL state.
 	_rtl_state = RTL_STATE_NONE;
+
+	// Keep the return altitude up to date, it only depends on home and the current position.
+	if (_navigator->home_position_valid()) {
+		_rtl_alt = calculate_return_alt_from_cone_half_angle((float)_param_rtl_cone_half_angle_deg.get());
+	}
 }
 
 int
@@ -67,7 +72,7 @@ RTL::rtl_type() const
 void
 RTL::on_activation()
 {
-
+	// refresh the return altitude for the current position, this does not access storage
 	_rtl_alt = calculate_return_alt_from_cone_half_angle((float)_param_rtl_cone_half_angle_deg.get());
 
 	if (_navigator->get_land_detected()->landed) {
@@ -585,7 +585,8 @@ Sensors::run()
 	parameter_update_poll(true);
 
 	/* get a set of initial values */
-	_voted_sensors_update.sensorsPoll(raw, airdata, magnetometer);
+	_voted_sensors_update.imuPoll(raw);
+	_voted_sensors_update.sensorsPoll(airdata, magnetometer);
 
 	diff_pres_poll(airdata);
 
@@ -636,7 +637,15 @@ Sensors::run()
 		const uint64_t airdata_prev_timestamp = airdata.timestamp;
 		const uint64_t magnetometer_prev_timestamp = magnetometer.timestamp;
 
-		_voted_sensors_update.sensorsPoll(raw, airdata, magnetometer);
+		_voted_sensors_update.imuPoll(raw);
+
+		/* publish the IMU data before doing the slower sensors, it's what the estimator waits for */
+		if (raw.timestamp > 0) {
+			_voted_sensors_update.setRelativeTimestamps(raw);
+			_sensor_pub.publish(raw);
+		}
+
+		_voted_sensors_update.sensorsPoll(airdata, magnetometer);
 
 		/* check battery voltage */
 		adc_poll();
@@ -645,10 +654,6 @@ Sensors::run()
 
 		if (raw.timestamp > 0) {
 
-			_voted_sensors_update.setRelativeTimestamps(raw);
-
-			_sensor_pub.publish(raw);
-
 			if (airdata.timestamp != airdata_prev_timestamp) {
 				_airdata_pub.publish(airdata);
 			}
@@ -760,7 +765,8 @@ The provided functionality includes:
 - Do preflight sensor consistency checks and publish the `sensor_preflight` topic.
 
 ### Implementation
-It runs in its own thread and polls on the currently selected gyro topic.
+It runs in its own thread and polls on the currently selected gyro topic. `sensor_combined` is published as
+soon as the IMU data is voted, before the magnetometer, baro, ADC and airspeed processing.
 
 )DESCR_STR");
 
@@ -385,6 +385,7 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 	for (int i = 0; i < sensor_count_max; ++i) {
 		if (device_id == (uint32_t)sensor_cal_data[i].ID) {
 			sensor_data.device_mapping[topic_instance] = i;
+			sensor_data.cache_valid[topic_instance] = false;
 			return i;
 		}
 	}
@@ -392,66 +393,76 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 	return -1;
 }
 
-int TemperatureCompensation::apply_corrections_gyro(int topic_instance, matrix::Vector3f &sensor_data,
+int TemperatureCompensation::apply_corrections_3D(int32_t tc_enable, PerSensorData &sensor_data,
+		const SensorCalData3D *sensor_cal_data, int topic_instance, matrix::Vector3f data[], uint8_t count,
 		float temperature, float *offsets, float *scales)
 {
-	if (_parameters.gyro_tc_enable != 1) {
+	if (tc_enable != 1) {
 		return 0;
 	}
 
-	uint8_t mapping = _gyro_data.device_mapping[topic_instance];
+	uint8_t mapping = sensor_data.device_mapping[topic_instance];
 
 	if (mapping == 255) {
 		return -1;
 	}
 
-	calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
+	const SensorCalData3D &cal_data = sensor_cal_data[mapping];
 
-	// get the sensor scale factors and correct the data
-	for (unsigned axis_index = 0; axis_index < 3; axis_index++) {
-		scales[axis_index] = _parameters.gyro_cal_data[mapping].scale[axis_index];
-		sensor_data(axis_index) = (sensor_data(axis_index) - offsets[axis_index]) * scales[axis_index];
-	}
+	// offsets only depend on the (clipped) temperature, re-evaluate the polynomial once it changed
+	const float clipped_temp = math::constrain(temperature, cal_data.min_temp, cal_data.max_temp);
+	float *cached_offsets = sensor_data.offsets[topic_instance];
+	float *cached_scales = sensor_data.scales[topic_instance];
 
-	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > 1.0f) {
-		_gyro_data.last_temperature[topic_instance] = temperature;
-		return 2;
-	}
+	if (!sensor_data.cache_valid[topic_instance]
+	    || fabsf(clipped_temp - sensor_data.cache_temperature[topic_instance]) > TEMPERATURE_CACHE_THRESHOLD) {
 
-	return 1;
-}
-
-int TemperatureCompensation::apply_corrections_accel(int topic_instance, matrix::Vector3f &sensor_data,
-		float temperature, float *offsets, float *scales)
-{
-	if (_parameters.accel_tc_enable != 1) {
-		return 0;
-	}
+		calc_thermal_offsets_3D(cal_data, clipped_temp, cached_offsets);
 
-	uint8_t mapping = _accel_data.device_mapping[topic_instance];
+		for (unsigned axis_index = 0; axis_index < 3; axis_index++) {
+			cached_scales[axis_index] = cal_data.scale[axis_index];
+		}
 
-	if (mapping == 255) {
-		return -1;
+		sensor_data.cache_temperature[topic_instance] = clipped_temp;
+		sensor_data.cache_valid[topic_instance] = true;
 	}
 
-	calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
-
-	// get the sensor scale factors and correct the data
 	for (unsigned axis_index = 0; axis_index < 3; axis_index++) {
-		scales[axis_index] = _parameters.accel_cal_data[mapping].scale[axis_index];
-		sensor_data(axis_index) = (sensor_data(axis_index) - offsets[axis_index]) * scales[axis_index];
+		offsets[axis_index] = cached_offsets[axis_index];
+		scales[axis_index] = cached_scales[axis_index];
 	}
 
-	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > 1.0f) {
-		_accel_data.last_temperature[topic_instance] = temperature;
+	// correct the data
+	for (uint8_t i = 0; i < count; i++) {
+		for (unsigned axis_index = 0; axis_index < 3; axis_index++) {
+			data[i](axis_index) = (data[i](axis_index) - offsets[axis_index]) * scales[axis_index];
+		}
+	}
+
+	if (fabsf(temperature - sensor_data.last_temperature[topic_instance]) > 1.0f) {
+		sensor_data.last_temperature[topic_instance] = temperature;
 		return 2;
 	}
 
 	return 1;
 }
 
-int TemperatureCompensation::apply_corrections_baro(int topic_instance, float &sensor_data, float temperature,
-		float *offsets, float *scales)
+int TemperatureCompensation::apply_corrections_gyro(int topic_instance, matrix::Vector3f sensor_data[], uint8_t count,
+		float temperature, float *offsets, float *scales)
+{
+	return apply_corrections_3D(_parameters.gyro_tc_enable, _gyro_data, _parameters.gyro_cal_data, topic_instance,
+				    sensor_data, count, temperature, offsets, scales);
+}
+
+int TemperatureCompensation::apply_corrections_accel(int topic_instance, matrix::Vector3f sensor_data[], uint8_t count,
+		float temperature, float *offsets, float *scales)
+{
+	return apply_corrections_3D(_parameters.accel_tc_enable, _accel_data, _parameters.accel_cal_data, topic_instance,
+				    sensor_data, count, temperature, offsets, scales);
+}
+
+int TemperatureCompensation::apply_corrections_baro(int topic_instance, float sensor_data[], uint8_t count,
+		float temperature, float *offsets, float *scales)
 {
 	if (_parameters.baro_tc_enable != 1) {
 		return 0;
@@ -463,11 +474,26 @@ int TemperatureCompensation::apply_corrections_baro(int topic_instance, float &s
 		return -1;
 	}
 
-	calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
+	SensorCalData1D &cal_data = _parameters.baro_cal_data[mapping];
+
+	const float clipped_temp = math::constrain(temperature, cal_data.min_temp, cal_data.max_temp);
+
+	if (!_baro_data.cache_valid[topic_instance]
+	    || fabsf(clipped_temp - _baro_data.cache_temperature[topic_instance]) > TEMPERATURE_CACHE_THRESHOLD) {
+
+		calc_thermal_offsets_1D(cal_data, clipped_temp, _baro_data.offsets[topic_instance][0]);
+		_baro_data.scales[topic_instance][0] = cal_data.scale;
+		_baro_data.cache_temperature[topic_instance] = clipped_temp;
+		_baro_data.cache_valid[topic_instance] = true;
+	}
+
+	*offsets = _baro_data.offsets[topic_instance][0];
+	*scales = _baro_data.scales[topic_instance][0];
 
-	// get the sensor scale factors and correct the data
-	*scales = _parameters.baro_cal_data[mapping].scale;
-	sensor_data = (sensor_data - *offsets) * *scales;
+	// correct the data
+	for (uint8_t i = 0; i < count; i++) {
+		sensor_data[i] = (sensor_data[i] - *offsets) * *scales;
+	}
 
 	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > 1.0f) {
 		_baro_data.last_temperature[topic_instance] = temperature;
@@ -80,6 +80,8 @@ public:
 
 	/**
 	 * Apply Thermal corrections to gyro (& other) sensor data.
+	 * The offsets & scales are cached per topic instance and only re-evaluated once the temperature
+	 * changed by more than TEMPERATURE_CACHE_THRESHOLD.
 	 * @param topic_instance uORB topic instance
 	 * @param sensor_data input sensor data, output sensor data with applied corrections
 	 * @param temperature measured current temperature
@@ -91,12 +93,36 @@ public:
 	 *         2: corrections applied and offsets & scales updated
 	 */
 	int apply_corrections_gyro(int topic_instance, matrix::Vector3f &sensor_data, float temperature, float *offsets,
-				   float *scales);
+				   float *scales)
+	{
+		return apply_corrections_gyro(topic_instance, &sensor_data, 1, temperature, offsets, scales);
+	}
 
 	int apply_corrections_accel(int topic_instance, matrix::Vector3f &sensor_data, float temperature, float *offsets,
-				    float *scales);
+				    float *scales)
+	{
+		return apply_corrections_accel(topic_instance, &sensor_data, 1, temperature, offsets, scales);
+	}
+
+	int apply_corrections_baro(int topic_instance, float &sensor_data, float temperature, float *offsets, float *scales)
+	{
+		return apply_corrections_baro(topic_instance, &sensor_data, 1, temperature, offsets, scales);
+	}
 
-	int apply_corrections_baro(int topic_instance, float &sensor_data, float temperature, float *offsets, float *scales);
+	/**
+	 * Apply Thermal corrections to a block of samples (e.g. read from a FIFO), all taken at the same temperature.
+	 * @param sensor_data input sensor data, output sensor data with applied corrections (length = count)
+	 * @param count number of samples
+	 * @see apply_corrections_gyro() for the other arguments and the return value
+	 */
+	int apply_corrections_gyro(int topic_instance, matrix::Vector3f sensor_data[], uint8_t count, float temperature,
+				   float *offsets, float *scales);
+
+	int apply_corrections_accel(int topic_instance, matrix::Vector3f sensor_data[], uint8_t count, float temperature,
+				    float *offsets, float *scales);
+
+	int apply_corrections_baro(int topic_instance, float sensor_data[], uint8_t count, float temperature, float *offsets,
+				   float *scales);
 
 	/** output current configuration status to console */
 	void print_status();
@@ -254,18 +280,31 @@ private:
 
 	Parameters _parameters;
 
+	/**
+	 * Temperature change (deg C) after which the cached offsets are re-evaluated. This is well below the
+	 * temperature resolution of the calibration, so the offset error it introduces stays in the sensor noise.
+	 */
+	static constexpr float TEMPERATURE_CACHE_THRESHOLD = 0.05f;
 
 	struct PerSensorData {
 		PerSensorData()
 		{
-			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) { device_mapping[i] = 255; last_temperature[i] = -100.0f; }
+			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) { device_mapping[i] = 255; }
+
+			reset_temperature();
 		}
 		void reset_temperature()
 		{
-			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) { last_temperature[i] = -100.0f; }
+			for (int i = 0; i < SENSOR_COUNT_MAX; ++i) { last_temperature[i] = -100.0f; cache_valid[i] = false; }
 		}
 		uint8_t device_mapping[SENSOR_COUNT_MAX]; /// map a topic instance to the parameters index
 		float last_temperature[SENSOR_COUNT_MAX];
+
+		/// offsets & scales per topic instance, evaluated at cache_temperature (only index 0 is used for baro)
+		bool cache_valid[SENSOR_COUNT_MAX];
+		float cache_temperature[SENSOR_COUNT_MAX];
+		float offsets[SENSOR_COUNT_MAX][3];
+		float scales[SENSOR_COUNT_MAX][3];
 	};
 	PerSensorData _gyro_data;
 	PerSensorData _accel_data;
@@ -275,6 +314,13 @@ private:
 	template<typename T>
 	static inline int set_sensor_id(uint32_t device_id, int topic_instance, PerSensorData &sensor_data,
 					const T *sensor_cal_data, uint8_t sensor_count_max);
+
+	/**
+	 * Block correction shared by gyro & accel.
+	 * @see apply_corrections_gyro()
+	 */
+	int apply_corrections_3D(int32_t tc_enable, PerSensorData &sensor_data, const SensorCalData3D *sensor_cal_data,
+				 int topic_instance, matrix::Vector3f data[], uint8_t count, float temperature, float *offsets, float *scales);
 };
 
 }
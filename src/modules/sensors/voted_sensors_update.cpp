@@ -526,89 +526,116 @@ void VotedSensorsUpdate::parametersUpdate()
 
 }
 
-void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
+bool VotedSensorsUpdate::selectionRequired(SensorData &sensor, bool updated)
 {
-	float *offsets[] = {_corrections.accel_offset_0, _corrections.accel_offset_1, _corrections.accel_offset_2 };
-	float *scales[] = {_corrections.accel_scale_0, _corrections.accel_scale_1, _corrections.accel_scale_2 };
+	const hrt_abstime now = hrt_absolute_time();
 
-	for (int uorb_index = 0; uorb_index < _accel.subscription_count; uorb_index++) {
-		bool accel_updated;
-		orb_check(_accel.subscription[uorb_index], &accel_updated);
+	if (updated || (now - sensor.last_selection) >= SELECTION_TIMEOUT_CHECK_INTERVAL) {
+		sensor.last_selection = now;
+		return true;
+	}
 
-		if (accel_updated) {
-			sensor_accel_s accel_report;
+	return false;
+}
 
-			int ret = orb_copy(ORB_ID(sensor_accel), _accel.subscription[uorb_index], &accel_report);
+bool VotedSensorsUpdate::accelUpdate(uint8_t uorb_index)
+{
+	bool accel_updated;
+	orb_check(_accel.subscription[uorb_index], &accel_updated);
 
-			if (ret != PX4_OK || accel_report.timestamp == 0) {
-				continue; //ignore invalid data
-			}
+	if (!accel_updated) {
+		return false;
+	}
 
-			if (!_accel.enabled[uorb_index]) {
-				continue;
-			}
+	sensor_accel_s accel_report;
 
-			// First publication with data
-			if (_accel.priority[uorb_index] == 0) {
-				int32_t priority = 0;
-				orb_priority(_accel.subscription[uorb_index], &priority);
-				_accel.priority[uorb_index] = (uint8_t)priority;
-			}
+	int ret = orb_copy(ORB_ID(sensor_accel), _accel.subscription[uorb_index], &accel_report);
 
-			_accel_device_id[uorb_index] = accel_report.device_id;
+	if (ret != PX4_OK || accel_report.timestamp == 0) {
+		return false; //ignore invalid data
+	}
 
-			Vector3f accel_data;
+	if (!_accel.enabled[uorb_index]) {
+		return false;
+	}
 
-			if (accel_report.integral_dt != 0) {
-				/*
-				 * Using data that has been integrated in the driver before downsampling is preferred
-				 * becasue it reduces aliasing errors. Correct the raw sensor data for scale factor errors
-				 * and offsets due to temperature variation. It is assumed that any filtering of input
-				 * data required is performed in the sensor driver, preferably before downsampling.
-				*/
+	// First publication with data
+	if (_accel.priority[uorb_index] == 0) {
+		int32_t priority = 0;
+		orb_priority(_accel.subscription[uorb_index], &priority);
+		_accel.priority[uorb_index] = (uint8_t)priority;
+	}
 
-				// convert the delta velocities to an equivalent acceleration before application of corrections
-				float dt_inv = 1.e6f / accel_report.integral_dt;
-				accel_data = Vector3f(accel_report.x_integral * dt_inv,
-						      accel_report.y_integral * dt_inv,
-						      accel_report.z_integral * dt_inv);
+	_accel_device_id[uorb_index] = accel_report.device_id;
 
-				_last_sensor_data[uorb_index].accelerometer_integral_dt = accel_report.integral_dt;
+	Vector3f accel_data;
 
-			} else {
-				// using the value instead of the integral (the integral is the prefered choice)
+	if (accel_report.integral_dt != 0) {
+		/*
+		 * Using data that has been integrated in the driver before downsampling is preferred
+		 * becasue it reduces aliasing errors. Correct the raw sensor data for scale factor errors
+		 * and offsets due to temperature variation. It is assumed that any filtering of input
+		 * data required is performed in the sensor driver, preferably before downsampling.
+		*/
 
-				// Correct each sensor for temperature effects
-				// Filtering and/or downsampling of temperature should be performed in the driver layer
-				accel_data = Vector3f(accel_report.x, accel_report.y, accel_report.z);
+		// convert the delta velocities to an equivalent acceleration before application of corrections
+		float dt_inv = 1.e6f / accel_report.integral_dt;
+		accel_data = Vector3f(accel_report.x_integral * dt_inv,
+				      accel_report.y_integral * dt_inv,
+				      accel_report.z_integral * dt_inv);
 
-				// handle the cse where this is our first output
-				if (_last_accel_timestamp[uorb_index] == 0) {
-					_last_accel_timestamp[uorb_index] = accel_report.timestamp - 1000;
-				}
+		_last_sensor_data[uorb_index].accelerometer_integral_dt = accel_report.integral_dt;
 
-				// approximate the  delta time using the difference in accel data time stamps
-				_last_sensor_data[uorb_index].accelerometer_integral_dt =
-					(accel_report.timestamp - _last_accel_timestamp[uorb_index]);
-			}
+	} else {
+		// using the value instead of the integral (the integral is the prefered choice)
 
-			// handle temperature compensation
-			if (_temperature_compensation.apply_corrections_accel(uorb_index, accel_data, accel_report.temperature,
-					offsets[uorb_index], scales[uorb_index]) == 2) {
-				_corrections_changed = true;
-			}
+		// Correct each sensor for temperature effects
+		// Filtering and/or downsampling of temperature should be performed in the driver layer
+		accel_data = Vector3f(accel_report.x, accel_report.y, accel_report.z);
 
-			// rotate corrected measurements from sensor to body frame
-			accel_data = _board_rotation * accel_data;
+		// handle the cse where this is our first output
+		if (_last_accel_timestamp[uorb_index] == 0) {
+			_last_accel_timestamp[uorb_index] = accel_report.timestamp - 1000;
+		}
 
-			_last_sensor_data[uorb_index].accelerometer_m_s2[0] = accel_data(0);
-			_last_sensor_data[uorb_index].accelerometer_m_s2[1] = accel_data(1);
-			_last_sensor_data[uorb_index].accelerometer_m_s2[2] = accel_data(2);
+		// approximate the  delta time using the difference in accel data time stamps
+		_last_sensor_data[uorb_index].accelerometer_integral_dt =
+			(accel_report.timestamp - _last_accel_timestamp[uorb_index]);
+	}
 
-			_last_accel_timestamp[uorb_index] = accel_report.timestamp;
-			_accel.voter.put(uorb_index, accel_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
-					 accel_report.error_count, _accel.priority[uorb_index]);
-		}
+	float *offsets[] = {_corrections.accel_offset_0, _corrections.accel_offset_1, _corrections.accel_offset_2 };
+	float *scales[] = {_corrections.accel_scale_0, _corrections.accel_scale_1, _corrections.accel_scale_2 };
+
+	// handle temperature compensation
+	if (_temperature_compensation.apply_corrections_accel(uorb_index, accel_data, accel_report.temperature,
+			offsets[uorb_index], scales[uorb_index]) == 2) {
+		_corrections_changed = true;
+	}
+
+	// rotate corrected measurements from sensor to body frame
+	accel_data = _board_rotation * accel_data;
+
+	_last_sensor_data[uorb_index].accelerometer_m_s2[0] = accel_data(0);
+	_last_sensor_data[uorb_index].accelerometer_m_s2[1] = accel_data(1);
+	_last_sensor_data[uorb_index].accelerometer_m_s2[2] = accel_data(2);
+
+	_last_accel_timestamp[uorb_index] = accel_report.timestamp;
+	_accel.voter.put(uorb_index, accel_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
+			 accel_report.error_count, _accel.priority[uorb_index]);
+
+	return true;
+}
+
+void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
+{
+	bool updated = false;
+
+	for (int uorb_index = 0; uorb_index < _accel.subscription_count; uorb_index++) {
+		updated |= accelUpdate(uorb_index);
+	}
+
+	if (!selectionRequired(_accel, updated)) {
+		return;
 	}
 
 	// find the best sensor
@@ -633,89 +660,104 @@ void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
 	}
 }
 
-void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
+bool VotedSensorsUpdate::gyroUpdate(uint8_t uorb_index)
 {
-	float *offsets[] = {_corrections.gyro_offset_0, _corrections.gyro_offset_1, _corrections.gyro_offset_2 };
-	float *scales[] = {_corrections.gyro_scale_0, _corrections.gyro_scale_1, _corrections.gyro_scale_2 };
+	bool gyro_updated;
+	orb_check(_gyro.subscription[uorb_index], &gyro_updated);
 
-	for (int uorb_index = 0; uorb_index < _gyro.subscription_count; uorb_index++) {
-		bool gyro_updated;
-		orb_check(_gyro.subscription[uorb_index], &gyro_updated);
+	if (!gyro_updated) {
+		return false;
+	}
 
-		if (gyro_updated) {
-			sensor_gyro_s gyro_report;
+	sensor_gyro_s gyro_report;
 
-			int ret = orb_copy(ORB_ID(sensor_gyro), _gyro.subscription[uorb_index], &gyro_report);
+	int ret = orb_copy(ORB_ID(sensor_gyro), _gyro.subscription[uorb_index], &gyro_report);
 
-			if (ret != PX4_OK || gyro_report.timestamp == 0) {
-				continue; //ignore invalid data
-			}
+	if (ret != PX4_OK || gyro_report.timestamp == 0) {
+		return false; //ignore invalid data
+	}
 
-			if (!_gyro.enabled[uorb_index]) {
-				continue;
-			}
+	if (!_gyro.enabled[uorb_index]) {
+		return false;
+	}
 
-			// First publication with data
-			if (_gyro.priority[uorb_index] == 0) {
-				int32_t priority = 0;
-				orb_priority(_gyro.subscription[uorb_index], &priority);
-				_gyro.priority[uorb_index] = (uint8_t)priority;
-			}
+	// First publication with data
+	if (_gyro.priority[uorb_index] == 0) {
+		int32_t priority = 0;
+		orb_priority(_gyro.subscription[uorb_index], &priority);
+		_gyro.priority[uorb_index] = (uint8_t)priority;
+	}
 
-			_gyro_device_id[uorb_index] = gyro_report.device_id;
+	_gyro_device_id[uorb_index] = gyro_report.device_id;
 
-			Vector3f gyro_rate;
+	Vector3f gyro_rate;
 
-			if (gyro_report.integral_dt != 0) {
-				/*
-				 * Using data that has been integrated in the driver before downsampling is preferred
-				 * becasue it reduces aliasing errors. Correct the raw sensor data for scale factor errors
-				 * and offsets due to temperature variation. It is assumed that any filtering of input
-				 * data required is performed in the sensor driver, preferably before downsampling.
-				*/
+	if (gyro_report.integral_dt != 0) {
+		/*
+		 * Using data that has been integrated in the driver before downsampling is preferred
+		 * becasue it reduces aliasing errors. Correct the raw sensor data for scale factor errors
+		 * and offsets due to temperature variation. It is assumed that any filtering of input
+		 * data required is performed in the sensor driver, preferably before downsampling.
+		*/
 
-				// convert the delta angles to an equivalent angular rate before application of corrections
-				float dt_inv = 1.e6f / gyro_report.integral_dt;
-				gyro_rate = Vector3f(gyro_report.x_integral * dt_inv,
-						     gyro_report.y_integral * dt_inv,
-						     gyro_report.z_integral * dt_inv);
+		// convert the delta angles to an equivalent angular rate before application of corrections
+		float dt_inv = 1.e6f / gyro_report.integral_dt;
+		gyro_rate = Vector3f(gyro_report.x_integral * dt_inv,
+				     gyro_report.y_integral * dt_inv,
+				     gyro_report.z_integral * dt_inv);
 
-				_last_sensor_data[uorb_index].gyro_integral_dt = gyro_report.integral_dt;
+		_last_sensor_data[uorb_index].gyro_integral_dt = gyro_report.integral_dt;
 
-			} else {
-				//using the value instead of the integral (the integral is the prefered choice)
+	} else {
+		//using the value instead of the integral (the integral is the prefered choice)
 
-				// Correct each sensor for temperature effects
-				// Filtering and/or downsampling of temperature should be performed in the driver layer
-				gyro_rate = Vector3f(gyro_report.x, gyro_report.y, gyro_report.z);
+		// Correct each sensor for temperature effects
+		// Filtering and/or downsampling of temperature should be performed in the driver layer
+		gyro_rate = Vector3f(gyro_report.x, gyro_report.y, gyro_report.z);
 
-				// handle the case where this is our first output
-				if (_last_sensor_data[uorb_index].timestamp == 0) {
-					_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp - 1000;
-				}
+		// handle the case where this is our first output
+		if (_last_sensor_data[uorb_index].timestamp == 0) {
+			_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp - 1000;
+		}
 
-				// approximate the delta time using the difference in gyro data time stamps
-				_last_sensor_data[uorb_index].gyro_integral_dt =
-					(gyro_report.timestamp - _last_sensor_data[uorb_index].timestamp);
-			}
+		// approximate the delta time using the difference in gyro data time stamps
+		_last_sensor_data[uorb_index].gyro_integral_dt =
+			(gyro_report.timestamp - _last_sensor_data[uorb_index].timestamp);
+	}
 
-			// handle temperature compensation
-			if (_temperature_compensation.apply_corrections_gyro(uorb_index, gyro_rate, gyro_report.temperature,
-					offsets[uorb_index], scales[uorb_index]) == 2) {
-				_corrections_changed = true;
-			}
+	float *offsets[] = {_corrections.gyro_offset_0, _corrections.gyro_offset_1, _corrections.gyro_offset_2 };
+	float *scales[] = {_corrections.gyro_scale_0, _corrections.gyro_scale_1, _corrections.gyro_scale_2 };
 
-			// rotate corrected measurements from sensor to body frame
-			gyro_rate = _board_rotation * gyro_rate;
+	// handle temperature compensation
+	if (_temperature_compensation.apply_corrections_gyro(uorb_index, gyro_rate, gyro_report.temperature,
+			offsets[uorb_index], scales[uorb_index]) == 2) {
+		_corrections_changed = true;
+	}
 
-			_last_sensor_data[uorb_index].gyro_rad[0] = gyro_rate(0);
-			_last_sensor_data[uorb_index].gyro_rad[1] = gyro_rate(1);
-			_last_sensor_data[uorb_index].gyro_rad[2] = gyro_rate(2);
+	// rotate corrected measurements from sensor to body frame
+	gyro_rate = _board_rotation * gyro_rate;
 
-			_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp;
-			_gyro.voter.put(uorb_index, gyro_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
-					gyro_report.error_count, _gyro.priority[uorb_index]);
-		}
+	_last_sensor_data[uorb_index].gyro_rad[0] = gyro_rate(0);
+	_last_sensor_data[uorb_index].gyro_rad[1] = gyro_rate(1);
+	_last_sensor_data[uorb_index].gyro_rad[2] = gyro_rate(2);
+
+	_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp;
+	_gyro.voter.put(uorb_index, gyro_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
+			gyro_report.error_count, _gyro.priority[uorb_index]);
+
+	return true;
+}
+
+void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
+{
+	bool updated = false;
+
+	for (int uorb_index = 0; uorb_index < _gyro.subscription_count; uorb_index++) {
+		updated |= gyroUpdate(uorb_index);
+	}
+
+	if (!selectionRequired(_gyro, updated)) {
+		return;
 	}
 
 	// find the best sensor
@@ -741,45 +783,60 @@ void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
 	}
 }
 
-void VotedSensorsUpdate::magPoll(vehicle_magnetometer_s &magnetometer)
+bool VotedSensorsUpdate::magUpdate(uint8_t uorb_index)
 {
-	for (int uorb_index = 0; uorb_index < _mag.subscription_count; uorb_index++) {
-		bool mag_updated;
-		orb_check(_mag.subscription[uorb_index], &mag_updated);
+	bool mag_updated;
+	orb_check(_mag.subscription[uorb_index], &mag_updated);
 
-		if (mag_updated) {
-			struct mag_report mag_report;
+	if (!mag_updated) {
+		return false;
+	}
 
-			int ret = orb_copy(ORB_ID(sensor_mag), _mag.subscription[uorb_index], &mag_report);
+	struct mag_report mag_report;
 
-			if (ret != PX4_OK || mag_report.timestamp == 0) {
-				continue; //ignore invalid data
-			}
+	int ret = orb_copy(ORB_ID(sensor_mag), _mag.subscription[uorb_index], &mag_report);
 
-			if (!_mag.enabled[uorb_index]) {
-				continue;
-			}
+	if (ret != PX4_OK || mag_report.timestamp == 0) {
+		return false; //ignore invalid data
+	}
 
-			// First publication with data
-			if (_mag.priority[uorb_index] == 0) {
-				int32_t priority = 0;
-				orb_priority(_mag.subscription[uorb_index], &priority);
-				_mag.priority[uorb_index] = (uint8_t)priority;
+	if (!_mag.enabled[uorb_index]) {
+		return false;
+	}
 
-				/* force a scale and offset update the first time we get data */
-				parametersUpdate();
-			}
+	// First publication with data
+	if (_mag.priority[uorb_index] == 0) {
+		int32_t priority = 0;
+		orb_priority(_mag.subscription[uorb_index], &priority);
+		_mag.priority[uorb_index] = (uint8_t)priority;
 
-			Vector3f vect(mag_report.x, mag_report.y, mag_report.z);
-			vect = _mag_rotation[uorb_index] * vect;
+		/* force a scale and offset update the first time we get data */
+		parametersUpdate();
+	}
 
-			_last_magnetometer[uorb_index].timestamp = mag_report.timestamp;
-			_last_magnetometer[uorb_index].magnetometer_ga[0] = vect(0);
-			_last_magnetometer[uorb_index].magnetometer_ga[1] = vect(1);
-			_last_magnetometer[uorb_index].magnetometer_ga[2] = vect(2);
+	Vector3f vect(mag_report.x, mag_report.y, mag_report.z);
+	vect = _mag_rotation[uorb_index] * vect;
 
-			_mag.voter.put(uorb_index, mag_report.timestamp, vect.data(), mag_report.error_count, _mag.priority[uorb_index]);
-		}
+	_last_magnetometer[uorb_index].timestamp = mag_report.timestamp;
+	_last_magnetometer[uorb_index].magnetometer_ga[0] = vect(0);
+	_last_magnetometer[uorb_index].magnetometer_ga[1] = vect(1);
+	_last_magnetometer[uorb_index].magnetometer_ga[2] = vect(2);
+
+	_mag.voter.put(uorb_index, mag_report.timestamp, vect.data(), mag_report.error_count, _mag.priority[uorb_index]);
+
+	return true;
+}
+
+void VotedSensorsUpdate::magPoll(vehicle_magnetometer_s &magnetometer)
+{
+	bool updated = false;
+
+	for (int uorb_index = 0; uorb_index < _mag.subscription_count; uorb_index++) {
+		updated |= magUpdate(uorb_index);
+	}
+
+	if (!selectionRequired(_mag, updated)) {
+		return;
 	}
 
 	int best_index;
@@ -796,55 +853,66 @@ void VotedSensorsUpdate::magPoll(vehicle_magnetometer_s &magnetometer)
 	}
 }
 
-void VotedSensorsUpdate::baroPoll(vehicle_air_data_s &airdata)
+bool VotedSensorsUpdate::baroUpdate(uint8_t uorb_index)
 {
-	bool got_update = false;
-	float *offsets[] = {&_corrections.baro_offset_0, &_corrections.baro_offset_1, &_corrections.baro_offset_2 };
-	float *scales[] = {&_corrections.baro_scale_0, &_corrections.baro_scale_1, &_corrections.baro_scale_2 };
+	bool baro_updated;
+	orb_check(_baro.subscription[uorb_index], &baro_updated);
 
-	for (int uorb_index = 0; uorb_index < _baro.subscription_count; uorb_index++) {
-		bool baro_updated;
-		orb_check(_baro.subscription[uorb_index], &baro_updated);
+	if (!baro_updated) {
+		return false;
+	}
 
-		if (baro_updated) {
-			sensor_baro_s baro_report;
+	sensor_baro_s baro_report;
 
-			int ret = orb_copy(ORB_ID(sensor_baro), _baro.subscription[uorb_index], &baro_report);
+	int ret = orb_copy(ORB_ID(sensor_baro), _baro.subscription[uorb_index], &baro_report);
 
-			if (ret != PX4_OK || baro_report.timestamp == 0) {
-				continue; //ignore invalid data
-			}
+	if (ret != PX4_OK || baro_report.timestamp == 0) {
+		return false; //ignore invalid data
+	}
 
-			// Convert from millibar to Pa
-			float corrected_pressure = 100.0f * baro_report.pressure;
+	// Convert from millibar to Pa
+	float corrected_pressure = 100.0f * baro_report.pressure;
 
-			// handle temperature compensation
-			if (_temperature_compensation.apply_corrections_baro(uorb_index, corrected_pressure, baro_report.temperature,
-					offsets[uorb_index], scales[uorb_index]) == 2) {
-				_corrections_changed = true;
-			}
+	float *offsets[] = {&_corrections.baro_offset_0, &_corrections.baro_offset_1, &_corrections.baro_offset_2 };
+	float *scales[] = {&_corrections.baro_scale_0, &_corrections.baro_scale_1, &_corrections.baro_scale_2 };
 
-			// First publication with data
-			if (_baro.priority[uorb_index] == 0) {
-				int32_t priority = 0;
-				orb_priority(_baro.subscription[uorb_index], &priority);
-				_baro.priority[uorb_index] = (uint8_t)priority;
-			}
+	// handle temperature compensation
+	if (_temperature_compensation.apply_corrections_baro(uorb_index, corrected_pressure, baro_report.temperature,
+			offsets[uorb_index], scales[uorb_index]) == 2) {
+		_corrections_changed = true;
+	}
+
+	// First publication with data
+	if (_baro.priority[uorb_index] == 0) {
+		int32_t priority = 0;
+		orb_priority(_baro.subscription[uorb_index], &priority);
+		_baro.priority[uorb_index] = (uint8_t)priority;
+	}
 
-			_baro_device_id[uorb_index] = baro_report.device_id;
+	_baro_device_id[uorb_index] = baro_report.device_id;
 
-			got_update = true;
-			Vector3f vect(baro_report.pressure, baro_report.temperature, 0.f);
+	Vector3f vect(baro_report.pressure, baro_report.temperature, 0.f);
 
-			_last_airdata[uorb_index].timestamp = baro_report.timestamp;
-			_last_airdata[uorb_index].baro_temp_celcius = baro_report.temperature;
-			_last_airdata[uorb_index].baro_pressure_pa = corrected_pressure;
+	_last_airdata[uorb_index].timestamp = baro_report.timestamp;
+	_last_airdata[uorb_index].baro_temp_celcius = baro_report.temperature;
+	_last_airdata[uorb_index].baro_pressure_pa = corrected_pressure;
 
-			_baro.voter.put(uorb_index, baro_report.timestamp, vect.data(), baro_report.error_count, _baro.priority[uorb_index]);
-		}
+	_baro.voter.put(uorb_index, baro_report.timestamp, vect.data(), baro_report.error_count, _baro.priority[uorb_index]);
+
+	return true;
+}
+
+void VotedSensorsUpdate::baroPoll(vehicle_air_data_s &airdata)
+{
+	bool got_update = false;
+
+	for (int uorb_index = 0; uorb_index < _baro.subscription_count; uorb_index++) {
+		got_update |= baroUpdate(uorb_index);
 	}
 
 	if (got_update) {
+		_baro.last_selection = hrt_absolute_time();
+
 		int best_index;
 		_baro.voter.get_best(hrt_absolute_time(), &best_index);
 
@@ -1054,11 +1122,15 @@ VotedSensorsUpdate::applyMagCalibration(DevHandle &h, const struct mag_calibrati
 #endif
 }
 
-void VotedSensorsUpdate::sensorsPoll(sensor_combined_s &raw, vehicle_air_data_s &airdata,
-				     vehicle_magnetometer_s &magnetometer)
+void VotedSensorsUpdate::imuPoll(sensor_combined_s &raw)
 {
-	accelPoll(raw);
+	// the gyro first, it paces the sensors loop
 	gyroPoll(raw);
+	accelPoll(raw);
+}
+
+void VotedSensorsUpdate::sensorsPoll(vehicle_air_data_s &airdata, vehicle_magnetometer_s &magnetometer)
+{
 	magPoll(magnetometer);
 	baroPoll(airdata);
 
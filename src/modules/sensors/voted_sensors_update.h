@@ -109,12 +109,19 @@ public:
 	void parametersUpdate();
 
 	/**
-	 * read new sensor data
+	 * read new gyro and accel data, only the instances that published are processed.
+	 * The gyro and accel fields of raw are updated in place from the selected sensors,
+	 * so raw can be published right after this call.
 	 */
-	void sensorsPoll(sensor_combined_s &raw, vehicle_air_data_s &airdata, vehicle_magnetometer_s &magnetometer);
+	void imuPoll(sensor_combined_s &raw);
 
 	/**
-	 * set the relative timestamps of each sensor timestamp, based on the last sensorsPoll,
+	 * read new mag and baro data and publish the sensor corrections and selection if they changed
+	 */
+	void sensorsPoll(vehicle_air_data_s &airdata, vehicle_magnetometer_s &magnetometer);
+
+	/**
+	 * set the relative timestamps of each sensor timestamp, based on the last imuPoll,
 	 * so that the data can be published.
 	 */
 	void setRelativeTimestamps(sensor_combined_s &raw);
@@ -152,7 +159,8 @@ private:
 			: last_best_vote(0),
 			  subscription_count(0),
 			  voter(1),
-			  last_failover_count(0)
+			  last_failover_count(0),
+			  last_selection(0)
 		{
 			for (unsigned i = 0; i < SENSOR_COUNT_MAX; i++) {
 				enabled[i] = true;
@@ -169,10 +177,53 @@ private:
 		int subscription_count;
 		DataValidatorGroup voter;
 		unsigned int last_failover_count;
+		hrt_abstime last_selection; /**< last time the best sensor was selected */
 	};
 
+	/**
+	 * the best sensor is selected whenever an instance of the class published, without updates
+	 * only at this interval to still detect timeouts of all instances [us]
+	 */
+	static constexpr hrt_abstime SELECTION_TIMEOUT_CHECK_INTERVAL = 50000;
+
 	void initSensorClass(const orb_metadata *meta, SensorData &sensor_data, uint8_t sensor_count_max);
 
+	/**
+	 * Check if a sensor class needs a new selection of the best sensor.
+	 *
+	 * @param updated	true if at least one instance published new data
+	 * @return		true if DataValidatorGroup::get_best() should run
+	 */
+	bool selectionRequired(SensorData &sensor, bool updated);
+
+	/**
+	 * Process new data of a single accelerometer instance, if it published.
+	 *
+	 * @return true if new valid data was passed to the voter
+	 */
+	bool accelUpdate(uint8_t uorb_index);
+
+	/**
+	 * Process new data of a single gyro instance, if it published.
+	 *
+	 * @return true if new valid data was passed to the voter
+	 */
+	bool gyroUpdate(uint8_t uorb_index);
+
+	/**
+	 * Process new data of a single magnetometer instance, if it published.
+	 *
+	 * @return true if new valid data was passed to the voter
+	 */
+	bool magUpdate(uint8_t uorb_index);
+
+	/**
+	 * Process new data of a single barometer instance, if it published.
+	 *
+	 * @return true if new valid data was passed to the voter
+	 */
+	bool baroUpdate(uint8_t uorb_index);
+
 	/**
 	 * Poll the accelerometer for updated data.
 	 *
@@ -66,6 +66,21 @@ public:
 
 	~PublicationMulti() { orb_unadvertise(_handle); }
 
+	/**
+	 * Advertise the topic with an empty message, so that the multi-instance
+	 * is known before the first publication.
+	 * @return The multi-instance index, or -1 on failure.
+	 */
+	int advertise()
+	{
+		if (_handle == nullptr) {
+			const T data{};
+			_handle = orb_advertise_multi(_meta, &data, &_instance, _priority);
+		}
+
+		return (_handle != nullptr) ? _instance : -1;
+	}
+
 	/**
 	 * Publish the struct
 	 * @param data The uORB message struct we are updating.
@@ -76,8 +91,7 @@ public:
 			return (orb_publish(_meta, _handle, &data) == PX4_OK);
 
 		} else {
-			int instance = 0;
-			orb_advert_t handle = orb_advertise_multi(_meta, &data, &instance, _priority);
+			orb_advert_t handle = orb_advertise_multi(_meta, &data, &_instance, _priority);
 
 			if (handle != nullptr) {
 				_handle = handle;
@@ -93,6 +107,8 @@ protected:
 
 	orb_advert_t _handle{nullptr};
 
+	int _instance{0};
+
 	const uint8_t _priority;
 };
 
@@ -47,7 +47,8 @@ class ModuleParams : public ListNode<ModuleParams *>
 {
 public:
 
-	ModuleParams(ModuleParams *parent)
+	ModuleParams(ModuleParams *parent) :
+		_param_update_epoch(param_get_epoch())
 	{
 		setParent(parent);
 	}
@@ -78,19 +79,33 @@ protected:
 	 */
 	virtual void updateParams()
 	{
+		// take the epoch first: a change during the update is then picked up by the next one
+		const uint32_t epoch = param_get_epoch();
+
 		for (const auto &child : _children) {
 			child->updateParams();
 		}
 
 		updateParamsImpl();
+
+		_param_update_epoch = epoch;
 	}
 
 	/**
-	 * @brief The implementation for this is generated with the macro DEFINE_PARAMETERS()
+	 * @brief The implementation for this is generated with the macro DEFINE_PARAMETERS().
+	 *        It only re-reads the parameters for which paramChanged() is true, and the ones changed locally with set().
 	 */
 	virtual void updateParamsImpl() {}
 
+	/**
+	 * @return true if the parameter changed since the last updateParams() (or construction) of this object
+	 */
+	bool paramChanged(param_t handle) const { return param_changed_since(handle, _param_update_epoch); }
+
 private:
+	/** parameter change epoch at the last update */
+	uint32_t _param_update_epoch;
+
 	/** @list _children The module parameter list of inheriting classes. */
 	List<ModuleParams *> _children;
 };
@@ -57,10 +57,13 @@ inline static param_t param_handle(px4::params p)
 #define _DEFINE_SINGLE_PARAMETER(x) \
 	do_not_explicitly_use_this_namespace::PAIR(x);
 
+// a parameter modified with set() is re-read as well, so that a value which was not committed is restored
 #define _CALL_UPDATE(x) \
-	STRIP(x).update();
+	if (STRIP(x).set_locally() || paramChanged(STRIP(x).handle())) { \
+		STRIP(x).update(); \
+	}
 
-// define the parameter update method, which will update all parameters.
+// define the parameter update method, which will update all changed parameters.
 // It is marked as 'final', so that wrong usages lead to a compile error (see below)
 #define _DEFINE_PARAMETER_UPDATE_METHOD(...) \
 	protected: \
@@ -130,13 +133,26 @@ public:
 	/// Store the parameter value to the parameter storage, w/o notifying the system (@see param_set_no_notification())
 	bool commit_no_notification() const { return param_set_no_notification(handle(), &_val) == 0; }
 
-	void set(float val) { _val = val; }
+	/// Change the local value only, it is restored from the parameter storage with the next update (unless committed)
+	void set(float val)
+	{
+		_val = val;
+		_set_locally = true;
+	}
+
+	/// @return true if the local value was changed with set() since the last update()
+	bool set_locally() const { return _set_locally; }
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	bool update()
+	{
+		_set_locally = false;
+		return param_get(handle(), &_val) == 0;
+	}
 
 	param_t handle() const { return param_handle(p); }
 private:
 	float _val;
+	bool _set_locally{false};
 };
 
 // external version
@@ -164,13 +180,26 @@ public:
 	/// Store the parameter value to the parameter storage, w/o notifying the system (@see param_set_no_notification())
 	bool commit_no_notification() const { return param_set_no_notification(handle(), &_val) == 0; }
 
-	void set(float val) { _val = val; }
+	/// Change the local value only, it is restored from the parameter storage with the next update (unless committed)
+	void set(float val)
+	{
+		_val = val;
+		_set_locally = true;
+	}
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	/// @return true if the local value was changed with set() since the last update()
+	bool set_locally() const { return _set_locally; }
+
+	bool update()
+	{
+		_set_locally = false;
+		return param_get(handle(), &_val) == 0;
+	}
 
 	param_t handle() const { return param_handle(p); }
 private:
 	float &_val;
+	bool _set_locally{false};
 };
 
 template<px4::params p>
@@ -196,13 +225,26 @@ public:
 	/// Store the parameter value to the parameter storage, w/o notifying the system (@see param_set_no_notification())
 	bool commit_no_notification() const { return param_set_no_notification(handle(), &_val) == 0; }
 
-	void set(int32_t val) { _val = val; }
+	/// Change the local value only, it is restored from the parameter storage with the next update (unless committed)
+	void set(int32_t val)
+	{
+		_val = val;
+		_set_locally = true;
+	}
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	/// @return true if the local value was changed with set() since the last update()
+	bool set_locally() const { return _set_locally; }
+
+	bool update()
+	{
+		_set_locally = false;
+		return param_get(handle(), &_val) == 0;
+	}
 
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t _val;
+	bool _set_locally{false};
 };
 
 //external version
@@ -230,13 +272,26 @@ public:
 	/// Store the parameter value to the parameter storage, w/o notifying the system (@see param_set_no_notification())
 	bool commit_no_notification() const { return param_set_no_notification(handle(), &_val) == 0; }
 
-	void set(int32_t val) { _val = val; }
+	/// Change the local value only, it is restored from the parameter storage with the next update (unless committed)
+	void set(int32_t val)
+	{
+		_val = val;
+		_set_locally = true;
+	}
+
+	/// @return true if the local value was changed with set() since the last update()
+	bool set_locally() const { return _set_locally; }
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	bool update()
+	{
+		_set_locally = false;
+		return param_get(handle(), &_val) == 0;
+	}
 
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t &_val;
+	bool _set_locally{false};
 };
 
 template<px4::params p>
@@ -270,10 +325,20 @@ public:
 		return param_set_no_notification(handle(), &value_int) == 0;
 	}
 
-	void set(bool val) { _val = val; }
+	/// Change the local value only, it is restored from the parameter storage with the next update (unless committed)
+	void set(bool val)
+	{
+		_val = val;
+		_set_locally = true;
+	}
+
+	/// @return true if the local value was changed with set() since the last update()
+	bool set_locally() const { return _set_locally; }
 
 	bool update()
 	{
+		_set_locally = false;
+
 		int32_t value_int;
 		int ret = param_get(handle(), &value_int);
 
@@ -288,6 +353,7 @@ public:
 	param_t handle() const { return param_handle(p); }
 private:
 	bool _val;
+	bool _set_locally{false};
 };
 
 template <px4::params p>
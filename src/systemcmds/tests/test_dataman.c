@@ -59,9 +59,12 @@
 
 static px4_sem_t *sems;
 static bool *task_returned_error;
+static ssize_t range_async_result;
 int test_dataman(int argc, char *argv[]);
 
 #define NUM_MISSIONS_TEST 50
+#define NUM_LATENCY_TEST 1000
+#define NUM_RANGE_TEST 20
 
 #define DM_MAX_DATA_SIZE sizeof(struct mission_s)
 
@@ -143,8 +146,8 @@ task_main(int argc, char *argv[])
 	}
 
 	hrt_abstime rend = hrt_absolute_time();
-	PX4_INFO("task %d pass, hit %d, miss %d, io time read %" PRIu64 "ms. write %" PRIu64 "ms.",
-		 my_id, hit, miss, (rend - rstart) / NUM_MISSIONS_TEST / 1000, (wend - wstart) / NUM_MISSIONS_TEST / 1000);
+	PX4_INFO("task %d pass, hit %d, miss %d, io time read %" PRIu64 "us. write %" PRIu64 "us.",
+		 my_id, hit, miss, (rend - rstart) / NUM_MISSIONS_TEST, (wend - wstart) / NUM_MISSIONS_TEST);
 	px4_sem_post(sems + my_id);
 	return 0;
 
@@ -156,6 +159,71 @@ fail:
 	return -1;
 }
 
+static void
+range_async_callback(ssize_t result, void *arg)
+{
+	range_async_result = result;
+	px4_sem_post((px4_sem_t *)arg);
+}
+
+static int
+test_range(void)
+{
+	struct mission_item_s *items = (struct mission_item_s *)malloc(2 * NUM_RANGE_TEST * sizeof(struct mission_item_s));
+	struct mission_item_s *readback = items + NUM_RANGE_TEST;
+	int ret = -1;
+
+	if (items == NULL) {
+		PX4_ERR("Range test allocation failed");
+		return -1;
+	}
+
+	for (unsigned i = 0; i < NUM_RANGE_TEST; i++) {
+		memset(&items[i], i + 1, sizeof(struct mission_item_s));
+	}
+
+	if (dm_write_range(DM_KEY_WAYPOINTS_OFFBOARD_1, 0, NUM_RANGE_TEST, DM_PERSIST_IN_FLIGHT_RESET, items,
+			   sizeof(struct mission_item_s)) != NUM_RANGE_TEST) {
+		PX4_ERR("Range write failed");
+		goto out;
+	}
+
+	memset(readback, 0, NUM_RANGE_TEST * sizeof(struct mission_item_s));
+
+	if (dm_read_range(DM_KEY_WAYPOINTS_OFFBOARD_1, 0, NUM_RANGE_TEST, readback,
+			  sizeof(struct mission_item_s)) != NUM_RANGE_TEST
+	    || memcmp(items, readback, NUM_RANGE_TEST * sizeof(struct mission_item_s)) != 0) {
+		PX4_ERR("Range read failed");
+		goto out;
+	}
+
+	px4_sem_t done;
+	px4_sem_init(&done, 1, 0);
+	/* done use case is a signal */
+	px4_sem_setprotocol(&done, SEM_PRIO_NONE);
+	memset(readback, 0, NUM_RANGE_TEST * sizeof(struct mission_item_s));
+	range_async_result = -1;
+
+	if (dm_read_range_async(DM_KEY_WAYPOINTS_OFFBOARD_1, 0, NUM_RANGE_TEST, readback, sizeof(struct mission_item_s),
+				range_async_callback, &done) == 0) {
+		px4_sem_wait(&done);
+	}
+
+	px4_sem_destroy(&done);
+
+	if (range_async_result != NUM_RANGE_TEST
+	    || memcmp(items, readback, NUM_RANGE_TEST * sizeof(struct mission_item_s)) != 0) {
+		PX4_ERR("Asynchronous range read failed");
+		goto out;
+	}
+
+	ret = 0;
+
+out:
+	free(items);
+	return ret;
+}
+
 int test_dataman(int argc, char *argv[])
 {
 	int i = 0;
@@ -210,6 +278,32 @@ int test_dataman(int argc, char *argv[])
 		return -1;
 	}
 
+	/* round trip latency of reading a stored item */
+	hrt_abstime latency_max = 0;
+	hrt_abstime latency_start = hrt_absolute_time();
+
+	for (i = 0; i < NUM_LATENCY_TEST; i++) {
+		hrt_abstime t = hrt_absolute_time();
+
+		if (dm_read(DM_KEY_WAYPOINTS_OFFBOARD_1, i % NUM_MISSIONS_TEST, buffer, sizeof(buffer)) < 0) {
+			PX4_ERR("Latency read failed");
+			return -1;
+		}
+
+		t = hrt_absolute_time() - t;
+
+		if (t > latency_max) {
+			latency_max = t;
+		}
+	}
+
+	PX4_INFO("dm_read latency avg %" PRIu64 "us, max %" PRIu64 "us",
+		 (hrt_absolute_time() - latency_start) / NUM_LATENCY_TEST, latency_max);
+
+	if (test_range() != 0) {
+		return -1;
+	}
+
 	dm_restart(DM_INIT_REASON_IN_FLIGHT);
 
 	for (i = 0; i < NUM_MISSIONS_TEST; i++) {
@@ -0,0 +1,223 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_geofence.cpp
+ * Tests and benchmark for the geofence geometry.
+ */
+
+#include <unit_test.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <drivers/drv_hrt.h>
+#include <lib/geofence/GeofenceGeometry.hpp>
+#include <perf/perf_counter.h>
+
+class GeofenceTest : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool simpleAreas();
+	bool manyVertices();
+	bool benchmark();
+
+	/** star shaped (concave) polygon around the origin */
+	static void makeStar(float *x, float *y, int vertex_count, float radius);
+
+	/** PNPOLY reference implementation, without any precomputation */
+	static bool referenceInside(const float *x, const float *y, int vertex_count, float px, float py);
+
+	static float random(float min, float max) { return min + (max - min) * (float)rand() / (float)RAND_MAX; }
+};
+
+bool GeofenceTest::run_tests()
+{
+	ut_run_test(simpleAreas);
+	ut_run_test(manyVertices);
+	ut_run_test(benchmark);
+
+	return (_tests_failed == 0);
+}
+
+void GeofenceTest::makeStar(float *x, float *y, int vertex_count, float radius)
+{
+	for (int i = 0; i < vertex_count; ++i) {
+		const float angle = 2.f * M_PI_F * i / vertex_count;
+		const float r = (i % 2 == 0) ? radius : radius * 0.6f;
+		x[i] = r * cosf(angle);
+		y[i] = r * sinf(angle);
+	}
+}
+
+bool GeofenceTest::referenceInside(const float *x, const float *y, int vertex_count, float px, float py)
+{
+	bool c = false;
+
+	for (int i = 0, j = vertex_count - 1; i < vertex_count; j = i++) {
+		if ((y[i] >= py) != (y[j] >= py) && px <= (x[j] - x[i]) * (py - y[i]) / (y[j] - y[i]) + x[i]) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
+
+bool GeofenceTest::simpleAreas()
+{
+	GeofenceGeometry geometry;
+
+	// empty fence accepts everything
+	ut_assert_true(geometry.inside(0.f, 0.f));
+
+	const float square_x[] = {-100.f, 100.f, 100.f, -100.f};
+	const float square_y[] = {-100.f, -100.f, 100.f, 100.f};
+
+	ut_assert_true(geometry.reset(3, 4));
+	ut_assert_true(geometry.addPolygon(square_x, square_y, 4, true));
+	ut_assert_true(geometry.addCircle(50.f, 50.f, 10.f, false));
+	ut_assert_true(geometry.addCircle(500.f, 0.f, 20.f, true));
+	ut_assert_false(geometry.addCircle(0.f, 0.f, 1.f, true)); // no space left
+
+	ut_assert_true(geometry.inside(0.f, 0.f));
+	ut_assert_false(geometry.inside(150.f, 0.f));
+	ut_assert_false(geometry.inside(52.f, 48.f)); // exclusion circle
+	ut_assert_true(geometry.inside(510.f, 5.f)); // second inclusion area
+	ut_assert_false(geometry.inside(530.f, 0.f));
+
+	ut_assert_true(geometry.insideArea(0, 99.f, -99.f));
+	ut_assert_false(geometry.insideArea(1, 0.f, 0.f));
+	ut_assert_false(geometry.insideArea(3, 0.f, 0.f)); // invalid area
+
+	// a degenerate polygon does not contain any point
+	ut_assert_true(geometry.reset(1, 2));
+	ut_assert_true(geometry.addPolygon(square_x, square_y, 2, true));
+	ut_assert_false(geometry.inside(0.f, 0.f));
+
+	return true;
+}
+
+bool GeofenceTest::manyVertices()
+{
+	static constexpr int vertex_counts[] = {5, 16, 64, 256, 1024};
+
+	for (int vertex_count : vertex_counts) {
+		float *x = new float[vertex_count];
+		float *y = new float[vertex_count];
+		ut_assert_true(x != nullptr && y != nullptr);
+
+		makeStar(x, y, vertex_count, 1000.f);
+
+		GeofenceGeometry geometry;
+		ut_assert_true(geometry.reset(1, vertex_count));
+		ut_assert_true(geometry.addPolygon(x, y, vertex_count, true));
+
+		int mismatches = 0;
+
+		for (int i = 0; i < 2000; ++i) {
+			const float px = random(-1200.f, 1200.f);
+			const float py = random(-1200.f, 1200.f);
+
+			if (geometry.insideArea(0, px, py) != referenceInside(x, y, vertex_count, px, py)) {
+				++mismatches;
+			}
+		}
+
+		delete[] x;
+		delete[] y;
+
+		ut_compare("point tests differ from the reference", mismatches, 0);
+	}
+
+	return true;
+}
+
+bool GeofenceTest::benchmark()
+{
+	static constexpr int vertex_counts[] = {16, 64, 256, 1024};
+	static constexpr int num_points = 1000;
+
+	float *points = new float[2 * num_points];
+	ut_assert_true(points != nullptr);
+
+	for (int i = 0; i < 2 * num_points; ++i) {
+		points[i] = random(-1200.f, 1200.f);
+	}
+
+	for (int vertex_count : vertex_counts) {
+		float *x = new float[vertex_count];
+		float *y = new float[vertex_count];
+		ut_assert_true(x != nullptr && y != nullptr);
+
+		makeStar(x, y, vertex_count, 1000.f);
+
+		GeofenceGeometry geometry;
+		ut_assert_true(geometry.reset(1, vertex_count));
+		ut_assert_true(geometry.addPolygon(x, y, vertex_count, true));
+
+		char name[48];
+		snprintf(name, sizeof(name), "geofence: %i vertices", vertex_count);
+		perf_counter_t perf = perf_alloc(PC_ELAPSED, name);
+		snprintf(name, sizeof(name), "geofence: %i vertices (reference)", vertex_count);
+		perf_counter_t perf_reference = perf_alloc(PC_ELAPSED, name);
+		int num_inside = 0;
+
+		for (int i = 0; i < num_points; ++i) {
+			perf_begin(perf);
+			num_inside += geometry.inside(points[2 * i], points[2 * i + 1]);
+			perf_end(perf);
+
+			perf_begin(perf_reference);
+			num_inside -= referenceInside(x, y, vertex_count, points[2 * i], points[2 * i + 1]);
+			perf_end(perf_reference);
+		}
+
+		perf_print_counter(perf);
+		perf_print_counter(perf_reference);
+		perf_free(perf);
+		perf_free(perf_reference);
+		delete[] x;
+		delete[] y;
+
+		ut_compare("benchmark results differ from the reference", num_inside, 0);
+	}
+
+	delete[] points;
+
+	return true;
+}
+
+ut_declare_test_c(test_geofence, GeofenceTest)
@@ -0,0 +1,204 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_lpe.cpp
+ * Compares the sparse covariance propagation and correction of the local position estimator
+ * against the dense matrix products they replace.
+ */
+
+#include <unit_test.h>
+
+#include <local_position_estimator/SparseCovariance.hpp>
+
+#include <math.h>
+#include <stdlib.h>
+
+using namespace matrix;
+using namespace lpe;
+
+class LPETest : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool predictTest();
+	bool correctTest();
+
+	// random symmetric positive definite covariance
+	Matrix<float, n_x, n_x> randomCovariance();
+
+	float random(float min, float max) { return min + (max - min) * (float)rand() / (float)RAND_MAX; }
+
+	template<size_t M, size_t N>
+	float maxError(const Matrix<float, M, N> &a, const Matrix<float, M, N> &b)
+	{
+		float err = 0.f;
+
+		for (size_t i = 0; i < M; i++) {
+			for (size_t j = 0; j < N; j++) {
+				err = fmaxf(err, fabsf(a(i, j) - b(i, j)));
+			}
+		}
+
+		return err;
+	}
+
+	static constexpr float TOLERANCE = 1e-5f;
+};
+
+bool LPETest::run_tests()
+{
+	srand(0);
+
+	ut_run_test(predictTest);
+	ut_run_test(correctTest);
+
+	return (_tests_failed == 0);
+}
+
+Matrix<float, n_x, n_x> LPETest::randomCovariance()
+{
+	Matrix<float, n_x, n_x> L;
+
+	for (size_t i = 0; i < n_x; i++) {
+		for (size_t j = 0; j < n_x; j++) {
+			L(i, j) = random(-1.f, 1.f);
+		}
+	}
+
+	return L * L.transpose();
+}
+
+bool LPETest::predictTest()
+{
+	for (int n = 0; n < 20; n++) {
+		const Matrix<float, n_x, n_x> P = randomCovariance();
+		const Dcmf R_att{Eulerf{random(-1.f, 1.f), random(-1.f, 1.f), random(-3.f, 3.f)}};
+
+		Matrix<float, 3, 3> R;
+		R(0, 0) = R(1, 1) = random(0.01f, 1.f);
+		R(2, 2) = random(0.01f, 1.f);
+
+		Matrix<float, n_x, n_x> Q;
+
+		for (size_t i = 0; i < n_x; i++) {
+			Q(i, i) = random(0.f, 0.1f);
+		}
+
+		// dense dynamics and input matrices, as in BlockLocalPositionEstimator::initSS()
+		Matrix<float, n_x, n_x> A;
+		A(X_x, X_vx) = 1;
+		A(X_y, X_vy) = 1;
+		A(X_z, X_vz) = 1;
+
+		for (size_t i = 0; i < 3; i++) {
+			for (size_t j = 0; j < 3; j++) {
+				A(X_vx + i, X_bx + j) = -R_att(i, j);
+			}
+		}
+
+		Matrix<float, n_x, 3> B;
+		B(X_vx, 0) = 1;
+		B(X_vy, 1) = 1;
+		B(X_vz, 2) = 1;
+
+		const float dt = 0.004f;
+
+		const Matrix<float, n_x, n_x> dP_dense = (A * P + P * A.transpose() + B * R * B.transpose() + Q) * dt;
+
+		Matrix<float, n_x, n_x> dP;
+		predictCovariance(P, R_att, R, Q, dt, dP);
+
+		ut_assert("predict matches dense", maxError(dP, dP_dense) < TOLERANCE);
+	}
+
+	return true;
+}
+
+bool LPETest::correctTest()
+{
+	// lidar style measurement, agl = tz - z
+	Matrix<float, 1, n_x> C_agl;
+	C_agl(0, X_z) = -1;
+	C_agl(0, X_tz) = 1;
+
+	// gps style measurement, position and velocity
+	Matrix<float, 6, n_x> C_gps;
+
+	for (size_t i = 0; i < 6; i++) {
+		C_gps(i, X_x + i) = 1;
+	}
+
+	for (int n = 0; n < 20; n++) {
+		{
+			const Matrix<float, n_x, n_x> P = randomCovariance();
+
+			const Matrix<float, n_x, 1> PCt = covarianceTimesCt(P, C_agl);
+			ut_assert("P * C' matches dense", maxError(PCt, Matrix<float, n_x, 1> {P * C_agl.transpose()}) < TOLERANCE);
+
+			const Matrix<float, 1, 1> S = C_agl * PCt;
+			const Matrix<float, n_x, 1> K = PCt * (1.f / (S(0, 0) + 0.1f));
+
+			Matrix<float, n_x, n_x> P_sparse = P;
+			correctCovariance(P_sparse, K, PCt);
+
+			ut_assert("agl correct matches dense", maxError(P_sparse, Matrix<float, n_x, n_x> {P - K * C_agl * P}) < TOLERANCE);
+		}
+
+		{
+			const Matrix<float, n_x, n_x> P = randomCovariance();
+
+			const Matrix<float, n_x, 6> PCt = covarianceTimesCt(P, C_gps);
+			ut_assert("P * C' matches dense", maxError(PCt, Matrix<float, n_x, 6> {P * C_gps.transpose()}) < TOLERANCE);
+
+			SquareMatrix<float, 6> S{C_gps * PCt};
+
+			for (size_t i = 0; i < 6; i++) {
+				S(i, i) += 0.1f;
+			}
+
+			const Matrix<float, n_x, 6> K = PCt * inv<float, 6>(S);
+
+			Matrix<float, n_x, n_x> P_sparse = P;
+			correctCovariance(P_sparse, K, PCt);
+
+			ut_assert("gps correct matches dense", maxError(P_sparse, Matrix<float, n_x, n_x> {P - K * C_gps * P}) < TOLERANCE);
+		}
+	}
+
+	return true;
+}
+
+ut_declare_test_c(test_lpe, LPETest)
@@ -59,6 +59,8 @@
 #include <systemlib/err.h>
 #include <drivers/drv_hrt.h>
 #include <matrix/math.hpp>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
+#include <mathlib/math/filter/LowPassFilter2pVector3f.hpp>
 
 #include "tests_main.h"
 
@@ -79,6 +81,7 @@ private:
 	bool testQuaternionfrom_euler();
 	bool testQuaternionRotate();
 	bool testFinite();
+	bool testBiquadFilterBank();
 };
 
 #define TEST_OP(_title, _op) { unsigned int n = 30000; hrt_abstime t0, t1; t0 = hrt_absolute_time(); for (unsigned int j = 0; j < n; j++) { _op; }; t1 = hrt_absolute_time(); PX4_INFO(_title ": %.6fus", (double)(t1 - t0) / n); }
@@ -390,6 +393,83 @@ bool MathlibTest::testFinite()
 	return true;
 }
 
+bool MathlibTest::testBiquadFilterBank()
+{
+	static constexpr int N = 100;
+	const float sample_freq = 1000.0f;
+
+	// a single low pass section matches LowPassFilter2pVector3f
+	{
+		math::LowPassFilter2pVector3f reference{sample_freq, 30.0f};
+		math::BiquadFilterBank<3> bank;
+		ut_assert_true(bank.add_lowpass(sample_freq, 30.0f));
+
+		float block[N][3];
+
+		for (int i = 0; i < N; i++) {
+			block[i][0] = sinf(0.1f * i);
+			block[i][1] = cosf(0.3f * i);
+			block[i][2] = (i % 10 < 5) ? 1.0f : -1.0f;
+		}
+
+		float expected[N][3];
+
+		for (int i = 0; i < N; i++) {
+			reference.apply(matrix::Vector3f{block[i]}).copyTo(expected[i]);
+		}
+
+		// in two blocks, the state carries over
+		bank.apply(block, N / 2);
+		bank.apply(&block[N / 2], N - N / 2);
+
+		for (int i = 0; i < N; i++) {
+			for (int ch = 0; ch < 3; ch++) {
+				ut_compare_float("lowpass matches LowPassFilter2pVector3f", block[i][ch], expected[i][ch], 5);
+			}
+		}
+	}
+
+	// notch rejects its center frequency and passes DC
+	{
+		math::BiquadFilterBank<2> bank;
+		ut_assert_true(bank.add_notch(sample_freq, 100.0f, 20.0f));
+		ut_assert_false(bank.add_notch(sample_freq, 600.0f, 20.0f));
+		ut_assert_true(bank.add_lowpass(sample_freq, 80.0f));
+		ut_assert_false(bank.add_lowpass(sample_freq, 80.0f));
+		ut_assert_true(bank.sections() == 2);
+
+		float block[N][2];
+		float max_notch = 0.0f;
+
+		for (int rep = 0; rep < 10; rep++) {
+			for (int i = 0; i < N; i++) {
+				block[i][0] = sinf(2.0f * M_PI_F * 100.0f * (rep * N + i) / sample_freq);
+				block[i][1] = 1.0f;
+			}
+
+			bank.apply(block, N);
+		}
+
+		for (int i = 0; i < N; i++) {
+			max_notch = math::max(max_notch, fabsf(block[i][0]));
+		}
+
+		ut_assert_true(max_notch < 0.01f);
+		ut_compare_float("DC passes", block[N - 1][1], 1.0f, 3);
+
+		// reset to a steady state, a constant input stays constant
+		const float value[2] {2.0f, -3.0f};
+		bank.reset(value);
+		block[0][0] = value[0];
+		block[0][1] = value[1];
+		bank.apply(block, 1);
+		ut_compare_float("reset steady state", block[0][0], value[0], 3);
+		ut_compare_float("reset steady state", block[0][1], value[1], 3);
+	}
+
+	return true;
+}
+
 bool MathlibTest::run_tests()
 {
 	ut_run_test(testVector2);
@@ -401,6 +481,7 @@ bool MathlibTest::run_tests()
 	ut_run_test(testQuaternionfrom_euler);
 	ut_run_test(testQuaternionRotate);
 	ut_run_test(testFinite);
+	ut_run_test(testBiquadFilterBank);
 
 	return (_tests_failed == 0);
 }
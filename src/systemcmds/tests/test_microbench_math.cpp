@@ -44,6 +44,8 @@
 #include <math.h>
 
 #include <drivers/drv_hrt.h>
+#include <mathlib/math/filter/BiquadFilterBank.hpp>
+#include <mathlib/math/filter/LowPassFilter2pVector3f.hpp>
 #include <perf/perf_counter.h>
 #include <px4_config.h>
 #include <px4_micro_hal.h>
@@ -103,6 +105,8 @@ private:
 	bool time_32bit_integers();
 	bool time_64bit_integers();
 
+	bool time_filters();
+
 	void reset();
 
 	float f32;
@@ -125,6 +129,14 @@ private:
 
 	uint64_t u_64;
 	uint64_t u_64_out;
+
+	static constexpr int FILTER_BLOCK = 8;	// e.g. 1 ms of 8 kHz FIFO data
+
+	matrix::Vector3f v3;
+	matrix::Vector3f v3_out;
+
+	float block[FILTER_BLOCK][3];
+	float block_3imu[FILTER_BLOCK][9];
 };
 
 bool MicroBenchMath::run_tests()
@@ -137,6 +149,7 @@ bool MicroBenchMath::run_tests()
 	ut_run_test(time_16bit_integers);
 	ut_run_test(time_32bit_integers);
 	ut_run_test(time_64bit_integers);
+	ut_run_test(time_filters);
 
 	return (_tests_failed == 0);
 }
@@ -173,6 +186,18 @@ void MicroBenchMath::reset()
 
 	u_64 = rand();
 	u_64_out = rand();
+
+	v3 = matrix::Vector3f(random(-10.0f, 10.0f), random(-10.0f, 10.0f), random(-10.0f, 10.0f));
+
+	for (int i = 0; i < FILTER_BLOCK; i++) {
+		for (int ch = 0; ch < 3; ch++) {
+			block[i][ch] = random(-10.0f, 10.0f);
+		}
+
+		for (int ch = 0; ch < 9; ch++) {
+			block_3imu[i][ch] = random(-10.0f, 10.0f);
+		}
+	}
 }
 
 ut_declare_test_c(test_microbench_math, MicroBenchMath)
@@ -268,4 +293,49 @@ bool MicroBenchMath::time_64bit_integers()
 	return true;
 }
 
+bool MicroBenchMath::time_filters()
+{
+	// per sample cost of the scalar filter vs. the filter bank, compare the
+	// block results divided by FILTER_BLOCK (and by 3 for the 3 IMU case)
+	math::LowPassFilter2pVector3f lpf{8000.0f, 30.0f};
+	math::LowPassFilter2pVector3f lpf_3imu[3] {{8000.0f, 30.0f}, {8000.0f, 30.0f}, {8000.0f, 30.0f}};
+
+	math::BiquadFilterBank<3> bank;
+	bank.add_lowpass(8000.0f, 30.0f);
+
+	math::BiquadFilterBank<9> bank_3imu;
+	bank_3imu.add_lowpass(8000.0f, 30.0f);
+
+	math::BiquadFilterBank<3> bank_notch;
+	bank_notch.add_notch(8000.0f, 250.0f, 50.0f);
+	bank_notch.add_lowpass(8000.0f, 30.0f);
+
+	PERF("LowPassFilter2pVector3f 1 sample", v3_out = lpf.apply(v3), 1000);
+	PERF("BiquadFilterBank<3> 1 sample", bank.apply(block, 1), 1000);
+
+	auto lpf_block = [&]() {
+		for (int i = 0; i < FILTER_BLOCK; i++) {
+			v3_out = lpf.apply(matrix::Vector3f{block[i]});
+		}
+	};
+
+	auto lpf_block_3imu = [&]() {
+		for (int i = 0; i < FILTER_BLOCK; i++) {
+			for (int imu = 0; imu < 3; imu++) {
+				v3_out = lpf_3imu[imu].apply(matrix::Vector3f{&block_3imu[i][imu * 3]});
+			}
+		}
+	};
+
+	PERF("LowPassFilter2pVector3f 8 samples", lpf_block(), 1000);
+	PERF("BiquadFilterBank<3> 8 samples", bank.apply(block, FILTER_BLOCK), 1000);
+
+	PERF("LowPassFilter2pVector3f 3 IMUs 8 samples", lpf_block_3imu(), 1000);
+	PERF("BiquadFilterBank<9> 3 IMUs 8 samples", bank_3imu.apply(block_3imu, FILTER_BLOCK), 1000);
+
+	PERF("BiquadFilterBank<3> notch+lpf 8 samples", bank_notch.apply(block, FILTER_BLOCK), 1000);
+
+	return true;
+}
+
 } // namespace MicroBenchMath
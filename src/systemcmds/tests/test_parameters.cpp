@@ -39,9 +39,11 @@
 #include <unit_test.h>
 
 #include <px4_defines.h>
+#include <drivers/drv_hrt.h>
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include <math.h>
 
@@ -80,12 +82,21 @@ private:
 	bool ResetAllExcludesBoundaryCheck();
 	bool ResetAllExcludesWildcard();
 	bool exportImport();
+	bool changeTracking();
 
 	// tests on system parameters
 	// WARNING, can potentially trash your system
 	bool exportImportAll();
+	bool importBenchmark();
+	bool saveJournal();
 };
 
+static off_t param_file_size()
+{
+	struct stat st;
+	return (stat(param_get_default_file(), &st) == 0) ? st.st_size : -1;
+}
+
 bool ParameterTest::_assert_parameter_int_value(param_t param, int32_t expected)
 {
 	int32_t value;
@@ -532,6 +543,268 @@ bool ParameterTest::exportImportAll()
 	return ret;
 }
 
+bool ParameterTest::changeTracking()
+{
+	param_reset_all();
+
+	const uint32_t epoch = param_get_epoch();
+	const uint32_t hash = param_hash_check();
+
+	ut_assert_false(param_changed_since(p0, epoch));
+	ut_assert_false(param_changed_since(p1, epoch));
+	ut_compare("hash changed without parameter change", hash, param_hash_check());
+
+	int32_t value = 42;
+	param_set(p0, &value);
+
+	ut_assert_true(param_get_epoch() != epoch);
+	ut_assert_true(param_changed_since(p0, epoch));
+	ut_assert_false(param_changed_since(p1, epoch));
+	ut_assert_true(hash != param_hash_check());
+
+	// setting the same value again is not a change
+	const uint32_t epoch_after_set = param_get_epoch();
+	param_set(p0, &value);
+	ut_assert_false(param_changed_since(p0, epoch_after_set));
+
+	// resetting to the default is a change
+	param_reset(p0);
+	ut_assert_true(param_changed_since(p0, epoch_after_set));
+	ut_compare("hash not restored after reset", hash, param_hash_check());
+
+	// an unknown (future) epoch reports everything as changed
+	ut_assert_true(param_changed_since(p1, param_get_epoch() + 1));
+
+	return true;
+}
+
+bool ParameterTest::importBenchmark()
+{
+	static constexpr unsigned NUM_CHANGED_PARAMS = 1000;
+
+	// backup current parameters
+	const char *backup_file_name = PX4_STORAGEDIR "/param_backup";
+	const char *bench_file_name = PX4_STORAGEDIR "/param_bench";
+	int fd = open(backup_file_name, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", backup_file_name, errno);
+		return false;
+	}
+
+	int result = param_export(fd, false);
+	close(fd);
+
+	if (result != PX4_OK) {
+		PX4_ERR("param_export failed");
+		return false;
+	}
+
+	// change up to NUM_CHANGED_PARAMS parameters
+	param_reset_all();
+
+	unsigned num_changed = 0;
+
+	for (int i = param_count() - 1; i >= 0 && num_changed < NUM_CHANGED_PARAMS; i--) {
+		param_t p = param_for_index(i);
+
+		if (param_type(p) == PARAM_TYPE_INT32) {
+			int32_t val = 0;
+			param_get(p, &val);
+			val++;
+			param_set_no_notification(p, &val);
+			num_changed++;
+
+		} else if (param_type(p) == PARAM_TYPE_FLOAT) {
+			float val = 0.0f;
+			param_get(p, &val);
+			val += 1.0f;
+			param_set_no_notification(p, &val);
+			num_changed++;
+		}
+	}
+
+	fd = open(bench_file_name, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", bench_file_name, errno);
+		return false;
+	}
+
+	result = param_export(fd, false);
+	close(fd);
+
+	ut_compare("param_export failed", result, PX4_OK);
+
+	// boot-time import of the changed parameters
+	param_reset_all();
+
+	fd = open(bench_file_name, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", bench_file_name, errno);
+		return false;
+	}
+
+	const hrt_abstime import_start = hrt_absolute_time();
+	result = param_import(fd);
+	const hrt_abstime import_time = hrt_elapsed_time(&import_start);
+	close(fd);
+
+	ut_assert_true(result >= 0);
+
+	unsigned num_imported = 0;
+	const hrt_abstime get_start = hrt_absolute_time();
+
+	for (unsigned i = 0; i < param_count(); i++) {
+		param_t p = param_for_index(i);
+
+		if (!param_value_is_default(p)) {
+			num_imported++;
+		}
+	}
+
+	const hrt_abstime get_time = hrt_elapsed_time(&get_start);
+
+	PX4_INFO("import of %u changed parameters: %llu us, lookup of %u parameters: %llu us", num_imported,
+		 (unsigned long long)import_time, param_count(), (unsigned long long)get_time);
+
+	ut_compare("not all changed parameters imported", num_imported, num_changed);
+
+	unlink(bench_file_name);
+
+	// restore original params
+	param_reset_all();
+
+	fd = open(backup_file_name, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", backup_file_name, errno);
+		return false;
+	}
+
+	result = param_import(fd);
+	close(fd);
+
+	if (result < 0) {
+		PX4_ERR("importing from '%s' failed (%i)", backup_file_name, result);
+		return false;
+	}
+
+	return true;
+}
+
+bool ParameterTest::saveJournal()
+{
+	// backup current parameters
+	const char *backup_file_name = PX4_STORAGEDIR "/param_backup";
+	int fd = open(backup_file_name, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", backup_file_name, errno);
+		return false;
+	}
+
+	int result = param_export(fd, false);
+	close(fd);
+
+	if (result != PX4_OK) {
+		PX4_ERR("param_export failed");
+		return false;
+	}
+
+	// a reset requires a full write, the following saves append journal records
+	param_reset_all();
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+	const off_t base_size = param_file_size();
+	ut_assert("param file missing", base_size > 0);
+
+	char temp_filename[256];
+	snprintf(temp_filename, sizeof(temp_filename), "%s.tmp", param_get_default_file());
+	ut_assert("temporary param file left behind", access(temp_filename, F_OK) != 0);
+
+	int32_t value = 5;
+	param_set(p0, &value);
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+
+	// a save appends one record instead of rewriting the file
+	const off_t record_size = param_file_size() - base_size;
+	ut_assert("save did not append a record", record_size > 0 && record_size < base_size);
+
+	// a save without changes does not write anything
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+	ut_compare("save without changes modified the file", param_file_size(), base_size + record_size);
+
+	value = 6;
+	param_set(p0, &value);
+	value = 7;
+	param_set(p1, &value);
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+
+	// the loaded values need to include all records
+	ut_compare("param_load_default failed", param_load_default(), PX4_OK);
+	ut_assert_true(_assert_parameter_int_value(p0, 6));
+	ut_assert_true(_assert_parameter_int_value(p1, 7));
+
+	// a reset is stored as well
+	param_reset(p0);
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+	ut_compare("param_load_default failed", param_load_default(), PX4_OK);
+	ut_assert_true(param_value_is_default(p0));
+	ut_assert_true(_assert_parameter_int_value(p1, 7));
+
+	// a torn last record (e.g. power loss during a save) is dropped, the earlier records are kept
+	value = 8;
+	param_set(p0, &value);
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+
+	value = 9;
+	param_set(p1, &value);
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+
+	fd = open(param_get_default_file(), O_WRONLY);
+	ut_assert("open param file failed", fd >= 0);
+	const off_t file_size = lseek(fd, 0, SEEK_END);
+	result = ftruncate(fd, file_size - 3); // cut into the value of the last record
+	close(fd);
+	ut_compare("ftruncate failed", result, 0);
+
+	ut_compare("param_load_default failed", param_load_default(), PX4_OK);
+	ut_assert_true(_assert_parameter_int_value(p0, 8));
+	ut_assert_true(_assert_parameter_int_value(p1, 7));
+
+	// the damaged file is rewritten by the next save
+	ut_compare("param_save_default failed", param_save_default(), PX4_OK);
+	ut_compare("param_load_default failed", param_load_default(), PX4_OK);
+	ut_assert_true(_assert_parameter_int_value(p0, 8));
+	ut_assert_true(_assert_parameter_int_value(p1, 7));
+
+	// restore original params
+	param_reset_all();
+
+	fd = open(backup_file_name, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("open '%s' failed (%i)", backup_file_name, errno);
+		return false;
+	}
+
+	result = param_import(fd);
+	close(fd);
+
+	if (result < 0) {
+		PX4_ERR("importing from '%s' failed (%i)", backup_file_name, result);
+		return false;
+	}
+
+	if (param_save_default() != PX4_OK) {
+		PX4_ERR("param_save_default failed");
+		return false;
+	}
+
+	return true;
+}
+
 bool ParameterTest::run_tests()
 {
 	param_control_autosave(false);
@@ -544,10 +817,13 @@ bool ParameterTest::run_tests()
 	ut_run_test(ResetAllExcludesBoundaryCheck);
 	ut_run_test(ResetAllExcludesWildcard);
 	ut_run_test(exportImport);
+	ut_run_test(changeTracking);
 
 	// WARNING, can potentially trash your system
 #ifdef __PX4_POSIX
 	ut_run_test(exportImportAll);
+	ut_run_test(importBenchmark);
+	ut_run_test(saveJournal);
 #endif /* __PX4_POSIX */
 
 	param_control_autosave(true);
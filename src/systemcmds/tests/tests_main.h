@@ -53,6 +53,7 @@ extern int test_dataman(int argc, char *argv[]);
 extern int test_file(int argc, char *argv[]);
 extern int test_file2(int argc, char *argv[]);
 extern int test_float(int argc, char *argv[]);
+extern int test_geofence(int argc, char *argv[]);
 extern int test_hott_telemetry(int argc, char *argv[]);
 extern int test_hrt(int argc, char *argv[]);
 extern int test_int(int argc, char *argv[]);
@@ -60,6 +61,7 @@ extern int test_IntrusiveQueue(int argc, char *argv[]);
 extern int test_jig_voltages(int argc, char *argv[]);
 extern int test_led(int argc, char *argv[]);
 extern int test_List(int argc, char *argv[]);
+extern int test_lpe(int argc, char *argv[]);
 extern int test_mathlib(int argc, char *argv[]);
 extern int test_matrix(int argc, char *argv[]);
 extern int test_microbench_hrt(int argc, char *argv[]);
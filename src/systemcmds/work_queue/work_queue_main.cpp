@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2019 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file work_queue_main.cpp
+ *
+ * Show the status of the work queues.
+ */
+
+#include <px4_config.h>
+#include <px4_log.h>
+#include <px4_module.h>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+
+#include <string.h>
+
+static void	usage();
+
+extern "C" {
+	__EXPORT int work_queue_main(int argc, char *argv[]);
+}
+
+static void
+usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+
+Command-line tool to show the work queue status.
+
+Work items scheduled from a timer (e.g. drivers on a shared I2C or SPI bus) are listed per work queue
+with their measured rate, interval and phase if they are periodic, average and maximum run time, and the
+fraction of time the queue (bus) spends on them. The averages are taken over one second.
+
+Items scheduled with ScheduleOnInterval() get their phase assigned to minimize the overlap with the other
+periodic items on the same queue. On the I2C and SPI bus queues, items that re-arm themselves with
+ScheduleDelayed() (e.g. measure/collect cycles) have each run moved back slightly where it would otherwise
+delay the next run of another item on the bus.
+
+Up to 12 items per queue are tracked; the number of further items is shown separately.
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("work_queue", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "print status info");
+}
+
+int
+work_queue_main(int argc, char *argv[])
+{
+	if (argc == 2 && strcmp(argv[1], "status") == 0) {
+		return px4::WorkQueueManagerStatus();
+	}
+
+	usage();
+	return 1;
+}